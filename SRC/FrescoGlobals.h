@@ -77,8 +77,17 @@ static const int OF_RemoteTest_getInitialStiff  = 12;
 static const int OF_RemoteTest_getTangentStiff  = 13;
 static const int OF_RemoteTest_getDamp          = 14;
 static const int OF_RemoteTest_getMass          = 15;
+static const int OF_RemoteTest_batch            = 16;
+static const int OF_RemoteTest_setupBulk        = 17;
+static const int OF_RemoteTest_trajectory       = 18;
+static const int OF_RemoteTest_getMatrix        = 19;
 static const int OF_RemoteTest_DIE              = 99;
 
+// Matrix Reply Format (OF_RemoteTest_getMatrix)
+static const int OF_Matrix_unchanged = 0;
+static const int OF_Matrix_full      = 1;
+static const int OF_Matrix_upperTri  = 2;
+
 // tentative remote test
 static const int OF_RemoteTest_acquire          = 50;
 
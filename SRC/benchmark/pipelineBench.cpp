@@ -0,0 +1,849 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// $Revision$
+// $Date$
+// $URL$
+
+// Created: 10/26
+// Revision: A
+//
+// Purpose: This file is a standalone end-to-end benchmark of the
+// hybrid simulation pipeline. All scenarios run on one machine, the
+// servers run on threads of this process and talk over loopback:
+//
+//   localSite        LocalExpSite + ESNoTransformation + ECSimUniaxialMaterials
+//   shadowActorTCP   ShadowExpSite <-> ActorExpSite over TCP
+//   shadowActorUDP   ShadowExpSite <-> ActorExpSite over UDP
+//   shadowActorCodec ShadowExpSite <-> ActorExpSite over TCP with
+//                    daq responses quantized to 1.0E-6
+//   trajectoryTCP    ShadowExpSite <-> ActorExpSite over TCP, all steps
+//                    uploaded as one trajectory in chunks (-chunk n,
+//                    default 256)
+//   eeGeneric        EEGeneric element <-> SimAppSiteServer over TCP
+//   ecGenericTCP     LocalExpSite + ECGenericTCP <-> stub controller over TCP
+//   bearingArray     array of EEBearing2d isolators with p-delta effects, each
+//                    with its own LocalExpSite (-bearings n, default 100)
+//
+// Each step sets the trial response, gets the daq response and commits
+// the state. For each scenario one JSON object is written per line to
+// stdout with the throughput, the percentiles of the per-step latency
+// and the number of operator new calls per step (of all threads of the
+// process, so that the server side is included). Progress messages of
+// the objects go to stderr. The bearingArray scenario also forms the
+// tangent of every bearing in each step like a Newton iteration does
+// and reports the number of free dofs (3 per bearing). The
+// trajectoryTCP scenario can only time the whole trajectory and
+// reports the mean latency per step instead of the percentiles.
+//
+// usage: pipelineBench <-steps n> <-warmup n> <-dof n> <-bearings n>
+//                      <-chunk n> <-port p> <-scenario name> ...
+
+// standard C++ includes
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <new>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <OPS_Globals.h>
+#include <StandardStream.h>
+#include <tcl.h>
+
+// includes the domain classes
+#include <Domain.h>
+#include <Node.h>
+#include <ElasticMaterial.h>
+#include <TCP_Socket.h>
+#include <UDP_Socket.h>
+
+// includes OpenFresco classes
+#include <FrescoGlobals.h>
+#include <ECSimUniaxialMaterials.h>
+#include <ECGenericTCP.h>
+#include <ESNoTransformation.h>
+#include <LocalExpSite.h>
+#include <ShadowExpSite.h>
+#include <ActorExpSite.h>
+#include <EEGeneric.h>
+#include <EEBearing2d.h>
+
+// init the global variabled defined in OPS_Globals.h
+StandardStream sserr;
+OPS_Stream *opserrPtr = &sserr;
+
+extern int TclStartSimAppSiteServer(ClientData clientData,
+    Tcl_Interp *interp, int argc, TCL_Char **argv);
+
+// time the servers get to start listening after they signal
+#define BENCH_SETTLE_USEC 100000
+
+
+// ----------------------------------------------------------------------------
+// allocation counting
+
+static volatile long numAllocs = 0;
+
+void *operator new(size_t size)
+{
+    __sync_fetch_and_add(&numAllocs, 1);
+    void *p = malloc(size > 0 ? size : 1);
+    if (p == 0)
+        throw std::bad_alloc();
+    return p;
+}
+
+void *operator new[](size_t size)
+{
+    __sync_fetch_and_add(&numAllocs, 1);
+    void *p = malloc(size > 0 ? size : 1);
+    if (p == 0)
+        throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void *p) throw()
+{
+    free(p);
+}
+
+void operator delete[](void *p) throw()
+{
+    free(p);
+}
+
+
+// ----------------------------------------------------------------------------
+// common helpers
+
+static double getTime()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + 1.0E-9*ts.tv_nsec;
+}
+
+
+static int compareDouble(const void *a, const void *b)
+{
+    double da = *(const double *)a;
+    double db = *(const double *)b;
+    return (da > db) - (da < db);
+}
+
+
+struct benchOptions {
+    int numSteps;
+    int numWarmup;
+    int numDOF;
+    int numBearings;
+    int chunkSize;
+    int port;
+};
+
+
+// displacement history of all scenarios
+static double getDisp(int step, int dof)
+{
+    return sin(0.01*(step+1) + 0.1*dof);
+}
+
+
+// steps of a scenario, returns a negative value on failure
+class BenchScenario
+{
+public:
+    virtual ~BenchScenario() {};
+    virtual int step(int k) = 0;
+};
+
+
+static int measure(const char *name, BenchScenario &theScenario,
+    const benchOptions &opt)
+{
+    int k;
+    for (k=0; k<opt.numWarmup; k++)  {
+        if (theScenario.step(k) < 0)  {
+            fprintf(stderr, "pipelineBench - %s failed in warmup step %d\n",
+                name, k);
+            return -1;
+        }
+    }
+    
+    double *lat = (double *)malloc(opt.numSteps*sizeof(double));
+    long allocs0 = numAllocs;
+    double tStart = getTime();
+    for (k=0; k<opt.numSteps; k++)  {
+        double t0 = getTime();
+        if (theScenario.step(opt.numWarmup+k) < 0)  {
+            fprintf(stderr, "pipelineBench - %s failed in step %d\n",
+                name, opt.numWarmup+k);
+            free(lat);
+            return -1;
+        }
+        lat[k] = getTime() - t0;
+    }
+    double tTotal = getTime() - tStart;
+    long allocs = numAllocs - allocs0;
+    
+    qsort(lat, opt.numSteps, sizeof(double), compareDouble);
+    int n = opt.numSteps - 1;
+    fprintf(stdout, "{\"scenario\": \"%s\", \"dof\": %d, \"steps\": %d, "
+        "\"stepsPerSec\": %.1f, \"latencyUs\": {\"min\": %.2f, \"p50\": %.2f, "
+        "\"p90\": %.2f, \"p99\": %.2f, \"p999\": %.2f, \"max\": %.2f}, "
+        "\"allocsPerStep\": %.2f}\n",
+        name, opt.numDOF, opt.numSteps, opt.numSteps/tTotal,
+        1.0E6*lat[0], 1.0E6*lat[n/2], 1.0E6*lat[(int)(0.9*n)],
+        1.0E6*lat[(int)(0.99*n)], 1.0E6*lat[(int)(0.999*n)], 1.0E6*lat[n],
+        (double)allocs/opt.numSteps);
+    fflush(stdout);
+    
+    free(lat);
+    return 0;
+}
+
+
+// flag that a server thread sets once its socket is bound
+struct serverSync {
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    int ready;
+};
+
+
+static void initSync(serverSync &sync)
+{
+    pthread_mutex_init(&sync.mutex, NULL);
+    pthread_cond_init(&sync.cond, NULL);
+    sync.ready = 0;
+}
+
+
+static void signalReady(serverSync &sync)
+{
+    pthread_mutex_lock(&sync.mutex);
+    sync.ready = 1;
+    pthread_cond_broadcast(&sync.cond);
+    pthread_mutex_unlock(&sync.mutex);
+}
+
+
+static void waitReady(serverSync &sync)
+{
+    pthread_mutex_lock(&sync.mutex);
+    while (!sync.ready)
+        pthread_cond_wait(&sync.cond, &sync.mutex);
+    pthread_mutex_unlock(&sync.mutex);
+    
+    // the TCP servers only listen once they set up the connection
+    usleep(BENCH_SETTLE_USEC);
+}
+
+
+// experimental setup with elastic specimens used by the site scenarios
+static ExperimentalSetup *createSimSetup(int tag, int numDOF)
+{
+    UniaxialMaterial **theSpecimen = new UniaxialMaterial* [numDOF];
+    for (int i=0; i<numDOF; i++)
+        theSpecimen[i] = new ElasticMaterial(i+1, 100.0);
+    ExperimentalControl *theControl =
+        new ECSimUniaxialMaterials(tag, numDOF, theSpecimen);
+    for (int i=0; i<numDOF; i++)
+        delete theSpecimen[i];
+    delete [] theSpecimen;
+    
+    ID dof(numDOF);
+    for (int i=0; i<numDOF; i++)
+        dof(i) = i;
+    
+    return new ESNoTransformation(tag, dof, numDOF, numDOF, theControl);
+}
+
+
+// trial displacements and daq displacements and forces
+static void getSiteSizes(int numDOF, ID &sizeT, ID &sizeO)
+{
+    sizeT.Zero();
+    sizeO.Zero();
+    sizeT(OF_Resp_Disp) = numDOF;
+    sizeO(OF_Resp_Disp) = numDOF;
+    sizeO(OF_Resp_Force) = numDOF;
+}
+
+
+// ----------------------------------------------------------------------------
+// scenarios that drive an experimental site
+
+class SiteScenario : public BenchScenario
+{
+public:
+    SiteScenario(ExperimentalSite *site, int numDOF)
+        : theSite(site), tDisp(numDOF), dDisp(numDOF), dForce(numDOF)
+    {
+        ID sizeT(OF_Resp_All), sizeO(OF_Resp_All);
+        getSiteSizes(numDOF, sizeT, sizeO);
+        theSite->setSize(sizeT, sizeO);
+    };
+    
+    int step(int k)
+    {
+        for (int i=0; i<tDisp.Size(); i++)
+            tDisp(i) = getDisp(k, i);
+        int rValue = theSite->setTrialResponse(&tDisp,
+            (Vector*)0, (Vector*)0, (Vector*)0, (Vector*)0);
+        rValue += theSite->getDaqResponse(&dDisp,
+            (Vector*)0, (Vector*)0, &dForce, (Vector*)0);
+        rValue += theSite->commitState();
+        return rValue;
+    };
+    
+private:
+    ExperimentalSite *theSite;
+    Vector tDisp, dDisp, dForce;
+};
+
+
+static int benchLocalSite(const benchOptions &opt)
+{
+    LocalExpSite *theSite =
+        new LocalExpSite(1, createSimSetup(1, opt.numDOF));
+    
+    SiteScenario theScenario(theSite, opt.numDOF);
+    int rValue = measure("localSite", theScenario, opt);
+    
+    delete theSite;
+    return rValue;
+}
+
+
+struct actorData {
+    serverSync sync;
+    int port;
+    int udp;
+    int numDOF;
+};
+
+
+static void *actorThread(void *arg)
+{
+    actorData *data = (actorData *)arg;
+    
+    Channel *theChannel;
+    if (data->udp)
+        theChannel = new UDP_Socket(data->port, true);
+    else
+        theChannel = new TCP_Socket(data->port, true, 1);
+    signalReady(data->sync);
+    
+    // the constructor waits for the shadow site to connect and
+    // run returns once the shadow site is destroyed
+    ActorExpSite *theSite = new ActorExpSite(1,
+        createSimSetup(2, data->numDOF), *theChannel);
+    theSite->run();
+    
+    delete theSite;
+    delete theChannel;
+    
+    return 0;
+}
+
+
+static int benchShadowActor(const benchOptions &opt, int udp,
+    int compress = 0)
+{
+    actorData data;
+    initSync(data.sync);
+    data.port = opt.port + (compress ? 5 : (udp ? 2 : 1));
+    data.udp = udp;
+    data.numDOF = opt.numDOF;
+    
+    pthread_t theThread;
+    pthread_create(&theThread, NULL, actorThread, &data);
+    waitReady(data.sync);
+    
+    char inetAddr[] = "127.0.0.1";
+    Channel *theChannel;
+    if (udp)
+        theChannel = new UDP_Socket(data.port, inetAddr, true);
+    else
+        theChannel = new TCP_Socket(data.port, inetAddr, true, 1);
+    ShadowExpSite *theSite = new ShadowExpSite(1, *theChannel);
+    if (compress)  {
+        Vector resolution(1);
+        resolution(0) = 1.0E-6;
+        theSite->setCompression(resolution);
+    }
+    
+    SiteScenario theScenario(theSite, opt.numDOF);
+    int rValue = measure(compress ? "shadowActorCodec" :
+        (udp ? "shadowActorUDP" : "shadowActorTCP"), theScenario, opt);
+    
+    // shuts down the actor site
+    delete theSite;
+    pthread_join(theThread, NULL);
+    delete theChannel;
+    
+    return rValue;
+}
+
+
+static int runTrajectory(ExperimentalSite *theSite, int first,
+    int numPoints, int numDOF, int chunkSize)
+{
+    Matrix trial(numPoints, numDOF);
+    Matrix out(numPoints, 2*numDOF);
+    for (int k=0; k<numPoints; k++)
+        for (int i=0; i<numDOF; i++)
+            trial(k,i) = getDisp(first+k, i);
+    
+    int numDone;
+    int rValue = theSite->runTrajectory(trial, out, numDone, chunkSize);
+    if (rValue < 0 || numDone != numPoints)
+        return -1;
+    
+    return 0;
+}
+
+
+static int benchShadowActorTrajectory(const benchOptions &opt)
+{
+    actorData data;
+    initSync(data.sync);
+    data.port = opt.port + 6;
+    data.udp = 0;
+    data.numDOF = opt.numDOF;
+    
+    pthread_t theThread;
+    pthread_create(&theThread, NULL, actorThread, &data);
+    waitReady(data.sync);
+    
+    char inetAddr[] = "127.0.0.1";
+    Channel *theChannel = new TCP_Socket(data.port, inetAddr, true, 1);
+    ShadowExpSite *theSite = new ShadowExpSite(1, *theChannel);
+    ID sizeT(OF_Resp_All), sizeO(OF_Resp_All);
+    getSiteSizes(opt.numDOF, sizeT, sizeO);
+    theSite->setSize(sizeT, sizeO);
+    
+    int rValue = 0;
+    if (opt.numWarmup > 0)
+        rValue = runTrajectory(theSite, 0, opt.numWarmup,
+            opt.numDOF, opt.chunkSize);
+    
+    long allocs0 = numAllocs;
+    double tStart = getTime();
+    if (rValue == 0)
+        rValue = runTrajectory(theSite, opt.numWarmup, opt.numSteps,
+            opt.numDOF, opt.chunkSize);
+    double tTotal = getTime() - tStart;
+    long allocs = numAllocs - allocs0;
+    
+    if (rValue == 0)  {
+        fprintf(stdout, "{\"scenario\": \"trajectoryTCP\", \"dof\": %d, "
+            "\"steps\": %d, \"chunk\": %d, \"stepsPerSec\": %.1f, "
+            "\"latencyUs\": {\"mean\": %.2f}, \"allocsPerStep\": %.2f}\n",
+            opt.numDOF, opt.numSteps, opt.chunkSize, opt.numSteps/tTotal,
+            1.0E6*tTotal/opt.numSteps, (double)allocs/opt.numSteps);
+        fflush(stdout);
+    } else  {
+        fprintf(stderr, "pipelineBench - trajectoryTCP failed\n");
+    }
+    
+    // shuts down the actor site
+    delete theSite;
+    pthread_join(theThread, NULL);
+    delete theChannel;
+    
+    return rValue;
+}
+
+
+struct stubData {
+    serverSync sync;
+    int port;
+    double stiffness;
+};
+
+
+// generic controller that returns the commanded displacements
+// and the forces of linear elastic specimens
+static void *stubControllerThread(void *arg)
+{
+    stubData *data = (stubData *)arg;
+    
+    TCP_Socket *theChannel = new TCP_Socket(data->port, false, 1);
+    signalReady(data->sync);
+    if (theChannel->setUpConnection() != 0)  {
+        fprintf(stderr, "pipelineBench - stub controller could not "
+            "setup connection\n");
+        delete theChannel;
+        return 0;
+    }
+    
+    ID idData(2*OF_Resp_All+1);
+    theChannel->recvID(0, 0, idData, 0);
+    int numCtrl = idData(OF_Resp_Disp);
+    int numDaq = idData(OF_Resp_All+OF_Resp_Disp);
+    int dataSize = idData(2*OF_Resp_All);
+    
+    Vector recvData(dataSize), sendData(dataSize);
+    Vector disp(numCtrl);
+    bool exitYet = false;
+    while (!exitYet)  {
+        theChannel->recvVector(0, 0, recvData, 0);
+        switch ((int)recvData(0))  {
+        case OF_RemoteTest_setTrialResponse:
+            for (int i=0; i<numCtrl; i++)
+                disp(i) = recvData(1+i);
+            break;
+        case OF_RemoteTest_getDaqResponse:
+            for (int i=0; i<numDaq && i<numCtrl; i++)  {
+                sendData(i) = disp(i);
+                sendData(numDaq+i) = data->stiffness*disp(i);
+            }
+            theChannel->sendVector(0, 0, sendData, 0);
+            break;
+        case OF_RemoteTest_DIE:
+            exitYet = true;
+            break;
+        default:
+            break;
+        }
+    }
+    
+    delete theChannel;
+    return 0;
+}
+
+
+static int benchECGenericTCP(const benchOptions &opt)
+{
+    stubData data;
+    initSync(data.sync);
+    data.port = opt.port + 3;
+    data.stiffness = 100.0;
+    
+    pthread_t theThread;
+    pthread_create(&theThread, NULL, stubControllerThread, &data);
+    waitReady(data.sync);
+    
+    ID ctrlModes(5), daqModes(5);
+    ctrlModes(OF_Resp_Disp) = 1;
+    daqModes(OF_Resp_Disp) = 1;
+    daqModes(OF_Resp_Force) = 1;
+    char *inetAddr = new char [10];
+    strcpy(inetAddr, "127.0.0.1");
+    ECGenericTCP *theControl = new ECGenericTCP(1, inetAddr, data.port,
+        ctrlModes, daqModes);
+    theControl->setBatchInit();
+    
+    ID dof(opt.numDOF);
+    for (int i=0; i<opt.numDOF; i++)
+        dof(i) = i;
+    LocalExpSite *theSite = new LocalExpSite(1,
+        new ESNoTransformation(1, dof, opt.numDOF, opt.numDOF, theControl));
+    
+    SiteScenario theScenario(theSite, opt.numDOF);
+    int rValue = measure("ecGenericTCP", theScenario, opt);
+    
+    // shuts down the stub controller
+    delete theSite;
+    pthread_join(theThread, NULL);
+    
+    return rValue;
+}
+
+
+// ----------------------------------------------------------------------------
+// EEGeneric element with a SimAppSiteServer
+
+static ExperimentalSite *theServerSite = 0;
+
+// used by the SimAppSiteServer instead of the site of the interpreter
+ExperimentalSite *getExperimentalSite(int tag)
+{
+    return theServerSite;
+}
+
+
+struct siteServerData {
+    serverSync sync;
+    int port;
+};
+
+
+static void *siteServerThread(void *arg)
+{
+    siteServerData *data = (siteServerData *)arg;
+    
+    char portStr[16];
+    sprintf(portStr, "%d", data->port);
+    TCL_Char *argv[3] = {"startSimAppSiteServer", "1", portStr};
+    Tcl_Interp *interp = Tcl_CreateInterp();
+    signalReady(data->sync);
+    
+    // returns once the element is destroyed
+    TclStartSimAppSiteServer(0, interp, 3, argv);
+    
+    Tcl_DeleteInterp(interp);
+    return 0;
+}
+
+
+class ElementScenario : public BenchScenario
+{
+public:
+    ElementScenario(Domain *domain, Node *node)
+        : theDomain(domain), theNode(node), disp(node->getNumberDOF())
+    {
+        
+    };
+    
+    int step(int k)
+    {
+        for (int i=0; i<disp.Size(); i++)
+            disp(i) = getDisp(k, i);
+        theDomain->setCurrentTime(0.01*(k+1));
+        int rValue = theNode->setTrialDisp(disp);
+        rValue += theDomain->update();
+        theDomain->getElement(1)->getResistingForce();
+        rValue += theDomain->commit();
+        return rValue;
+    };
+    
+private:
+    Domain *theDomain;
+    Node *theNode;
+    Vector disp;
+};
+
+
+static int benchEEGeneric(const benchOptions &opt)
+{
+    theServerSite = new LocalExpSite(1, createSimSetup(3, opt.numDOF));
+    
+    siteServerData data;
+    initSync(data.sync);
+    data.port = opt.port + 4;
+    
+    pthread_t theThread;
+    pthread_create(&theThread, NULL, siteServerThread, &data);
+    waitReady(data.sync);
+    
+    // one node whose dofs are all controlled by the element
+    Domain *theDomain = new Domain();
+    Node *theNode = new Node(1, opt.numDOF, 0.0);
+    theDomain->addNode(theNode);
+    
+    ID nodes(1);
+    nodes(0) = 1;
+    ID *dof = new ID [1];
+    dof[0].resize(opt.numDOF);
+    for (int i=0; i<opt.numDOF; i++)
+        dof[0](i) = i;
+    char *inetAddr = new char [10];
+    strcpy(inetAddr, "127.0.0.1");
+    EEGeneric *theElement = new EEGeneric(1, nodes, dof, data.port, inetAddr);
+    Matrix kInit(opt.numDOF, opt.numDOF);
+    for (int i=0; i<opt.numDOF; i++)
+        kInit(i,i) = 100.0;
+    theElement->setInitialStiff(kInit);
+    theDomain->addElement(theElement);
+    delete [] dof;
+    
+    ElementScenario theScenario(theDomain, theNode);
+    int rValue = measure("eeGeneric", theScenario, opt);
+    
+    // the element shuts down the server
+    delete theDomain;
+    pthread_join(theThread, NULL);
+    delete theServerSite;
+    theServerSite = 0;
+    
+    return rValue;
+}
+
+
+// ----------------------------------------------------------------------------
+// array of EEBearing2d isolators with local sites
+
+class BearingScenario : public BenchScenario
+{
+public:
+    BearingScenario(Domain *domain, int numBearings)
+        : theDomain(domain), numEle(numBearings), disp(3)
+    {
+        
+    };
+    
+    int step(int k)
+    {
+        int i, rValue = 0;
+        theDomain->setCurrentTime(0.01*(k+1));
+        // the top nodes move with a small axial displacement
+        // and a shear displacement that varies along the array
+        for (i=0; i<numEle; i++)  {
+            disp(0) = getDisp(k, i);
+            disp(1) = -1.0E-3*getDisp(k, 0);
+            rValue += theDomain->getNode(2*i+2)->setTrialDisp(disp);
+        }
+        rValue += theDomain->update();
+        for (i=0; i<numEle; i++)  {
+            Element *theElement = theDomain->getElement(i+1);
+            theElement->getResistingForce();
+            theElement->getTangentStiff();
+        }
+        rValue += theDomain->commit();
+        return rValue;
+    };
+    
+private:
+    Domain *theDomain;
+    int numEle;
+    Vector disp;
+};
+
+
+static int benchBearingArray(const benchOptions &opt)
+{
+    Domain *theDomain = new Domain();
+    
+    // axial and rotational materials of the bearings
+    UniaxialMaterial *theMaterials[2];
+    theMaterials[0] = new ElasticMaterial(1, 1.0E4);
+    theMaterials[1] = new ElasticMaterial(2, 1.0E3);
+    
+    Vector Mratio(2);
+    Mratio(0) = 0.25;
+    Mratio(1) = 0.25;
+    Matrix kInit(1,1);
+    kInit(0,0) = 100.0;
+    
+    // vertical bearings between a bottom and a top node
+    for (int i=0; i<opt.numBearings; i++)  {
+        theDomain->addNode(new Node(2*i+1, 3, 2.0*i, 0.0));
+        theDomain->addNode(new Node(2*i+2, 3, 2.0*i, 1.0));
+        // the element takes ownership of the site
+        ExperimentalSite *theSite =
+            new LocalExpSite(i+1, createSimSetup(i+1, 3));
+        EEBearing2d *theElement = new EEBearing2d(i+1, 2*i+1, 2*i+2,
+            0, theMaterials, theSite, Vector(0), Vector(0), Mratio);
+        theElement->setInitialStiff(kInit);
+        theDomain->addElement(theElement);
+    }
+    delete theMaterials[0];
+    delete theMaterials[1];
+    
+    // the number of free dofs is reported
+    benchOptions bearingOpt = opt;
+    bearingOpt.numDOF = 3*opt.numBearings;
+    
+    BearingScenario theScenario(theDomain, opt.numBearings);
+    int rValue = measure("bearingArray", theScenario, bearingOpt);
+    
+    delete theDomain;
+    
+    return rValue;
+}
+
+
+// ----------------------------------------------------------------------------
+
+int main(int argc, char **argv)
+{
+    benchOptions opt;
+    opt.numSteps = 2000;
+    opt.numWarmup = 100;
+    opt.numDOF = 1;
+    opt.numBearings = 100;
+    opt.chunkSize = 256;
+    opt.port = 8090;
+    
+    const char *allScenarios[] = {"localSite", "shadowActorTCP",
+        "shadowActorUDP", "shadowActorCodec", "trajectoryTCP",
+        "eeGeneric", "ecGenericTCP", "bearingArray"};
+    const int numAllScenarios = 8;
+    const char **scenarios = new const char* [argc+numAllScenarios];
+    int numScenarios = 0;
+    
+    for (int i=1; i<argc; i++)  {
+        if (i+1 < argc && strcmp(argv[i], "-steps") == 0)
+            opt.numSteps = atoi(argv[++i]);
+        else if (i+1 < argc && strcmp(argv[i], "-warmup") == 0)
+            opt.numWarmup = atoi(argv[++i]);
+        else if (i+1 < argc && strcmp(argv[i], "-dof") == 0)
+            opt.numDOF = atoi(argv[++i]);
+        else if (i+1 < argc && strcmp(argv[i], "-bearings") == 0)
+            opt.numBearings = atoi(argv[++i]);
+        else if (i+1 < argc && strcmp(argv[i], "-chunk") == 0)
+            opt.chunkSize = atoi(argv[++i]);
+        else if (i+1 < argc && strcmp(argv[i], "-port") == 0)
+            opt.port = atoi(argv[++i]);
+        else if (i+1 < argc && strcmp(argv[i], "-scenario") == 0)
+            scenarios[numScenarios++] = argv[++i];
+        else  {
+            fprintf(stderr, "usage: pipelineBench <-steps n> <-warmup n> "
+                "<-dof n> <-bearings n> <-chunk n> <-port p> "
+                "<-scenario name> ...\n");
+            return -1;
+        }
+    }
+    if (opt.numSteps < 1 || opt.numWarmup < 0 || opt.numDOF < 1 ||
+        opt.numBearings < 1 || opt.chunkSize < 1)  {
+        fprintf(stderr, "pipelineBench - invalid steps, warmup, dof, "
+            "bearings or chunk\n");
+        return -1;
+    }
+    if (numScenarios == 0)  {
+        for (int i=0; i<numAllScenarios; i++)
+            scenarios[numScenarios++] = allScenarios[i];
+    }
+    
+    int rValue = 0;
+    for (int i=0; i<numScenarios; i++)  {
+        if (strcmp(scenarios[i], "localSite") == 0)
+            rValue += benchLocalSite(opt);
+        else if (strcmp(scenarios[i], "shadowActorTCP") == 0)
+            rValue += benchShadowActor(opt, 0);
+        else if (strcmp(scenarios[i], "shadowActorUDP") == 0)
+            rValue += benchShadowActor(opt, 1);
+        else if (strcmp(scenarios[i], "shadowActorCodec") == 0)
+            rValue += benchShadowActor(opt, 0, 1);
+        else if (strcmp(scenarios[i], "trajectoryTCP") == 0)
+            rValue += benchShadowActorTrajectory(opt);
+        else if (strcmp(scenarios[i], "eeGeneric") == 0)
+            rValue += benchEEGeneric(opt);
+        else if (strcmp(scenarios[i], "ecGenericTCP") == 0)
+            rValue += benchECGenericTCP(opt);
+        else if (strcmp(scenarios[i], "bearingArray") == 0)
+            rValue += benchBearingArray(opt);
+        else  {
+            fprintf(stderr, "pipelineBench - unknown scenario %s\n",
+                scenarios[i]);
+            rValue--;
+        }
+    }
+    
+    delete [] scenarios;
+    return (rValue == 0) ? 0 : -1;
+}
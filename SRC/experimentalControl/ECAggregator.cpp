@@ -0,0 +1,930 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// $Revision$
+// $Date$
+// $URL$
+
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the implementation of the
+// ECAggregator class.
+
+#include "ECAggregator.h"
+
+#include <ExpCheckpoint.h>
+
+#ifndef _WIN32
+#include <sys/time.h>
+#include <time.h>
+#endif
+
+
+static double getTime()
+{
+#ifdef _WIN32
+    LARGE_INTEGER freq, count;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&count);
+    return (double)count.QuadPart/(double)freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + 1.0E-9*ts.tv_nsec;
+#endif
+}
+
+
+ECAggregator::ECAggregator(int tag, int nControls,
+    ExperimentalControl **controls,
+    const ID &numctrl, const ID &numdaq,
+    int barr, double tout)
+    : ExperimentalControl(tag), numControls(nControls),
+    theControls(0), numCtrl(numctrl), numDaq(numdaq),
+    ctrlOffset(nControls), daqOffset(nControls),
+    barrier(barr), timeout(tout), subCtrl(0), subDaq(0),
+    jobs(0), results(0), numBusy(0), numControlled(0),
+    stepPending(false), numSteps(0), numTimeouts(0),
+    stopFlag(false), running(false), workerArgs(0), theThreads(0)
+{
+    if (controls == 0)  {
+        opserr << "ECAggregator::ECAggregator() - "
+            << "null experimental control array passed.\n";
+        exit(OF_ReturnType_failed);
+    }
+    
+    // the aggregator takes ownership of the controls
+    theControls = new ExperimentalControl* [numControls];
+    for (int i=0; i<numControls; i++)  {
+        if (controls[i] == 0)  {
+            opserr << "ECAggregator::ECAggregator() - "
+                << "null experimental control pointer passed.\n";
+            exit(OF_ReturnType_failed);
+        }
+        theControls[i] = controls[i];
+    }
+    
+    this->initialize();
+}
+
+
+ECAggregator::ECAggregator(const ECAggregator &ec)
+    : ExperimentalControl(ec), numControls(ec.numControls),
+    theControls(0), numCtrl(ec.numCtrl), numDaq(ec.numDaq),
+    ctrlOffset(ec.numControls), daqOffset(ec.numControls),
+    barrier(ec.barrier), timeout(ec.timeout), subCtrl(0), subDaq(0),
+    jobs(0), results(0), numBusy(0), numControlled(0),
+    stepPending(false), numSteps(0), numTimeouts(0),
+    stopFlag(false), running(false), workerArgs(0), theThreads(0)
+{
+    theControls = new ExperimentalControl* [numControls];
+    for (int i=0; i<numControls; i++)  {
+        theControls[i] = ec.theControls[i]->getCopy();
+        if (theControls[i] == 0)  {
+            opserr << "ECAggregator::ECAggregator() - "
+                << "failed to get copy of experimental control.\n";
+            exit(OF_ReturnType_failed);
+        }
+    }
+    
+    this->initialize();
+}
+
+
+ECAggregator::~ECAggregator()
+{
+    // stop the threads of the controls
+    this->stopThreads();
+    
+    // delete memory of vectors
+    this->deleteVectors();
+    if (subCtrl != 0)
+        delete [] subCtrl;
+    if (subDaq != 0)
+        delete [] subDaq;
+    
+    if (theControls != 0)  {
+        for (int i=0; i<numControls; i++)
+            if (theControls[i] != 0)
+                delete theControls[i];
+        delete [] theControls;
+    }
+    
+    if (jobs != 0)
+        delete [] jobs;
+    if (results != 0)
+        delete [] results;
+    if (workerArgs != 0)
+        delete [] workerArgs;
+    if (theThreads != 0)
+        delete [] theThreads;
+    
+#ifdef _WIN32
+    DeleteCriticalSection(&theMutex);
+#else
+    pthread_mutex_destroy(&theMutex);
+    pthread_cond_destroy(&theCond);
+#endif
+}
+
+
+int ECAggregator::setup()
+{
+    int i, j, rValue = 0;
+    
+    // stop the threads from a previous setup
+    this->stopThreads();
+    
+    // allocate the signal vectors of the aggregator and of
+    // each control, the time signals are not partitioned
+    this->deleteVectors();
+    for (j=0; j<OF_Resp_All; j++)  {
+        if ((*sizeCtrl)(j) != 0)
+            ctrlSig[j] = new Vector((*sizeCtrl)(j));
+        if ((*sizeDaq)(j) != 0)
+            daqSig[j] = new Vector((*sizeDaq)(j));
+    }
+    for (i=0; i<numControls; i++)  {
+        for (j=0; j<OF_Resp_All; j++)  {
+            int nCtrl = (j == OF_Resp_Time) ? (*sizeCtrl)(j) : numCtrl(i);
+            int nDaq = (j == OF_Resp_Time) ? (*sizeDaq)(j) : numDaq(i);
+            if ((*sizeCtrl)(j) != 0 && nCtrl != 0)
+                subCtrl[i*OF_Resp_All+j] = new Vector(nCtrl);
+            if ((*sizeDaq)(j) != 0 && nDaq != 0)
+                subDaq[i*OF_Resp_All+j] = new Vector(nDaq);
+        }
+    }
+    
+    // setup the controls one after the other,
+    // since they might ask the user to proceed
+    for (i=0; i<numControls; i++)
+        rValue += theControls[i]->setup();
+    
+    // print experimental control information
+    //this->Print(opserr);
+    
+    if (this->startThreads() < 0)
+        return OF_ReturnType_failed;
+    
+    // get the initial daq signals of all the controls
+    rValue += this->acquire();
+    
+    return rValue;
+}
+
+
+int ECAggregator::setSize(ID sizeT, ID sizeO)
+{
+    int i, j, sumCtrl = 0, sumDaq = 0, rValue = 0;
+    
+    // the displacement, velocity, acceleration and force
+    // signals are partitioned among the controls, so their
+    // sizes need to match the sum of the control sizes
+    for (i=0; i<numControls; i++)  {
+        ctrlOffset(i) = sumCtrl;
+        daqOffset(i) = sumDaq;
+        sumCtrl += numCtrl(i);
+        sumDaq += numDaq(i);
+    }
+    for (j=0; j<OF_Resp_Time; j++)  {
+        if ((sizeT(j) != 0 && sizeT(j) != sumCtrl) ||
+            (sizeO(j) != 0 && sizeO(j) != sumDaq))  {
+            opserr << "ECAggregator::setSize() - wrong sizeTrial/Out\n";
+            opserr << "sizeT(" << j << ") = " << sizeT(j)
+                << " != " << sumCtrl << " or\n";
+            opserr << "sizeO(" << j << ") = " << sizeO(j)
+                << " != " << sumDaq << endln;
+            opserr << "see User Manual.\n";
+            exit(OF_ReturnType_failed);
+        }
+    }
+    
+    *sizeCtrl = sizeT;
+    *sizeDaq = sizeO;
+    
+    // set the sizes of the controls
+    ID sizeTi(OF_Resp_All), sizeOi(OF_Resp_All);
+    for (i=0; i<numControls; i++)  {
+        for (j=0; j<OF_Resp_Time; j++)  {
+            sizeTi(j) = (sizeT(j) != 0) ? numCtrl(i) : 0;
+            sizeOi(j) = (sizeO(j) != 0) ? numDaq(i) : 0;
+        }
+        sizeTi(OF_Resp_Time) = sizeT(OF_Resp_Time);
+        sizeOi(OF_Resp_Time) = sizeO(OF_Resp_Time);
+        rValue += theControls[i]->setSize(sizeTi, sizeOi);
+    }
+    
+    return rValue;
+}
+
+
+int ECAggregator::setTrialResponse(const Vector* disp,
+    const Vector* vel,
+    const Vector* accel,
+    const Vector* force,
+    const Vector* time)
+{
+    int i, j;
+    const Vector *trial[OF_Resp_All] = {disp, vel, accel, force, time};
+    
+    for (j=0; j<OF_Resp_All; j++)  {
+        if (trial[j] != 0 && ctrlSig[j] != 0)  {
+            *ctrlSig[j] = *trial[j];
+            if (theCtrlFilters[j] != 0)  {
+                for (i=0; i<(*sizeCtrl)(j); i++)
+                    (*ctrlSig[j])(i) = theCtrlFilters[j]->filtering((*ctrlSig[j])(i));
+            }
+        }
+    }
+    
+    return this->control();
+}
+
+
+int ECAggregator::getDaqResponse(Vector* disp,
+    Vector* vel,
+    Vector* accel,
+    Vector* force,
+    Vector* time)
+{
+    int i, j;
+    Vector *daq[OF_Resp_All] = {disp, vel, accel, force, time};
+    
+    int rValue = this->acquire();
+    if (daqSig[OF_Resp_Disp] != 0)
+        this->setCtrlFilterFeedback(*daqSig[OF_Resp_Disp]);
+    
+    for (j=0; j<OF_Resp_All; j++)  {
+        if (daq[j] != 0 && daqSig[j] != 0)  {
+            if (theDaqFilters[j] != 0)  {
+                for (i=0; i<(*sizeDaq)(j); i++)
+                    (*daqSig[j])(i) = theDaqFilters[j]->filtering((*daqSig[j])(i));
+            }
+            *daq[j] = *daqSig[j];
+        }
+    }
+    
+    return rValue;
+}
+
+
+int ECAggregator::commitState()
+{
+    int rValue = 0;
+    
+    this->waitIdle();
+    for (int i=0; i<numControls; i++)
+        rValue += theControls[i]->commitState();
+    
+    return rValue;
+}
+
+
+ExperimentalControl* ECAggregator::getCopy()
+{
+    return new ECAggregator(*this);
+}
+
+
+Response* ECAggregator::setResponse(const char **argv, int argc,
+    OPS_Stream &output)
+{
+    int i;
+    char outputData[15];
+    Response *theResponse = 0;
+    
+    output.tag("ExpControlOutput");
+    output.attr("ctrlType",this->getClassType());
+    output.attr("ctrlTag",this->getTag());
+    
+    // ctrl displacements
+    if (ctrlSig[OF_Resp_Disp] != 0 && (
+        strcmp(argv[0],"ctrlDisp") == 0 ||
+        strcmp(argv[0],"ctrlDisplacement") == 0 ||
+        strcmp(argv[0],"ctrlDisplacements") == 0))
+    {
+        for (i=0; i<(*sizeCtrl)(OF_Resp_Disp); i++)  {
+            sprintf(outputData,"ctrlDisp%d",i+1);
+            output.tag("ResponseType",outputData);
+        }
+        theResponse = new ExpControlResponse(this, 1, &ctrlSig[OF_Resp_Disp]);
+    }
+    
+    // ctrl velocities
+    else if (ctrlSig[OF_Resp_Vel] != 0 && (
+        strcmp(argv[0],"ctrlVel") == 0 ||
+        strcmp(argv[0],"ctrlVelocity") == 0 ||
+        strcmp(argv[0],"ctrlVelocities") == 0))
+    {
+        for (i=0; i<(*sizeCtrl)(OF_Resp_Vel); i++)  {
+            sprintf(outputData,"ctrlVel%d",i+1);
+            output.tag("ResponseType",outputData);
+        }
+        theResponse = new ExpControlResponse(this, 2, &ctrlSig[OF_Resp_Vel]);
+    }
+    
+    // ctrl accelerations
+    else if (ctrlSig[OF_Resp_Accel] != 0 && (
+        strcmp(argv[0],"ctrlAccel") == 0 ||
+        strcmp(argv[0],"ctrlAcceleration") == 0 ||
+        strcmp(argv[0],"ctrlAccelerations") == 0))
+    {
+        for (i=0; i<(*sizeCtrl)(OF_Resp_Accel); i++)  {
+            sprintf(outputData,"ctrlAccel%d",i+1);
+            output.tag("ResponseType",outputData);
+        }
+        theResponse = new ExpControlResponse(this, 3, &ctrlSig[OF_Resp_Accel]);
+    }
+    
+    // ctrl forces
+    else if (ctrlSig[OF_Resp_Force] != 0 && (
+        strcmp(argv[0],"ctrlForce") == 0 ||
+        strcmp(argv[0],"ctrlForces") == 0))
+    {
+        for (i=0; i<(*sizeCtrl)(OF_Resp_Force); i++)  {
+            sprintf(outputData,"ctrlForce%d",i+1);
+            output.tag("ResponseType",outputData);
+        }
+        theResponse = new ExpControlResponse(this, 4, &ctrlSig[OF_Resp_Force]);
+    }
+    
+    // ctrl times
+    else if (ctrlSig[OF_Resp_Time] != 0 && (
+        strcmp(argv[0],"ctrlTime") == 0 ||
+        strcmp(argv[0],"ctrlTimes") == 0))
+    {
+        for (i=0; i<(*sizeCtrl)(OF_Resp_Time); i++)  {
+            sprintf(outputData,"ctrlTime%d",i+1);
+            output.tag("ResponseType",outputData);
+        }
+        theResponse = new ExpControlResponse(this, 5, &ctrlSig[OF_Resp_Time]);
+    }
+    
+    // daq displacements
+    else if (daqSig[OF_Resp_Disp] != 0 && (
+        strcmp(argv[0],"daqDisp") == 0 ||
+        strcmp(argv[0],"daqDisplacement") == 0 ||
+        strcmp(argv[0],"daqDisplacements") == 0))
+    {
+        for (i=0; i<(*sizeDaq)(OF_Resp_Disp); i++)  {
+            sprintf(outputData,"daqDisp%d",i+1);
+            output.tag("ResponseType",outputData);
+        }
+        theResponse = new ExpControlResponse(this, 6, &daqSig[OF_Resp_Disp]);
+    }
+    
+    // daq velocities
+    else if (daqSig[OF_Resp_Vel] != 0 && (
+        strcmp(argv[0],"daqVel") == 0 ||
+        strcmp(argv[0],"daqVelocity") == 0 ||
+        strcmp(argv[0],"daqVelocities") == 0))
+    {
+        for (i=0; i<(*sizeDaq)(OF_Resp_Vel); i++)  {
+            sprintf(outputData,"daqVel%d",i+1);
+            output.tag("ResponseType",outputData);
+        }
+        theResponse = new ExpControlResponse(this, 7, &daqSig[OF_Resp_Vel]);
+    }
+    
+    // daq accelerations
+    else if (daqSig[OF_Resp_Accel] != 0 && (
+        strcmp(argv[0],"daqAccel") == 0 ||
+        strcmp(argv[0],"daqAcceleration") == 0 ||
+        strcmp(argv[0],"daqAccelerations") == 0))
+    {
+        for (i=0; i<(*sizeDaq)(OF_Resp_Accel); i++)  {
+            sprintf(outputData,"daqAccel%d",i+1);
+            output.tag("ResponseType",outputData);
+        }
+        theResponse = new ExpControlResponse(this, 8, &daqSig[OF_Resp_Accel]);
+    }
+    
+    // daq forces
+    else if (daqSig[OF_Resp_Force] != 0 && (
+        strcmp(argv[0],"daqForce") == 0 ||
+        strcmp(argv[0],"daqForces") == 0))
+    {
+        for (i=0; i<(*sizeDaq)(OF_Resp_Force); i++)  {
+            sprintf(outputData,"daqForce%d",i+1);
+            output.tag("ResponseType",outputData);
+        }
+        theResponse = new ExpControlResponse(this, 9, &daqSig[OF_Resp_Force]);
+    }
+    
+    // daq times
+    else if (daqSig[OF_Resp_Time] != 0 && (
+        strcmp(argv[0],"daqTime") == 0 ||
+        strcmp(argv[0],"daqTimes") == 0))
+    {
+        for (i=0; i<(*sizeDaq)(OF_Resp_Time); i++)  {
+            sprintf(outputData,"daqTime%d",i+1);
+            output.tag("ResponseType",outputData);
+        }
+        theResponse = new ExpControlResponse(this, 10, &daqSig[OF_Resp_Time]);
+    }
+    
+    output.endTag();
+    
+    return theResponse;
+}
+
+
+int ECAggregator::getResponse(int responseID, Information &info)
+{
+    if (responseID >= 1 && responseID <= OF_Resp_All)
+        return info.setVector(*ctrlSig[responseID-1]);
+    else if (responseID > OF_Resp_All && responseID <= 2*OF_Resp_All)
+        return info.setVector(*daqSig[responseID-1-OF_Resp_All]);
+    else
+        return -1;
+}
+
+
+void ECAggregator::Print(OPS_Stream &s, int flag)
+{
+    int i;
+    
+    s << "****************************************************************\n";
+    s << "* ExperimentalControl: " << this->getTag() << endln;
+    s << "*   type: ECAggregator\n";
+    s << "*   controls:";
+    for (i=0; i<numControls; i++)
+        s << " " << theControls[i]->getTag();
+    s << "\n*   numCtrlSignals: " << numCtrl;
+    s << "*   numDaqSignals: " << numDaq;
+    s << "*   barrier: " << ((barrier == 1) ? "ctrl" : "daq")
+        << ", timeout: " << timeout << endln;
+    s << "*   steps: " << numSteps << ", timeouts: " << numTimeouts << endln;
+    s << "*   ctrlFilters:";
+    for (i=0; i<OF_Resp_All; i++)  {
+        if (theCtrlFilters[i] != 0)
+            s << " " << theCtrlFilters[i]->getTag();
+        else
+            s << " 0";
+    }
+    s << "\n*   daqFilters:";
+    for (i=0; i<OF_Resp_All; i++)  {
+        if (theDaqFilters[i] != 0)
+            s << " " << theDaqFilters[i]->getTag();
+        else
+            s << " 0";
+    }
+    s << endln;
+    s << "****************************************************************\n";
+    s << endln;
+}
+
+
+int ECAggregator::saveState(ExpCheckpoint &theCheckpoint)
+{
+    this->waitIdle();
+    
+    int rValue = this->ExperimentalControl::saveState(theCheckpoint);
+    for (int i=0; i<numControls; i++)
+        rValue += theControls[i]->saveState(theCheckpoint);
+    
+    return (rValue < 0) ? OF_ReturnType_failed : OF_ReturnType_completed;
+}
+
+
+int ECAggregator::restoreState(ExpCheckpoint &theCheckpoint)
+{
+    this->waitIdle();
+    
+    if (this->ExperimentalControl::restoreState(theCheckpoint) < 0)
+        return OF_ReturnType_failed;
+    for (int i=0; i<numControls; i++)  {
+        if (theControls[i]->restoreState(theCheckpoint) < 0)
+            return OF_ReturnType_failed;
+    }
+    
+    return OF_ReturnType_completed;
+}
+
+
+int ECAggregator::control()
+{
+    int i, j, k;
+    
+    if (!running)  {
+        opserr << "ECAggregator::control() - "
+            << "control threads are not running\n";
+        return OF_ReturnType_failed;
+    }
+    
+    this->lock();
+    
+    // a control that missed the timeout of the last
+    // step might still be busy
+    while (numBusy > 0)
+        this->wait();
+    
+    // partition the ctrl signals among the controls
+    for (i=0; i<numControls; i++)  {
+        for (j=0; j<OF_Resp_All; j++)  {
+            Vector *sub = subCtrl[i*OF_Resp_All+j];
+            if (sub == 0)
+                continue;
+            if (j == OF_Resp_Time)  {
+                *sub = *ctrlSig[j];
+            } else  {
+                for (k=0; k<numCtrl(i); k++)
+                    (*sub)(k) = (*ctrlSig[j])(ctrlOffset(i)+k);
+            }
+        }
+    }
+    
+    // the threads execute the command and acquire the daq
+    // signals right away, getDaqResponse only waits for them
+    this->postJob(jobStep);
+    stepPending = true;
+    numSteps++;
+    
+    this->unlock();
+    
+    return OF_ReturnType_completed;
+}
+
+
+int ECAggregator::acquire()
+{
+    int i, j, k, rValue = 0;
+    
+    if (!running)  {
+        opserr << "ECAggregator::acquire() - "
+            << "control threads are not running\n";
+        return OF_ReturnType_failed;
+    }
+    
+    this->lock();
+    
+    // without a pending step the controls only acquire
+    if (!stepPending)  {
+        while (numBusy > 0)
+            this->wait();
+        this->postJob(jobAcquire);
+    }
+    stepPending = false;
+    
+    // barrier, wait until all the controls are done
+    if (timeout > 0.0)  {
+        double tEnd = getTime() + timeout;
+        double tLeft = timeout;
+        while (numBusy > 0 && tLeft > 0.0)  {
+            this->wait((int)(1000.0*tLeft) + 1);
+            tLeft = tEnd - getTime();
+        }
+    } else  {
+        while (numBusy > 0)
+            this->wait();
+    }
+    if (numBusy > 0)  {
+        numTimeouts++;
+        opserr << "ECAggregator::acquire() - "
+            << numBusy << " of the controls did not finish within "
+            << timeout << " sec\n";
+        this->unlock();
+        return OF_ReturnType_failed;
+    }
+    
+    // assemble the daq signals of the controls, the
+    // time signals are taken from the first control
+    for (i=0; i<numControls; i++)  {
+        rValue += results[i];
+        for (j=0; j<OF_Resp_All; j++)  {
+            Vector *sub = subDaq[i*OF_Resp_All+j];
+            if (sub == 0)
+                continue;
+            if (j == OF_Resp_Time)  {
+                if (i == 0)
+                    *daqSig[j] = *sub;
+            } else  {
+                for (k=0; k<numDaq(i); k++)
+                    (*daqSig[j])(daqOffset(i)+k) = (*sub)(k);
+            }
+        }
+    }
+    
+    this->unlock();
+    
+    return rValue;
+}
+
+
+void ECAggregator::initialize()
+{
+    int i;
+    
+    if (numControls < 1)  {
+        opserr << "ECAggregator::ECAggregator() - "
+            << "at least one control is needed\n";
+        exit(OF_ReturnType_failed);
+    }
+    if (numCtrl.Size() != numControls || numDaq.Size() != numControls)  {
+        opserr << "ECAggregator::ECAggregator() - "
+            << "number of signals needed for each control\n";
+        exit(OF_ReturnType_failed);
+    }
+    for (i=0; i<numControls; i++)  {
+        if (numCtrl(i) < 0 || numDaq(i) < 0)  {
+            opserr << "ECAggregator::ECAggregator() - "
+                << "negative number of signals for control "
+                << theControls[i]->getTag() << endln;
+            exit(OF_ReturnType_failed);
+        }
+    }
+    if (barrier < 0 || barrier > 1)  {
+        opserr << "ECAggregator::ECAggregator() - "
+            << "barrier must be 0 or 1\n";
+        exit(OF_ReturnType_failed);
+    }
+    
+    for (i=0; i<OF_Resp_All; i++)  {
+        ctrlSig[i] = 0;
+        daqSig[i] = 0;
+    }
+    subCtrl = new Vector* [numControls*OF_Resp_All];
+    subDaq = new Vector* [numControls*OF_Resp_All];
+    for (i=0; i<numControls*OF_Resp_All; i++)  {
+        subCtrl[i] = 0;
+        subDaq[i] = 0;
+    }
+    
+    jobs = new Job [numControls];
+    results = new int [numControls];
+    workerArgs = new WorkerArg [numControls];
+    for (i=0; i<numControls; i++)  {
+        jobs[i] = jobNone;
+        results[i] = 0;
+        workerArgs[i].theAggregator = this;
+        workerArgs[i].id = i;
+    }
+    
+#ifdef _WIN32
+    theThreads = new HANDLE [numControls];
+    for (i=0; i<numControls; i++)
+        theThreads[i] = NULL;
+    InitializeCriticalSection(&theMutex);
+    InitializeConditionVariable(&theCond);
+#else
+    theThreads = new pthread_t [numControls];
+    pthread_mutex_init(&theMutex, NULL);
+    pthread_cond_init(&theCond, NULL);
+#endif
+}
+
+
+void ECAggregator::deleteVectors()
+{
+    int i;
+    
+    for (i=0; i<OF_Resp_All; i++)  {
+        if (ctrlSig[i] != 0)
+            delete ctrlSig[i];
+        if (daqSig[i] != 0)
+            delete daqSig[i];
+        ctrlSig[i] = 0;
+        daqSig[i] = 0;
+    }
+    if (subCtrl != 0 && subDaq != 0)  {
+        for (i=0; i<numControls*OF_Resp_All; i++)  {
+            if (subCtrl[i] != 0)
+                delete subCtrl[i];
+            if (subDaq[i] != 0)
+                delete subDaq[i];
+            subCtrl[i] = 0;
+            subDaq[i] = 0;
+        }
+    }
+}
+
+
+int ECAggregator::startThreads()
+{
+    int i;
+    
+    stopFlag = false;
+    numBusy = 0;
+    stepPending = false;
+    for (i=0; i<numControls; i++)
+        jobs[i] = jobNone;
+    
+    for (i=0; i<numControls; i++)  {
+#ifdef _WIN32
+        theThreads[i] = CreateThread(NULL, 0, threadFunc, &workerArgs[i], 0, NULL);
+        if (theThreads[i] == NULL)  {
+#else
+        if (pthread_create(&theThreads[i], NULL, threadFunc, &workerArgs[i]) != 0)  {
+#endif
+            opserr << "ECAggregator::startThreads() - "
+                << "could not create thread for control "
+                << theControls[i]->getTag() << endln;
+            // stop the threads that were already started
+            this->lock();
+            stopFlag = true;
+            this->notify();
+            this->unlock();
+            while (--i >= 0)  {
+#ifdef _WIN32
+                WaitForSingleObject(theThreads[i], INFINITE);
+                CloseHandle(theThreads[i]);
+                theThreads[i] = NULL;
+#else
+                pthread_join(theThreads[i], NULL);
+#endif
+            }
+            return -1;
+        }
+    }
+    running = true;
+    
+    return 0;
+}
+
+
+void ECAggregator::stopThreads()
+{
+    if (!running)
+        return;
+    
+    // the threads finish their current job first
+    this->lock();
+    stopFlag = true;
+    this->notify();
+    this->unlock();
+    
+    for (int i=0; i<numControls; i++)  {
+#ifdef _WIN32
+        WaitForSingleObject(theThreads[i], INFINITE);
+        CloseHandle(theThreads[i]);
+        theThreads[i] = NULL;
+#else
+        pthread_join(theThreads[i], NULL);
+#endif
+    }
+    
+    running = false;
+}
+
+
+#ifdef _WIN32
+DWORD WINAPI ECAggregator::threadFunc(LPVOID arg)
+{
+    WorkerArg *theArg = (WorkerArg *)arg;
+    theArg->theAggregator->runThread(theArg->id);
+    return 0;
+}
+#else
+void *ECAggregator::threadFunc(void *arg)
+{
+    WorkerArg *theArg = (WorkerArg *)arg;
+    theArg->theAggregator->runThread(theArg->id);
+    return 0;
+}
+#endif
+
+
+void ECAggregator::runThread(int id)
+{
+    ExperimentalControl *theControl = theControls[id];
+    Vector **ctrl = &subCtrl[id*OF_Resp_All];
+    Vector **daq = &subDaq[id*OF_Resp_All];
+    
+    this->lock();
+    while (true)  {
+        while (!stopFlag && jobs[id] == jobNone)
+            this->wait();
+        if (stopFlag)
+            break;
+        Job job = jobs[id];
+        this->unlock();
+    
+        // the controls only access data of their own,
+        // so they can run without holding the lock
+        int rValue = 0;
+        if (job == jobStep)  {
+            rValue += theControl->setTrialResponse(ctrl[OF_Resp_Disp],
+                ctrl[OF_Resp_Vel], ctrl[OF_Resp_Accel],
+                ctrl[OF_Resp_Force], ctrl[OF_Resp_Time]);
+            if (barrier == 1)  {
+                // wait until all the controls executed the command
+                this->lock();
+                numControlled++;
+                this->notify();
+                while (!stopFlag && numControlled < numControls)
+                    this->wait();
+                this->unlock();
+            }
+        }
+        rValue += theControl->getDaqResponse(daq[OF_Resp_Disp],
+            daq[OF_Resp_Vel], daq[OF_Resp_Accel],
+            daq[OF_Resp_Force], daq[OF_Resp_Time]);
+    
+        this->lock();
+        results[id] = rValue;
+        jobs[id] = jobNone;
+        numBusy--;
+        this->notify();
+    }
+    this->unlock();
+}
+
+
+void ECAggregator::postJob(Job job)
+{
+    // needs to be called with the lock held
+    for (int i=0; i<numControls; i++)  {
+        jobs[i] = job;
+        results[i] = 0;
+    }
+    numBusy = numControls;
+    numControlled = 0;
+    this->notify();
+}
+
+
+void ECAggregator::waitIdle()
+{
+    if (!running)
+        return;
+    
+    this->lock();
+    while (numBusy > 0)
+        this->wait();
+    this->unlock();
+}
+
+
+void ECAggregator::lock()
+{
+#ifdef _WIN32
+    EnterCriticalSection(&theMutex);
+#else
+    pthread_mutex_lock(&theMutex);
+#endif
+}
+
+
+void ECAggregator::unlock()
+{
+#ifdef _WIN32
+    LeaveCriticalSection(&theMutex);
+#else
+    pthread_mutex_unlock(&theMutex);
+#endif
+}
+
+
+void ECAggregator::notify()
+{
+#ifdef _WIN32
+    WakeAllConditionVariable(&theCond);
+#else
+    pthread_cond_broadcast(&theCond);
+#endif
+}
+
+
+void ECAggregator::wait()
+{
+#ifdef _WIN32
+    SleepConditionVariableCS(&theCond, &theMutex, INFINITE);
+#else
+    pthread_cond_wait(&theCond, &theMutex);
+#endif
+}
+
+
+void ECAggregator::wait(int msec)
+{
+#ifdef _WIN32
+    SleepConditionVariableCS(&theCond, &theMutex, msec);
+#else
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    struct timespec until;
+    long nsec = 1000L*now.tv_usec + 1000000L*(msec%1000);
+    until.tv_sec = now.tv_sec + msec/1000 + nsec/1000000000L;
+    until.tv_nsec = nsec % 1000000000L;
+    pthread_cond_timedwait(&theCond, &theMutex, &until);
+#endif
+}
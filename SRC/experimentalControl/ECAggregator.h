@@ -0,0 +1,166 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// $Revision$
+// $Date$
+// $URL$
+
+#ifndef ECAggregator_h
+#define ECAggregator_h
+
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the class definition for
+// ECAggregator. ECAggregator combines several experimental controls
+// into one. The control and daq signals are partitioned into
+// consecutive blocks, one for each control, and the time signals are
+// passed to all of them. Each control is driven by a thread of its
+// own, so that the latencies of the controls overlap instead of
+// adding up. The daq signals are only returned once all the controls
+// have acquired them. Optionally the controls also wait for each
+// other before acquiring, so that all the daq signals are measured
+// after all the commands have been executed.
+
+#include "ExperimentalControl.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+class ECAggregator : public ExperimentalControl
+{
+public:
+    // constructors
+    ECAggregator(int tag, int nControls,
+        ExperimentalControl **controls,
+        const ID &numCtrlSignals, const ID &numDaqSignals,
+        int barrier = 0, double timeout = 0.0);
+    ECAggregator(const ECAggregator &ec);
+
+    // destructor
+    virtual ~ECAggregator();
+
+    // method to get class type
+    const char *getClassType() const {return "ECAggregator";};
+
+    // public methods to set and to get response
+    virtual int setup();
+    virtual int setSize(ID sizeT, ID sizeO);
+
+    virtual int setTrialResponse(
+        const Vector* disp,
+        const Vector* vel,
+        const Vector* accel,
+        const Vector* force,
+        const Vector* time);
+    virtual int getDaqResponse(
+        Vector* disp,
+        Vector* vel,
+        Vector* accel,
+        Vector* force,
+        Vector* time);
+
+    virtual int commitState();
+
+    virtual ExperimentalControl *getCopy();
+
+    // public methods for experimental control recorder
+    virtual Response *setResponse(const char **argv, int argc,
+        OPS_Stream &output);
+    virtual int getResponse(int responseID, Information &info);
+
+    // public methods to save and restore the state for a checkpoint
+    virtual int saveState(ExpCheckpoint &theCheckpoint);
+    virtual int restoreState(ExpCheckpoint &theCheckpoint);
+
+    // public methods for output
+    void Print(OPS_Stream &s, int flag = 0);
+
+protected:
+    // protected methods to set and to get response
+    virtual int control();
+    virtual int acquire();
+
+private:
+    enum Job {jobNone, jobStep, jobAcquire};
+
+    struct WorkerArg  {
+        ECAggregator *theAggregator;
+        int id;
+    };
+
+    void initialize();
+    void deleteVectors();
+    int startThreads();
+    void stopThreads();
+    void runThread(int id);
+    void postJob(Job job);
+    void waitIdle();
+    void lock();
+    void unlock();
+    void notify();
+    void wait();
+    void wait(int msec);
+
+#ifdef _WIN32
+    static DWORD WINAPI threadFunc(LPVOID arg);
+#else
+    static void *threadFunc(void *arg);
+#endif
+
+    int numControls;                    // number of controls
+    ExperimentalControl **theControls;  // controls that are driven
+    ID numCtrl, numDaq;     // number of signals of each control
+    ID ctrlOffset, daqOffset;           // first signal of each control
+    int barrier;            // 0 = wait before returning daq, 1 = also before acquiring
+    double timeout;         // time to wait for the controls (0 = no limit)
+
+    Vector *ctrlSig[OF_Resp_All];   // ctrl signals of all the controls
+    Vector *daqSig[OF_Resp_All];    // daq signals of all the controls
+    Vector **subCtrl;       // ctrl signals of each control
+    Vector **subDaq;        // daq signals of each control
+
+    Job *jobs;              // pending job of each thread
+    int *results;           // return value of the last job of each thread
+    int numBusy;            // number of threads with a pending job
+    int numControlled;      // number of controls that executed the command
+    bool stepPending;       // flag if the daq of a step is being acquired
+    int numSteps;           // number of steps sent to the controls
+    int numTimeouts;        // number of times the controls were too late
+    bool stopFlag;          // flag to stop the threads
+    bool running;           // flag if the threads are running
+
+    WorkerArg *workerArgs;
+#ifdef _WIN32
+    HANDLE *theThreads;
+    CRITICAL_SECTION theMutex;
+    CONDITION_VARIABLE theCond;
+#else
+    pthread_t *theThreads;
+    pthread_mutex_t theMutex;
+    pthread_cond_t theCond;
+#endif
+};
+
+#endif
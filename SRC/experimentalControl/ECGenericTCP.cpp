@@ -42,17 +42,21 @@ using std::ios;
 #include <TCP_Socket.h>
 #include <TCP_SocketSSL.h>
 #include <UDP_Socket.h>
+#include <ImpairedChannel.h>
+#include <ChannelOptions.h>
 
 
 ECGenericTCP::ECGenericTCP(int tag,
     char *ipaddress, int ipport,
     ID ctrlmodes, ID daqmodes,
-    char *initfilename, int ssl, int udp)
+    char *initfilename, int ssl, int udp,
+    const ChannelOptions *options, int bulkinit)
     : ExperimentalControl(tag),
     ipAddress(ipaddress), ipPort(ipport),
     dataSize(OF_Network_dataSize), theChannel(0),
     sData(0), sendData(0), rData(0), recvData(0),
     ctrlModes(ctrlmodes), daqModes(daqmodes), initFileName(initfilename),
+    bulkInit(bulkinit),
     ctrlDisp(0), ctrlVel(0), ctrlAccel(0), ctrlForce(0), ctrlTime(0),
     daqDisp(0), daqVel(0), daqAccel(0), daqForce(0), daqTime(0)
 {   
@@ -76,6 +80,10 @@ ECGenericTCP::ECGenericTCP(int tag,
             << "failed to create channel.\n";
         exit(OF_ReturnType_failed);
     }
+    if (options != 0)  {
+        theChannel->setChannelOptions(*options);
+        theChannel = ImpairedChannel::wrap(theChannel, *options);
+    }
     if (theChannel->setUpConnection() != 0)  {
         opserr << "ECGenericTCP::ECGenericTCP() - "
             << "failed to setup TCP connection to generic controller.\n";
@@ -115,6 +123,7 @@ ECGenericTCP::ECGenericTCP(const ECGenericTCP &ec)
     ctrlModes = ec.ctrlModes;
     daqModes = ec.daqModes;
     initFileName = ec.initFileName;
+    bulkInit = ec.bulkInit;
     
     // allocate memory for the send vectors
     sData = new double [dataSize];
@@ -255,6 +264,7 @@ int ECGenericTCP::setup()
     }
     
     // send the data size to the generic controller
+    this->startInitPhase("sizes");
     ID idData(2*OF_Resp_All+1);
     for (int i=0; i<OF_Resp_All; i++)  {
         idData(i) = (*sizeCtrl)(i);
@@ -264,7 +274,45 @@ int ECGenericTCP::setup()
     theChannel->sendID(0, 0, idData, 0);
     
     // read the parameter initialization file and send information
-    if (initFileName != 0)  {
+    if (initFileName != 0 && bulkInit)  {
+        this->startInitPhase("upload");
+        
+        // open the parameter initialization file
+        ifstream initFile;
+        initFile.open(initFileName, ios::in | ios::binary);
+        if (initFile.bad() || !initFile.is_open())  {
+            opserr << "ECGenericTCP::setup() - "
+                << "could not open parameter initialization file.\n";
+            return(OF_ReturnType_failed);
+        }
+        
+        // read the whole file
+        initFile.seekg(0, ios::end);
+        int fileSize = (int)initFile.tellg();
+        initFile.seekg(0, ios::beg);
+        char *fData = new char [fileSize+1];
+        initFile.read(fData, fileSize);
+        fData[fileSize] = '\0';
+        initFile.close();
+        
+        // announce the length of the file in a message of the same
+        // size as the line messages and then send the whole file
+        const int maxLineLength = 16384;
+        char mData[maxLineLength+1];
+        memset(mData, 0, maxLineLength+1);
+        mData[0] = OF_RemoteTest_setupBulk;
+        sprintf(&mData[1], "%d", fileSize);
+        Message msgHeader(mData, maxLineLength+1);
+        theChannel->sendMsg(0, 0, msgHeader, 0);
+        if (fileSize > 0)  {
+            Message msgData(fData, fileSize);
+            theChannel->sendMsg(0, 0, msgData, 0);
+        }
+        delete [] fData;
+    }
+    else if (initFileName != 0)  {
+        this->startInitPhase("upload");
+        
         
         // determine the number of lines in the parameter file
         ifstream initFile;
@@ -293,6 +341,7 @@ int ECGenericTCP::setup()
     
     // print experimental control information
     this->Print(opserr);
+    this->startInitPhase("confirm");
     
     opserr << "****************************************************************\n";
     opserr << "* Make sure that offset values of controller are set to ZERO   *\n";
@@ -300,15 +349,15 @@ int ECGenericTCP::setup()
     opserr << "* Press 'Enter' to proceed or 'c' to cancel the initialization *\n";
     opserr << "****************************************************************\n";
     opserr << endln;
-    int c = getchar();
+    int c = this->getInitKey();
     if (c == 'c')  {
-        getchar();
         sData[0] = OF_RemoteTest_DIE;
         theChannel->sendVector(0, 0, *sendData, 0);
         delete theChannel;
         exit(OF_ReturnType_failed);
     }
     
+    this->startInitPhase("measure");
     do  {
         rValue += this->control();
         rValue += this->acquire();
@@ -331,18 +380,17 @@ int ECGenericTCP::setup()
         opserr << "* 'c' to cancel the initialization\n";
         opserr << "****************************************************************\n";
         opserr << endln;
-        c = getchar();
+        c = this->getInitKey(maxAbs(daqDisp), maxAbs(daqForce));
         if (c == 'c')  {
-            getchar();
             sData[0] = OF_RemoteTest_DIE;
             theChannel->sendVector(0, 0, *sendData, 0);
             delete theChannel;
             exit(OF_ReturnType_failed);
-        } else if (c == 'r')  {
-            getchar();
         }
     } while (c == 'r');
     
+    this->startInitPhase(0);
+    
     opserr << "*****************\n";
     opserr << "* Running...... *\n";
     opserr << "*****************\n";
@@ -532,6 +580,8 @@ int ECGenericTCP::getDaqResponse(Vector* disp,
     Vector* time)
 {
     this->acquire();
+    if (daqDisp != 0)
+        this->setCtrlFilterFeedback(*daqDisp);
     
     int i;
     if (disp != 0 && (*sizeDaq)(OF_Resp_Disp) != 0)  {
@@ -607,7 +657,7 @@ Response* ECGenericTCP::setResponse(const char **argv, int argc,
             sprintf(outputData,"ctrlDisp%d",i+1);
             output.tag("ResponseType",outputData);
         }
-        theResponse = new ExpControlResponse(this, 1, *ctrlDisp);
+        theResponse = new ExpControlResponse(this, 1, &ctrlDisp);
     }
     
     // ctrl velocities
@@ -620,7 +670,7 @@ Response* ECGenericTCP::setResponse(const char **argv, int argc,
             sprintf(outputData,"ctrlVel%d",i+1);
             output.tag("ResponseType",outputData);
         }
-        theResponse = new ExpControlResponse(this, 2, *ctrlVel);
+        theResponse = new ExpControlResponse(this, 2, &ctrlVel);
     }
     
     // ctrl accelerations
@@ -633,7 +683,7 @@ Response* ECGenericTCP::setResponse(const char **argv, int argc,
             sprintf(outputData,"ctrlAccel%d",i+1);
             output.tag("ResponseType",outputData);
         }
-        theResponse = new ExpControlResponse(this, 3, *ctrlAccel);
+        theResponse = new ExpControlResponse(this, 3, &ctrlAccel);
     }
     
     // ctrl forces
@@ -645,7 +695,7 @@ Response* ECGenericTCP::setResponse(const char **argv, int argc,
             sprintf(outputData,"ctrlForce%d",i+1);
             output.tag("ResponseType",outputData);
         }
-        theResponse = new ExpControlResponse(this, 4, *ctrlForce);
+        theResponse = new ExpControlResponse(this, 4, &ctrlForce);
     }
     
     // ctrl times
@@ -657,7 +707,7 @@ Response* ECGenericTCP::setResponse(const char **argv, int argc,
             sprintf(outputData,"ctrlTime%d",i+1);
             output.tag("ResponseType",outputData);
         }
-        theResponse = new ExpControlResponse(this, 5, *ctrlTime);
+        theResponse = new ExpControlResponse(this, 5, &ctrlTime);
     }
     
     // daq displacements
@@ -670,7 +720,7 @@ Response* ECGenericTCP::setResponse(const char **argv, int argc,
             sprintf(outputData,"daqDisp%d",i+1);
             output.tag("ResponseType",outputData);
         }
-        theResponse = new ExpControlResponse(this, 6, *daqDisp);
+        theResponse = new ExpControlResponse(this, 6, &daqDisp);
     }
     
     // daq velocities
@@ -683,7 +733,7 @@ Response* ECGenericTCP::setResponse(const char **argv, int argc,
             sprintf(outputData,"daqVel%d",i+1);
             output.tag("ResponseType",outputData);
         }
-        theResponse = new ExpControlResponse(this, 7, *daqVel);
+        theResponse = new ExpControlResponse(this, 7, &daqVel);
     }
     
     // daq accelerations
@@ -696,7 +746,7 @@ Response* ECGenericTCP::setResponse(const char **argv, int argc,
             sprintf(outputData,"daqAccel%d",i+1);
             output.tag("ResponseType",outputData);
         }
-        theResponse = new ExpControlResponse(this, 8, *daqAccel);
+        theResponse = new ExpControlResponse(this, 8, &daqAccel);
     }
     
     // daq forces
@@ -708,7 +758,7 @@ Response* ECGenericTCP::setResponse(const char **argv, int argc,
             sprintf(outputData,"daqForce%d",i+1);
             output.tag("ResponseType",outputData);
         }
-        theResponse = new ExpControlResponse(this, 9, *daqForce);
+        theResponse = new ExpControlResponse(this, 9, &daqForce);
     }
     
     // daq times
@@ -720,7 +770,7 @@ Response* ECGenericTCP::setResponse(const char **argv, int argc,
             sprintf(outputData,"daqTime%d",i+1);
             output.tag("ResponseType",outputData);
         }
-        theResponse = new ExpControlResponse(this, 10, *daqTime);
+        theResponse = new ExpControlResponse(this, 10, &daqTime);
     }
     
     output.endTag();
@@ -32,11 +32,15 @@
 //
 // Description: This file contains the class definition for ECGenericTCP.
 // ECGenericTCP is a controller class for communicating with a generic
-// controller over a single TCP/IP connection.
+// controller over a single TCP/IP connection. The parameter
+// initialization file is either sent line by line or, with bulkInit,
+// in a single message that is announced by an OF_RemoteTest_setupBulk
+// message holding its length.
 
 #include "ExperimentalControl.h"
 
 class Channel;
+class ChannelOptions;
 
 class ECGenericTCP : public ExperimentalControl
 {
@@ -44,7 +48,8 @@ public:
     // constructors
     ECGenericTCP(int tag, char *ipAddress, int ipPort,
         ID ctrlModes, ID daqModes, char *initFileName = 0,
-        int ssl = 0, int udp = 0);
+        int ssl = 0, int udp = 0, const ChannelOptions *options = 0,
+        int bulkInit = 0);
     ECGenericTCP(const ECGenericTCP &ec);
     
     // destructor
@@ -100,6 +105,7 @@ private:
     ID daqModes;                // id with daq modes (size = 5)
     
     char *initFileName;         // parameter initialization file
+    int bulkInit;               // flag to send the file in one message
     
     Vector *ctrlDisp, *ctrlVel, *ctrlAccel, *ctrlForce, *ctrlTime;
     Vector *daqDisp, *daqVel, *daqAccel, *daqForce, *daqTime;
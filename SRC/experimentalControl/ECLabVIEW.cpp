@@ -44,7 +44,8 @@ ECLabVIEW::ECLabVIEW(int tag,
     numTrialCPs(nTrialCPs), trialCPs(0), numOutCPs(nOutCPs), outCPs(0),
     ipAddress(ipaddress), ipPort(ipport),
     theSocket(0), sData(0), sendData(0), rData(0), recvData(0),
-    ctrlDisp(0), ctrlForce(0), daqDisp(0), daqForce(0)
+    ctrlDisp(0), ctrlForce(0), daqDisp(0), daqForce(0),
+    numCtrlSignals(0), ctrlSignal(0)
 {
     // open log file
     logFile = fopen("ECLabVIEW.log","w");
@@ -123,7 +124,8 @@ ECLabVIEW::ECLabVIEW(int tag,
 ECLabVIEW::ECLabVIEW(const ECLabVIEW &ec)
     : ExperimentalControl(ec),
     theSocket(0), sData(0), sendData(0), rData(0), recvData(0),
-    ctrlDisp(0), ctrlForce(0), daqDisp(0), daqForce(0)
+    ctrlDisp(0), ctrlForce(0), daqDisp(0), daqForce(0),
+    numCtrlSignals(0), ctrlSignal(0)
 {
     numTrialCPs = ec.numTrialCPs;
     numOutCPs = ec.numOutCPs;
@@ -162,6 +164,10 @@ ECLabVIEW::~ECLabVIEW()
     if (daqForce != 0)
         delete daqForce;
     
+    // delete memory of parameter array
+    if (ctrlSignal != 0)
+        delete [] ctrlSignal;
+    
     // delete memory of string
     if (ipAddress != 0)
         delete [] ipAddress;
@@ -250,8 +256,28 @@ int ECLabVIEW::setup()
         daqForce->Zero();
     }
     
+    // create parameter array and compile the limits
+    // of the trial control points
+    if (ctrlSignal != 0)
+        delete [] ctrlSignal;
+    numCtrlSignals = 0;
+    for (int i=0; i<numTrialCPs; i++)
+        numCtrlSignals += trialCPs[i]->getNumSignal();
+    ctrlSignal = new double [numCtrlSignals];
+    for (int i=0; i<numCtrlSignals; i++)
+        ctrlSignal[i] = 0.0;
+    if (ctrlLimits.setup(numTrialCPs, trialCPs) != 0)  {
+        sprintf(sData,"close-session\tOpenFresco\n");
+            fprintf(logFile,"%s",sData);
+        delete sendData;  sendData = new Message(sData,(int)strlen(sData));  // needed because of bug in LabVIEW-plugin
+        theSocket->sendMsg(0, 0, *sendData, 0);
+        delete theSocket;
+        exit(OF_ReturnType_failed);
+    }
+    
     // print experimental control information
     this->Print(opserr);
+    this->startInitPhase("confirm");
     
     opserr << "****************************************************************\n";
     opserr << "* Make sure that offset values of controller are set to ZERO   *\n";
@@ -259,9 +285,8 @@ int ECLabVIEW::setup()
     opserr << "* Press 'Enter' to proceed or 'c' to cancel the initialization *\n";
     opserr << "****************************************************************\n";
     opserr << endln;
-    int c = getchar();
+    int c = this->getInitKey();
     if (c == 'c')  {
-        getchar();
         sprintf(sData,"close-session\tOpenFresco\n");
             fprintf(logFile,"%s",sData);
         delete sendData;  sendData = new Message(sData,(int)strlen(sData));  // needed because of bug in LabVIEW-plugin
@@ -270,6 +295,7 @@ int ECLabVIEW::setup()
         exit(OF_ReturnType_failed);
     }
     
+    this->startInitPhase("measure");
     do  {
         rValue += this->control();
         rValue += this->acquire();
@@ -292,20 +318,19 @@ int ECLabVIEW::setup()
         opserr << "* 'c' to cancel the initialization\n";
         opserr << "****************************************************************\n";
         opserr << endln;
-        c = getchar();
+        c = this->getInitKey(maxAbs(daqDisp), maxAbs(daqForce));
         if (c == 'c')  {
-            getchar();
             sprintf(sData,"close-session\tOpenFresco\n");
                 fprintf(logFile,"%s",sData);
             delete sendData;  sendData = new Message(sData,(int)strlen(sData));  // needed because of bug in LabVIEW-plugin
             theSocket->sendMsg(0, 0, *sendData, 0);
             delete theSocket;
             exit(OF_ReturnType_failed);
-        } else if (c == 'r')  {
-            getchar();
         }
     } while (c == 'r');
     
+    this->startInitPhase(0);
+    
     opserr << "*****************\n";
     opserr << "* Running...... *\n";
     opserr << "*****************\n";
@@ -390,6 +415,8 @@ int ECLabVIEW::getDaqResponse(
     Vector* time)
 {
     this->acquire();
+    if (daqDisp != 0)
+        this->setCtrlFilterFeedback(*daqDisp);
     
     int i;
     if (disp != 0)  {
@@ -444,7 +471,7 @@ Response* ECLabVIEW::setResponse(const char **argv, int argc,
             sprintf(outputData,"ctrlDisp%d",i+1);
             output.tag("ResponseType",outputData);
         }
-        theResponse = new ExpControlResponse(this, 1, *ctrlDisp);
+        theResponse = new ExpControlResponse(this, 1, &ctrlDisp);
     }
     
     // ctrl forces
@@ -456,7 +483,7 @@ Response* ECLabVIEW::setResponse(const char **argv, int argc,
             sprintf(outputData,"ctrlForce%d",i+1);
             output.tag("ResponseType",outputData);
         }
-        theResponse = new ExpControlResponse(this, 2, *ctrlForce);
+        theResponse = new ExpControlResponse(this, 2, &ctrlForce);
     }
     
     // daq displacements
@@ -469,7 +496,7 @@ Response* ECLabVIEW::setResponse(const char **argv, int argc,
             sprintf(outputData,"daqDisp%d",i+1);
             output.tag("ResponseType",outputData);
         }
-        theResponse = new ExpControlResponse(this, 3, *daqDisp);
+        theResponse = new ExpControlResponse(this, 3, &daqDisp);
     }
     
     // daq forces
@@ -481,7 +508,7 @@ Response* ECLabVIEW::setResponse(const char **argv, int argc,
             sprintf(outputData,"daqForce%d",i+1);
             output.tag("ResponseType",outputData);
         }
-        theResponse = new ExpControlResponse(this, 4, *daqForce);
+        theResponse = new ExpControlResponse(this, 4, &daqForce);
     }
     
     output.endTag();
@@ -545,11 +572,73 @@ int ECLabVIEW::control()
     sprintf(OPFTransactionID,"OPFTransaction%4d%02d%02d%02d%02d%02d",
         1900+ptm->tm_year,ptm->tm_mon,ptm->tm_mday,ptm->tm_hour,ptm->tm_min,ptm->tm_sec);
     
+    // assemble the scaled parameters of all the trial control points
+    int dID = 0, fID = 0, k = 0;
+    for (int i=0; i<numTrialCPs; i++)  {
+        // get trial control point parameters
+        int numSignals = trialCPs[i]->getNumSignal();
+        ID rsp = trialCPs[i]->getRspType();
+        Vector fact = trialCPs[i]->getFactor();
+        
+        for (int j=0; j<numSignals; j++)  {
+            if (rsp(j) == OF_Resp_Disp)  {
+                ctrlSignal[k] = fact(j)*(*ctrlDisp)(dID);
+                dID++;
+            }
+            else if (rsp(j) == OF_Resp_Force)  {
+                ctrlSignal[k] = fact(j)*(*ctrlForce)(fID);
+                fID++;
+            }
+            else {
+                opserr << "ECLabVIEW::control() - "
+                    << "requested response type is not supported.\n";
+                exit(OF_ReturnType_failed);
+            }
+            k++;
+        }
+    }
+    
+    // check all the parameters against the limits of the
+    // control points in one pass before anything is proposed
+    if (ctrlLimits.isActive() && ctrlLimits.check(ctrlSignal) > 0)  {
+        int c;
+        for (int i=0; i<ctrlLimits.getNumViolation(); i++)  {
+            k = ctrlLimits.getViolation(i);
+            double lowerLim = ctrlLimits.getLowerBound(k);
+            double upperLim = ctrlLimits.getUpperBound(k);
+            opserr << "****************************************************************\n";
+            opserr << "* WARNING - Control command exceeds the limits:\n";
+            opserr << "*\n";
+            opserr << "* Limits = [" << lowerLim << "," << upperLim << "]";
+            opserr << " -> Command = " << ctrlSignal[k] << endln;
+            opserr << "*\n";
+            opserr << "* Press 'Enter' to continue the test or\n";
+            opserr << "* 's' to saturate the command at the limits or\n";
+            opserr << "* 'c' to cancel the test\n";
+            opserr << "****************************************************************\n";
+            opserr << endln;
+            c = getchar();
+            if (c == 'c')  {
+                getchar();
+                sprintf(sData,"close-session\tOpenFresco\n");
+                    fprintf(logFile,"%s",sData);
+                delete sendData;  sendData = new Message(sData,(int)strlen(sData));  // needed because of bug in LabVIEW-plugin
+                theSocket->sendMsg(0, 0, *sendData, 0);
+                delete theSocket;
+                exit(OF_ReturnType_failed);
+            } else if (c == 's')  {
+                getchar();
+                ctrlSignal[k] = (ctrlSignal[k] < lowerLim) ? lowerLim : upperLim;
+            }
+        }
+    }
+    ctrlLimits.commit(ctrlSignal);
+    
     // propose ctrl values
-    int dID = 0, fID = 0;
     sprintf(sData,"propose\t%s",OPFTransactionID);
     
     // loop through all the trial control points
+    k = 0;
     for (int i=0; i<numTrialCPs; i++)  {
         // append trial control point name
         if (i==0)
@@ -563,128 +652,34 @@ int ECLabVIEW::control()
         int numSignals = trialCPs[i]->getNumSignal();
         ID dof = trialCPs[i]->getDOF();
         ID rsp = trialCPs[i]->getRspType();
-        Vector fact = trialCPs[i]->getFactor();
         
-        if (trialCPs[i]->hasLimits())  {
-            // loop through all the trial control point parameters
-            // and check if commands are within given limits
-            double parameter; int c;
-            for (int j=0; j<numSignals; j++)  {
-                // append GeomType
-                if (dof(j) == 0 || dof(j) == 3)  {
-                    sprintf(sData,"%s\tx",sData);
-                }
-                else if (dof(j) == 1 || dof(j) == 4)  {
-                    sprintf(sData,"%s\ty",sData);
-                }
-                else if (dof(j) == 2 || dof(j) == 5)  {
-                    sprintf(sData,"%s\tz",sData);
-                }
-                else {
-                    opserr << "ECLabVIEW::control() - "
-                        << "requested dof is not supported.\n";
-                    exit(OF_ReturnType_failed);
-                }
-                // append ParameterType
-                if (dof(j) < ndm && rsp(j) == OF_Resp_Disp)  {
-                    parameter = fact(j)*(*ctrlDisp)(dID);
-                    sprintf(sData,"%s\tdisplacement",sData);
-                    dID++;
-                }
-                else if (dof(j) < ndm && rsp(j) == OF_Resp_Force)  {
-                    parameter = fact(j)*(*ctrlForce)(fID);
-                    sprintf(sData,"%s\tforce",sData);
-                    fID++;
-                }
-                else if (dof(j) >= ndm && rsp(j) == OF_Resp_Disp)  {
-                    parameter = fact(j)*(*ctrlDisp)(dID);
-                    sprintf(sData,"%s\trotation",sData);
-                    dID++;
-                }
-                else if (dof(j) >= ndm && rsp(j) == OF_Resp_Force)  {
-                    parameter = fact(j)*(*ctrlForce)(fID);
-                    sprintf(sData,"%s\tmoment",sData);
-                    fID++;
-                }
-                else {
-                    opserr << "ECLabVIEW::control() - "
-                        << "requested response type is not supported.\n";
-                    exit(OF_ReturnType_failed);
-                }
-                // check if parameter is within limits and append
-                Vector lowerLim = trialCPs[i]->getLowerLimit();
-                Vector upperLim = trialCPs[i]->getUpperLimit();
-                if (parameter < lowerLim(j) || parameter > upperLim(j))  {
-                    opserr << "****************************************************************\n";
-                    opserr << "* WARNING - Control command exceeds the limits:\n";
-                    opserr << "*\n";
-                    opserr << "* Limits = [" << lowerLim(j) << "," << upperLim(j) << "]";
-                    opserr << " -> Command = " << parameter << endln;
-                    opserr << "*\n";
-                    opserr << "* Press 'Enter' to continue the test or\n";
-                    opserr << "* 's' to saturate the command at the limits or\n";
-                    opserr << "* 'c' to cancel the test\n";
-                    opserr << "****************************************************************\n";
-                    opserr << endln;
-                    c = getchar();
-                    if (c == 'c')  {
-                        getchar();
-                        sprintf(sData,"close-session\tOpenFresco\n");
-                            fprintf(logFile,"%s",sData);
-                        delete sendData;  sendData = new Message(sData,(int)strlen(sData));  // needed because of bug in LabVIEW-plugin
-                        theSocket->sendMsg(0, 0, *sendData, 0);
-                        delete theSocket;
-                        exit(OF_ReturnType_failed);
-                    } else if (c == 's')  {
-                        getchar();
-                        parameter = (parameter < lowerLim(j)) ? lowerLim(j) : upperLim(j);
-                    }
-                }
-                sprintf(sData,"%s\t%.10E",sData,parameter);
+        // loop through all the trial control point parameters
+        for (int j=0; j<numSignals; j++)  {
+            // append GeomType
+            if (dof(j) == 0 || dof(j) == 3)  {
+                sprintf(sData,"%s\tx",sData);
             }
-        }
-        else  {
-            // loop through all the trial control point parameters
-            // without checking if commands are within limits
-            for (int j=0; j<numSignals; j++)  {
-                // append GeomType
-                if (dof(j) == 0 || dof(j) == 3)  {
-                    sprintf(sData,"%s\tx",sData);
-                }
-                else if (dof(j) == 1 || dof(j) == 4)  {
-                    sprintf(sData,"%s\ty",sData);
-                }
-                else if (dof(j) == 2 || dof(j) == 5)  {
-                    sprintf(sData,"%s\tz",sData);
-                }
-                else {
-                    opserr << "ECLabVIEW::control() - "
-                        << "requested dof is not supported.\n";
-                    exit(OF_ReturnType_failed);
-                }
-                // append ParameterType and Parameter
-                if (dof(j) < ndm && rsp(j) == OF_Resp_Disp)  {
-                    sprintf(sData,"%s\tdisplacement\t%.10E",sData,fact(j)*(*ctrlDisp)(dID));
-                    dID++;
-                }
-                else if (dof(j) < ndm && rsp(j) == OF_Resp_Force)  {
-                    sprintf(sData,"%s\tforce\t%.10E",sData,fact(j)*(*ctrlForce)(fID));
-                    fID++;
-                }
-                else if (dof(j) >= ndm && rsp(j) == OF_Resp_Disp)  {
-                    sprintf(sData,"%s\trotation\t%.10E",sData,fact(j)*(*ctrlDisp)(dID));
-                    dID++;
-                }
-                else if (dof(j) >= ndm && rsp(j) == OF_Resp_Force)  {
-                    sprintf(sData,"%s\tmoment\t%.10E",sData,fact(j)*(*ctrlForce)(fID));
-                    fID++;
-                }
-                else {
-                    opserr << "ECLabVIEW::control() - "
-                        << "requested response type is not supported.\n";
-                    exit(OF_ReturnType_failed);
-                }
+            else if (dof(j) == 1 || dof(j) == 4)  {
+                sprintf(sData,"%s\ty",sData);
+            }
+            else if (dof(j) == 2 || dof(j) == 5)  {
+                sprintf(sData,"%s\tz",sData);
+            }
+            else {
+                opserr << "ECLabVIEW::control() - "
+                    << "requested dof is not supported.\n";
+                exit(OF_ReturnType_failed);
             }
+            // append ParameterType and Parameter
+            if (dof(j) < ndm && rsp(j) == OF_Resp_Disp)
+                sprintf(sData,"%s\tdisplacement\t%.10E",sData,ctrlSignal[k]);
+            else if (dof(j) < ndm && rsp(j) == OF_Resp_Force)
+                sprintf(sData,"%s\tforce\t%.10E",sData,ctrlSignal[k]);
+            else if (dof(j) >= ndm && rsp(j) == OF_Resp_Disp)
+                sprintf(sData,"%s\trotation\t%.10E",sData,ctrlSignal[k]);
+            else if (dof(j) >= ndm && rsp(j) == OF_Resp_Force)
+                sprintf(sData,"%s\tmoment\t%.10E",sData,ctrlSignal[k]);
+            k++;
         }
     }
     sprintf(sData,"%s\n",sData);
@@ -35,6 +35,7 @@
 // using ASCII over a single TCP/IP connection.
 
 #include "ExperimentalControl.h"
+#include <ExpCPLimits.h>
 
 #include <time.h>
 
@@ -109,6 +110,10 @@ private:
     Vector *ctrlDisp, *ctrlForce;
     Vector *daqDisp, *daqForce;
     
+    int numCtrlSignals;         // number of trial parameters
+    double *ctrlSignal;         // scaled trial parameters
+    ExpCPLimits ctrlLimits;     // limits of the trial parameters
+    
     time_t rawtime;
     struct tm *ptm;
     char OPFTransactionID[30];
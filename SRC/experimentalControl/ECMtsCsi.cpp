@@ -191,8 +191,16 @@ int ECMtsCsi::setup()
     trialSigOffset.resize(numCtrlSignals);
     trialSigOffset.Zero();
     
+    // compile the limits of the trial control points
+    if (ctrlLimits.setup(numTrialCPs, trialCPs) != 0)  {
+        CsiController->reset();
+        delete CsiController;
+        exit(OF_ReturnType_failed);
+    }
+    
     // print experimental control information
     this->Print(opserr);
+    this->startInitPhase("confirm");
     
     opserr << "****************************************************************\n";
     opserr << "* Make sure that offset values of controller are set to ZERO   *\n";
@@ -200,9 +208,8 @@ int ECMtsCsi::setup()
     opserr << "* Press 'Enter' to proceed or 'c' to cancel the initialization *\n";
     opserr << "****************************************************************\n";
     opserr << endln;
-    int c = getchar();
+    int c = this->getInitKey();
     if (c == 'c')  {
-        getchar();
         CsiController->reset();
         delete CsiController;
         exit(OF_ReturnType_failed);
@@ -221,6 +228,7 @@ int ECMtsCsi::setup()
         exit(OF_ReturnType_failed);
     }
     
+    this->startInitPhase("measure");
     do  {
         //rValue += this->control();  // CHECK IF WE NEED THIS, CHECK rampId
         rValue += this->acquire();
@@ -283,17 +291,16 @@ int ECMtsCsi::setup()
         opserr << "* 'c' to cancel the initialization\n";
         opserr << "****************************************************************\n";
         opserr << endln;
-        c = getchar();
+        c = this->getInitKey(maxAbs(daqSignal, numDaqSignals), 0.0);
         if (c == 'c')  {
-            getchar();
             CsiController->reset();
             delete CsiController;
             exit(OF_ReturnType_failed);
-        } else if (c == 'r')  {
-            getchar();
         }
     } while (c == 'r');
     
+    this->startInitPhase(0);
+    
     opserr << "*****************\n";
     opserr << "* Running...... *\n";
     opserr << "*****************\n";
@@ -440,110 +447,59 @@ int ECMtsCsi::setTrialResponse(
         ID dof = trialCPs[i]->getDOF();
         ID rsp = trialCPs[i]->getRspType();
         
-        // control point has no limits defined
-        if (trialCPs[i]->hasLimits() == 0)  {
-            // loop through all the trial control point dofs
-            for (int j=0; j<numSignals; j++)  {
-                // assemble the control signal array
-                if (rsp(j) == OF_Resp_Disp  &&  disp != 0)
-                    ctrlSignal[k] = (*disp)(dof(j));
-                else if (rsp(j) == OF_Resp_Force  &&  force != 0)
-                    ctrlSignal[k] = (*force)(dof(j));
-                else if (rsp(j) == OF_Resp_Time  &&  time != 0)
-                    ctrlSignal[k] = (*time)(dof(j));
-                else if (rsp(j) == OF_Resp_Vel  &&  vel != 0)
-                    ctrlSignal[k] = (*vel)(dof(j));
-                else if (rsp(j) == OF_Resp_Accel  &&  accel != 0)
-                    ctrlSignal[k] = (*accel)(dof(j));
-                
-                // get initial trial signal offsets
-                if (gotRelativeTrial == 0  &&  ctrlSignal[k] != 0)
-                    trialSigOffset(k) = -ctrlSignal[k];
-                
-                // apply trial signal offsets if they are not zero
-                if (trialSigOffset(k) != 0)
-                    ctrlSignal[k] += trialSigOffset(k);
-                
-                // filter control signals if any filters exist
-                if (theCtrlFilters[rsp(j)] != 0)
-                    ctrlSignal[k] = theCtrlFilters[rsp(j)]->filtering(ctrlSignal[k]);
-                
-                // apply control signal offsets if they are not zero
-                if (ctrlSigOffset(k) != 0)
-                    ctrlSignal[k] += ctrlSigOffset(k);
-                
-                // increment counter
-                k++;
-            }
+        // loop through all the trial control point dofs
+        for (int j=0; j<numSignals; j++)  {
+            // assemble the control signal array
+            if (rsp(j) == OF_Resp_Disp  &&  disp != 0)
+                ctrlSignal[k] = (*disp)(dof(j));
+            else if (rsp(j) == OF_Resp_Force  &&  force != 0)
+                ctrlSignal[k] = (*force)(dof(j));
+            else if (rsp(j) == OF_Resp_Time  &&  time != 0)
+                ctrlSignal[k] = (*time)(dof(j));
+            else if (rsp(j) == OF_Resp_Vel  &&  vel != 0)
+                ctrlSignal[k] = (*vel)(dof(j));
+            else if (rsp(j) == OF_Resp_Accel  &&  accel != 0)
+                ctrlSignal[k] = (*accel)(dof(j));
+            
+            // increment counter
+            k++;
+        }
+    }
+    
+    // saturate the control signals at the limits of the
+    // control points in one pass over the whole array
+    if (ctrlLimits.isActive())  {
+        ctrlLimits.saturate(ctrlSignal);
+        ctrlLimits.commit(ctrlSignal);
+    }
+    
+    // loop through all the trial control points
+    k = 0;
+    for (int i=0; i<numTrialCPs; i++)  {
+        // get trial control point parameters
+        int numSignals = trialCPs[i]->getNumSignal();
+        ID rsp = trialCPs[i]->getRspType();
         
-        // control point has limits defined
-        } else  {
-            Vector lowerLim = trialCPs[i]->getLowerLimit();
-            Vector upperLim = trialCPs[i]->getUpperLimit();
+        // loop through all the trial control point dofs
+        for (int j=0; j<numSignals; j++)  {
+            // get initial trial signal offsets
+            if (gotRelativeTrial == 0  &&  ctrlSignal[k] != 0)
+                trialSigOffset(k) = -ctrlSignal[k];
             
-            // loop through all the trial control point dofs
-            for (int j=0; j<numSignals; j++)  {
-                // assemble the control signal array
-                if (rsp(j) == OF_Resp_Disp  &&  disp != 0)  {
-                    if (lowerLim(j) < (*disp)(dof(j)) && (*disp)(dof(j)) < upperLim(j))
-                        ctrlSignal[k] = (*disp)(dof(j));
-                    else if ((*disp)(dof(j)) <= lowerLim(j))
-                        ctrlSignal[k] = lowerLim(j);
-                    else if ((*disp)(dof(j)) >= upperLim(j))
-                        ctrlSignal[k] = upperLim(j);
-                }
-                else if (rsp(j) == OF_Resp_Force  &&  force != 0)  {
-                    if (lowerLim(j) < (*force)(dof(j)) && (*force)(dof(j)) < upperLim(j))
-                        ctrlSignal[k] = (*force)(dof(j));
-                    else if ((*force)(dof(j)) <= lowerLim(j))
-                        ctrlSignal[k] = lowerLim(j);
-                    else if ((*force)(dof(j)) >= upperLim(j))
-                        ctrlSignal[k] = upperLim(j);
-                }
-                else if (rsp(j) == OF_Resp_Time  &&  time != 0)  {
-                    if (lowerLim(j) < (*time)(dof(j)) && (*time)(dof(j)) < upperLim(j))
-                        ctrlSignal[k] = (*time)(dof(j));
-                    else if ((*time)(dof(j)) <= lowerLim(j))
-                        ctrlSignal[k] = lowerLim(j);
-                    else if ((*time)(dof(j)) >= upperLim(j))
-                        ctrlSignal[k] = upperLim(j);
-                }
-                else if (rsp(j) == OF_Resp_Vel  &&  vel != 0)  {
-                    if (lowerLim(j) < (*vel)(dof(j)) && (*vel)(dof(j)) < upperLim(j))
-                        ctrlSignal[k] = (*vel)(dof(j));
-                    else if ((*vel)(dof(j)) <= lowerLim(j))
-                        ctrlSignal[k] = lowerLim(j);
-                    else if ((*vel)(dof(j)) >= upperLim(j))
-                        ctrlSignal[k] = upperLim(j);
-                }
-                else if (rsp(j) == OF_Resp_Accel  &&  accel != 0)  {
-                    if (lowerLim(j) < (*accel)(dof(j)) && (*accel)(dof(j)) < upperLim(j))
-                        ctrlSignal[k] = (*accel)(dof(j));
-                    else if ((*accel)(dof(j)) <= lowerLim(j))
-                        ctrlSignal[k] = lowerLim(j);
-                    else if ((*accel)(dof(j)) >= upperLim(j))
-                        ctrlSignal[k] = upperLim(j);
-                }
-                
-                // get initial trial signal offsets
-                if (gotRelativeTrial == 0  &&  ctrlSignal[k] != 0)
-                    trialSigOffset(k) = -ctrlSignal[k];
-                
-                // apply trial signal offsets if they are not zero
-                if (trialSigOffset(k) != 0)
-                    ctrlSignal[k] += trialSigOffset(k);
-                
-                // filter control signals if any filters exist
-                if (theCtrlFilters[rsp(j)] != 0)
-                    ctrlSignal[k] = theCtrlFilters[rsp(j)]->filtering(ctrlSignal[k]);
-                
-                // apply control signal offsets if they are not zero
-                if (ctrlSigOffset(k) != 0)
-                    ctrlSignal[k] += ctrlSigOffset(k);
-                
-                // increment counter
-                k++;
-            }
+            // apply trial signal offsets if they are not zero
+            if (trialSigOffset(k) != 0)
+                ctrlSignal[k] += trialSigOffset(k);
+            
+            // filter control signals if any filters exist
+            if (theCtrlFilters[rsp(j)] != 0)
+                ctrlSignal[k] = theCtrlFilters[rsp(j)]->filtering(ctrlSignal[k]);
+            
+            // apply control signal offsets if they are not zero
+            if (ctrlSigOffset(k) != 0)
+                ctrlSignal[k] += ctrlSigOffset(k);
+            
+            // increment counter
+            k++;
         }
     }
     
@@ -566,6 +522,8 @@ int ECMtsCsi::getDaqResponse(
 {
     // get daq signal array from controller/daq
     int rValue = this->acquire();
+    this->setCtrlFilterFeedback(numTrialCPs, trialCPs,
+        numOutCPs, outCPs, daqSignal, &daqSigOffset);
     
     // loop through all the output control points
     int k = 0;
@@ -640,7 +598,7 @@ Response* ECMtsCsi::setResponse(const char **argv, int argc,
             output.tag("ResponseType",outputData);
         }
         theResponse = new ExpControlResponse(this, 1,
-            Vector(numCtrlSignals));
+            &ctrlSignal, numCtrlSignals);
     }
     
     // daq signals
@@ -654,7 +612,7 @@ Response* ECMtsCsi::setResponse(const char **argv, int argc,
             output.tag("ResponseType",outputData);
         }
         theResponse = new ExpControlResponse(this, 2,
-            Vector(numDaqSignals));
+            &daqSignal, numDaqSignals);
     }
     output.endTag();
     
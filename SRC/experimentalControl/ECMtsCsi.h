@@ -35,6 +35,7 @@
 #include "ExperimentalControl.h"
 
 #include <MtsCsi.h>
+#include <ExpCPLimits.h>
 
 class ExperimentalCP;
 
@@ -104,6 +105,7 @@ private:
     Vector ctrlSigOffset, daqSigOffset;      // signal offsets (i.e. setpoints)
     Vector trialSigOffset;                   // trial signal offsets
     int useRelativeTrial, gotRelativeTrial;  // relative trial signal flags
+    ExpCPLimits ctrlLimits;                  // limits of the trial signals
     
     int rampId;  // set this to -1 to get current feedback
 };
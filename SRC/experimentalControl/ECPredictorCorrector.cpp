@@ -0,0 +1,913 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// $Revision$
+// $Date$
+// $URL$
+
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the implementation of the
+// ECPredictorCorrector class.
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include "ECPredictorCorrector.h"
+
+#include <ExpCheckpoint.h>
+
+#include <math.h>
+
+#ifndef _WIN32
+#include <errno.h>
+#include <sched.h>
+#include <time.h>
+#endif
+
+
+ECPredictorCorrector::ECPredictorCorrector(int tag,
+    ExperimentalControl *control, double dtcon, double dtsim,
+    int ord, int prio, int cpuid, double actlag)
+    : ExperimentalControl(tag), theControl(control),
+    dtCon(dtcon), dtSim(dtsim), order(ord), priority(prio), cpu(cpuid),
+    actLag(actlag), numSubSteps(0), targets(0),
+    ctrlDisp(0), ctrlTime(0), lastTime(0), cmdDisp(0), cmdTime(0),
+    actDisp(0), actDispOld(0), actVel(0), actVelOld(0), actAccel(0),
+    daqDisp(0), daqVel(0), daqAccel(0), daqForce(0), daqTime(0),
+    corrCmd(0), numCorrPts(0), state(0), subStep(0), numSent(0),
+    numReached(0), numStalls(0), numOverruns(0),
+    stopFlag(false), running(false)
+{
+    if (theControl == 0)  {
+        opserr << "ECPredictorCorrector::ECPredictorCorrector() - "
+            << "null experimental control pointer passed.\n";
+        exit(OF_ReturnType_failed);
+    }
+    
+    this->initialize();
+}
+
+
+ECPredictorCorrector::ECPredictorCorrector(const ECPredictorCorrector &ec)
+    : ExperimentalControl(ec), theControl(0),
+    dtCon(ec.dtCon), dtSim(ec.dtSim), order(ec.order),
+    priority(ec.priority), cpu(ec.cpu), actLag(ec.actLag),
+    numSubSteps(0), targets(0),
+    ctrlDisp(0), ctrlTime(0), lastTime(0), cmdDisp(0), cmdTime(0),
+    actDisp(0), actDispOld(0), actVel(0), actVelOld(0), actAccel(0),
+    daqDisp(0), daqVel(0), daqAccel(0), daqForce(0), daqTime(0),
+    corrCmd(0), numCorrPts(0), state(0), subStep(0), numSent(0),
+    numReached(0), numStalls(0), numOverruns(0),
+    stopFlag(false), running(false)
+{
+    theControl = ec.theControl->getCopy();
+    if (theControl == 0)  {
+        opserr << "ECPredictorCorrector::ECPredictorCorrector() - "
+            << "failed to get copy of experimental control.\n";
+        exit(OF_ReturnType_failed);
+    }
+    
+    this->initialize();
+}
+
+
+ECPredictorCorrector::~ECPredictorCorrector()
+{
+    // stop the command thread
+    this->stopThread();
+    
+    // delete memory of vectors
+    this->deleteVectors();
+    if (targets != 0)
+        delete [] targets;
+    
+    if (theControl != 0)
+        delete theControl;
+    
+#ifdef _WIN32
+    DeleteCriticalSection(&theMutex);
+#else
+    pthread_mutex_destroy(&theMutex);
+    pthread_cond_destroy(&theCond);
+#endif
+}
+
+
+int ECPredictorCorrector::setup()
+{
+    int i, rValue = 0;
+    
+    // stop a command thread from a previous setup
+    this->stopThread();
+    
+    int nDisp = (*sizeCtrl)(OF_Resp_Disp);
+    if (((*sizeCtrl)(OF_Resp_Vel) != 0 && (*sizeCtrl)(OF_Resp_Vel) != nDisp) ||
+        ((*sizeCtrl)(OF_Resp_Accel) != 0 && (*sizeCtrl)(OF_Resp_Accel) != nDisp))  {
+        opserr << "ECPredictorCorrector::setup() - "
+            << "velocity and acceleration commands need to have "
+            << "the same size as the displacement commands\n";
+        return OF_ReturnType_failed;
+    }
+    
+    // allocate the targets and the command vectors
+    this->deleteVectors();
+    for (i=0; i<=order; i++)
+        targets[i] = new Vector(nDisp);
+    ctrlDisp = new Vector(nDisp);
+    cmdDisp = new Vector(nDisp);
+    corrCmd = new Vector(nDisp);
+    actDisp = new Vector(nDisp);
+    actDispOld = new Vector(nDisp);
+    actVel = new Vector(nDisp);
+    actVelOld = new Vector(nDisp);
+    actAccel = new Vector(nDisp);
+    if ((*sizeCtrl)(OF_Resp_Time) != 0)  {
+        ctrlTime = new Vector((*sizeCtrl)(OF_Resp_Time));
+        lastTime = new Vector((*sizeCtrl)(OF_Resp_Time));
+        cmdTime = new Vector((*sizeCtrl)(OF_Resp_Time));
+    }
+    
+    // allocate the daq vectors
+    if ((*sizeDaq)(OF_Resp_Disp) != 0)
+        daqDisp = new Vector((*sizeDaq)(OF_Resp_Disp));
+    if ((*sizeDaq)(OF_Resp_Vel) != 0)
+        daqVel = new Vector((*sizeDaq)(OF_Resp_Vel));
+    if ((*sizeDaq)(OF_Resp_Accel) != 0)
+        daqAccel = new Vector((*sizeDaq)(OF_Resp_Accel));
+    if ((*sizeDaq)(OF_Resp_Force) != 0)
+        daqForce = new Vector((*sizeDaq)(OF_Resp_Force));
+    if ((*sizeDaq)(OF_Resp_Time) != 0)
+        daqTime = new Vector((*sizeDaq)(OF_Resp_Time));
+    
+    // setup the other control and get its initial response
+    rValue += theControl->setup();
+    rValue += theControl->getDaqResponse(daqDisp, daqVel,
+        daqAccel, daqForce, daqTime);
+    
+    // the command starts at rest at zero
+    numSubSteps = (int)floor(dtSim/dtCon + 0.5);
+    state = 0;
+    subStep = 0;
+    numSent = 0;
+    numReached = 0;
+    numStalls = 0;
+    numOverruns = 0;
+    
+    // print experimental control information
+    //this->Print(opserr);
+    
+    if (this->startThread() < 0)
+        return OF_ReturnType_failed;
+    
+    return rValue;
+}
+
+
+int ECPredictorCorrector::setSize(ID sizeT, ID sizeO)
+{
+    // ECPredictorCorrector objects generate the displacement
+    // commands, so displacements are required and forces cannot
+    // be commanded
+    if (sizeT(OF_Resp_Disp) == 0 || sizeT(OF_Resp_Force) != 0)  {
+        opserr << "ECPredictorCorrector::setSize() - wrong sizeTrial/Out\n";
+        opserr << "sizeT(Disp) = " << sizeT(OF_Resp_Disp) << " == 0 or\n";
+        opserr << "sizeT(Force) = " << sizeT(OF_Resp_Force) << " != 0\n";
+        opserr << "see User Manual.\n";
+        exit(OF_ReturnType_failed);
+    }
+    
+    *sizeCtrl = sizeT;
+    *sizeDaq = sizeO;
+    
+    return theControl->setSize(sizeT, sizeO);
+}
+
+
+int ECPredictorCorrector::setTrialResponse(const Vector* disp,
+    const Vector* vel,
+    const Vector* accel,
+    const Vector* force,
+    const Vector* time)
+{
+    int i, rValue = 0;
+    
+    this->lock();
+    
+    // the command thread might still be correcting towards
+    // the previous target if the response was not acquired
+    while (running && numReached < numSent)
+        this->wait();
+    
+    if (disp != 0)  {
+        *ctrlDisp = *disp;
+        if (theCtrlFilters[OF_Resp_Disp] != 0)  {
+            for (i=0; i<(*sizeCtrl)(OF_Resp_Disp); i++)
+                (*ctrlDisp)(i) = theCtrlFilters[OF_Resp_Disp]->filtering((*ctrlDisp)(i));
+        }
+    }
+    if (time != 0 && ctrlTime != 0)  {
+        *ctrlTime = *time;
+        if (theCtrlFilters[OF_Resp_Time] != 0)  {
+            for (i=0; i<(*sizeCtrl)(OF_Resp_Time); i++)
+                (*ctrlTime)(i) = theCtrlFilters[OF_Resp_Time]->filtering((*ctrlTime)(i));
+        }
+    }
+    
+    rValue = this->control();
+    
+    this->unlock();
+    
+    return rValue;
+}
+
+
+int ECPredictorCorrector::getDaqResponse(Vector* disp,
+    Vector* vel,
+    Vector* accel,
+    Vector* force,
+    Vector* time)
+{
+    this->lock();
+    
+    int i, rValue = this->acquire();
+    if (daqDisp != 0)
+        this->setCtrlFilterFeedback(*daqDisp);
+    
+    if (disp != 0 && daqDisp != 0)  {
+        if (theDaqFilters[OF_Resp_Disp] != 0)  {
+            for (i=0; i<(*sizeDaq)(OF_Resp_Disp); i++)
+                (*daqDisp)(i) = theDaqFilters[OF_Resp_Disp]->filtering((*daqDisp)(i));
+        }
+        *disp = *daqDisp;
+    }
+    if (vel != 0 && daqVel != 0)  {
+        if (theDaqFilters[OF_Resp_Vel] != 0)  {
+            for (i=0; i<(*sizeDaq)(OF_Resp_Vel); i++)
+                (*daqVel)(i) = theDaqFilters[OF_Resp_Vel]->filtering((*daqVel)(i));
+        }
+        *vel = *daqVel;
+    }
+    if (accel != 0 && daqAccel != 0)  {
+        if (theDaqFilters[OF_Resp_Accel] != 0)  {
+            for (i=0; i<(*sizeDaq)(OF_Resp_Accel); i++)
+                (*daqAccel)(i) = theDaqFilters[OF_Resp_Accel]->filtering((*daqAccel)(i));
+        }
+        *accel = *daqAccel;
+    }
+    if (force != 0 && daqForce != 0)  {
+        if (theDaqFilters[OF_Resp_Force] != 0)  {
+            for (i=0; i<(*sizeDaq)(OF_Resp_Force); i++)
+                (*daqForce)(i) = theDaqFilters[OF_Resp_Force]->filtering((*daqForce)(i));
+        }
+        *force = *daqForce;
+    }
+    if (time != 0 && daqTime != 0)  {
+        if (theDaqFilters[OF_Resp_Time] != 0)  {
+            for (i=0; i<(*sizeDaq)(OF_Resp_Time); i++)
+                (*daqTime)(i) = theDaqFilters[OF_Resp_Time]->filtering((*daqTime)(i));
+        }
+        *time = *daqTime;
+    }
+    
+    this->unlock();
+    
+    return rValue;
+}
+
+
+int ECPredictorCorrector::commitState()
+{
+    this->lock();
+    int rValue = theControl->commitState();
+    this->unlock();
+    
+    return rValue;
+}
+
+
+ExperimentalControl* ECPredictorCorrector::getCopy()
+{
+    return new ECPredictorCorrector(*this);
+}
+
+
+Response* ECPredictorCorrector::setResponse(const char **argv, int argc,
+    OPS_Stream &output)
+{
+    int i;
+    char outputData[15];
+    Response *theResponse = 0;
+    
+    output.tag("ExpControlOutput");
+    output.attr("ctrlType",this->getClassType());
+    output.attr("ctrlTag",this->getTag());
+    
+    // ctrl displacements
+    if (ctrlDisp != 0 && (
+        strcmp(argv[0],"ctrlDisp") == 0 ||
+        strcmp(argv[0],"ctrlDisplacement") == 0 ||
+        strcmp(argv[0],"ctrlDisplacements") == 0))
+    {
+        for (i=0; i<(*sizeCtrl)(OF_Resp_Disp); i++)  {
+            sprintf(outputData,"ctrlDisp%d",i+1);
+            output.tag("ResponseType",outputData);
+        }
+        theResponse = new ExpControlResponse(this, 1, *ctrlDisp);
+    }
+    
+    // command displacements
+    if (actDisp != 0 && (
+        strcmp(argv[0],"cmdDisp") == 0 ||
+        strcmp(argv[0],"cmdDisplacement") == 0 ||
+        strcmp(argv[0],"cmdDisplacements") == 0))
+    {
+        for (i=0; i<(*sizeCtrl)(OF_Resp_Disp); i++)  {
+            sprintf(outputData,"cmdDisp%d",i+1);
+            output.tag("ResponseType",outputData);
+        }
+        theResponse = new ExpControlResponse(this, 2, *actDisp);
+    }
+    
+    // daq displacements
+    if (daqDisp != 0 && (
+        strcmp(argv[0],"daqDisp") == 0 ||
+        strcmp(argv[0],"daqDisplacement") == 0 ||
+        strcmp(argv[0],"daqDisplacements") == 0))
+    {
+        for (i=0; i<(*sizeDaq)(OF_Resp_Disp); i++)  {
+            sprintf(outputData,"daqDisp%d",i+1);
+            output.tag("ResponseType",outputData);
+        }
+        theResponse = new ExpControlResponse(this, 3, *daqDisp);
+    }
+    
+    // daq forces
+    if (daqForce != 0 && (
+        strcmp(argv[0],"daqForce") == 0 ||
+        strcmp(argv[0],"daqForces") == 0))
+    {
+        for (i=0; i<(*sizeDaq)(OF_Resp_Force); i++)  {
+            sprintf(outputData,"daqForce%d",i+1);
+            output.tag("ResponseType",outputData);
+        }
+        theResponse = new ExpControlResponse(this, 4, *daqForce);
+    }
+    
+    output.endTag();
+    
+    return theResponse;
+}
+
+
+int ECPredictorCorrector::getResponse(int responseID, Information &info)
+{
+    int rValue = -1;
+    
+    this->lock();
+    switch (responseID)  {
+    case 1:  // ctrl displacements
+        rValue = info.setVector(*ctrlDisp);
+        break;
+        
+    case 2:  // command displacements
+        rValue = info.setVector(*actDisp);
+        break;
+        
+    case 3:  // daq displacements
+        rValue = info.setVector(*daqDisp);
+        break;
+        
+    case 4:  // daq forces
+        rValue = info.setVector(*daqForce);
+        break;
+    }
+    this->unlock();
+    
+    return rValue;
+}
+
+
+void ECPredictorCorrector::Print(OPS_Stream &s, int flag)
+{
+    s << "****************************************************************\n";
+    s << "* ExperimentalControl: " << this->getTag() << endln; 
+    s << "*   type: ECPredictorCorrector\n";
+    s << "*   control: " << theControl->getTag() << endln;
+    s << "*   dtCon: " << dtCon << ", dtSim: " << dtSim
+        << ", order: " << order << endln;
+    s << "*   priority: " << priority << ", cpu: " << cpu
+        << ", actuatorLag: " << actLag << endln;
+    s << "*   targets: " << numReached << ", stalls: " << numStalls
+        << ", overruns: " << numOverruns << endln;
+    s << "*   ctrlFilters:";
+    for (int i=0; i<OF_Resp_All; i++)  {
+        if (theCtrlFilters[i] != 0)
+            s << " " << theCtrlFilters[i]->getTag();
+        else
+            s << " 0";
+    }
+    s << "\n*   daqFilters:";
+    for (int i=0; i<OF_Resp_All; i++)  {
+        if (theDaqFilters[i] != 0)
+            s << " " << theDaqFilters[i]->getTag();
+        else
+            s << " 0";
+    }
+    s << endln;
+    s << "****************************************************************\n";
+    s << endln;
+}
+
+
+int ECPredictorCorrector::saveState(ExpCheckpoint &theCheckpoint)
+{
+    this->lock();
+    
+    // wait until the last target has been reached
+    while (running && numReached < numSent)
+        this->wait();
+    
+    int rValue = this->ExperimentalControl::saveState(theCheckpoint);
+    rValue += theControl->saveState(theCheckpoint);
+    theCheckpoint.save(targets[order]);
+    theCheckpoint.save(lastTime);
+    
+    this->unlock();
+    
+    return (rValue < 0) ? OF_ReturnType_failed : OF_ReturnType_completed;
+}
+
+
+int ECPredictorCorrector::restoreState(ExpCheckpoint &theCheckpoint)
+{
+    int i, rValue = 0;
+    
+    this->lock();
+    
+    if (this->ExperimentalControl::restoreState(theCheckpoint) < 0 ||
+        theControl->restoreState(theCheckpoint) < 0 ||
+        theCheckpoint.restore(targets[order]) < 0 ||
+        theCheckpoint.restore(lastTime) < 0)  {
+        rValue = OF_ReturnType_failed;
+    }
+    else  {
+        // the older targets are not known after a restart, so all
+        // of them are set to the last one and the command is held
+        // there until the next target arrives
+        for (i=0; i<order; i++)
+            *targets[i] = *targets[order];
+        *cmdDisp = *targets[order];
+        *actDisp = *cmdDisp;
+        *actDispOld = *cmdDisp;
+        actVel->Zero();
+        actVelOld->Zero();
+        actAccel->Zero();
+        if (cmdTime != 0)
+            *cmdTime = *lastTime;
+        state = 0;
+        subStep = numSubSteps+1;
+        numSent = numReached;
+    }
+    
+    this->unlock();
+    
+    return rValue;
+}
+
+
+int ECPredictorCorrector::control()
+{
+    if (!running)  {
+        opserr << "ECPredictorCorrector::control() - "
+            << "command thread is not running\n";
+        return OF_ReturnType_failed;
+    }
+    
+    // the command thread switches to the corrector
+    // with its next command
+    numSent++;
+    
+    return OF_ReturnType_completed;
+}
+
+
+int ECPredictorCorrector::acquire()
+{
+    // wait until the command thread has reached the target
+    while (running && numReached < numSent)
+        this->wait();
+    
+    if (numReached < numSent)  {
+        opserr << "ECPredictorCorrector::acquire() - "
+            << "command thread stopped before reaching the target\n";
+        return OF_ReturnType_failed;
+    }
+    
+    return OF_ReturnType_completed;
+}
+
+
+void ECPredictorCorrector::initialize()
+{
+    if (dtCon <= 0.0 || dtSim < dtCon)  {
+        opserr << "ECPredictorCorrector::ECPredictorCorrector() - "
+            << "dtCon must be positive and not larger than dtSim\n";
+        exit(OF_ReturnType_failed);
+    }
+    if (order < 1 || order > 3)  {
+        opserr << "ECPredictorCorrector::ECPredictorCorrector() - "
+            << "order must be 1, 2 or 3\n";
+        exit(OF_ReturnType_failed);
+    }
+    if (actLag < 0.0)  {
+        opserr << "ECPredictorCorrector::ECPredictorCorrector() - "
+            << "actuator lag must not be negative\n";
+        exit(OF_ReturnType_failed);
+    }
+    
+    // the predictor uses the targets at -order, ..., -1, 0
+    // where 1 is the end of the current simulation step
+    targets = new Vector* [order+1];
+    for (int i=0; i<=order; i++)  {
+        targets[i] = 0;
+        predX[i] = i - order;
+    }
+    for (int i=0; i<4; i++)  {
+        corrX[i] = 0.0;
+        corrPts[i] = 0;
+    }
+    
+#ifdef _WIN32
+    theThread = NULL;
+    InitializeCriticalSection(&theMutex);
+    InitializeConditionVariable(&theCond);
+#else
+    pthread_mutex_init(&theMutex, NULL);
+    pthread_cond_init(&theCond, NULL);
+#endif
+}
+
+
+void ECPredictorCorrector::deleteVectors()
+{
+    if (targets != 0)  {
+        for (int i=0; i<=order; i++)  {
+            if (targets[i] != 0)
+                delete targets[i];
+            targets[i] = 0;
+        }
+    }
+    
+    Vector **vectors[] = {&ctrlDisp, &ctrlTime, &lastTime,
+        &cmdDisp, &cmdTime, &corrCmd,
+        &actDisp, &actDispOld, &actVel, &actVelOld, &actAccel,
+        &daqDisp, &daqVel, &daqAccel, &daqForce, &daqTime};
+    for (unsigned int i=0; i<sizeof(vectors)/sizeof(Vector **); i++)  {
+        if (*vectors[i] != 0)
+            delete *vectors[i];
+        *vectors[i] = 0;
+    }
+}
+
+
+int ECPredictorCorrector::startThread()
+{
+    stopFlag = false;
+    running = true;
+    
+#ifdef _WIN32
+    theThread = CreateThread(NULL, 0, threadFunc, this, 0, NULL);
+    if (theThread == NULL)  {
+        opserr << "ECPredictorCorrector::startThread() - "
+            << "could not create command thread\n";
+        running = false;
+        return -1;
+    }
+    if (priority >= 0)
+        SetThreadPriority(theThread, THREAD_PRIORITY_TIME_CRITICAL);
+    if (cpu >= 0 && (cpu >= (int)(8*sizeof(DWORD_PTR)) ||
+        SetThreadAffinityMask(theThread, ((DWORD_PTR)1) << cpu) == 0))  {
+        opserr << "ECPredictorCorrector::startThread() - "
+            << "could not bind command thread to cpu " << cpu << endln;
+    }
+#else
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    if (priority >= 0)  {
+        struct sched_param param;
+        param.sched_priority = priority;
+        pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+        pthread_attr_setschedpolicy(&attr, SCHED_FIFO);
+        pthread_attr_setschedparam(&attr, &param);
+    }
+    int rValue = pthread_create(&theThread, &attr, threadFunc, this);
+    pthread_attr_destroy(&attr);
+    if (rValue == EPERM && priority >= 0)  {
+        opserr << "WARNING ECPredictorCorrector::startThread() - "
+            << "no permission for real-time priority, "
+            << "using a normal command thread\n";
+        rValue = pthread_create(&theThread, NULL, threadFunc, this);
+    }
+    if (rValue != 0)  {
+        opserr << "ECPredictorCorrector::startThread() - "
+            << "could not create command thread\n";
+        running = false;
+        return -1;
+    }
+#if defined(__linux__)
+    if (cpu >= 0)  {
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        CPU_SET(cpu, &cpuSet);
+        if (pthread_setaffinity_np(theThread, sizeof(cpu_set_t), &cpuSet) != 0)  {
+            opserr << "ECPredictorCorrector::startThread() - "
+                << "could not bind command thread to cpu " << cpu << endln;
+        }
+    }
+#endif
+#endif
+    
+    return 0;
+}
+
+
+void ECPredictorCorrector::stopThread()
+{
+    if (!running)
+        return;
+    
+    this->lock();
+    stopFlag = true;
+    this->unlock();
+    
+#ifdef _WIN32
+    WaitForSingleObject(theThread, INFINITE);
+    CloseHandle(theThread);
+    theThread = NULL;
+#else
+    pthread_join(theThread, NULL);
+#endif
+    
+    running = false;
+}
+
+
+#ifdef _WIN32
+DWORD WINAPI ECPredictorCorrector::threadFunc(LPVOID arg)
+{
+    ((ECPredictorCorrector *)arg)->runThread();
+    return 0;
+}
+#else
+void *ECPredictorCorrector::threadFunc(void *arg)
+{
+    ((ECPredictorCorrector *)arg)->runThread();
+    return 0;
+}
+#endif
+
+
+void ECPredictorCorrector::runThread()
+{
+    bool stop = false, overrun;
+    
+#ifdef _WIN32
+    LARGE_INTEGER freq, now, next;
+    QueryPerformanceFrequency(&freq);
+    LONGLONG period = (LONGLONG)(dtCon*freq.QuadPart);
+    QueryPerformanceCounter(&next);
+#else
+    struct timespec now, next;
+    long period = (long)(1.0E9*dtCon);
+    clock_gettime(CLOCK_MONOTONIC, &next);
+#endif
+    
+    while (!stop)  {
+        // wait for the start of the next command period, sleep
+        // until it is close and then spin on the counter
+#ifdef _WIN32
+        next.QuadPart += period;
+        QueryPerformanceCounter(&now);
+        while (now.QuadPart < next.QuadPart)  {
+            if (next.QuadPart - now.QuadPart > freq.QuadPart/500)
+                Sleep(1);
+            QueryPerformanceCounter(&now);
+        }
+        overrun = (now.QuadPart - next.QuadPart > period);
+#else
+        next.tv_nsec += period;
+        while (next.tv_nsec >= 1000000000L)  {
+            next.tv_nsec -= 1000000000L;
+            next.tv_sec++;
+        }
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME,
+            &next, NULL) == EINTR);
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        overrun = ((now.tv_sec - next.tv_sec)*1.0E9 +
+            (now.tv_nsec - next.tv_nsec) > period);
+#endif
+        // a missed period is not made up for, the command is
+        // continued from the current time instead
+        if (overrun)
+            next = now;
+        
+        this->lock();
+        if (overrun)
+            numOverruns++;
+        stop = stopFlag;
+        if (!stop)
+            this->generateCommand();
+        this->unlock();
+    }
+}
+
+
+int ECPredictorCorrector::generateCommand()
+{
+    int i, j, rValue = 0;
+    double x;
+    
+    // switch to the corrector once a new target has been received,
+    // the abscissae are normalized so that the last target is at 0
+    // and the new target at 1
+    if (state == 0 && numSent > numReached)  {
+        if (subStep == 0)  {
+            // no prediction yet, use the last targets
+            for (j=0; j<order; j++)  {
+                corrX[j] = j - (order-1);
+                corrPts[j] = targets[j+1];
+            }
+            numCorrPts = order+1;
+        }
+        else if (subStep < numSubSteps)  {
+            // continue from the current command
+            for (j=0; j<order-1; j++)  {
+                corrX[j] = j - (order-2);
+                corrPts[j] = targets[j+2];
+            }
+            *corrCmd = *cmdDisp;
+            corrX[order-1] = (double)subStep/numSubSteps;
+            corrPts[order-1] = corrCmd;
+            numCorrPts = order+1;
+        }
+        else  {
+            // the prediction ran out, restart the step from the
+            // held command and move linearly to the new target
+            *corrCmd = *cmdDisp;
+            corrX[0] = 0.0;
+            corrPts[0] = corrCmd;
+            numCorrPts = 2;
+            subStep = 0;
+        }
+        corrX[numCorrPts-1] = 1.0;
+        corrPts[numCorrPts-1] = ctrlDisp;
+        state = 1;
+    }
+    
+    subStep++;
+    if (state == 0)  {
+        // predictor, hold the command at the end of the step
+        // until the new target arrives
+        if (subStep > numSubSteps)  {
+            if (subStep == numSubSteps+1)
+                numStalls++;
+            subStep = numSubSteps+1;
+            x = 1.0;
+        }
+        else  {
+            x = (double)subStep/numSubSteps;
+        }
+        this->evalPolynomial(order+1, predX, targets, x, *cmdDisp);
+        if (cmdTime != 0)
+            *cmdTime = *lastTime;
+    }
+    else  {
+        // corrector, the target is reached exactly at the end
+        x = (double)subStep/numSubSteps;
+        if (subStep >= numSubSteps)
+            *cmdDisp = *ctrlDisp;
+        else
+            this->evalPolynomial(numCorrPts, corrX, corrPts, x, *cmdDisp);
+        if (cmdTime != 0)  {
+            for (i=0; i<cmdTime->Size(); i++)
+                (*cmdTime)(i) = (*lastTime)(i) + x*((*ctrlTime)(i) - (*lastTime)(i));
+        }
+    }
+    
+    // simulated first-order actuator lag
+    if (actLag > 0.0)
+        actDisp->addVector(1.0 - dtCon/(actLag+dtCon), *cmdDisp, dtCon/(actLag+dtCon));
+    else
+        *actDisp = *cmdDisp;
+    
+    // velocities and accelerations of the command
+    actVel->addVector(0.0, *actDisp, 1.0/dtCon);
+    actVel->addVector(1.0, *actDispOld, -1.0/dtCon);
+    actAccel->addVector(0.0, *actVel, 1.0/dtCon);
+    actAccel->addVector(1.0, *actVelOld, -1.0/dtCon);
+    *actDispOld = *actDisp;
+    *actVelOld = *actVel;
+    
+    rValue = theControl->setTrialResponse(actDisp,
+        ((*sizeCtrl)(OF_Resp_Vel) != 0) ? actVel : 0,
+        ((*sizeCtrl)(OF_Resp_Accel) != 0) ? actAccel : 0,
+        0, cmdTime);
+    
+    // target reached, acquire the response and shift the targets
+    if (state == 1 && subStep >= numSubSteps)  {
+        rValue += theControl->getDaqResponse(daqDisp, daqVel,
+            daqAccel, daqForce, daqTime);
+        
+        Vector *oldest = targets[0];
+        for (j=0; j<order; j++)
+            targets[j] = targets[j+1];
+        targets[order] = oldest;
+        *oldest = *ctrlDisp;
+        if (lastTime != 0)
+            *lastTime = *ctrlTime;
+        
+        state = 0;
+        subStep = 0;
+        numReached++;
+        this->notify();
+    }
+    
+    return rValue;
+}
+
+
+void ECPredictorCorrector::evalPolynomial(int numPts, const double *x,
+    Vector *const *y, double xi, Vector &result)
+{
+    // Lagrange form of the polynomial through the points
+    result.Zero();
+    for (int j=0; j<numPts; j++)  {
+        double w = 1.0;
+        for (int m=0; m<numPts; m++)  {
+            if (m != j)
+                w *= (xi - x[m])/(x[j] - x[m]);
+        }
+        result.addVector(1.0, *y[j], w);
+    }
+}
+
+
+void ECPredictorCorrector::lock()
+{
+#ifdef _WIN32
+    EnterCriticalSection(&theMutex);
+#else
+    pthread_mutex_lock(&theMutex);
+#endif
+}
+
+
+void ECPredictorCorrector::unlock()
+{
+#ifdef _WIN32
+    LeaveCriticalSection(&theMutex);
+#else
+    pthread_mutex_unlock(&theMutex);
+#endif
+}
+
+
+void ECPredictorCorrector::notify()
+{
+#ifdef _WIN32
+    WakeAllConditionVariable(&theCond);
+#else
+    pthread_cond_broadcast(&theCond);
+#endif
+}
+
+
+void ECPredictorCorrector::wait()
+{
+#ifdef _WIN32
+    SleepConditionVariableCS(&theCond, &theMutex, INFINITE);
+#else
+    pthread_cond_wait(&theCond, &theMutex);
+#endif
+}
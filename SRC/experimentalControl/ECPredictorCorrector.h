@@ -0,0 +1,167 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// $Revision$
+// $Date$
+// $URL$
+
+#ifndef ECPredictorCorrector_h
+#define ECPredictorCorrector_h
+
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the class definition for
+// ECPredictorCorrector. ECPredictorCorrector is a controller class
+// that drives another experimental control with a continuous command
+// signal instead of ramp-and-hold steps. A thread generates a new
+// displacement command every dtCon seconds using the predictor-
+// corrector algorithm of the Simulink hybrid controllers: while the
+// next target is not known the command is extrapolated with a
+// polynomial through the last targets, once it is known the command
+// is interpolated so that the target is reached after dtSim seconds.
+// The daq response of the other control is acquired at that instant.
+// An optional first-order actuator lag can be added for testing with
+// simulation controls.
+
+#include "ExperimentalControl.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+class ECPredictorCorrector : public ExperimentalControl
+{
+public:
+    // constructors
+    ECPredictorCorrector(int tag, ExperimentalControl *control,
+        double dtCon, double dtSim, int order = 2,
+        int priority = -1, int cpu = -1, double actLag = 0.0);
+    ECPredictorCorrector(const ECPredictorCorrector &ec);
+
+    // destructor
+    virtual ~ECPredictorCorrector();
+
+    // method to get class type
+    const char *getClassType() const {return "ECPredictorCorrector";};
+
+    // public methods to set and to get response
+    virtual int setup();
+    virtual int setSize(ID sizeT, ID sizeO);
+
+    virtual int setTrialResponse(
+        const Vector* disp,
+        const Vector* vel,
+        const Vector* accel,
+        const Vector* force,
+        const Vector* time);
+    virtual int getDaqResponse(
+        Vector* disp,
+        Vector* vel,
+        Vector* accel,
+        Vector* force,
+        Vector* time);
+
+    virtual int commitState();
+
+    virtual ExperimentalControl *getCopy();
+
+    // public methods for experimental control recorder
+    virtual Response *setResponse(const char **argv, int argc,
+        OPS_Stream &output);
+    virtual int getResponse(int responseID, Information &info);
+
+    // public methods to save and restore the state for a checkpoint
+    virtual int saveState(ExpCheckpoint &theCheckpoint);
+    virtual int restoreState(ExpCheckpoint &theCheckpoint);
+
+    // public methods for output
+    void Print(OPS_Stream &s, int flag = 0);
+
+protected:
+    // protected methods to set and to get response
+    virtual int control();
+    virtual int acquire();
+
+private:
+    void initialize();
+    void deleteVectors();
+    int startThread();
+    void stopThread();
+    void runThread();
+    int generateCommand();
+    void evalPolynomial(int numPts, const double *x,
+        Vector *const *y, double xi, Vector &result);
+    void lock();
+    void unlock();
+    void notify();
+    void wait();
+
+#ifdef _WIN32
+    static DWORD WINAPI threadFunc(LPVOID arg);
+#else
+    static void *threadFunc(void *arg);
+#endif
+
+    ExperimentalControl *theControl;  // control that is commanded
+    double dtCon;       // period of the command thread
+    double dtSim;       // duration of each simulation step
+    int order;          // order of the predictor-corrector polynomials
+    int priority;       // real-time priority of the thread (-1 = normal)
+    int cpu;            // cpu of the thread (-1 = not bound)
+    double actLag;      // time constant of simulated actuator (0 = none)
+    int numSubSteps;    // number of commands per simulation step
+
+    Vector **targets;   // last order+1 targets, oldest first
+    Vector *ctrlDisp, *ctrlTime, *lastTime;         // new and last target
+    Vector *cmdDisp, *cmdTime;                      // generated commands
+    Vector *actDisp, *actDispOld, *actVel, *actVelOld, *actAccel;
+    Vector *daqDisp, *daqVel, *daqAccel, *daqForce, *daqTime;
+
+    double predX[4];    // abscissae of the predictor polynomial
+    double corrX[4];    // abscissae of the corrector polynomial
+    Vector *corrPts[4]; // ordinates of the corrector polynomial
+    Vector *corrCmd;    // command at the switch to the corrector
+    int numCorrPts;     // number of points of the corrector polynomial
+
+    int state;          // 0 = predicting, 1 = correcting
+    int subStep;        // commands sent in the current simulation step
+    int numSent;        // number of targets received
+    int numReached;     // number of targets reached
+    int numStalls;      // steps in which the prediction ran out
+    int numOverruns;    // command periods that were missed
+    bool stopFlag;      // flag to stop the thread
+    bool running;       // flag if the thread is running
+
+#ifdef _WIN32
+    HANDLE theThread;
+    CRITICAL_SECTION theMutex;
+    CONDITION_VARIABLE theCond;
+#else
+    pthread_t theThread;
+    pthread_mutex_t theMutex;
+    pthread_cond_t theCond;
+#endif
+};
+
+#endif
@@ -223,6 +223,7 @@ int ECSCRAMNet::setup()
     
     // print experimental control information
     this->Print(opserr);
+    this->startInitPhase("confirm");
     
     opserr << "****************************************************************\n";
     opserr << "* Make sure that offset values of controller are set to ZERO,  *\n";
@@ -231,13 +232,13 @@ int ECSCRAMNet::setup()
     opserr << "* Press 'Enter' to proceed or 'c' to cancel the initialization *\n";
     opserr << "****************************************************************\n";
     opserr << endln;
-    int c = getchar();
+    int c = this->getInitKey();
     if (c == 'c')  {
-        getchar();
         this->~ECSCRAMNet();
         exit(OF_ReturnType_failed);
     }
     
+    this->startInitPhase("measure");
     do  {
         rValue += this->control();
         rValue += this->acquire();
@@ -260,16 +261,16 @@ int ECSCRAMNet::setup()
         opserr << "* 'c' to cancel the initialization\n";
         opserr << "****************************************************************\n";
         opserr << endln;
-        c = getchar();
+        c = this->getInitKey(maxAbs(daqDisp, (*sizeDaq)(OF_Resp_Disp)),
+            maxAbs(daqForce, (*sizeDaq)(OF_Resp_Force)));
         if (c == 'c')  {
-            getchar();
             this->~ECSCRAMNet();
             exit(OF_ReturnType_failed);
-        } else if (c == 'r')  {
-            getchar();
         }
     } while (c == 'r');
     
+    this->startInitPhase(0);
+    
     opserr << "*****************\n";
     opserr << "* Running...... *\n";
     opserr << "*****************\n";
@@ -394,6 +395,14 @@ int ECSCRAMNet::getDaqResponse(
     
     rValue = this->acquire();
     
+    // pass the measured displacements to the ctrl filter
+    if (theCtrlFilters[OF_Resp_Disp] != 0)  {
+        Vector fbDisp((*sizeDaq)(OF_Resp_Disp));
+        for (i=0; i<(*sizeDaq)(OF_Resp_Disp); i++)
+            fbDisp(i) = daqDisp[i];
+        this->setCtrlFilterFeedback(fbDisp);
+    }
+    
     if (disp != 0)  {
         if (theDaqFilters[OF_Resp_Disp] == 0)  {
             for (i=0; i<(*sizeDaq)(OF_Resp_Disp); i++)
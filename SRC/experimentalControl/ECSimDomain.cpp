@@ -41,6 +41,8 @@
 
 #include <Domain.h>
 #include <Node.h>
+#include <Element.h>
+#include <ElementIter.h>
 #include <LinearSeries.h>
 #include <LoadPattern.h>
 #include <SP_Constraint.h>
@@ -87,9 +89,11 @@ ECSimDomain::ECSimDomain(int tag,
     : ECSimulation(tag), numTrialCPs(nTrialCPs), numOutCPs(nOutCPs),
     theDomain(0), theModel(0), theTest(0), theAlgorithm(0), theIntegrator(0),
     theHandler(0), theNumberer(0), theSOE(0), theAnalysis(0),
-    theSeries(0), thePattern(0), theSPs(0), theNodes(0), numSPs(0),
+    theSeries(0), thePattern(0), theSPs(0), theNodes(0), theElements(0),
+    numSPs(0), numElements(0), loadTime(0.0),
     ctrlDisp(0), ctrlVel(0), ctrlAccel(0), ctrlForce(0),
-    daqDisp(0), daqVel(0), daqAccel(0), daqForce(0)
+    daqDisp(0), daqVel(0), daqAccel(0), daqForce(0),
+    fbIndex(0), fbDisp(0)
 {
     // get trial and output control points
     if (trialcps == 0 || outcps == 0)  {
@@ -119,9 +123,11 @@ ECSimDomain::ECSimDomain(const ECSimDomain& ec)
     : ECSimulation(ec), trialCPs(0), outCPs(0),
     theDomain(0), theModel(0), theTest(0), theAlgorithm(0), theIntegrator(0),
     theHandler(0), theNumberer(0), theSOE(0), theAnalysis(0),
-    theSeries(0), thePattern(0), theSPs(0), theNodes(0), numSPs(0),
+    theSeries(0), thePattern(0), theSPs(0), theNodes(0), theElements(0),
+    numSPs(0), numElements(0), loadTime(0.0),
     ctrlDisp(0), ctrlVel(0), ctrlAccel(0), ctrlForce(0),
-    daqDisp(0), daqVel(0), daqAccel(0), daqForce(0)
+    daqDisp(0), daqVel(0), daqAccel(0), daqForce(0),
+    fbIndex(0), fbDisp(0)
 {
     numTrialCPs = ec.numTrialCPs;
     trialCPs    = ec.trialCPs;
@@ -159,6 +165,10 @@ ECSimDomain::~ECSimDomain()
         delete daqAccel;
     if (daqForce != 0)
         delete daqForce;
+    if (fbIndex != 0)
+        delete [] fbIndex;
+    if (fbDisp != 0)
+        delete [] fbDisp;
     
     // cleanup the analysis
     if (theAnalysis != 0)  {
@@ -176,6 +186,8 @@ ECSimDomain::~ECSimDomain()
         delete [] theSPs;
     if (theNodes != 0)
         delete [] theNodes;
+    if (theElements != 0)
+        delete [] theElements;
     
     // delete memory of control points
     int i;
@@ -309,10 +321,85 @@ int ECSimDomain::setup()
     }
     
     // create array of output nodes to be used in acquire method
+    if (theNodes != 0)
+        delete [] theNodes;
     theNodes = new Node* [numOutCPs];
+    ID outNodeTags(numOutCPs);
     for (int i=0; i<numOutCPs; i++)  {
         int nodeTag = outCPs[i]->getNodeTag();
         theNodes[i] = theDomain->getNode(nodeTag);
+        outNodeTags(i) = nodeTag;
+    }
+    
+    // create array of the elements connected to the output nodes,
+    // which are the only ones contributing to their reactions
+    if (theElements != 0)
+        delete [] theElements;
+    theElements = 0;
+    numElements = 0;
+    for (int pass=0; pass<2; pass++)  {
+        if (pass == 1 && numElements > 0)
+            theElements = new Element* [numElements];
+        numElements = 0;
+        Element *theEle;
+        ElementIter &theEles = theDomain->getElements();
+        while ((theEle = theEles()) != 0)  {
+            if (theEle->isSubdomain() == true)
+                continue;
+            const ID &eleNodes = theEle->getExternalNodes();
+            for (int j=0; j<eleNodes.Size(); j++)  {
+                if (outNodeTags.getLocation(eleNodes(j)) >= 0)  {
+                    if (theElements != 0)
+                        theElements[numElements] = theEle;
+                    numElements++;
+                    break;
+                }
+            }
+        }
+    }
+    
+    // find the daq displacement that measures each ctrl displacement,
+    // so that the ctrl filter gets the feedback in its own order
+    if (fbIndex != 0)
+        delete [] fbIndex;
+    if (fbDisp != 0)
+        delete [] fbDisp;
+    fbIndex = 0;
+    fbDisp = 0;
+    int numDisp = (*sizeCtrl)(OF_Resp_Disp);
+    if (theCtrlFilters[OF_Resp_Disp] != 0 && numDisp != 0 &&
+        (*sizeDaq)(OF_Resp_Disp) != 0)  {
+        fbIndex = new int [numDisp];
+        int iCtrl = 0;
+        for (int i=0; i<numTrialCPs; i++)  {
+            int nodeTag = trialCPs[i]->getNodeTag();
+            int numDir = trialCPs[i]->getNumDOF();
+            ID dir = trialCPs[i]->getUniqueDOF();
+            for (int j=0; j<numDir && iCtrl<numDisp; j++, iCtrl++)  {
+                fbIndex[iCtrl] = -1;
+                int iDaq = 0;
+                for (int k=0; k<numOutCPs; k++)  {
+                    int numOutDir = outCPs[k]->getNumDOF();
+                    ID outDir = outCPs[k]->getUniqueDOF();
+                    for (int l=0; l<numOutDir; l++, iDaq++)  {
+                        if (outCPs[k]->getNodeTag() == nodeTag &&
+                            outDir(l) == dir(j) && fbIndex[iCtrl] < 0)
+                            fbIndex[iCtrl] = iDaq;
+                    }
+                }
+            }
+        }
+        
+        // without a measurement of each ctrl displacement
+        // the ctrl filter does not get any feedback
+        for (int i=0; i<numDisp && fbIndex != 0; i++)  {
+            if (i >= iCtrl || fbIndex[i] < 0)  {
+                delete [] fbIndex;
+                fbIndex = 0;
+            }
+        }
+        if (fbIndex != 0)
+            fbDisp = new double [numDisp];
     }
     
     theModel = new AnalysisModel();
@@ -345,6 +432,7 @@ int ECSimDomain::setup()
     // initialize and analyze one step
     theAnalysis->initialize();
     theAnalysis->analyze(1);
+    loadTime = theDomain->getCurrentTime();
     
     opserr << "*****************\n";
     opserr << "* Running...... *\n";
@@ -441,6 +529,12 @@ int ECSimDomain::getDaqResponse(
     Vector* time)
 {
     this->acquire();
+    if (fbIndex != 0)  {
+        int numDisp = (*sizeCtrl)(OF_Resp_Disp);
+        for (int i=0; i<numDisp; i++)
+            fbDisp[i] = daqDisp[fbIndex[i]];
+        this->setCtrlFilterFeedback(Vector(fbDisp, numDisp));
+    }
     
     int i;
     if (disp != 0)  {
@@ -510,7 +604,7 @@ Response* ECSimDomain::setResponse(const char **argv, int argc,
             output.tag("ResponseType",outputData);
         }
         theResponse = new ExpControlResponse(this, 1,
-            Vector((*sizeCtrl)(OF_Resp_Disp)));
+            &ctrlDisp, (*sizeCtrl)(OF_Resp_Disp));
     }
     
     // ctrl velocities
@@ -524,7 +618,7 @@ Response* ECSimDomain::setResponse(const char **argv, int argc,
             output.tag("ResponseType",outputData);
         }
         theResponse = new ExpControlResponse(this, 2,
-            Vector((*sizeCtrl)(OF_Resp_Vel)));
+            &ctrlVel, (*sizeCtrl)(OF_Resp_Vel));
     }
     
     // ctrl accelerations
@@ -538,7 +632,7 @@ Response* ECSimDomain::setResponse(const char **argv, int argc,
             output.tag("ResponseType",outputData);
         }
         theResponse = new ExpControlResponse(this, 3,
-            Vector((*sizeCtrl)(OF_Resp_Accel)));
+            &ctrlAccel, (*sizeCtrl)(OF_Resp_Accel));
     }
     
     // ctrl forces
@@ -551,7 +645,7 @@ Response* ECSimDomain::setResponse(const char **argv, int argc,
             output.tag("ResponseType",outputData);
         }
         theResponse = new ExpControlResponse(this, 4,
-            Vector((*sizeCtrl)(OF_Resp_Force)));
+            &ctrlForce, (*sizeCtrl)(OF_Resp_Force));
     }
     
     // daq displacements
@@ -565,7 +659,7 @@ Response* ECSimDomain::setResponse(const char **argv, int argc,
             output.tag("ResponseType",outputData);
         }
         theResponse = new ExpControlResponse(this, 5,
-            Vector((*sizeDaq)(OF_Resp_Disp)));
+            &daqDisp, (*sizeDaq)(OF_Resp_Disp));
     }
     
     // daq velocities
@@ -579,7 +673,7 @@ Response* ECSimDomain::setResponse(const char **argv, int argc,
             output.tag("ResponseType",outputData);
         }
         theResponse = new ExpControlResponse(this, 6,
-            Vector((*sizeDaq)(OF_Resp_Vel)));
+            &daqVel, (*sizeDaq)(OF_Resp_Vel));
     }
     
     // daq accelerations
@@ -593,7 +687,7 @@ Response* ECSimDomain::setResponse(const char **argv, int argc,
             output.tag("ResponseType",outputData);
         }
         theResponse = new ExpControlResponse(this, 7,
-            Vector((*sizeDaq)(OF_Resp_Accel)));
+            &daqAccel, (*sizeDaq)(OF_Resp_Accel));
     }
     
     // daq forces
@@ -606,7 +700,7 @@ Response* ECSimDomain::setResponse(const char **argv, int argc,
             output.tag("ResponseType",outputData);
         }
         theResponse = new ExpControlResponse(this, 8,
-            Vector((*sizeDaq)(OF_Resp_Force)));
+            &daqForce, (*sizeDaq)(OF_Resp_Force));
     }
     
     output.endTag();
@@ -689,7 +783,21 @@ void ECSimDomain::Print(OPS_Stream &s, int flag)
 
 int ECSimDomain::control()
 {
+    // the control points read ctrlDisp during the analysis, so the
+    // simulated actuators are applied for this step only and the
+    // commands are restored afterwards
+    int numDisp = (*sizeCtrl)(OF_Resp_Disp);
+    Vector cmdDisp(numDisp);
+    if (numDisp > 0)  {
+        cmdDisp = Vector(ctrlDisp, numDisp);
+        this->actuate(ctrlDisp, numDisp);
+    }
+    
     theAnalysis->analyze(1);
+    loadTime = theDomain->getCurrentTime();
+    
+    for (int i=0; i<numDisp; i++)
+        ctrlDisp[i] = cmdDisp(i);
 
     return OF_ReturnType_completed;
 }
@@ -698,8 +806,23 @@ int ECSimDomain::control()
 int ECSimDomain::acquire()
 {
     // get nodal reactions if forces need to be acquired
-    if ((*sizeDaq)(OF_Resp_Force) != 0)
-        theDomain->calculateNodalReactions(true);
+    if ((*sizeDaq)(OF_Resp_Force) != 0)  {
+        // the analysis applied the loads at the current time already,
+        // so they only need to be applied again if the time changed
+        if (theDomain->getCurrentTime() != loadTime)  {
+            loadTime = theDomain->getCurrentTime();
+            theDomain->applyLoad(loadTime);
+        }
+        
+        // only the reactions of the output nodes are needed, so only
+        // the elements connected to them are visited (the reactions
+        // of the other nodes of these elements are incomplete)
+        int i;
+        for (i=0; i<numOutCPs; i++)
+            theNodes[i]->resetReactionForce(true);
+        for (i=0; i<numElements; i++)
+            theElements[i]->addResistingForceToNodalReaction(true);
+    }
     
     // loop through all the output control points
     int iSP = 0;
@@ -32,7 +32,9 @@
 //
 // Description: This file contains the class definition for ECSimDomain.
 // ECSimDomain is a controller class for simulating the behavior of a
-// specimen using the OpenSees domain.
+// specimen using the OpenSees domain. The reactions of the output
+// control points are only assembled from the elements connected to
+// their nodes, which are collected once at setup.
 
 #include "ECSimulation.h"
 
@@ -52,6 +54,7 @@ class TimeSeries;
 class LoadPattern;
 class SP_Constraint;
 class Node;
+class Element;
 
 class ECSimDomain : public ECSimulation
 {
@@ -122,11 +125,16 @@ private:
     LoadPattern   *thePattern;
     SP_Constraint **theSPs;
     Node          **theNodes;
+    Element       **theElements;    // elements connected to the output nodes
     
-    int numSPs;     // total number of SP constraints
+    int numSPs;         // total number of SP constraints
+    int numElements;    // number of elements connected to the output nodes
+    double loadTime;    // domain time at which the loads were applied
     
     double *ctrlDisp, *ctrlVel, *ctrlAccel, *ctrlForce;
     double *daqDisp, *daqVel, *daqAccel, *daqForce;
+    int *fbIndex;       // daq displacement measuring each ctrl displacement
+    double *fbDisp;     // daq displacements in the order of the ctrl ones
 };
 
 #endif
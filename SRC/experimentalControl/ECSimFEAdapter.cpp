@@ -353,6 +353,8 @@ int ECSimFEAdapter::getDaqResponse(
 {
     // get daq signal array from controller/daq
     int rValue = this->acquire();
+    this->setCtrlFilterFeedback(numTrialCPs, trialCPs,
+        numOutCPs, outCPs, &(*daqSignal)(0));
     
     // loop through all the output control points
     int k = 0;
@@ -422,7 +424,7 @@ Response* ECSimFEAdapter::setResponse(const char **argv, int argc,
             sprintf(outputData,"ctrlSignal%d",i+1);
             output.tag("ResponseType",outputData);
         }
-        theResponse = new ExpControlResponse(this, 1, *ctrlSignal);
+        theResponse = new ExpControlResponse(this, 1, &ctrlSignal);
     }
     
     // daq signals
@@ -435,7 +437,7 @@ Response* ECSimFEAdapter::setResponse(const char **argv, int argc,
             sprintf(outputData,"daqSignal%d",i+1);
             output.tag("ResponseType",outputData);
         }
-        theResponse = new ExpControlResponse(this, 2, *daqSignal);
+        theResponse = new ExpControlResponse(this, 2, &daqSignal);
     }
     output.endTag();
     
@@ -200,6 +200,7 @@ int ECSimSimulink::setup()
     
     // print experimental control information
     this->Print(opserr);
+    this->startInitPhase("confirm");
     
     opserr << "****************************************************************\n";
     opserr << "* Make sure that offset values of controller are set to ZERO   *\n";
@@ -207,13 +208,13 @@ int ECSimSimulink::setup()
     opserr << "* Press 'Enter' to proceed or 'c' to cancel the initialization *\n";
     opserr << "****************************************************************\n";
     opserr << endln;
-    int c = getchar();
+    int c = this->getInitKey();
     if (c == 'c')  {
-        getchar();
         this->~ECSimSimulink();
         exit(OF_ReturnType_failed);
     }
     
+    this->startInitPhase("measure");
     do  {
         rValue += this->control();
         rValue += this->acquire();
@@ -236,16 +237,15 @@ int ECSimSimulink::setup()
         opserr << "* 'c' to cancel the initialization\n";
         opserr << "****************************************************************\n";
         opserr << endln;
-        c = getchar();
+        c = this->getInitKey(maxAbs(daqDisp), maxAbs(daqForce));
         if (c == 'c')  {
-            getchar();
             this->~ECSimSimulink();
             exit(OF_ReturnType_failed);
-        } else if (c == 'r')  {
-            getchar();
         }
     } while (c == 'r');
     
+    this->startInitPhase(0);
+    
     opserr << "*****************\n";
     opserr << "* Running...... *\n";
     opserr << "*****************\n";
@@ -320,6 +320,8 @@ int ECSimSimulink::getDaqResponse(Vector* disp,
     Vector* time)
 {
     this->acquire();
+    if (daqDisp != 0)
+        this->setCtrlFilterFeedback(*daqDisp);
     
     int i;
     if (disp != 0)  {
@@ -384,7 +386,7 @@ Response* ECSimSimulink::setResponse(const char **argv, int argc,
             sprintf(outputData,"ctrlDisp%d",i+1);
             output.tag("ResponseType",outputData);
         }
-        theResponse = new ExpControlResponse(this, 1, *ctrlDisp);
+        theResponse = new ExpControlResponse(this, 1, &ctrlDisp);
     }
     
     // ctrl forces
@@ -396,7 +398,7 @@ Response* ECSimSimulink::setResponse(const char **argv, int argc,
             sprintf(outputData,"ctrlForce%d",i+1);
             output.tag("ResponseType",outputData);
         }
-        theResponse = new ExpControlResponse(this, 2, *ctrlForce);
+        theResponse = new ExpControlResponse(this, 2, &ctrlForce);
     }
     
     // ctrl time
@@ -408,7 +410,7 @@ Response* ECSimSimulink::setResponse(const char **argv, int argc,
             sprintf(outputData,"ctrlTime%d",i+1);
             output.tag("ResponseType",outputData);
         }
-        theResponse = new ExpControlResponse(this, 3, *ctrlTime);
+        theResponse = new ExpControlResponse(this, 3, &ctrlTime);
     }
     
     // daq displacements
@@ -421,7 +423,7 @@ Response* ECSimSimulink::setResponse(const char **argv, int argc,
             sprintf(outputData,"daqDisp%d",i+1);
             output.tag("ResponseType",outputData);
         }
-        theResponse = new ExpControlResponse(this, 4, *daqDisp);
+        theResponse = new ExpControlResponse(this, 4, &daqDisp);
     }
     
     // daq forces
@@ -433,7 +435,7 @@ Response* ECSimSimulink::setResponse(const char **argv, int argc,
             sprintf(outputData,"daqForce%d",i+1);
             output.tag("ResponseType",outputData);
         }
-        theResponse = new ExpControlResponse(this, 5, *daqForce);
+        theResponse = new ExpControlResponse(this, 5, &daqForce);
     }
     
     // daq time
@@ -445,7 +447,7 @@ Response* ECSimSimulink::setResponse(const char **argv, int argc,
             sprintf(outputData,"daqTime%d",i+1);
             output.tag("ResponseType",outputData);
         }
-        theResponse = new ExpControlResponse(this, 6, *daqTime);
+        theResponse = new ExpControlResponse(this, 6, &daqTime);
     }
     
     output.endTag();
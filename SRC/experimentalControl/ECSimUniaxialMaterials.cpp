@@ -174,6 +174,8 @@ int ECSimUniaxialMaterials::setup()
     
     rValue += this->control();
     rValue += this->acquire();
+    if (daqDisp != 0)
+        this->setCtrlFilterFeedback(*daqDisp);
     
     return rValue;
 }
@@ -245,6 +247,8 @@ int ECSimUniaxialMaterials::getDaqResponse(Vector* disp,
     Vector* time)
 {
     this->acquire();
+    if (daqDisp != 0)
+        this->setCtrlFilterFeedback(*daqDisp);
     
     int i;
     if (disp != 0)  {
@@ -312,7 +316,7 @@ Response* ECSimUniaxialMaterials::setResponse(const char **argv, int argc,
             sprintf(outputData,"ctrlDisp%d",i+1);
             output.tag("ResponseType",outputData);
         }
-        theResponse = new ExpControlResponse(this, 1, *ctrlDisp);
+        theResponse = new ExpControlResponse(this, 1, &ctrlDisp);
     }
     
     // ctrl velocities
@@ -325,7 +329,7 @@ Response* ECSimUniaxialMaterials::setResponse(const char **argv, int argc,
             sprintf(outputData,"ctrlVel%d",i+1);
             output.tag("ResponseType",outputData);
         }
-        theResponse = new ExpControlResponse(this, 2, *ctrlVel);
+        theResponse = new ExpControlResponse(this, 2, &ctrlVel);
     }
     
     // daq displacements
@@ -338,7 +342,7 @@ Response* ECSimUniaxialMaterials::setResponse(const char **argv, int argc,
             sprintf(outputData,"daqDisp%d",i+1);
             output.tag("ResponseType",outputData);
         }
-        theResponse = new ExpControlResponse(this, 3, *daqDisp);
+        theResponse = new ExpControlResponse(this, 3, &daqDisp);
     }
     
     // daq velocities
@@ -351,7 +355,7 @@ Response* ECSimUniaxialMaterials::setResponse(const char **argv, int argc,
             sprintf(outputData,"daqVel%d",i+1);
             output.tag("ResponseType",outputData);
         }
-        theResponse = new ExpControlResponse(this, 4, *daqVel);
+        theResponse = new ExpControlResponse(this, 4, &daqVel);
     }
     
     // daq forces
@@ -363,7 +367,7 @@ Response* ECSimUniaxialMaterials::setResponse(const char **argv, int argc,
             sprintf(outputData,"daqForce%d",i+1);
             output.tag("ResponseType",outputData);
         }
-        theResponse = new ExpControlResponse(this, 5, *daqForce);
+        theResponse = new ExpControlResponse(this, 5, &daqForce);
     }
     
     output.endTag();
@@ -428,8 +432,12 @@ int ECSimUniaxialMaterials::control()
 {
     int rValue = 0;
     
+    // the commands are kept, only the simulated actuators lag behind
+    Vector disp(*ctrlDisp);
+    this->actuate(&disp(0), numMats);
+    
     for (int i=0; i<numMats; i++)  {
-        rValue += theSpecimen[i]->setTrialStrain((*ctrlDisp)(i),(*ctrlVel)(i));
+        rValue += theSpecimen[i]->setTrialStrain(disp(i),(*ctrlVel)(i));
     }
     
     return rValue;
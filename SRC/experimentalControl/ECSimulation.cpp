@@ -32,16 +32,21 @@
 
 #include "ECSimulation.h"
 
+#include <math.h>
+
 
 ECSimulation::ECSimulation(int tag)
-    : ExperimentalControl(tag)
+    : ExperimentalControl(tag),
+    actDelay(0.0), actDt(0.0), actNumSig(0), actNumHist(0), actHist(0)
 {
     // does nothing
 }
 
 
 ECSimulation::ECSimulation(const ECSimulation& ec)
-    : ExperimentalControl(ec)
+    : ExperimentalControl(ec),
+    actDelay(ec.actDelay), actDt(ec.actDt),
+    actNumSig(0), actNumHist(0), actHist(0)
 {
     // does nothing
 }
@@ -49,5 +54,58 @@ ECSimulation::ECSimulation(const ECSimulation& ec)
 
 ECSimulation::~ECSimulation()
 {
-    // does nothing
+    if (actHist != 0)
+        delete [] actHist;
+}
+
+
+void ECSimulation::setActuatorDelay(double delay, double dt)
+{
+    if (delay < 0.0 || (delay > 0.0 && dt <= 0.0))  {
+        opserr << "ECSimulation::setActuatorDelay() - "
+            << "delay must not be negative and dt must be positive\n";
+        return;
+    }
+    actDelay = delay;
+    actDt = dt;
+    
+    // the history is started again with the next command
+    if (actHist != 0)
+        delete [] actHist;
+    actHist = 0;
+    actNumSig = 0;
+}
+
+
+void ECSimulation::actuate(double *disp, int size)
+{
+    if (actDelay <= 0.0 || size < 1)
+        return;
+    
+    int i, j;
+    double s = actDelay/actDt;
+    int m = (int)floor(s);
+    double f = s - m;
+    
+    // the history starts at rest at the first command
+    if (actHist == 0 || actNumSig != size)  {
+        if (actHist != 0)
+            delete [] actHist;
+        actNumSig = size;
+        actNumHist = m + 2;
+        actHist = new double [actNumSig*actNumHist];
+        for (i=0; i<actNumSig; i++)
+            for (j=0; j<actNumHist; j++)
+                actHist[i*actNumHist+j] = disp[i];
+    }
+    
+    // the actuators reach the command that was
+    // sent delay ago by linear interpolation
+    for (i=0; i<actNumSig; i++)  {
+        double *h = &actHist[i*actNumHist];
+        for (j=actNumHist-1; j>0; j--)
+            h[j] = h[j-1];
+        h[0] = disp[i];
+        disp[i] = (1.0 - f)*h[m] + f*h[m+1];
+    }
 }
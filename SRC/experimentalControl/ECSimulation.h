@@ -64,11 +64,25 @@ public:
         Vector* time) = 0;
     
     virtual ExperimentalControl *getCopy() = 0;
+    
+    // method to simulate actuators that lag behind the commands
+    // by delay, the commands are sent every dt (0 = no delay)
+    void setActuatorDelay(double delay, double dt);
 
 protected:
     // protected methods to set and to get response
     virtual int control() = 0;
     virtual int acquire() = 0;
+    
+    // method to delay the commanded displacements in place
+    void actuate(double *disp, int size);
+
+private:
+    double actDelay;    // delay of the simulated actuators
+    double actDt;       // time between two commands
+    int actNumSig;      // number of delayed signals
+    int actNumHist;     // number of commands in the history
+    double *actHist;    // last commands of each signal, newest first
 };
 
 #endif
@@ -35,6 +35,7 @@
 // digital signal processor.
 
 #include "ExperimentalControl.h"
+#include <ExpCPLimits.h>
 
 #include <clib32.h>
 
@@ -104,6 +105,7 @@ private:
     unsigned int newTarget, switchPC, atTarget;
     int numCtrlSignals, numDaqSignals;
     double *ctrlSignal, *daqSignal;
+    ExpCPLimits ctrlLimits;
     
     UInt32 simStateId;
     UInt32 newTargetId, switchPCId, atTargetId;
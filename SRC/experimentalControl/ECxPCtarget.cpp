@@ -296,6 +296,13 @@ int ECxPCtarget::setup()
     for (int i=0; i<numCtrlSignals; i++)
         ctrlSignal[i] = 0.0;
     
+    // compile the limits of the trial control points
+    if (ctrlLimits.setup(numTrialCPs, trialCPs) != 0)  {
+        xPCClosePort(port);
+        xPCFreeAPI();
+        exit(OF_ReturnType_failed);
+    }
+    
     // create daq signal array
     daqSignal = new double [numDaqSignals];
     daqSignalId = new int [numDaqSignals];
@@ -387,6 +394,7 @@ int ECxPCtarget::setup()
     
     // print experimental control information
     this->Print(opserr);
+    this->startInitPhase("confirm");
     
     opserr << "****************************************************************\n";
     opserr << "* Make sure that offset values of controller are set to ZERO   *\n";
@@ -394,9 +402,8 @@ int ECxPCtarget::setup()
     opserr << "* Press 'Enter' to proceed or 'c' to cancel the initialization *\n";
     opserr << "****************************************************************\n";
     opserr << endln;
-    int c = getchar();
+    int c = this->getInitKey();
     if (c == 'c')  {
-        getchar();
         xPCClosePort(port);
         xPCFreeAPI();
         exit(OF_ReturnType_failed);
@@ -414,6 +421,7 @@ int ECxPCtarget::setup()
     }
     this->ExperimentalControl::sleep(1000);
     
+    this->startInitPhase("measure");
     do  {
         rValue += this->control();
         rValue += this->acquire();
@@ -430,18 +438,17 @@ int ECxPCtarget::setup()
         opserr << "* 'c' to cancel the initialization\n";
         opserr << "****************************************************************\n";
         opserr << endln;
-        c = getchar();
+        c = this->getInitKey(maxAbs(daqSignal, numDaqSignals), 0.0);
         if (c == 'c')  {
-            getchar();
             xPCStopApp(port);
             xPCClosePort(port);
             xPCFreeAPI();
             exit(OF_ReturnType_failed);
-        } else if (c == 'r')  {
-            getchar();
         }
     } while (c == 'r');
     
+    this->startInitPhase(0);
+    
     opserr << "*****************\n";
     opserr << "* Running...... *\n";
     opserr << "*****************\n";
@@ -539,7 +546,23 @@ int ECxPCtarget::setTrialResponse(
             else if (rsp(j) == OF_Resp_Accel  &&  accel != 0)  {
                 ctrlSignal[k] = (*accel)(dof(j));
             }
-            // filter control signal if the filter exists
+            k++;
+        }
+    }
+    
+    // saturate the control signals at the limits of the
+    // control points in one pass over the whole array
+    if (ctrlLimits.isActive())  {
+        ctrlLimits.saturate(ctrlSignal);
+        ctrlLimits.commit(ctrlSignal);
+    }
+    
+    // filter control signals if the filters exist
+    k = 0;
+    for (int i=0; i<numTrialCPs; i++)  {
+        int numSignals = trialCPs[i]->getNumSignal();
+        ID rsp = trialCPs[i]->getRspType();
+        for (int j=0; j<numSignals; j++)  {
             if (theCtrlFilters[rsp(j)] != 0)
                 ctrlSignal[k] = theCtrlFilters[rsp(j)]->filtering(ctrlSignal[k]);
             k++;
@@ -562,6 +585,8 @@ int ECxPCtarget::getDaqResponse(
 {
     // get daq signal array from controller/daq
     int rValue = this->acquire();
+    this->setCtrlFilterFeedback(numTrialCPs, trialCPs,
+        numOutCPs, outCPs, daqSignal);
     
     // loop through all the output control points
     int k = 0;
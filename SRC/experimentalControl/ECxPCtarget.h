@@ -35,6 +35,7 @@
 // digital signal processor.
 
 #include "ExperimentalControl.h"
+#include <ExpCPLimits.h>
 
 class ExperimentalCP;
 
@@ -109,6 +110,7 @@ private:
     Vector ctrlSigOffset, daqSigOffset;      // signal offsets (i.e. setpoints)
     Vector trialSigOffset;                   // trial signal offsets
     int useRelativeTrial, gotRelativeTrial;  // relative trial signal flags
+    ExpCPLimits ctrlLimits;                  // limits of the trial signals
     
     int newTargetId, switchPCId, atTargetId;
     int ctrlSignalId;
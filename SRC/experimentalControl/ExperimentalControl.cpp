@@ -35,11 +35,37 @@
 
 #include "ExperimentalControl.h"
 
+#include <ExpCheckpoint.h>
+#include <ExperimentalCP.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+#include <math.h>
+
+
+static double getTime()
+{
+#ifdef _WIN32
+    LARGE_INTEGER freq, count;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&count);
+    return (double)count.QuadPart/(double)freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + 1.0E-9*ts.tv_nsec;
+#endif
+}
+
 
 ExperimentalControl::ExperimentalControl(int tag)
     : TaggedObject(tag),
     sizeCtrl(0), sizeDaq(0),
-    theCtrlFilters(0), theDaqFilters(0)
+    theCtrlFilters(0), theDaqFilters(0),
+    batchInit(false), initDispTol(-1.0), initForceTol(-1.0),
+    initNumTries(1), initTry(0), initPhase(0),
+    initPhaseStart(0.0), initStart(0.0)
 {
     sizeCtrl = new ID(OF_Resp_All);
     sizeDaq = new ID(OF_Resp_All);
@@ -73,7 +99,10 @@ ExperimentalControl::ExperimentalControl(int tag)
 ExperimentalControl::ExperimentalControl(const ExperimentalControl& ec) 
     : TaggedObject(ec), 
     sizeCtrl(0), sizeDaq(0),
-    theCtrlFilters(0), theDaqFilters(0)
+    theCtrlFilters(0), theDaqFilters(0),
+    batchInit(ec.batchInit), initDispTol(ec.initDispTol),
+    initForceTol(ec.initForceTol), initNumTries(ec.initNumTries),
+    initTry(0), initPhase(0), initPhaseStart(0.0), initStart(0.0)
 {
     sizeCtrl = new ID(OF_Resp_All);
     sizeDaq = new ID(OF_Resp_All);
@@ -160,6 +189,48 @@ int ExperimentalControl::getResponse(int responseID, Information &info)
 }
 
 
+int ExperimentalControl::saveState(ExpCheckpoint &theCheckpoint)
+{
+    // the specimen itself cannot be saved, so only the states of
+    // the signal filters are written, controls with a history of
+    // their own need to add it in their subclass
+    theCheckpoint.beginObject(this->getClassType(), this->getTag());
+    for (int i=0; i<OF_Resp_All; i++)  {
+        if (theCtrlFilters[i] != 0)
+            theCtrlFilters[i]->saveState(theCheckpoint);
+        if (theDaqFilters[i] != 0)
+            theDaqFilters[i]->saveState(theCheckpoint);
+    }
+    
+    return theCheckpoint.save(0);
+}
+
+
+int ExperimentalControl::restoreState(ExpCheckpoint &theCheckpoint)
+{
+    int end = -1;
+    
+    if (theCheckpoint.checkObject(this->getClassType(), this->getTag()) < 0)
+        return OF_ReturnType_failed;
+    for (int i=0; i<OF_Resp_All; i++)  {
+        if (theCtrlFilters[i] != 0)
+            theCtrlFilters[i]->restoreState(theCheckpoint);
+        if (theDaqFilters[i] != 0)
+            theDaqFilters[i]->restoreState(theCheckpoint);
+    }
+    
+    // the end marker catches filters that read too much or too little
+    if (theCheckpoint.restore(end) < 0 || end != 0)  {
+        opserr << "ExperimentalControl::restoreState() - "
+            << "signal filter states of control " << this->getTag()
+            << " do not match checkpoint\n";
+        return OF_ReturnType_failed;
+    }
+    
+    return OF_ReturnType_completed;
+}
+
+
 void ExperimentalControl::setCtrlFilter(ExperimentalSignalFilter* theFilter,
     int respType)
 {
@@ -216,9 +287,167 @@ const ID& ExperimentalControl::getSizeDaq()
 }
 
 
+void ExperimentalControl::setBatchInit(double dispTol, double forceTol,
+    int numTries)
+{
+    batchInit = true;
+    initDispTol = dispTol;
+    initForceTol = forceTol;
+    initNumTries = (numTries > 0) ? numTries : 1;
+}
+
+
+void ExperimentalControl::setCtrlFilterFeedback(const Vector &daqDisp)
+{
+    // the filter checks that the measured displacements
+    // correspond one to one to the commanded displacements
+    if (theCtrlFilters[OF_Resp_Disp] != 0)
+        theCtrlFilters[OF_Resp_Disp]->setFeedback(daqDisp);
+}
+
+
+void ExperimentalControl::setCtrlFilterFeedback(int numTrialCPs,
+    ExperimentalCP **trialCPs, int numOutCPs, ExperimentalCP **outCPs,
+    const double *daqSignal, const Vector *daqSigOffset)
+{
+    if (theCtrlFilters[OF_Resp_Disp] == 0)
+        return;
+    
+    // collect the measured displacements by dof
+    Vector daqDisp((*sizeDaq)(OF_Resp_Disp));
+    int i, j, k = 0;
+    for (i=0; i<numOutCPs; i++)  {
+        int numSignals = outCPs[i]->getNumSignal();
+        const ID &dof = outCPs[i]->getDOF();
+        const ID &rsp = outCPs[i]->getRspType();
+        for (j=0; j<numSignals; j++, k++)  {
+            if (rsp(j) == OF_Resp_Disp)  {
+                daqDisp(dof(j)) = daqSignal[k];
+                if (daqSigOffset != 0)
+                    daqDisp(dof(j)) += (*daqSigOffset)(k);
+            }
+        }
+    }
+    if (daqDisp.Size() != (*sizeCtrl)(OF_Resp_Disp))  {
+        theCtrlFilters[OF_Resp_Disp]->setFeedback(daqDisp);
+        return;
+    }
+    
+    // the ctrl displacement signals are filtered in
+    // the order of the trial control points
+    Vector fbDisp((*sizeCtrl)(OF_Resp_Disp));
+    k = 0;
+    for (i=0; i<numTrialCPs; i++)  {
+        int numSignals = trialCPs[i]->getNumSignal();
+        const ID &dof = trialCPs[i]->getDOF();
+        const ID &rsp = trialCPs[i]->getRspType();
+        for (j=0; j<numSignals && k<fbDisp.Size(); j++)  {
+            if (rsp(j) == OF_Resp_Disp)
+                fbDisp(k++) = daqDisp(dof(j));
+        }
+    }
+    theCtrlFilters[OF_Resp_Disp]->setFeedback(fbDisp);
+}
+
+
 void ExperimentalControl::sleep(const clock_t wait)
 {
     clock_t goal;
     goal = wait + clock();
     while (goal>clock());
 }
+
+
+int ExperimentalControl::getInitKey()
+{
+    initTry = 0;
+    if (batchInit)  {
+        opserr << "* Batch initialization: proceeding\n\n";
+        return '\n';
+    }
+    
+    int c = getchar();
+    if (c == 'c' || c == 'r')
+        getchar();
+    
+    return c;
+}
+
+
+int ExperimentalControl::getInitKey(double maxDisp, double maxForce)
+{
+    if (!batchInit)
+        return this->getInitKey();
+    
+    initTry++;
+    if ((initDispTol < 0.0 || maxDisp <= initDispTol) &&
+        (initForceTol < 0.0 || maxForce <= initForceTol))  {
+        opserr << "* Batch initialization: initial values of DAQ accepted\n\n";
+        return '\n';
+    }
+    
+    opserr << "* Batch initialization: max |dspDaq| = " << maxDisp
+        << " (tol = " << initDispTol << "), max |frcDaq| = " << maxForce
+        << " (tol = " << initForceTol << ")\n";
+    if (initTry < initNumTries)  {
+        opserr << "* repeating measurement " << initTry+1
+            << " of " << initNumTries << "\n\n";
+        return 'r';
+    }
+    
+    opserr << "ExperimentalControl::getInitKey() - "
+        << "initial values of DAQ not accepted after "
+        << initNumTries << " measurements, cancelling\n";
+    return 'c';
+}
+
+
+double ExperimentalControl::maxAbs(const Vector *data)
+{
+    double max = 0.0;
+    if (data != 0)  {
+        for (int i=0; i<data->Size(); i++)
+            if (fabs((*data)(i)) > max)
+                max = fabs((*data)(i));
+    }
+    return max;
+}
+
+
+double ExperimentalControl::maxAbs(const double *data, int size)
+{
+    double max = 0.0;
+    for (int i=0; i<size; i++)
+        if (fabs(data[i]) > max)
+            max = fabs(data[i]);
+    return max;
+}
+
+
+double ExperimentalControl::maxAbs(const float *data, int size)
+{
+    double max = 0.0;
+    for (int i=0; i<size; i++)
+        if (fabs(data[i]) > max)
+            max = fabs(data[i]);
+    return max;
+}
+
+
+void ExperimentalControl::startInitPhase(const char *name)
+{
+    double t = getTime();
+    
+    if (initPhase != 0)  {
+        opserr << "* Setup phase '" << initPhase << "' took "
+            << 1.0E3*(t - initPhaseStart) << " ms\n";
+    } else  {
+        initStart = t;
+    }
+    if (name == 0 && initPhase != 0)  {
+        opserr << "* Setup took " << 1.0E3*(t - initStart) << " ms\n\n";
+    }
+    
+    initPhase = name;
+    initPhaseStart = t;
+}
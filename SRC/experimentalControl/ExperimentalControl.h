@@ -47,6 +47,8 @@
 #include <time.h>
 
 class Response;
+class ExpCheckpoint;
+class ExperimentalCP;
 
 class ExperimentalControl : public TaggedObject
 {
@@ -85,6 +87,10 @@ public:
         OPS_Stream &output);
     virtual int getResponse(int responseID, Information &info);
     
+    // public methods to save and restore the state for a checkpoint
+    virtual int saveState(ExpCheckpoint &theCheckpoint);
+    virtual int restoreState(ExpCheckpoint &theCheckpoint);
+    
     // public methods to set experimental signal filters
     void setCtrlFilter(ExperimentalSignalFilter* theFilter,
         int respType);
@@ -94,14 +100,44 @@ public:
     const ID& getSizeCtrl();
     const ID& getSizeDaq();
     
+    // public method to set the batch initialization mode, in which
+    // setup does not wait for the user but accepts the initial daq
+    // values once they are within the tolerances (negative = no check)
+    // and cancels after numTries measurements otherwise
+    void setBatchInit(double dispTol = -1.0, double forceTol = -1.0,
+        int numTries = 1);
+    
 protected:
     // protected methods to set and to get response
     virtual int control() = 0;
     virtual int acquire() = 0;
     
+    // method to pass the measured displacements, ordered like the
+    // ctrl displacements, to the ctrl displacement filter after each
+    // acquire, so that it can adapt to the specimen
+    void setCtrlFilterFeedback(const Vector &daqDisp);
+    // same for controls that send and acquire the signals
+    // of the control points, including the daq signal offsets
+    void setCtrlFilterFeedback(int numTrialCPs, ExperimentalCP **trialCPs,
+        int numOutCPs, ExperimentalCP **outCPs, const double *daqSignal,
+        const Vector *daqSigOffset = 0);
+    
     // method to pause for wait msec
     void sleep(const clock_t wait);
     
+    // methods to get the key that proceeds ('\n'), repeats ('r') or
+    // cancels ('c') the initialization in setup, the second one is used
+    // after the initial daq values have been measured
+    int getInitKey();
+    int getInitKey(double maxDisp, double maxForce);
+    static double maxAbs(const Vector *data);
+    static double maxAbs(const double *data, int size);
+    static double maxAbs(const float *data, int size);
+    
+    // method to time the phases of setup, a null name ends the last
+    // phase and prints the total time
+    void startInitPhase(const char *name);
+    
     // size of ctrl/daq data
     // sizeCtrl/Daq[0]:disp, [1]:vel, [2]:accel, [3]:force, [4]:time
     ID *sizeCtrl;
@@ -110,6 +146,13 @@ protected:
     // experimental signal filters
     ExperimentalSignalFilter **theCtrlFilters;
     ExperimentalSignalFilter **theDaqFilters;
+    
+    // batch initialization
+    bool batchInit;
+    double initDispTol, initForceTol;
+    int initNumTries, initTry;
+    const char *initPhase;
+    double initPhaseStart, initStart;
 };
 
 #endif
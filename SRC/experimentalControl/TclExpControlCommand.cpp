@@ -42,6 +42,9 @@
 #include <ECSimFEAdapter.h>
 #include <ECSimSimulink.h>
 #include <ECGenericTCP.h>
+#include <ECPredictorCorrector.h>
+#include <ECAggregator.h>
+#include <ChannelOptions.h>
 
 #ifndef _WIN64
 #include <ECMtsCsi.h>
@@ -145,6 +148,7 @@ int TclExpControlCommand(ClientData clientData, Tcl_Interp *interp,
             opserr << "WARNING invalid number of arguments\n";
             printCommand(argc,argv);
             opserr << "Want: expControl SimUniaxialMaterials tag matTags "
+                << "<-actuatorDelay delay dt> "
                 << "<-ctrlFilters (5 filterTag)> <-daqFilters (5 filterTag)>\n";
             return TCL_ERROR;
         }
@@ -159,6 +163,7 @@ int TclExpControlCommand(ClientData clientData, Tcl_Interp *interp,
         argi++;
         // now read the number of materials
         while (argi+numMats < argc &&
+            strcmp(argv[argi+numMats],"-actuatorDelay") != 0 &&
             strcmp(argv[argi+numMats],"-ctrlFilters") != 0 &&
             strcmp(argv[argi+numMats],"-daqFilters") != 0)  {
                 numMats++;
@@ -267,6 +272,7 @@ int TclExpControlCommand(ClientData clientData, Tcl_Interp *interp,
             opserr << "WARNING invalid number of arguments\n";
             printCommand(argc,argv);
             opserr << "Want: expControl SimDomain tag -trialCP cpTags -outCP cpTags "
+                << "<-actuatorDelay delay dt> "
                 << "<-ctrlFilters (5 filterTag)> <-daqFilters (5 filterTag)>\n";
             return TCL_ERROR;
         }
@@ -325,6 +331,7 @@ int TclExpControlCommand(ClientData clientData, Tcl_Interp *interp,
         }
         argi++;
         while (argi+numOutCPs < argc &&
+            strcmp(argv[argi+numOutCPs],"-actuatorDelay") != 0 &&
             strcmp(argv[argi+numOutCPs],"-ctrlFilters") != 0 &&
             strcmp(argv[argi+numOutCPs],"-daqFilters") != 0)  {
                 numOutCPs++;
@@ -528,15 +535,16 @@ int TclExpControlCommand(ClientData clientData, Tcl_Interp *interp,
             opserr << "WARNING invalid number of arguments\n";
             printCommand(argc,argv);
             opserr << "Want: expControl GenericTCP tag ipAddr ipPort -ctrlModes (5 mode) -daqModes (5 mode) "
-                << "<-initFile fileName> <-ssl> <-udp> <-ctrlFilters (5 filterTag)> <-daqFilters (5 filterTag)>\n";
+                << "<-initFile fileName> <-bulkInit> <-ssl> <-udp> <channelOptions> <-ctrlFilters (5 filterTag)> <-daqFilters (5 filterTag)>\n";
             return TCL_ERROR;
         }
         
         char *ipAddr;
-        int i, ipPort, mode;
+        int i, ipPort, mode, numArgs;
         ID ctrlModes(5), daqModes(5);
         char *initFileName = 0;
-        int ssl = 0, udp = 0;
+        int ssl = 0, udp = 0, bulkInit = 0;
+        ChannelOptions theOptions;
         
         argi = 2;
         if (Tcl_GetInt(interp, argv[argi], &tag) != TCL_OK)  {
@@ -594,11 +602,218 @@ int TclExpControlCommand(ClientData clientData, Tcl_Interp *interp,
                 ssl = 1;
             else if (strcmp(argv[i], "-udp") == 0)
                 udp = 1;
+            else if (strcmp(argv[i], "-bulkInit") == 0)
+                bulkInit = 1;
+            else if ((numArgs = theOptions.parse(argc-i, &argv[i])) != 0)  {
+                if (numArgs < 0)  {
+                    opserr << "WARNING invalid channel option\n";
+                    opserr << "expControl GenericTCP " << tag << endln;
+                    return TCL_ERROR;
+                }
+                i += numArgs-1;
+            }
         }
         
         // parsing was successful, allocate the control
         theControl = new ECGenericTCP(tag, ipAddr, ipPort,
-            ctrlModes, daqModes, initFileName, ssl, udp);
+            ctrlModes, daqModes, initFileName, ssl, udp, &theOptions, bulkInit);
+    }
+    
+    // ----------------------------------------------------------------------------	
+    else if (strcmp(argv[1],"PredictorCorrector") == 0)  {
+        if (argc < 6)  {
+            opserr << "WARNING invalid number of arguments\n";
+            printCommand(argc,argv);
+            opserr << "Want: expControl PredictorCorrector tag ctrlTag dtCon dtSim "
+                << "<-order n> <-priority p> <-cpu c> <-actuatorLag tau> "
+                << "<-ctrlFilters (5 filterTag)> <-daqFilters (5 filterTag)>\n";
+            return TCL_ERROR;
+        }
+        
+        int i, ctrlTag, order = 2, priority = -1, cpu = -1;
+        double dtCon, dtSim, actLag = 0.0;
+        ExperimentalControl *theInnerControl = 0;
+        
+        argi = 2;
+        if (Tcl_GetInt(interp, argv[argi], &tag) != TCL_OK)  {
+            opserr << "WARNING invalid expControl PredictorCorrector tag\n";
+            return TCL_ERROR;
+        }
+        argi++;
+        if (Tcl_GetInt(interp, argv[argi], &ctrlTag) != TCL_OK)  {
+            opserr << "WARNING invalid ctrlTag\n";
+            opserr << "expControl PredictorCorrector " << tag << endln;
+            return TCL_ERROR;
+        }
+        theInnerControl = getExperimentalControl(ctrlTag);
+        if (theInnerControl == 0)  {
+            opserr << "WARNING experimental control not found\n";
+            opserr << "expControl: " << ctrlTag << endln;
+            opserr << "expControl PredictorCorrector " << tag << endln;
+            return TCL_ERROR;
+        }
+        argi++;
+        if (Tcl_GetDouble(interp, argv[argi], &dtCon) != TCL_OK || dtCon <= 0.0)  {
+            opserr << "WARNING invalid dtCon\n";
+            opserr << "expControl PredictorCorrector " << tag << endln;
+            return TCL_ERROR;
+        }
+        argi++;
+        if (Tcl_GetDouble(interp, argv[argi], &dtSim) != TCL_OK || dtSim < dtCon)  {
+            opserr << "WARNING invalid dtSim\n";
+            opserr << "expControl PredictorCorrector " << tag << endln;
+            return TCL_ERROR;
+        }
+        argi++;
+        for (i=argi; i<argc; i++)  {
+            if (i+1 < argc && strcmp(argv[i], "-order") == 0)  {
+                if (Tcl_GetInt(interp, argv[i+1], &order) != TCL_OK ||
+                    order < 1 || order > 3)  {
+                    opserr << "WARNING invalid order, want 1, 2 or 3\n";
+                    opserr << "expControl PredictorCorrector " << tag << endln;
+                    return TCL_ERROR;
+                }
+            }
+            else if (i+1 < argc && strcmp(argv[i], "-priority") == 0)  {
+                if (Tcl_GetInt(interp, argv[i+1], &priority) != TCL_OK)  {
+                    opserr << "WARNING invalid priority\n";
+                    opserr << "expControl PredictorCorrector " << tag << endln;
+                    return TCL_ERROR;
+                }
+            }
+            else if (i+1 < argc && strcmp(argv[i], "-cpu") == 0)  {
+                if (Tcl_GetInt(interp, argv[i+1], &cpu) != TCL_OK)  {
+                    opserr << "WARNING invalid cpu\n";
+                    opserr << "expControl PredictorCorrector " << tag << endln;
+                    return TCL_ERROR;
+                }
+            }
+            else if (i+1 < argc && strcmp(argv[i], "-actuatorLag") == 0)  {
+                if (Tcl_GetDouble(interp, argv[i+1], &actLag) != TCL_OK || actLag < 0.0)  {
+                    opserr << "WARNING invalid actuatorLag\n";
+                    opserr << "expControl PredictorCorrector " << tag << endln;
+                    return TCL_ERROR;
+                }
+            }
+        }
+        
+        // parsing was successful, allocate the control
+        theControl = new ECPredictorCorrector(tag, theInnerControl->getCopy(),
+            dtCon, dtSim, order, priority, cpu, actLag);
+    }
+    
+    // ----------------------------------------------------------------------------	
+    else if (strcmp(argv[1],"Aggregator") == 0)  {
+        if (argc < 7)  {
+            opserr << "WARNING invalid number of arguments\n";
+            printCommand(argc,argv);
+            opserr << "Want: expControl Aggregator tag -control ctrlTag numCtrl numDaq "
+                << "<-control ctrlTag numCtrl numDaq ...> <-barrier daq|ctrl> "
+                << "<-timeout t> <-ctrlFilters (5 filterTag)> <-daqFilters (5 filterTag)>\n";
+            return TCL_ERROR;
+        }
+        
+        int i, ctrlTag, numControls = 0, barrier = 0;
+        double timeout = 0.0;
+        
+        argi = 2;
+        if (Tcl_GetInt(interp, argv[argi], &tag) != TCL_OK)  {
+            opserr << "WARNING invalid expControl Aggregator tag\n";
+            return TCL_ERROR;
+        }
+        argi++;
+        // count the controls
+        for (i=argi; i<argc; i++)  {
+            if (strcmp(argv[i], "-control") == 0)
+                numControls++;
+        }
+        if (numControls == 0)  {
+            opserr << "WARNING no controls specified\n";
+            opserr << "expControl Aggregator " << tag << endln;
+            return TCL_ERROR;
+        }
+        // create the arrays to hold the controls and sizes
+        ExperimentalControl **theControls = new ExperimentalControl* [numControls];
+        ID numCtrl(numControls), numDaq(numControls);
+        numControls = 0;
+        for (i=argi; i<argc; i++)  {
+            if (strcmp(argv[i], "-control") == 0)  {
+                if (i+3 >= argc ||
+                    Tcl_GetInt(interp, argv[i+1], &ctrlTag) != TCL_OK ||
+                    Tcl_GetInt(interp, argv[i+2], &numCtrl(numControls)) != TCL_OK ||
+                    Tcl_GetInt(interp, argv[i+3], &numDaq(numControls)) != TCL_OK ||
+                    numCtrl(numControls) < 0 || numDaq(numControls) < 0)  {
+                    opserr << "WARNING invalid -control ctrlTag numCtrl numDaq\n";
+                    opserr << "expControl Aggregator " << tag << endln;
+                    for (int j=0; j<numControls; j++)
+                        delete theControls[j];
+                    delete [] theControls;
+                    return TCL_ERROR;
+                }
+                ExperimentalControl *theInnerControl = getExperimentalControl(ctrlTag);
+                if (theInnerControl == 0)  {
+                    opserr << "WARNING experimental control not found\n";
+                    opserr << "expControl: " << ctrlTag << endln;
+                    opserr << "expControl Aggregator " << tag << endln;
+                    for (int j=0; j<numControls; j++)
+                        delete theControls[j];
+                    delete [] theControls;
+                    return TCL_ERROR;
+                }
+                theControls[numControls++] = theInnerControl->getCopy();
+                i += 3;
+            }
+            else if (i+1 < argc && strcmp(argv[i], "-barrier") == 0)  {
+                if (strcmp(argv[i+1], "daq") == 0)
+                    barrier = 0;
+                else if (strcmp(argv[i+1], "ctrl") == 0)
+                    barrier = 1;
+                else  {
+                    opserr << "WARNING invalid barrier, want daq or ctrl\n";
+                    opserr << "expControl Aggregator " << tag << endln;
+                    for (int j=0; j<numControls; j++)
+                        delete theControls[j];
+                    delete [] theControls;
+                    return TCL_ERROR;
+                }
+                i++;
+            }
+            else if (i+1 < argc && strcmp(argv[i], "-timeout") == 0)  {
+                if (Tcl_GetDouble(interp, argv[i+1], &timeout) != TCL_OK || timeout < 0.0)  {
+                    opserr << "WARNING invalid timeout\n";
+                    opserr << "expControl Aggregator " << tag << endln;
+                    for (int j=0; j<numControls; j++)
+                        delete theControls[j];
+                    delete [] theControls;
+                    return TCL_ERROR;
+                }
+                i++;
+            }
+            // skip the options common to all controls, they are read below
+            else if (i+5 < argc && (strcmp(argv[i], "-ctrlFilters") == 0 ||
+                strcmp(argv[i], "-daqFilters") == 0))
+                i += 5;
+            else if (i+2 < argc && (strcmp(argv[i], "-actuatorDelay") == 0 ||
+                strcmp(argv[i], "-initTol") == 0))
+                i += 2;
+            else if (i+1 < argc && strcmp(argv[i], "-initTries") == 0)
+                i++;
+            else if (strcmp(argv[i], "-batchInit") != 0)  {
+                opserr << "WARNING unknown option: " << argv[i] << endln;
+                opserr << "expControl Aggregator " << tag << endln;
+                for (int j=0; j<numControls; j++)
+                    delete theControls[j];
+                delete [] theControls;
+                return TCL_ERROR;
+            }
+        }
+        
+        // parsing was successful, allocate the control
+        theControl = new ECAggregator(tag, numControls, theControls,
+            numCtrl, numDaq, barrier, timeout);
+        
+        // cleanup dynamic memory, the aggregator owns the copies
+        delete [] theControls;
     }
     
 #ifndef _WIN64
@@ -1282,6 +1497,52 @@ int TclExpControlCommand(ClientData clientData, Tcl_Interp *interp,
         }
     }
     
+    // check for simulated actuators that lag behind the commands
+    for (i=argi; i<argc; i++)  {
+        if (i+2 < argc && strcmp(argv[i], "-actuatorDelay") == 0)  {
+            double delay, dt;
+            if (Tcl_GetDouble(interp, argv[i+1], &delay) != TCL_OK ||
+                Tcl_GetDouble(interp, argv[i+2], &dt) != TCL_OK)  {
+                opserr << "WARNING invalid actuatorDelay delay dt\n";
+                opserr << "expControl: " << tag << endln;
+                return TCL_ERROR;
+            }
+            ECSimulation *theSimulation = dynamic_cast<ECSimulation*>(theControl);
+            if (theSimulation != 0)
+                theSimulation->setActuatorDelay(delay, dt);
+            else
+                opserr << "WARNING -actuatorDelay is only available for "
+                    << "simulation controls, option ignored\n";
+        }
+    }
+    
+    // check for the batch initialization mode
+    for (i=argi; i<argc; i++)  {
+        if (strcmp(argv[i], "-batchInit") == 0)  {
+            double dispTol = -1.0, forceTol = -1.0;
+            int numTries = 1;
+            for (int j=argi; j<argc; j++)  {
+                if (j+2 < argc && strcmp(argv[j], "-initTol") == 0)  {
+                    if (Tcl_GetDouble(interp, argv[j+1], &dispTol) != TCL_OK ||
+                        Tcl_GetDouble(interp, argv[j+2], &forceTol) != TCL_OK)  {
+                        opserr << "WARNING invalid initTol dispTol forceTol\n";
+                        opserr << "expControl: " << tag << endln;
+                        return TCL_ERROR;
+                    }
+                }
+                else if (j+1 < argc && strcmp(argv[j], "-initTries") == 0)  {
+                    if (Tcl_GetInt(interp, argv[j+1], &numTries) != TCL_OK ||
+                        numTries < 1)  {
+                        opserr << "WARNING invalid initTries\n";
+                        opserr << "expControl: " << tag << endln;
+                        return TCL_ERROR;
+                    }
+                }
+            }
+            theControl->setBatchInit(dispTol, forceTol, numTries);
+        }
+    }
+    
     // now add the control to the modelBuilder
     if (addExperimentalControl(*theControl) < 0)  {
         delete theControl; // invoke the destructor, otherwise mem leak
@@ -0,0 +1,191 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// $Revision$
+// $Date$
+// $URL$
+
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the implementation of ExpCPLimits.
+
+#include "ExpCPLimits.h"
+#include <ExperimentalCP.h>
+
+#include <float.h>
+
+
+ExpCPLimits::ExpCPLimits()
+    : numSignals(0), numLim(0), numIncrLim(0),
+    lowerLim(0), upperLim(0), incrLim(0), lastSig(0),
+    lowerBnd(0), upperBnd(0), violation(0),
+    numViolation(0), gotLast(false)
+{
+    // does nothing
+}
+
+
+ExpCPLimits::~ExpCPLimits()
+{
+    this->deleteArrays();
+}
+
+
+int ExpCPLimits::setup(int numCPs, ExperimentalCP **CPs)
+{
+    this->deleteArrays();
+
+    // get total number of signals
+    numSignals = 0;
+    for (int i=0; i<numCPs; i++)
+        numSignals += CPs[i]->getNumSignal();
+
+    lowerLim = new double [numSignals];
+    upperLim = new double [numSignals];
+    incrLim  = new double [numSignals];
+    lastSig  = new double [numSignals];
+    lowerBnd = new double [numSignals];
+    upperBnd = new double [numSignals];
+    violation = new int [numSignals];
+
+    // compile the limits of all the control points into the
+    // flat arrays, signals without limits are left unbounded
+    numLim = 0;
+    numIncrLim = 0;
+    int k = 0;
+    for (int i=0; i<numCPs; i++)  {
+        int numSig = CPs[i]->getNumSignal();
+        int hasLim = CPs[i]->hasLimits();
+        int hasIncrLim = CPs[i]->hasIncrLimits();
+        for (int j=0; j<numSig; j++)  {
+            if (hasLim)  {
+                lowerLim[k] = CPs[i]->getLowerLimit(j);
+                upperLim[k] = CPs[i]->getUpperLimit(j);
+                if (lowerLim[k] > upperLim[k])  {
+                    opserr << "ExpCPLimits::setup() - lower limit "
+                        << "larger than upper limit for signal " << j
+                        << " of control point " << CPs[i]->getTag() << endln;
+                    return OF_ReturnType_failed;
+                }
+                numLim++;
+            } else  {
+                lowerLim[k] = -DBL_MAX;
+                upperLim[k] = DBL_MAX;
+            }
+            if (hasIncrLim)  {
+                incrLim[k] = CPs[i]->getIncrLimit(j);
+                if (incrLim[k] <= 0.0)  {
+                    opserr << "ExpCPLimits::setup() - increment limit "
+                        << "not positive for signal " << j
+                        << " of control point " << CPs[i]->getTag() << endln;
+                    return OF_ReturnType_failed;
+                }
+                numIncrLim++;
+            } else  {
+                incrLim[k] = DBL_MAX;
+            }
+            lastSig[k] = 0.0;
+            lowerBnd[k] = lowerLim[k];
+            upperBnd[k] = upperLim[k];
+            k++;
+        }
+    }
+    numViolation = 0;
+    gotLast = false;
+
+    return OF_ReturnType_completed;
+}
+
+
+int ExpCPLimits::check(const double *signal)
+{
+    int k;
+
+    // tighten the bounds by the increment limits around
+    // the last committed command
+    if (numIncrLim > 0 && gotLast)  {
+        for (k=0; k<numSignals; k++)  {
+            double lo = lastSig[k] - incrLim[k];
+            double hi = lastSig[k] + incrLim[k];
+            lowerBnd[k] = (lo > lowerLim[k]) ? lo : lowerLim[k];
+            upperBnd[k] = (hi < upperLim[k]) ? hi : upperLim[k];
+        }
+    }
+
+    // collect the signals outside of the bounds
+    numViolation = 0;
+    for (k=0; k<numSignals; k++)  {
+        violation[numViolation] = k;
+        numViolation += (signal[k] < lowerBnd[k]) | (signal[k] > upperBnd[k]);
+    }
+
+    return numViolation;
+}
+
+
+int ExpCPLimits::saturate(double *signal)
+{
+    if (this->check(signal) == 0)
+        return 0;
+
+    for (int i=0; i<numViolation; i++)  {
+        int k = violation[i];
+        signal[k] = (signal[k] < lowerBnd[k]) ? lowerBnd[k] : upperBnd[k];
+    }
+
+    return numViolation;
+}
+
+
+void ExpCPLimits::commit(const double *signal)
+{
+    if (numIncrLim == 0)
+        return;
+
+    for (int k=0; k<numSignals; k++)
+        lastSig[k] = signal[k];
+    gotLast = true;
+}
+
+
+void ExpCPLimits::deleteArrays()
+{
+    if (lowerLim != 0)
+        delete [] lowerLim;
+    if (upperLim != 0)
+        delete [] upperLim;
+    if (incrLim != 0)
+        delete [] incrLim;
+    if (lastSig != 0)
+        delete [] lastSig;
+    if (lowerBnd != 0)
+        delete [] lowerBnd;
+    if (upperBnd != 0)
+        delete [] upperBnd;
+    if (violation != 0)
+        delete [] violation;
+
+    lowerLim = upperLim = incrLim = lastSig = 0;
+    lowerBnd = upperBnd = 0;
+    violation = 0;
+    numSignals = 0;
+}
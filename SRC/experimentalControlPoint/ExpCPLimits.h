@@ -0,0 +1,93 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// $Revision$
+// $Date$
+// $URL$
+
+#ifndef ExpCPLimits_h
+#define ExpCPLimits_h
+
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the class definition for
+// ExpCPLimits. ExpCPLimits compiles the limits of an array of
+// control points into flat per-signal bound arrays, ordered like the
+// control signal arrays of the experimental controls. Signals without
+// limits get unbounded entries, so that a complete command array can
+// be checked or saturated in a single pass without any branching on
+// DOF IDs or response types. Optional increment limits restrict the
+// change of each signal with respect to the last committed command.
+
+class ExperimentalCP;
+
+class ExpCPLimits
+{
+public:
+    // constructor
+    ExpCPLimits();
+
+    // destructor
+    ~ExpCPLimits();
+
+    // method to compile the limits of the control points
+    int setup(int numCPs, ExperimentalCP **CPs);
+
+    // method to check a command array, returns the number of
+    // signals that are outside of the bounds (0 = all within)
+    int check(const double *signal);
+
+    // method to saturate a command array at the bounds, returns
+    // the number of signals that had to be saturated
+    int saturate(double *signal);
+
+    // method to set the command array that was sent as the
+    // reference for the increment limits of the next check
+    void commit(const double *signal);
+
+    // methods to query the compiled limits and the last check
+    int getNumSignal() const {return numSignals;};
+    bool isActive() const {return (numLim + numIncrLim) > 0;};
+    int getNumViolation() const {return numViolation;};
+    int getViolation(int i) const {return violation[i];};
+    double getLowerBound(int signalID) const {return lowerBnd[signalID];};
+    double getUpperBound(int signalID) const {return upperBnd[signalID];};
+
+private:
+    void deleteArrays();
+
+    int numSignals;     // total number of signals
+    int numLim;         // number of signals with limits
+    int numIncrLim;     // number of signals with increment limits
+
+    double *lowerLim;   // lower limits
+    double *upperLim;   // upper limits
+    double *incrLim;    // increment limits
+    double *lastSig;    // last committed command
+    double *lowerBnd;   // lower bounds of the last check
+    double *upperBnd;   // upper bounds of the last check
+    int *violation;     // signals outside of the bounds in the last check
+    int numViolation;   // number of signals outside of the bounds
+    bool gotLast;       // flag if a command has been committed
+};
+
+#endif
@@ -41,7 +41,7 @@ ExperimentalCP::ExperimentalCP(int tag, const ID &dof,
     : TaggedObject(tag),
     numSignals(dof.Size()), numDOF(dof.Size()),
     DOF(dof), rspType(rsptype), factor(dof.Size()),
-    lowerLim(0), upperLim(0), isRelative(dof.Size()),
+    lowerLim(0), upperLim(0), incrLim(0), isRelative(dof.Size()),
     uniqueDOF(dof), sizeRspType(5), dofRspType(5),
     nodeTag(0), nodeNDM(0), nodeNDF(0)
 {
@@ -103,6 +103,7 @@ ExperimentalCP::ExperimentalCP(const ExperimentalCP& ecp)
     factor     = ecp.factor;
     lowerLim   = ecp.lowerLim;
     upperLim   = ecp.upperLim;
+    incrLim    = ecp.incrLim;
     isRelative = ecp.isRelative;
     
     uniqueDOF   = ecp.uniqueDOF;
@@ -205,6 +206,21 @@ int ExperimentalCP::setLimits(const Vector &lowerlim,
 }
 
 
+int ExperimentalCP::setIncrLimits(const Vector &incrlim)
+{
+    if (incrlim.Size() != numSignals)  {
+            opserr << "ExperimentalCP::setIncrLimits() - "
+                << "increment limits need to be of "
+                << "size: " << numSignals << endln;
+            return OF_ReturnType_failed;
+    }
+    
+    incrLim = incrlim;
+    
+    return 0;
+}
+
+
 int ExperimentalCP::setSigRefType(const ID &isrelative)
 {
     if (isrelative.Size() != numSignals)  {
@@ -379,6 +395,19 @@ const Vector& ExperimentalCP::getUpperLimit()
 }
 
 
+const Vector& ExperimentalCP::getIncrLimit()
+{
+    if (incrLim == 0)  {
+        opserr << "ExperimentalCP::getIncrLimit() - "
+            << "this control point has no increment "
+            << "limits assigned.\n";
+        exit(OF_ReturnType_failed);
+    }
+    
+    return incrLim;
+}
+
+
 const ID& ExperimentalCP::getSigRefType()
 {
     return isRelative;
@@ -464,6 +493,26 @@ double ExperimentalCP::getUpperLimit(int signalID)
 }
 
 
+double ExperimentalCP::getIncrLimit(int signalID)
+{
+    if (incrLim == 0)  {
+        opserr << "ExperimentalCP::getIncrLimit() - "
+            << "this control point has no increment "
+            << "limits assigned.\n";
+        exit(OF_ReturnType_failed);
+    }
+    
+    if (signalID < 0 || numSignals <= signalID)  {
+        opserr << "ExperimentalCP::getIncrLimit() - "
+            << "signal ID out of bounds, "
+            << "component " << signalID << " does not exist.\n";
+        exit(OF_ReturnType_failed);
+    }
+    
+    return incrLim(signalID);
+}
+
+
 int ExperimentalCP::getSigRefType(int signalID)
 {
     if (signalID < 0 || numSignals <= signalID)  {
@@ -488,6 +537,8 @@ void ExperimentalCP::Print(OPS_Stream &s, int flag)
         s << "  lowerLim: " << lowerLim << endln;
     if (upperLim != 0)
         s << "  upperLim: " << upperLim << endln;
+    if (incrLim != 0)
+        s << "  incrLim : " << incrLim << endln;
     s << "  isRelative  : " << isRelative << endln;
     if (nodeTag != 0)  {
         s << "  nodeTag: " << nodeTag << endln;
@@ -507,6 +558,15 @@ int ExperimentalCP::hasLimits()
 }
 
 
+int ExperimentalCP::hasIncrLimits()
+{
+    if (incrLim != 0)
+        return 1;
+    
+    return 0;
+}
+
+
 int ExperimentalCP::operator == (ExperimentalCP& ecp)
 {
     // factor value IS NOT checked!
@@ -34,7 +34,9 @@
 // ExperimentalCP. This object possess control point data, i.e.
 // DOF-IDs and response types for each DOF. Optionally the
 // control point object can store scaling factors, response
-// limits, signal reference types and be associated with a node.
+// limits, increment limits (maximum change of a signal from one
+// command to the next), signal reference types and be associated
+// with a node.
 
 #include <FrescoGlobals.h>
 
@@ -62,6 +64,7 @@ public:
         const ID &rspType, const Vector &factor = 0);
     int setLimits(const Vector &lowerLimit,
         const Vector &upperLimit);
+    int setIncrLimits(const Vector &incrLimit);
     int setSigRefType(const ID &isRelative);
     int setNode(Node *theNode);
     
@@ -83,6 +86,7 @@ public:
     const Vector &getFactor();
     const Vector &getLowerLimit();
     const Vector &getUpperLimit();
+    const Vector &getIncrLimit();
     const ID &getSigRefType();
     
     const ID &getUniqueDOF();  // DO I STILL NEED THIS ???
@@ -92,10 +96,12 @@ public:
     double getFactor(int signalID);
     double getLowerLimit(int signalID);
     double getUpperLimit(int signalID);
+    double getIncrLimit(int signalID);
     int getSigRefType(int signalID);
     
     // methods to query information
     int hasLimits();
+    int hasIncrLimits();
     int operator == (ExperimentalCP &ecp);
     int operator != (ExperimentalCP &ecp);
     
@@ -108,6 +114,7 @@ protected:
     Vector factor;      // scaling factors (size = numSignals)
     Vector lowerLim;    // lower limits (size = numSignals)
     Vector upperLim;    // upper limits (size = numSignals)
+    Vector incrLim;     // increment limits (size = numSignals)
     ID isRelative;      // absolute or relative (size = numSignals)
     
     ID uniqueDOF;       // unique DOFs
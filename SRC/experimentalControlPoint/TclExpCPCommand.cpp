@@ -111,14 +111,14 @@ int TclExpCPCommand(ClientData clientData, Tcl_Interp *interp,
     if (argc < 4)  {
         opserr << "WARNING invalid number of arguments\n";
         printCommand(argc,argv);
-        opserr << "Want: expControlPoint tag <-node nodeTag> dof rspType <-fact f> <-lim l u> <-isRel> ...\n";
+        opserr << "Want: expControlPoint tag <-node nodeTag> dof rspType <-fact f> <-lim l u> <-incrLim d> <-isRel> ...\n";
         return TCL_ERROR;
     }
     
     int tag, i, argi = 1;
     int nodeTag = 0, ndf = 0, ndm = 0;
     Node *theNode = 0;
-    int numSignals = 0, numLim = 0, numRefType = 0;
+    int numSignals = 0, numLim = 0, numIncrLim = 0, numRefType = 0;
     double f, lim;
     ExperimentalCP *theCP = 0;
     
@@ -132,7 +132,7 @@ int TclExpCPCommand(ClientData clientData, Tcl_Interp *interp,
         if (Tcl_GetInt(interp, argv[argi], &nodeTag) != TCL_OK)  {
             opserr << "WARNING invalid nodeTag for control point: " << tag << endln;
             printCommand(argc,argv);
-            opserr << "Want: expControlPoint tag <-node nodeTag> dof rspType <-fact f> <-lim l u> <-isRel> ...\n";
+            opserr << "Want: expControlPoint tag <-node nodeTag> dof rspType <-fact f> <-lim l u> <-incrLim d> <-isRel> ...\n";
             return TCL_ERROR;
         }
         theNode = theDomain->getNode(nodeTag);
@@ -151,6 +151,10 @@ int TclExpCPCommand(ClientData clientData, Tcl_Interp *interp,
             i += 3;
             numLim++;
         }
+        else if (strcmp(argv[i],"-incrLim") == 0 || strcmp(argv[i],"-incrLimit") == 0)  {
+            i += 2;
+            numIncrLim++;
+        }
         else  {
             i += 2;
             numSignals++;
@@ -159,13 +163,19 @@ int TclExpCPCommand(ClientData clientData, Tcl_Interp *interp,
     if (numSignals == 0)  {
         opserr << "WARNING invalid number of arguments for control point: " << tag << endln;
         printCommand(argc,argv);
-        opserr << "Want: expControlPoint tag <-node nodeTag> dof rspType <-fact f> <-lim l u> <-isRel> ...\n";
+        opserr << "Want: expControlPoint tag <-node nodeTag> dof rspType <-fact f> <-lim l u> <-incrLim d> <-isRel> ...\n";
         return TCL_ERROR;
     }
     if (numLim > 0 && numLim != numSignals)  {
         opserr << "WARNING invalid number of limits for control point: " << tag << endln;
         printCommand(argc,argv);
-        opserr << "Want: expControlPoint tag <-node nodeTag> dof rspType <-fact f> <-lim l u> <-isRel> ...\n";
+        opserr << "Want: expControlPoint tag <-node nodeTag> dof rspType <-fact f> <-lim l u> <-incrLim d> <-isRel> ...\n";
+        return TCL_ERROR;
+    }
+    if (numIncrLim > 0 && numIncrLim != numSignals)  {
+        opserr << "WARNING invalid number of increment limits for control point: " << tag << endln;
+        printCommand(argc,argv);
+        opserr << "Want: expControlPoint tag <-node nodeTag> dof rspType <-fact f> <-lim l u> <-incrLim d> <-isRel> ...\n";
         return TCL_ERROR;
     }
     ID dof(numSignals);
@@ -173,6 +183,7 @@ int TclExpCPCommand(ClientData clientData, Tcl_Interp *interp,
     Vector factor(numSignals);
     Vector lowerLim(numSignals);
     Vector upperLim(numSignals);
+    Vector incrLim(numSignals);
     ID isRelative(numSignals);
     for (i=0; i<numSignals; i++)  {
         if (ndf == 0)  {
@@ -181,7 +192,7 @@ int TclExpCPCommand(ClientData clientData, Tcl_Interp *interp,
                 if (sscanf(argv[argi],"%*[dfouDFOU]%d",&dofID) != 1)  {
                     opserr << "WARNING invalid dof for control point: " << tag << endln;
                     printCommand(argc,argv);
-                    opserr << "Want: expControlPoint tag <-node nodeTag> dof rspType <-fact f> <-lim l u> <-isRel> ...\n";
+                    opserr << "Want: expControlPoint tag <-node nodeTag> dof rspType <-fact f> <-lim l u> <-incrLim d> <-isRel> ...\n";
                     return TCL_ERROR;
                 }
             }
@@ -196,7 +207,7 @@ int TclExpCPCommand(ClientData clientData, Tcl_Interp *interp,
             else  {
                 opserr << "WARNING invalid dof for control point: " << tag << endln;
                 printCommand(argc,argv);
-                opserr << "Want: expControlPoint tag <-node nodeTag> dof rspType <-fact f> <-lim l u> <-isRel> ...\n";
+                opserr << "Want: expControlPoint tag <-node nodeTag> dof rspType <-fact f> <-lim l u> <-incrLim d> <-isRel> ...\n";
                 return TCL_ERROR;
             }
         }
@@ -214,7 +225,7 @@ int TclExpCPCommand(ClientData clientData, Tcl_Interp *interp,
             else  {
                 opserr << "WARNING invalid dof for control point: " << tag << endln;
                 printCommand(argc,argv);
-                opserr << "Want: expControlPoint tag <-node nodeTag> dof rspType <-fact f> <-lim l u> <-isRel> ...\n";
+                opserr << "Want: expControlPoint tag <-node nodeTag> dof rspType <-fact f> <-lim l u> <-incrLim d> <-isRel> ...\n";
                 return TCL_ERROR;
             }
         }
@@ -237,7 +248,7 @@ int TclExpCPCommand(ClientData clientData, Tcl_Interp *interp,
             else  {
                 opserr << "WARNING invalid dof for control point: " << tag << endln;
                 printCommand(argc,argv);
-                opserr << "Want: expControlPoint tag <-node nodeTag> dof rspType <-fact f> <-lim l u> <-isRel> ...\n";
+                opserr << "Want: expControlPoint tag <-node nodeTag> dof rspType <-fact f> <-lim l u> <-incrLim d> <-isRel> ...\n";
                 return TCL_ERROR;
             }
         }
@@ -260,7 +271,7 @@ int TclExpCPCommand(ClientData clientData, Tcl_Interp *interp,
             else  {
                 opserr << "WARNING invalid dof for control point: " << tag << endln;
                 printCommand(argc,argv);
-                opserr << "Want: expControlPoint tag <-node nodeTag> dof rspType <-fact f> <-lim l u> <-isRel> ...\n";
+                opserr << "Want: expControlPoint tag <-node nodeTag> dof rspType <-fact f> <-lim l u> <-incrLim d> <-isRel> ...\n";
                 return TCL_ERROR;
             }
         }
@@ -298,7 +309,7 @@ int TclExpCPCommand(ClientData clientData, Tcl_Interp *interp,
             else  {
                 opserr << "WARNING invalid dof for control point: " << tag << endln;
                 printCommand(argc,argv);
-                opserr << "Want: expControlPoint tag <-node nodeTag> dof rspType <-fact f> <-lim l u> <-isRel> ...\n";
+                opserr << "Want: expControlPoint tag <-node nodeTag> dof rspType <-fact f> <-lim l u> <-incrLim d> <-isRel> ...\n";
                return TCL_ERROR;
             }
         }
@@ -321,7 +332,7 @@ int TclExpCPCommand(ClientData clientData, Tcl_Interp *interp,
         else  {
             opserr << "WARNING invalid rspType for control point: " << tag << endln;
             printCommand(argc,argv);
-            opserr << "Want: expControlPoint tag <-node nodeTag> dof rspType <-fact f> <-lim l u> <-isRel> ...\n";
+            opserr << "Want: expControlPoint tag <-node nodeTag> dof rspType <-fact f> <-lim l u> <-incrLim d> <-isRel> ...\n";
             return TCL_ERROR;
         }
         argi++;
@@ -330,7 +341,7 @@ int TclExpCPCommand(ClientData clientData, Tcl_Interp *interp,
             if (Tcl_GetDouble(interp, argv[argi], &f) != TCL_OK)  {
                 opserr << "WARNING invalid factor for control point: " << tag << endln;
                 printCommand(argc,argv);
-                opserr << "Want: expControlPoint tag <-node nodeTag> dof rspType <-fact f> <-lim l u> <-isRel> ...\n";
+                opserr << "Want: expControlPoint tag <-node nodeTag> dof rspType <-fact f> <-lim l u> <-incrLim d> <-isRel> ...\n";
                 return TCL_ERROR;
             }
             factor(i) = f;
@@ -343,7 +354,7 @@ int TclExpCPCommand(ClientData clientData, Tcl_Interp *interp,
             if (Tcl_GetDouble(interp, argv[argi], &lim) != TCL_OK)  {
                 opserr << "WARNING invalid lower limit for control point: " << tag << endln;
                 printCommand(argc,argv);
-                opserr << "Want: expControlPoint tag <-node nodeTag> dof rspType <-fact f> <-lim l u> <-isRel> ...\n";
+                opserr << "Want: expControlPoint tag <-node nodeTag> dof rspType <-fact f> <-lim l u> <-incrLim d> <-isRel> ...\n";
                 return TCL_ERROR;
             }
             lowerLim(i) = lim;
@@ -351,12 +362,23 @@ int TclExpCPCommand(ClientData clientData, Tcl_Interp *interp,
             if (Tcl_GetDouble(interp, argv[argi], &lim) != TCL_OK)  {
                 opserr << "WARNING invalid upper limit for control point: " << tag << endln;
                 printCommand(argc,argv);
-                opserr << "Want: expControlPoint tag <-node nodeTag> dof rspType <-fact f> <-lim l u> <-isRel> ...\n";
+                opserr << "Want: expControlPoint tag <-node nodeTag> dof rspType <-fact f> <-lim l u> <-incrLim d> <-isRel> ...\n";
                 return TCL_ERROR;
             }
             upperLim(i) = lim;
             argi++;
         }
+        if (argi<argc && (strcmp(argv[argi],"-incrLim") == 0 || strcmp(argv[argi],"-incrLimit") == 0))  {
+            argi++;
+            if (Tcl_GetDouble(interp, argv[argi], &lim) != TCL_OK || lim <= 0.0)  {
+                opserr << "WARNING invalid increment limit for control point: " << tag << endln;
+                printCommand(argc,argv);
+                opserr << "Want: expControlPoint tag <-node nodeTag> dof rspType <-fact f> <-lim l u> <-incrLim d> <-isRel> ...\n";
+                return TCL_ERROR;
+            }
+            incrLim(i) = lim;
+            argi++;
+        }
         if (argi<argc && (strcmp(argv[argi],"-isRel") == 0 || strcmp(argv[argi],"-isRelative") == 0))  {
             isRelative(i) = 1;
             numRefType++;
@@ -376,6 +398,10 @@ int TclExpCPCommand(ClientData clientData, Tcl_Interp *interp,
     if (numLim > 0)
         theCP->setLimits(lowerLim, upperLim);
     
+    // add increment limits if available
+    if (numIncrLim > 0)
+        theCP->setIncrLimits(incrLim);
+    
     // add signal reference types if available
     if (numRefType > 0)
         theCP->setSigRefType(isRelative);
@@ -38,11 +38,14 @@
 #include <Renderer.h>
 #include <Information.h>
 #include <ElementResponse.h>
+#include <ExpCheckpoint.h>
 #include <CrdTransf.h>
 #include <ElementalLoad.h>
 #include <TCP_Socket.h>
 #include <TCP_SocketSSL.h>
 #include <UDP_Socket.h>
+#include <ImpairedChannel.h>
+#include <ChannelOptions.h>
 
 #include <math.h>
 #include <stdlib.h>
@@ -150,7 +153,8 @@ EEBeamColumn2d::EEBeamColumn2d(int tag, int Nd1, int Nd2,
 EEBeamColumn2d::EEBeamColumn2d(int tag, int Nd1, int Nd2,
     CrdTransf &coordTransf,
     int port, char *machineInetAddr, int ssl, int udp,
-    int dataSize, bool iM, int addRay, double r, bool cm)
+    int dataSize, bool iM, int addRay, double r, bool cm,
+    const ChannelOptions *options)
     : ExperimentalElement(tag, ELE_TAG_EEBeamColumn2d),
     connectedExternalNodes(2), theCoordTransf(0),
     iMod(iM), addRayleigh(addRay), rho(r), cMass(cm),
@@ -201,6 +205,10 @@ EEBeamColumn2d::EEBeamColumn2d(int tag, int Nd1, int Nd2,
             << "- failed to create channel\n";
         exit(-1);
     }
+    if (options != 0)  {
+        theChannel->setChannelOptions(*options);
+        theChannel = ImpairedChannel::wrap(theChannel, *options);
+    }
     if (theChannel->setUpConnection() != 0)  {
         opserr << "EEBeamColumn2d::EEBeamColumn2d() "
             << "- failed to setup connection\n";
@@ -1031,6 +1039,58 @@ void EEBeamColumn2d::Print(OPS_Stream &s, int flag)
 }
 
 
+int EEBeamColumn2d::saveState(ExpCheckpoint &theCheckpoint)
+{
+    // first save the base class
+    if (this->ExperimentalElement::saveState(theCheckpoint) < 0)
+        return OF_ReturnType_failed;
+    
+    theCheckpoint.save(db);
+    theCheckpoint.save(vb);
+    theCheckpoint.save(ab);
+    theCheckpoint.save(t);
+    theCheckpoint.save(dbDaq);
+    theCheckpoint.save(vbDaq);
+    theCheckpoint.save(abDaq);
+    theCheckpoint.save(qbDaq);
+    theCheckpoint.save(tDaq);
+    theCheckpoint.save(&dbCtrl);
+    theCheckpoint.save(&vbCtrl);
+    theCheckpoint.save(&abCtrl);
+    theCheckpoint.save(&kbInit);
+    theCheckpoint.save(&dbLast);
+    theCheckpoint.save(tLast);
+    
+    return theCheckpoint.save(int(firstWarning));
+}
+
+
+int EEBeamColumn2d::restoreState(ExpCheckpoint &theCheckpoint)
+{
+    // first restore the base class
+    if (this->ExperimentalElement::restoreState(theCheckpoint) < 0)
+        return OF_ReturnType_failed;
+    
+    theCheckpoint.restore(db);
+    theCheckpoint.restore(vb);
+    theCheckpoint.restore(ab);
+    theCheckpoint.restore(t);
+    theCheckpoint.restore(dbDaq);
+    theCheckpoint.restore(vbDaq);
+    theCheckpoint.restore(abDaq);
+    theCheckpoint.restore(qbDaq);
+    theCheckpoint.restore(tDaq);
+    theCheckpoint.restore(&dbCtrl);
+    theCheckpoint.restore(&vbCtrl);
+    theCheckpoint.restore(&abCtrl);
+    theCheckpoint.restore(&kbInit);
+    theCheckpoint.restore(&dbLast);
+    theCheckpoint.restore(tLast);
+    
+    return theCheckpoint.restore(firstWarning);
+}
+
+
 Response* EEBeamColumn2d::setResponse(const char **argv, int argc,
     OPS_Stream &output)
 {
@@ -38,10 +38,13 @@
 #include <Renderer.h>
 #include <Information.h>
 #include <ElementResponse.h>
+#include <ExpCheckpoint.h>
 #include <UniaxialMaterial.h>
 #include <TCP_Socket.h>
 #include <TCP_SocketSSL.h>
 #include <UDP_Socket.h>
+#include <ImpairedChannel.h>
+#include <ChannelOptions.h>
 
 #include <float.h>
 #include <math.h>
@@ -49,11 +52,6 @@
 #include <string.h>
 
 
-// initialize the class wide variables
-Matrix EEBearing3d::theMatrix(12,12);
-Vector EEBearing3d::theVector(12);
-
-
 // responsible for allocating the necessary space needed
 // by each object and storing the tags of the end nodes.
 EEBearing3d::EEBearing3d(int tag, int Nd1, int Nd2,
@@ -67,6 +65,8 @@ EEBearing3d::EEBearing3d(int tag, int Nd1, int Nd2,
     dbDaq(0), vbDaq(0), abDaq(0), qbDaq(0), tDaq(0),
     dbCtrl(6), vbCtrl(6), abCtrl(6),
     dl(12), Tgl(12,12), Tlb(6,12), kbInit(6,6), dbLast(6), tLast(0.0),
+    dg(12), vg(12), ag(12), vl(12), al(12), kb(6,6), kl(12,12),
+    cb(6,6), cl(12,12), ql(12), daqValid(false), theMatrix(12,12), theVector(12),
     theLoad(12), firstWarning(true), onP0(true)
 {
     // ensure the connectedExternalNode ID is of correct size & set values
@@ -104,6 +104,7 @@ EEBearing3d::EEBearing3d(int tag, int Nd1, int Nd2,
             exit(OF_ReturnType_failed);
         }
     }
+    this->setMaterialResponse();
     
     // check p-delta moment distribution ratios
     if (Mratio.Size() == 4)  {
@@ -168,7 +169,8 @@ EEBearing3d::EEBearing3d(int tag, int Nd1, int Nd2,
     int pfc, UniaxialMaterial **materials,
     int port, char *machineInetAddr, int ssl, int udp, int dataSize,
     const Vector _y, const Vector _x,
-    const Vector Mr, double sdI, bool iM, int addRay, double m)
+    const Vector Mr, double sdI, bool iM, int addRay, double m,
+    const ChannelOptions *options)
     : ExperimentalElement(tag, ELE_TAG_EEBearing3d),
     connectedExternalNodes(2), pFrcCtrl(pfc), x(_x), y(_y), Mratio(Mr),
     shearDistI(sdI), iMod(iM), addRayleigh(addRay), mass(m), L(0.0),
@@ -177,6 +179,8 @@ EEBearing3d::EEBearing3d(int tag, int Nd1, int Nd2,
     dbDaq(0), vbDaq(0), abDaq(0), qbDaq(0), tDaq(0),
     dbCtrl(6), vbCtrl(6), abCtrl(6),
     dl(12), Tgl(12,12), Tlb(6,12), kbInit(6,6), dbLast(6), tLast(0.0),
+    dg(12), vg(12), ag(12), vl(12), al(12), kb(6,6), kl(12,12),
+    cb(6,6), cl(12,12), ql(12), daqValid(false), theMatrix(12,12), theVector(12),
     theLoad(12), firstWarning(true), onP0(true)
 {
     // ensure the connectedExternalNode ID is of correct size & set values
@@ -214,6 +218,7 @@ EEBearing3d::EEBearing3d(int tag, int Nd1, int Nd2,
             exit(OF_ReturnType_failed);
         }
     }
+    this->setMaterialResponse();
     
     // check p-delta moment distribution ratios
     if (Mratio.Size() == 4)  {
@@ -255,6 +260,10 @@ EEBearing3d::EEBearing3d(int tag, int Nd1, int Nd2,
             << "- failed to create channel.\n";
         exit(OF_ReturnType_failed);
     }
+    if (options != 0)  {
+        theChannel->setChannelOptions(*options);
+        theChannel = ImpairedChannel::wrap(theChannel, *options);
+    }
     if (theChannel->setUpConnection() != 0)  {
         opserr << "EEBearing3d::EEBearing3d() "
             << "- failed to setup connection.\n";
@@ -481,16 +490,16 @@ int EEBearing3d::commitState()
     // commit the base class
     rValue += this->Element::commitState();
     
-    // update dbLast
-    int ndim = 0, i;
-    Vector dgLast(12), dlLast(12);
+    // update dbLast (vl is used as workspace for the local displacements)
+    int ndim = 0, i, j;
     for (i=0; i<2; i++)  {
-        Vector disp = theNodes[i]->getTrialDisp();
-        dgLast.Assemble(disp, ndim);
+        const Vector &disp = theNodes[i]->getTrialDisp();
+        for (j=0; j<6; j++)
+            dg(ndim+j) = disp(j);
         ndim += 6;
     }
-    dlLast.addMatrixVector(0.0, Tgl, dgLast, 1.0);
-    dbLast.addMatrixVector(0.0, Tlb, dlLast, 1.0);
+    vl.addMatrixVector(0.0, Tgl, dg, 1.0);
+    dbLast.addMatrixVector(0.0, Tlb, vl, 1.0);
     
     return rValue;
 }
@@ -505,20 +514,20 @@ int EEBearing3d::update()
     (*t)(0) = theDomain->getCurrentTime();
     
     // get global trial response
-    int ndim = 0, i;
-    Vector dg(12), vg(12), ag(12);
+    int ndim = 0, i, j;
     for (i=0; i<2; i++)  {
-        Vector disp = theNodes[i]->getTrialDisp();
-        Vector vel = theNodes[i]->getTrialVel();
-        Vector accel = theNodes[i]->getTrialAccel();
-        dg.Assemble(disp, ndim);
-        vg.Assemble(vel, ndim);
-        ag.Assemble(accel, ndim);
+        const Vector &disp = theNodes[i]->getTrialDisp();
+        const Vector &vel = theNodes[i]->getTrialVel();
+        const Vector &accel = theNodes[i]->getTrialAccel();
+        for (j=0; j<6; j++)  {
+            dg(ndim+j) = disp(j);
+            vg(ndim+j) = vel(j);
+            ag(ndim+j) = accel(j);
+        }
         ndim += 6;
     }
     
     // transform response from the global to the local system
-    Vector vl(12), al(12);
     dl.addMatrixVector(0.0, Tgl, dg, 1.0);
     vl.addMatrixVector(0.0, Tgl, vg, 1.0);
     al.addMatrixVector(0.0, Tgl, ag, 1.0);
@@ -534,11 +543,14 @@ int EEBearing3d::update()
         (*qb)(0) = theMaterials[0]->getStress();
     
     // 2) set shear deformations in basic y- and z-direction
-    Vector dbDelta = (*db) - dbLast;
+    double dbDelta = 0.0;
+    for (i=0; i<6; i++)
+        if (fabs((*db)(i) - dbLast(i)) > dbDelta)
+            dbDelta = fabs((*db)(i) - dbLast(i));
     // do not check time for right now because of transformation constraint
     // handler calling update at beginning of new step when applying load
-    // if (dbDelta.pNorm(0) > DBL_EPSILON || (*t)(0) > tLast)  {
-    if (dbDelta.pNorm(0) > DBL_EPSILON)  {
+    // if (dbDelta > DBL_EPSILON || (*t)(0) > tLast)  {
+    if (dbDelta > DBL_EPSILON)  {
         // set the trial response at the site
         if (theSite != 0)  {
             theSite->setTrialResponse(db, vb, ab, qb, t);
@@ -558,6 +570,10 @@ int EEBearing3d::update()
     // 5) set rotations about basic z-direction
     theMaterials[3]->setTrialStrain((*db)(5), (*vb)(5));
     
+    // the material and daq response are determined once per update
+    this->setMaterialResponse();
+    daqValid = false;
+    
     // save the last displacements and time
     dbLast = (*db);
     tLast = (*t)(0);
@@ -586,11 +602,10 @@ int EEBearing3d::setInitialStiff(const Matrix& kbinit)
     theInitStiff.Zero();
     
     // transform from basic to local system
-    static Matrix klInit(12,12);
-    klInit.addMatrixTripleProduct(0.0, Tlb, kbInit, 1.0);
+    kl.addMatrixTripleProduct(0.0, Tlb, kbInit, 1.0);
     
     // transform from local to global system
-    theInitStiff.addMatrixTripleProduct(0.0, Tgl, klInit, 1.0);
+    theInitStiff.addMatrixTripleProduct(0.0, Tgl, kl, 1.0);
     
     return OF_ReturnType_completed;
 }
@@ -614,43 +629,20 @@ const Matrix& EEBearing3d::getTangentStiff()
     theMatrix.Zero();
     
     // get stiffness matrix in basic system
-    static Matrix kb(6,6);
     kb.Zero();
-    kb(0,0) = theMaterials[0]->getTangent();
+    kb(0,0) = matTangent[0];
     kb(1,1) = kbInit(1,1);  kb(1,2) = kbInit(1,2);
     kb(2,1) = kbInit(2,1);  kb(2,2) = kbInit(2,2);
-    kb(3,3) = theMaterials[1]->getTangent();
-    kb(4,4) = theMaterials[2]->getTangent();
-    kb(5,5) = theMaterials[3]->getTangent();
+    kb(3,3) = matTangent[1];
+    kb(4,4) = matTangent[2];
+    kb(5,5) = matTangent[3];
     
     // transform from basic to local system
-    static Matrix kl(12,12);
     kl.addMatrixTripleProduct(0.0, Tlb, kb, 1.0);
     
     if (Mratio.Size() == 4)  {
         // get daq resisting forces in basic system
-        if (theSite != 0)  {
-            (*qbDaq) = theSite->getForce();
-        }
-        else  {
-            sData[0] = OF_RemoteTest_getForce;
-            theChannel->sendVector(0, 0, *sendData, 0);
-            theChannel->recvVector(0, 0, *recvData, 0);
-        }
-        
-        // apply optional initial stiffness modification
-        if (iMod == true)
-            this->applyIMod();
-        
-        // use material force if force from test is zero
-        if ((*qbDaq)(0) == 0.0)
-            (*qbDaq)(0) = theMaterials[0]->getStress();
-        if ((*qbDaq)(3) == 0.0)
-            (*qbDaq)(3) = theMaterials[1]->getStress();
-        if ((*qbDaq)(4) == 0.0)
-            (*qbDaq)(4) = theMaterials[2]->getStress();
-        if ((*qbDaq)(5) == 0.0)
-            (*qbDaq)(5) = theMaterials[3]->getStress();
+        this->setDaqForce();
         
         // add geometric stiffness to local stiffness
         this->addPDeltaStiff(kl);
@@ -676,15 +668,13 @@ const Matrix& EEBearing3d::getDamp()
     }
     
     // now add damping tangent from materials
-    static Matrix cb(6,6);
     cb.Zero();
-    cb(0,0) = theMaterials[0]->getDampTangent();
-    cb(3,3) = theMaterials[1]->getDampTangent();
-    cb(4,4) = theMaterials[2]->getDampTangent();
-    cb(5,5) = theMaterials[3]->getDampTangent();
+    cb(0,0) = matDampTangent[0];
+    cb(3,3) = matDampTangent[1];
+    cb(4,4) = matDampTangent[2];
+    cb(5,5) = matDampTangent[3];
     
     // transform from basic to local system
-    static Matrix cl(12,12);
     cl.addMatrixTripleProduct(0.0, Tlb, cb, 1.0);
     
     // transform from local to global system and add to cg
@@ -763,28 +753,7 @@ const Vector& EEBearing3d::getResistingForce()
     theVector.Zero();
     
     // get daq resisting forces
-    if (theSite != 0)  {
-        (*qbDaq) = theSite->getForce();
-    }
-    else  {
-        sData[0] = OF_RemoteTest_getForce;
-        theChannel->sendVector(0, 0, *sendData, 0);
-        theChannel->recvVector(0, 0, *recvData, 0);
-    }
-    
-    // apply optional initial stiffness modification
-    if (iMod == true)
-        this->applyIMod();
-    
-    // use material force if force from test is zero
-    if ((*qbDaq)(0) == 0.0)
-        (*qbDaq)(0) = theMaterials[0]->getStress();
-    if ((*qbDaq)(3) == 0.0)
-        (*qbDaq)(3) = theMaterials[1]->getStress();
-    if ((*qbDaq)(4) == 0.0)
-        (*qbDaq)(4) = theMaterials[2]->getStress();
-    if ((*qbDaq)(5) == 0.0)
-        (*qbDaq)(5) = theMaterials[3]->getStress();
+    this->setDaqForce();
     
     // save corresponding ctrl displacements for recorder
     dbCtrl = (*db);
@@ -792,7 +761,6 @@ const Vector& EEBearing3d::getResistingForce()
     abCtrl = (*ab);
     
     // determine resisting forces in local system
-    static Vector ql(12);
     ql.addMatrixTransposeVector(0.0, Tlb, *qbDaq, 1.0);
     
     // add P-Delta effects to local forces
@@ -921,8 +889,8 @@ int EEBearing3d::displaySelf(Renderer &theViewer,
     const Vector &end1Crd = theNodes[0]->getCrds();
     const Vector &end2Crd = theNodes[1]->getCrds();
     
-    static Vector v1(3);
-    static Vector v2(3);
+    Vector v1(3);
+    Vector v2(3);
     
     if (displayMode >= 0)  {
         const Vector &end1Disp = theNodes[0]->getDisp();
@@ -978,6 +946,65 @@ void EEBearing3d::Print(OPS_Stream &s, int flag)
 }
 
 
+int EEBearing3d::saveState(ExpCheckpoint &theCheckpoint)
+{
+    // first save the base class
+    if (this->ExperimentalElement::saveState(theCheckpoint) < 0)
+        return OF_ReturnType_failed;
+    
+    theCheckpoint.save(db);
+    theCheckpoint.save(vb);
+    theCheckpoint.save(ab);
+    theCheckpoint.save(qb);
+    theCheckpoint.save(t);
+    theCheckpoint.save(dbDaq);
+    theCheckpoint.save(vbDaq);
+    theCheckpoint.save(abDaq);
+    theCheckpoint.save(qbDaq);
+    theCheckpoint.save(tDaq);
+    theCheckpoint.save(&dbCtrl);
+    theCheckpoint.save(&vbCtrl);
+    theCheckpoint.save(&abCtrl);
+    theCheckpoint.save(&kbInit);
+    theCheckpoint.save(&dbLast);
+    theCheckpoint.save(tLast);
+    theCheckpoint.save(int(firstWarning));
+    
+    return theCheckpoint.save(int(onP0));
+}
+
+
+int EEBearing3d::restoreState(ExpCheckpoint &theCheckpoint)
+{
+    // first restore the base class
+    if (this->ExperimentalElement::restoreState(theCheckpoint) < 0)
+        return OF_ReturnType_failed;
+    
+    theCheckpoint.restore(db);
+    theCheckpoint.restore(vb);
+    theCheckpoint.restore(ab);
+    theCheckpoint.restore(qb);
+    theCheckpoint.restore(t);
+    theCheckpoint.restore(dbDaq);
+    theCheckpoint.restore(vbDaq);
+    theCheckpoint.restore(abDaq);
+    theCheckpoint.restore(qbDaq);
+    theCheckpoint.restore(tDaq);
+    theCheckpoint.restore(&dbCtrl);
+    theCheckpoint.restore(&vbCtrl);
+    theCheckpoint.restore(&abCtrl);
+    theCheckpoint.restore(&kbInit);
+    theCheckpoint.restore(&dbLast);
+    theCheckpoint.restore(tLast);
+    theCheckpoint.restore(firstWarning);
+    
+    // acquire the daq response again after a restart
+    daqValid = false;
+    
+    return theCheckpoint.restore(onP0);
+}
+
+
 Response* EEBearing3d::setResponse(const char **argv, int argc,
     OPS_Stream &output)
 {
@@ -1248,7 +1275,7 @@ void EEBearing3d::setUp()
     
     // establish orientation of element for the tranformation matrix
     // z = x cross y
-    static Vector z(3);
+    Vector z(3);
     z(0) = x(1)*y(2) - x(2)*y(1);
     z(1) = x(2)*y(0) - x(0)*y(2);
     z(2) = x(0)*y(1) - x(1)*y(0);
@@ -1379,5 +1406,52 @@ void EEBearing3d::applyIMod()
     }
     
     // correct for displacement control errors using I-Modification
-    (*qbDaq) -= kbInit*((*dbDaq) - (*db));
+    qbDaq->addMatrixVector(1.0, kbInit, *dbDaq, -1.0);
+    qbDaq->addMatrixVector(1.0, kbInit, *db, 1.0);
+}
+
+
+void EEBearing3d::setMaterialResponse()
+{
+    // save the response of the uniaxial materials for the
+    // element state determination of the current update
+    for (int i=0; i<4; i++)  {
+        matStress[i] = theMaterials[i]->getStress();
+        matTangent[i] = theMaterials[i]->getTangent();
+        matDampTangent[i] = theMaterials[i]->getDampTangent();
+    }
+}
+
+
+void EEBearing3d::setDaqForce()
+{
+    // check for quick return
+    if (daqValid == true)
+        return;
+    
+    // get daq resisting forces in basic system
+    if (theSite != 0)  {
+        (*qbDaq) = theSite->getForce();
+    }
+    else  {
+        sData[0] = OF_RemoteTest_getForce;
+        theChannel->sendVector(0, 0, *sendData, 0);
+        theChannel->recvVector(0, 0, *recvData, 0);
+    }
+    
+    // apply optional initial stiffness modification
+    if (iMod == true)
+        this->applyIMod();
+    
+    // use material force if force from test is zero
+    if ((*qbDaq)(0) == 0.0)
+        (*qbDaq)(0) = matStress[0];
+    if ((*qbDaq)(3) == 0.0)
+        (*qbDaq)(3) = matStress[1];
+    if ((*qbDaq)(4) == 0.0)
+        (*qbDaq)(4) = matStress[2];
+    if ((*qbDaq)(5) == 0.0)
+        (*qbDaq)(5) = matStress[3];
+    
+    daqValid = true;
 }
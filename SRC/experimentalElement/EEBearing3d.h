@@ -37,6 +37,7 @@
 #include "ExperimentalElement.h"
 
 class Channel;
+class ChannelOptions;
 class UniaxialMaterial;
 
 #define ELE_TAG_EEBearing3d 9958
@@ -58,7 +59,8 @@ public:
         int ssl = 0, int udp = 0, int dataSize = OF_Network_dataSize,
         const Vector y = 0, const Vector x = 0, const Vector Mratio = 0,
         double shearDistI = 0.5, bool iMod = false,
-        int addRayleigh = 0, double mass = 0.0);
+        int addRayleigh = 0, double mass = 0.0,
+        const ChannelOptions *options = 0);
     
     // destructor
     ~EEBearing3d();
@@ -107,6 +109,10 @@ public:
         float fact, const char **modes = 0, int numModes = 0);
     void Print(OPS_Stream &s, int flag = 0);
     
+    // public methods to save and restore the state for a checkpoint
+    int saveState(ExpCheckpoint &theCheckpoint);
+    int restoreState(ExpCheckpoint &theCheckpoint);
+    
     // public methods for element recorder
     Response *setResponse(const char **argv, int argc, OPS_Stream &s);
     int getResponse(int responseID, Information &eleInfo);
@@ -119,6 +125,8 @@ private:
     void addPDeltaForces(Vector &pLocal);
     void addPDeltaStiff(Matrix &kLocal);
     void applyIMod();
+    void setMaterialResponse();
+    void setDaqForce();
     
     // private attributes - a copy for each object of the class
     ID connectedExternalNodes;          // contains the tags of the end nodes
@@ -166,8 +174,18 @@ private:
     Vector dbLast;      // displacements in basic system at last update
     double tLast;       // time at last update
     
-    static Matrix theMatrix;    // a class wide Matrix
-    static Vector theVector;    // a class wide Vector
+    Vector dg, vg, ag;  // trial response in global system
+    Vector vl, al;      // trial velocities and accelerations in local system
+    Matrix kb, kl;      // stiffness matrices in basic and local system
+    Matrix cb, cl;      // damping matrices in basic and local system
+    Vector ql;          // resisting forces in local system
+    double matStress[4];      // stresses of the uniaxial materials
+    double matTangent[4];     // tangents of the uniaxial materials
+    double matDampTangent[4]; // damping tangents of the uniaxial materials
+    bool daqValid;      // flag if qbDaq is valid for the current update
+    
+    Matrix theMatrix;   // the element matrix
+    Vector theVector;   // the element vector
     Vector theLoad;             // the load vector
     
     bool firstWarning;  // flag to warn about tangent stiffness
@@ -38,9 +38,12 @@
 #include <Renderer.h>
 #include <Information.h>
 #include <ElementResponse.h>
+#include <ExpCheckpoint.h>
 #include <TCP_Socket.h>
 #include <TCP_SocketSSL.h>
 #include <UDP_Socket.h>
+#include <ImpairedChannel.h>
+#include <ChannelOptions.h>
 
 #include <math.h>
 #include <stdlib.h>
@@ -145,7 +148,8 @@ EEGeneric::EEGeneric(int tag, ID nodes, ID *dof,
 EEGeneric::EEGeneric(int tag, ID nodes, ID *dof,
     int port, char *machineInetAddr, int ssl, int udp,
     int dataSize, bool iM, int addRay, const Matrix *m,
-    int checktime)
+    int checktime,
+    const ChannelOptions *options)
     : ExperimentalElement(tag, ELE_TAG_EEGeneric),
     connectedExternalNodes(nodes), basicDOF(1),
     numExternalNodes(0), numDOF(0), numBasicDOF(0),
@@ -213,6 +217,10 @@ EEGeneric::EEGeneric(int tag, ID nodes, ID *dof,
             << "- failed to create channel\n";
         exit(-1);
     }
+    if (options != 0)  {
+        theChannel->setChannelOptions(*options);
+        theChannel = ImpairedChannel::wrap(theChannel, *options);
+    }
     if (theChannel->setUpConnection() != 0)  {
         opserr << "EEGeneric::EEGeneric() "
             << "- failed to setup connection\n";
@@ -815,6 +823,56 @@ void EEGeneric::Print(OPS_Stream &s, int flag)
 }
 
 
+int EEGeneric::saveState(ExpCheckpoint &theCheckpoint)
+{
+    // first save the base class
+    if (this->ExperimentalElement::saveState(theCheckpoint) < 0)
+        return OF_ReturnType_failed;
+    
+    theCheckpoint.save(db);
+    theCheckpoint.save(vb);
+    theCheckpoint.save(ab);
+    theCheckpoint.save(t);
+    theCheckpoint.save(dbDaq);
+    theCheckpoint.save(vbDaq);
+    theCheckpoint.save(abDaq);
+    theCheckpoint.save(qDaq);
+    theCheckpoint.save(tDaq);
+    theCheckpoint.save(&dbCtrl);
+    theCheckpoint.save(&vbCtrl);
+    theCheckpoint.save(&abCtrl);
+    theCheckpoint.save(&kbInit);
+    theCheckpoint.save(&dbLast);
+    
+    return theCheckpoint.save(tLast);
+}
+
+
+int EEGeneric::restoreState(ExpCheckpoint &theCheckpoint)
+{
+    // first restore the base class
+    if (this->ExperimentalElement::restoreState(theCheckpoint) < 0)
+        return OF_ReturnType_failed;
+    
+    theCheckpoint.restore(db);
+    theCheckpoint.restore(vb);
+    theCheckpoint.restore(ab);
+    theCheckpoint.restore(t);
+    theCheckpoint.restore(dbDaq);
+    theCheckpoint.restore(vbDaq);
+    theCheckpoint.restore(abDaq);
+    theCheckpoint.restore(qDaq);
+    theCheckpoint.restore(tDaq);
+    theCheckpoint.restore(&dbCtrl);
+    theCheckpoint.restore(&vbCtrl);
+    theCheckpoint.restore(&abCtrl);
+    theCheckpoint.restore(&kbInit);
+    theCheckpoint.restore(&dbLast);
+    
+    return theCheckpoint.restore(tLast);
+}
+
+
 Response* EEGeneric::setResponse(const char **argv, int argc,
     OPS_Stream &output)
 {
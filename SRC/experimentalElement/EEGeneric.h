@@ -38,6 +38,7 @@
 #include "ExperimentalElement.h"
 
 class Channel;
+class ChannelOptions;
 
 #define ELE_TAG_EEGeneric 9955
 
@@ -54,7 +55,8 @@ public:
         int port, char *machineInetAddress = 0,
         int ssl = 0, int udp = 0, int dataSize = OF_Network_dataSize,
         bool iMod = false, int addRayleigh = 1, const Matrix *mass = 0,
-        int checkTime = 0);
+        int checkTime = 0,
+        const ChannelOptions *options = 0);
     
     // destructor
     ~EEGeneric();
@@ -102,6 +104,10 @@ public:
         float fact, const char **modes = 0, int numModes = 0);
     void Print(OPS_Stream &s, int flag = 0);
     
+    // public methods to save and restore the state for a checkpoint
+    int saveState(ExpCheckpoint &theCheckpoint);
+    int restoreState(ExpCheckpoint &theCheckpoint);
+    
     // public methods for element recorder
     Response *setResponse(const char **argv, int argc, OPS_Stream &s);
     int getResponse(int responseID, Information &eleInfo);
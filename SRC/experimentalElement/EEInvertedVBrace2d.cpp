@@ -38,9 +38,12 @@
 #include <Renderer.h>
 #include <Information.h>
 #include <ElementResponse.h>
+#include <ExpCheckpoint.h>
 #include <TCP_Socket.h>
 #include <TCP_SocketSSL.h>
 #include <UDP_Socket.h>
+#include <ImpairedChannel.h>
+#include <ChannelOptions.h>
 
 #include <math.h>
 #include <stdlib.h>
@@ -125,7 +128,8 @@ EEInvertedVBrace2d::EEInvertedVBrace2d(int tag, int Nd1, int Nd2, int Nd3,
 // by each object and storing the tags of the end nodes.
 EEInvertedVBrace2d::EEInvertedVBrace2d(int tag, int Nd1, int Nd2, int Nd3,
     int port, char *machineInetAddr, int ssl, int udp, int dataSize,
-    bool iM, bool nlGeomFlag, int addRay, double r1, double r2)
+    bool iM, bool nlGeomFlag, int addRay, double r1, double r2,
+    const ChannelOptions *options)
     : ExperimentalElement(tag, ELE_TAG_EEInvertedVBrace2d),
     connectedExternalNodes(3), iMod(iM), nlGeom(nlGeomFlag),
     addRayleigh(addRay), rho1(r1), rho2(r2), L1(0.0), L2(0.0), theLoad(9),
@@ -174,6 +178,10 @@ EEInvertedVBrace2d::EEInvertedVBrace2d(int tag, int Nd1, int Nd2, int Nd3,
             << "- failed to create channel\n";
         exit(-1);
     }
+    if (options != 0)  {
+        theChannel->setChannelOptions(*options);
+        theChannel = ImpairedChannel::wrap(theChannel, *options);
+    }
     if (theChannel->setUpConnection() != 0)  {
         opserr << "EEInvertedVBrace2d::EEInvertedVBrace2d() "
             << "- failed to setup connection\n";
@@ -874,6 +882,56 @@ void EEInvertedVBrace2d::Print(OPS_Stream &s, int flag)
 }
 
 
+int EEInvertedVBrace2d::saveState(ExpCheckpoint &theCheckpoint)
+{
+    // first save the base class
+    if (this->ExperimentalElement::saveState(theCheckpoint) < 0)
+        return OF_ReturnType_failed;
+    
+    theCheckpoint.save(db);
+    theCheckpoint.save(vb);
+    theCheckpoint.save(ab);
+    theCheckpoint.save(t);
+    theCheckpoint.save(dbDaq);
+    theCheckpoint.save(vbDaq);
+    theCheckpoint.save(abDaq);
+    theCheckpoint.save(qDaq);
+    theCheckpoint.save(tDaq);
+    theCheckpoint.save(&dbCtrl);
+    theCheckpoint.save(&vbCtrl);
+    theCheckpoint.save(&abCtrl);
+    theCheckpoint.save(&kbInit);
+    theCheckpoint.save(&dbLast);
+    
+    return theCheckpoint.save(tLast);
+}
+
+
+int EEInvertedVBrace2d::restoreState(ExpCheckpoint &theCheckpoint)
+{
+    // first restore the base class
+    if (this->ExperimentalElement::restoreState(theCheckpoint) < 0)
+        return OF_ReturnType_failed;
+    
+    theCheckpoint.restore(db);
+    theCheckpoint.restore(vb);
+    theCheckpoint.restore(ab);
+    theCheckpoint.restore(t);
+    theCheckpoint.restore(dbDaq);
+    theCheckpoint.restore(vbDaq);
+    theCheckpoint.restore(abDaq);
+    theCheckpoint.restore(qDaq);
+    theCheckpoint.restore(tDaq);
+    theCheckpoint.restore(&dbCtrl);
+    theCheckpoint.restore(&vbCtrl);
+    theCheckpoint.restore(&abCtrl);
+    theCheckpoint.restore(&kbInit);
+    theCheckpoint.restore(&dbLast);
+    
+    return theCheckpoint.restore(tLast);
+}
+
+
 Response* EEInvertedVBrace2d::setResponse(const char **argv, int argc,
     OPS_Stream &output)
 {
@@ -38,9 +38,12 @@
 #include <Renderer.h>
 #include <Information.h>
 #include <ElementResponse.h>
+#include <ExpCheckpoint.h>
 #include <TCP_Socket.h>
 #include <TCP_SocketSSL.h>
 #include <UDP_Socket.h>
+#include <ImpairedChannel.h>
+#include <ChannelOptions.h>
 
 #include <math.h>
 #include <stdlib.h>
@@ -138,7 +141,8 @@ EETruss::EETruss(int tag, int dim, int Nd1, int Nd2,
 EETruss::EETruss(int tag, int dim, int Nd1, int Nd2,
     int port, char *machineInetAddr, int ssl, int udp,
     int dataSize, ExperimentalTangentStiff *tang,
-    bool iM, int addRay, double r, bool cm)
+    bool iM, int addRay, double r, bool cm,
+    const ChannelOptions *options)
     : ExperimentalElement(tag, ELE_TAG_EETruss, NULL, tang),
     numDIM(dim), numDOF(0), connectedExternalNodes(2),
     iMod(iM), addRayleigh(addRay), rho(r), cMass(cm), L(0.0),
@@ -194,6 +198,10 @@ EETruss::EETruss(int tag, int dim, int Nd1, int Nd2,
             << "- failed to create channel\n";
         exit(-1);
     }
+    if (options != 0)  {
+        theChannel->setChannelOptions(*options);
+        theChannel = ImpairedChannel::wrap(theChannel, *options);
+    }
     if (theChannel->setUpConnection() != 0)  {
         opserr << "EETruss::EETruss() "
             << "- failed to setup connection\n";
@@ -949,6 +957,66 @@ void EETruss::Print(OPS_Stream &s, int flag)
 }
 
 
+int EETruss::saveState(ExpCheckpoint &theCheckpoint)
+{
+    // first save the base class
+    if (this->ExperimentalElement::saveState(theCheckpoint) < 0)
+        return OF_ReturnType_failed;
+    
+    theCheckpoint.save(db);
+    theCheckpoint.save(vb);
+    theCheckpoint.save(ab);
+    theCheckpoint.save(t);
+    theCheckpoint.save(dbDaq);
+    theCheckpoint.save(vbDaq);
+    theCheckpoint.save(abDaq);
+    theCheckpoint.save(qbDaq);
+    theCheckpoint.save(tDaq);
+    theCheckpoint.save(&dbCtrl);
+    theCheckpoint.save(&vbCtrl);
+    theCheckpoint.save(&abCtrl);
+    theCheckpoint.save(&kbInit);
+    theCheckpoint.save(&kb);
+    theCheckpoint.save(&kbLast);
+    theCheckpoint.save(&dbDaqLast);
+    theCheckpoint.save(&qbDaqLast);
+    theCheckpoint.save(&dbLast);
+    theCheckpoint.save(tLast);
+    
+    return theCheckpoint.save(int(firstWarning));
+}
+
+
+int EETruss::restoreState(ExpCheckpoint &theCheckpoint)
+{
+    // first restore the base class
+    if (this->ExperimentalElement::restoreState(theCheckpoint) < 0)
+        return OF_ReturnType_failed;
+    
+    theCheckpoint.restore(db);
+    theCheckpoint.restore(vb);
+    theCheckpoint.restore(ab);
+    theCheckpoint.restore(t);
+    theCheckpoint.restore(dbDaq);
+    theCheckpoint.restore(vbDaq);
+    theCheckpoint.restore(abDaq);
+    theCheckpoint.restore(qbDaq);
+    theCheckpoint.restore(tDaq);
+    theCheckpoint.restore(&dbCtrl);
+    theCheckpoint.restore(&vbCtrl);
+    theCheckpoint.restore(&abCtrl);
+    theCheckpoint.restore(&kbInit);
+    theCheckpoint.restore(&kb);
+    theCheckpoint.restore(&kbLast);
+    theCheckpoint.restore(&dbDaqLast);
+    theCheckpoint.restore(&qbDaqLast);
+    theCheckpoint.restore(&dbLast);
+    theCheckpoint.restore(tLast);
+    
+    return theCheckpoint.restore(firstWarning);
+}
+
+
 Response* EETruss::setResponse(const char **argv, int argc,
     OPS_Stream &output)
 {
@@ -38,9 +38,12 @@
 #include <Renderer.h>
 #include <Information.h>
 #include <ElementResponse.h>
+#include <ExpCheckpoint.h>
 #include <TCP_Socket.h>
 #include <TCP_SocketSSL.h>
 #include <UDP_Socket.h>
+#include <ImpairedChannel.h>
+#include <ChannelOptions.h>
 
 #include <math.h>
 #include <stdlib.h>
@@ -134,7 +137,8 @@ EETrussCorot::EETrussCorot(int tag, int dim, int Nd1, int Nd2,
 EETrussCorot::EETrussCorot(int tag, int dim, int Nd1, int Nd2,
     int port, char *machineInetAddr, int ssl, int udp,
     int dataSize, ExperimentalTangentStiff *tang,
-    bool iM, int addRay, double r, bool cm)
+    bool iM, int addRay, double r, bool cm,
+    const ChannelOptions *options)
     : ExperimentalElement(tag, ELE_TAG_EETrussCorot, NULL, tang),
     numDIM(dim), numDOF(0), connectedExternalNodes(2),
     iMod(iM), addRayleigh(addRay), rho(r), cMass(cm),
@@ -186,6 +190,10 @@ EETrussCorot::EETrussCorot(int tag, int dim, int Nd1, int Nd2,
             << "- failed to create channel\n";
         exit(-1);
     }
+    if (options != 0)  {
+        theChannel->setChannelOptions(*options);
+        theChannel = ImpairedChannel::wrap(theChannel, *options);
+    }
     if (theChannel->setUpConnection() != 0)  {
         opserr << "EETrussCorot::EETrussCorot() "
             << "- failed to setup connection\n";
@@ -1062,6 +1070,66 @@ void EETrussCorot::Print(OPS_Stream &s, int flag)
 }
 
 
+int EETrussCorot::saveState(ExpCheckpoint &theCheckpoint)
+{
+    // first save the base class
+    if (this->ExperimentalElement::saveState(theCheckpoint) < 0)
+        return OF_ReturnType_failed;
+    
+    theCheckpoint.save(db);
+    theCheckpoint.save(vb);
+    theCheckpoint.save(ab);
+    theCheckpoint.save(t);
+    theCheckpoint.save(dbDaq);
+    theCheckpoint.save(vbDaq);
+    theCheckpoint.save(abDaq);
+    theCheckpoint.save(qbDaq);
+    theCheckpoint.save(tDaq);
+    theCheckpoint.save(&dbCtrl);
+    theCheckpoint.save(&vbCtrl);
+    theCheckpoint.save(&abCtrl);
+    theCheckpoint.save(&kbInit);
+    theCheckpoint.save(&kb);
+    theCheckpoint.save(&kbLast);
+    theCheckpoint.save(&dbDaqLast);
+    theCheckpoint.save(&qbDaqLast);
+    theCheckpoint.save(&dbLast);
+    theCheckpoint.save(tLast);
+    
+    return theCheckpoint.save(int(firstWarning));
+}
+
+
+int EETrussCorot::restoreState(ExpCheckpoint &theCheckpoint)
+{
+    // first restore the base class
+    if (this->ExperimentalElement::restoreState(theCheckpoint) < 0)
+        return OF_ReturnType_failed;
+    
+    theCheckpoint.restore(db);
+    theCheckpoint.restore(vb);
+    theCheckpoint.restore(ab);
+    theCheckpoint.restore(t);
+    theCheckpoint.restore(dbDaq);
+    theCheckpoint.restore(vbDaq);
+    theCheckpoint.restore(abDaq);
+    theCheckpoint.restore(qbDaq);
+    theCheckpoint.restore(tDaq);
+    theCheckpoint.restore(&dbCtrl);
+    theCheckpoint.restore(&vbCtrl);
+    theCheckpoint.restore(&abCtrl);
+    theCheckpoint.restore(&kbInit);
+    theCheckpoint.restore(&kb);
+    theCheckpoint.restore(&kbLast);
+    theCheckpoint.restore(&dbDaqLast);
+    theCheckpoint.restore(&qbDaqLast);
+    theCheckpoint.restore(&dbLast);
+    theCheckpoint.restore(tLast);
+    
+    return theCheckpoint.restore(firstWarning);
+}
+
+
 Response* EETrussCorot::setResponse(const char **argv, int argc,
     OPS_Stream &output)
 {
@@ -39,6 +39,7 @@
 #include "ExperimentalElement.h"
 
 class Channel;
+class ChannelOptions;
 
 #define ELE_TAG_EETrussCorot 9956
 
@@ -57,7 +58,8 @@ public:
         int ssl = 0, int udp = 0, int dataSize = OF_Network_dataSize,
         ExperimentalTangentStiff *tangStiff = 0,
         bool iMod = false, int addRayleigh = 1,
-        double rho = 0.0, bool cMass = false);
+        double rho = 0.0, bool cMass = false,
+        const ChannelOptions *options = 0);
     
     // destructor
     ~EETrussCorot();
@@ -107,6 +109,10 @@ public:
         float fact, const char **modes = 0, int numModes = 0);
     void Print(OPS_Stream &s, int flag = 0);
     
+    // public methods to save and restore the state for a checkpoint
+    int saveState(ExpCheckpoint &theCheckpoint);
+    int restoreState(ExpCheckpoint &theCheckpoint);
+    
     // public methods for element recorder
     Response *setResponse(const char **argv, int argc, OPS_Stream &s);
     int getResponse(int responseID, Information &eleInfo);
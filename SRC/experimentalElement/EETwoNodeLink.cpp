@@ -38,9 +38,12 @@
 #include <Renderer.h>
 #include <Information.h>
 #include <ElementResponse.h>
+#include <ExpCheckpoint.h>
 #include <TCP_Socket.h>
 #include <TCP_SocketSSL.h>
 #include <UDP_Socket.h>
+#include <ImpairedChannel.h>
+#include <ChannelOptions.h>
 
 #include <float.h>
 #include <math.h>
@@ -203,7 +206,8 @@ EETwoNodeLink::EETwoNodeLink(int tag, int dim, int Nd1, int Nd2,
     const ID &direction, int port, char *machineInetAddr,
     int ssl, int udp, int dataSize, ExperimentalTangentStiff *tang,
     const Vector _y, const Vector _x, const Vector Mr,
-    const Vector sdI, bool iM, int addRay, double m)
+    const Vector sdI, bool iM, int addRay, double m,
+    const ChannelOptions *options)
     : ExperimentalElement(tag, ELE_TAG_EETwoNodeLink, NULL, tang),
     dimension(dim), numDOF(0), connectedExternalNodes(2),
     numDir(direction.Size()), dir(0), trans(3,3), x(_x), y(_y),
@@ -322,6 +326,10 @@ EETwoNodeLink::EETwoNodeLink(int tag, int dim, int Nd1, int Nd2,
             << "- failed to create channel\n";
         exit(-1);
     }
+    if (options != 0)  {
+        theChannel->setChannelOptions(*options);
+        theChannel = ImpairedChannel::wrap(theChannel, *options);
+    }
     if (theChannel->setUpConnection() != 0)  {
         opserr << "EETwoNodeLink::EETwoNodeLink() "
             << "- failed to setup connection\n";
@@ -1078,6 +1086,66 @@ void EETwoNodeLink::Print(OPS_Stream &s, int flag)
 }
 
 
+int EETwoNodeLink::saveState(ExpCheckpoint &theCheckpoint)
+{
+    // first save the base class
+    if (this->ExperimentalElement::saveState(theCheckpoint) < 0)
+        return OF_ReturnType_failed;
+    
+    theCheckpoint.save(db);
+    theCheckpoint.save(vb);
+    theCheckpoint.save(ab);
+    theCheckpoint.save(t);
+    theCheckpoint.save(dbDaq);
+    theCheckpoint.save(vbDaq);
+    theCheckpoint.save(abDaq);
+    theCheckpoint.save(qbDaq);
+    theCheckpoint.save(tDaq);
+    theCheckpoint.save(&dbCtrl);
+    theCheckpoint.save(&vbCtrl);
+    theCheckpoint.save(&abCtrl);
+    theCheckpoint.save(&kbInit);
+    theCheckpoint.save(&kb);
+    theCheckpoint.save(&kbLast);
+    theCheckpoint.save(&dbDaqLast);
+    theCheckpoint.save(&qbDaqLast);
+    theCheckpoint.save(&dbLast);
+    theCheckpoint.save(tLast);
+    
+    return theCheckpoint.save(int(firstWarning));
+}
+
+
+int EETwoNodeLink::restoreState(ExpCheckpoint &theCheckpoint)
+{
+    // first restore the base class
+    if (this->ExperimentalElement::restoreState(theCheckpoint) < 0)
+        return OF_ReturnType_failed;
+    
+    theCheckpoint.restore(db);
+    theCheckpoint.restore(vb);
+    theCheckpoint.restore(ab);
+    theCheckpoint.restore(t);
+    theCheckpoint.restore(dbDaq);
+    theCheckpoint.restore(vbDaq);
+    theCheckpoint.restore(abDaq);
+    theCheckpoint.restore(qbDaq);
+    theCheckpoint.restore(tDaq);
+    theCheckpoint.restore(&dbCtrl);
+    theCheckpoint.restore(&vbCtrl);
+    theCheckpoint.restore(&abCtrl);
+    theCheckpoint.restore(&kbInit);
+    theCheckpoint.restore(&kb);
+    theCheckpoint.restore(&kbLast);
+    theCheckpoint.restore(&dbDaqLast);
+    theCheckpoint.restore(&qbDaqLast);
+    theCheckpoint.restore(&dbLast);
+    theCheckpoint.restore(tLast);
+    
+    return theCheckpoint.restore(firstWarning);
+}
+
+
 Response* EETwoNodeLink::setResponse(const char **argv, int argc,
     OPS_Stream &output)
 {
@@ -38,6 +38,7 @@
 #include "ExperimentalElement.h"
 
 class Channel;
+class ChannelOptions;
 
 // Type of dimension of element NxDy has dimension x=1,2,3 and
 // y=2,4,6,12 degrees-of-freedom for the element
@@ -64,7 +65,8 @@ public:
         ExperimentalTangentStiff *tangStiff = 0,
         const Vector y = 0, const Vector x = 0, const Vector Mratio = 0,
         const Vector shearDistI = 0, bool iMod = false,
-        int addRayleigh = 1, double mass = 0.0);
+        int addRayleigh = 1, double mass = 0.0,
+        const ChannelOptions *options = 0);
     
     // destructor
     ~EETwoNodeLink();
@@ -114,6 +116,10 @@ public:
         float fact, const char **modes = 0, int numModes = 0);
     void Print(OPS_Stream &s, int flag = 0);
     
+    // public methods to save and restore the state for a checkpoint
+    int saveState(ExpCheckpoint &theCheckpoint);
+    int restoreState(ExpCheckpoint &theCheckpoint);
+    
     // public methods for element recorder
     Response *setResponse(const char **argv, int argc, OPS_Stream &s);
     int getResponse(int responseID, Information &eleInfo);
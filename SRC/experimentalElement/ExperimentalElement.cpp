@@ -39,6 +39,7 @@
 #include <ElementResponse.h>
 #include <Node.h>
 #include <Renderer.h>
+#include <ExpCheckpoint.h>
 
 #include <math.h>
 #include <stdlib.h>
@@ -140,6 +141,38 @@ const Vector& ExperimentalElement::getTime()
 }
 
 
+int ExperimentalElement::saveState(ExpCheckpoint &theCheckpoint)
+{
+    theCheckpoint.beginObject(this->getClassType(), this->getTag());
+    theCheckpoint.save(&theInitStiff);
+    theCheckpoint.save(int(firstWarning));
+    
+    // then save the tangent stiffness
+    if (theTangStiff != 0)
+        return theTangStiff->saveState(theCheckpoint);
+    
+    return OF_ReturnType_completed;
+}
+
+
+int ExperimentalElement::restoreState(ExpCheckpoint &theCheckpoint)
+{
+    if (theCheckpoint.checkObject(this->getClassType(), this->getTag()) < 0 ||
+        theCheckpoint.restore(&theInitStiff) < 0 ||
+        theCheckpoint.restore(firstWarning) < 0)  {
+        opserr << "ExperimentalElement::restoreState() - "
+            << "failed to restore state of element " << this->getTag() << endln;
+        return OF_ReturnType_failed;
+    }
+    
+    // then restore the tangent stiffness
+    if (theTangStiff != 0)
+        return theTangStiff->restoreState(theCheckpoint);
+    
+    return OF_ReturnType_completed;
+}
+
+
 int ExperimentalElement::revertToLastCommit()
 {
     opserr << "ExperimentalElement::revertToLastCommit() - "
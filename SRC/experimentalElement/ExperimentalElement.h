@@ -43,6 +43,8 @@
 #include <Element.h>
 #include <Matrix.h>
 
+class ExpCheckpoint;
+
 class ExperimentalElement : public Element
 {
 public:
@@ -69,6 +71,10 @@ public:
     virtual const Vector &getVel();
     virtual const Vector &getAccel();
     virtual const Vector &getTime();
+    
+    // public methods to save and restore the state for a checkpoint
+    virtual int saveState(ExpCheckpoint &theCheckpoint);
+    virtual int restoreState(ExpCheckpoint &theCheckpoint);
 
 protected:
     // pointer to ExperimentalSite object
@@ -38,6 +38,7 @@
 
 #include <EEBeamColumn2d.h>
 #include <EEBeamColumn3d.h>
+#include <ChannelOptions.h>
 
 extern ExperimentalSite *getExperimentalSite(int tag);
 
@@ -82,6 +83,8 @@ int addEEBeamColumn(ClientData clientData, Tcl_Interp *interp, int argc,
         ExperimentalSite *theSite = 0;
         char *ipAddr = 0;
         int ssl = 0, udp = 0;
+        int numArgs;
+        ChannelOptions theOptions;
         int dataSize = OF_Network_dataSize;
         bool iMod = false;
         int doRayleigh = 1;
@@ -156,6 +159,14 @@ int addEEBeamColumn(ClientData clientData, Tcl_Interp *interp, int argc,
                         return TCL_ERROR;
                     }
                 }
+                else if ((numArgs = theOptions.parse(argc-i, &argv[i])) != 0)  {
+                    if (numArgs < 0)  {
+                        opserr << "WARNING invalid channel option\n";
+                        opserr << "expElement beamColumn element: " << tag << endln;
+                        return TCL_ERROR;
+                    }
+                    i += numArgs-1;
+                }
             }
         }
         else  {
@@ -197,7 +208,7 @@ int addEEBeamColumn(ClientData clientData, Tcl_Interp *interp, int argc,
                 theSite, iMod, doRayleigh, rho, cMass);
         } else  {
             theExpElement = new EEBeamColumn2d(tag, iNode, jNode, *theTrans,
-                ipPort, ipAddr, ssl, udp, dataSize, iMod, doRayleigh, rho, cMass);
+                ipPort, ipAddr, ssl, udp, dataSize, iMod, doRayleigh, rho, cMass, &theOptions);
         }
         
         if (theExpElement == 0) {
@@ -268,6 +279,8 @@ int addEEBeamColumn(ClientData clientData, Tcl_Interp *interp, int argc,
         ExperimentalSite *theSite = 0;
         char *ipAddr = 0;
         int ssl = 0, udp = 0;
+        int numArgs;
+        ChannelOptions theOptions;
         int dataSize = OF_Network_dataSize;
         bool iMod = false;
         int doRayleigh = 1;
@@ -342,6 +355,14 @@ int addEEBeamColumn(ClientData clientData, Tcl_Interp *interp, int argc,
                         return TCL_ERROR;
                     }
                 }
+                else if ((numArgs = theOptions.parse(argc-i, &argv[i])) != 0)  {
+                    if (numArgs < 0)  {
+                        opserr << "WARNING invalid channel option\n";
+                        opserr << "expElement beamColumn element: " << tag << endln;
+                        return TCL_ERROR;
+                    }
+                    i += numArgs-1;
+                }
             }
         }
         else  {
@@ -383,7 +404,7 @@ int addEEBeamColumn(ClientData clientData, Tcl_Interp *interp, int argc,
                 theSite, iMod, doRayleigh, rho, cMass);
         } else  {
             theExpElement = new EEBeamColumn3d(tag, iNode, jNode, *theTrans,
-                ipPort, ipAddr, ssl, udp, dataSize, iMod, doRayleigh, rho, cMass);
+                ipPort, ipAddr, ssl, udp, dataSize, iMod, doRayleigh, rho, cMass, &theOptions);
         }
         
         if (theExpElement == 0) {
@@ -38,6 +38,7 @@
 
 #include <EEBearing2d.h>
 #include <EEBearing3d.h>
+#include <ChannelOptions.h>
 
 extern ExperimentalSite *getExperimentalSite(int tag);
 
@@ -82,6 +83,8 @@ int addEEBearing(ClientData clientData, Tcl_Interp *interp, int argc,
         ExperimentalSite *theSite = 0;
         char *ipAddr = 0;
         int ssl = 0, udp = 0;
+        int numArgs;
+        ChannelOptions theOptions;
         int dataSize = OF_Network_dataSize;
         Vector Mratio(0);
         double shearDistI = 0.5;
@@ -179,6 +182,14 @@ int addEEBearing(ClientData clientData, Tcl_Interp *interp, int argc,
 		                return TCL_ERROR;
 	                }
                 }
+                else if ((numArgs = theOptions.parse(argc-i, &argv[i])) != 0)  {
+                    if (numArgs < 0)  {
+                        opserr << "WARNING invalid channel option\n";
+                        opserr << "expElement bearing element: " << tag << endln;
+                        return TCL_ERROR;
+                    }
+                    i += numArgs-1;
+                }
             }
         }
         else  {
@@ -286,7 +297,7 @@ int addEEBearing(ClientData clientData, Tcl_Interp *interp, int argc,
         } else  {
 		    theExpElement = new EEBearing2d(tag, iNode, jNode, pFrcCtrl, theMaterials,
                 ipPort, ipAddr, ssl, udp, dataSize, y, x, Mratio, shearDistI,
-                iMod, doRayleigh, mass);
+                iMod, doRayleigh, mass, &theOptions);
         }
 		
 		if (theExpElement == 0) {
@@ -357,6 +368,8 @@ int addEEBearing(ClientData clientData, Tcl_Interp *interp, int argc,
         ExperimentalSite *theSite = 0;
         char *ipAddr = 0;
         int ssl = 0, udp = 0;
+        int numArgs;
+        ChannelOptions theOptions;
         int dataSize = OF_Network_dataSize;
         Vector Mratio(0);
         double shearDistI = 0.5;
@@ -482,6 +495,14 @@ int addEEBearing(ClientData clientData, Tcl_Interp *interp, int argc,
 		                return TCL_ERROR;
 	                }
                 }
+                else if ((numArgs = theOptions.parse(argc-i, &argv[i])) != 0)  {
+                    if (numArgs < 0)  {
+                        opserr << "WARNING invalid channel option\n";
+                        opserr << "expElement bearing element: " << tag << endln;
+                        return TCL_ERROR;
+                    }
+                    i += numArgs-1;
+                }
             }
         }
         else  {
@@ -601,7 +622,7 @@ int addEEBearing(ClientData clientData, Tcl_Interp *interp, int argc,
         } else  {
 		    theExpElement = new EEBearing3d(tag, iNode, jNode, pFrcCtrl, theMaterials,
                 ipPort, ipAddr, ssl, udp, dataSize, y, x, Mratio, shearDistI,
-                iMod, doRayleigh, mass);
+                iMod, doRayleigh, mass, &theOptions);
         }
 		
 		if (theExpElement == 0) {
@@ -36,6 +36,7 @@
 #include <Domain.h>
 
 #include <EEGeneric.h>
+#include <ChannelOptions.h>
 
 extern ExperimentalSite *getExperimentalSite(int tag);
 
@@ -69,6 +70,8 @@ int addEEGeneric(ClientData clientData, Tcl_Interp *interp,  int argc,
     ExperimentalSite *theSite = 0;
     char *ipAddr = 0;
     int ssl = 0, udp = 0;
+    int numArgs;
+    ChannelOptions theOptions;
     int dataSize = OF_Network_dataSize;
     bool iMod = false;
     int doRayleigh = 1;
@@ -193,6 +196,14 @@ int addEEGeneric(ClientData clientData, Tcl_Interp *interp,  int argc,
                     return TCL_ERROR;
                 }
             }
+            else if ((numArgs = theOptions.parse(argc-i, &argv[i])) != 0)  {
+                if (numArgs < 0)  {
+                    opserr << "WARNING invalid channel option\n";
+                    opserr << "expElement generic element: " << tag << endln;
+                    return TCL_ERROR;
+                }
+                i += numArgs-1;
+            }
         }
     }
     else  {
@@ -247,7 +258,7 @@ int addEEGeneric(ClientData clientData, Tcl_Interp *interp,  int argc,
     } else  {
         theExpElement = new EEGeneric(tag, nodes, dofs, ipPort,
             ipAddr, ssl, udp, dataSize, iMod, doRayleigh, mass,
-            checkTime);
+            checkTime, &theOptions);
     }
     
     // cleanup dynamic memory
@@ -37,6 +37,7 @@
 #include <elementAPI.h>
 
 #include <EEInvertedVBrace2d.h>
+#include <ChannelOptions.h>
 
 extern ExperimentalSite *getExperimentalSite(int tag);
 
@@ -80,6 +81,8 @@ int addEEInvertedVBrace(ClientData clientData, Tcl_Interp *interp, int argc,
         ExperimentalSite *theSite = 0;
         char *ipAddr = 0;
         int ssl = 0, udp = 0;
+        int numArgs;
+        ChannelOptions theOptions;
         int dataSize = OF_Network_dataSize;
         bool iMod = false;
         bool nlGeom = false;
@@ -149,6 +152,14 @@ int addEEInvertedVBrace(ClientData clientData, Tcl_Interp *interp, int argc,
 		                return TCL_ERROR;
 	                }
                 }
+                else if ((numArgs = theOptions.parse(argc-i, &argv[i])) != 0)  {
+                    if (numArgs < 0)  {
+                        opserr << "WARNING invalid channel option\n";
+                        opserr << "expElement invertedVBrace element: " << tag << endln;
+                        return TCL_ERROR;
+                    }
+                    i += numArgs-1;
+                }
             }
         }
         else  {
@@ -198,7 +209,7 @@ int addEEInvertedVBrace(ClientData clientData, Tcl_Interp *interp, int argc,
         } else  {
 		    theExpElement = new EEInvertedVBrace2d(tag, iNode, jNode, kNode,
                 ipPort, ipAddr, ssl, udp, dataSize, iMod, nlGeom, doRayleigh,
-                rho1, rho2);
+                rho1, rho2, &theOptions);
         }
 		
 		if (theExpElement == 0) {
@@ -38,6 +38,7 @@
 
 #include <EETruss.h>
 #include <EETrussCorot.h>
+#include <ChannelOptions.h>
 
 extern ExperimentalSite *getExperimentalSite(int tag);
 extern ExperimentalTangentStiff *getExperimentalTangentStiff(int tag);
@@ -73,6 +74,8 @@ int addEETruss(ClientData clientData, Tcl_Interp *interp,  int argc,
     ExperimentalTangentStiff *theTangStif = 0;
     char *ipAddr = 0;
     int ssl = 0, udp = 0;
+    int numArgs;
+    ChannelOptions theOptions;
     int dataSize = OF_Network_dataSize;
     bool iMod = false;
     int doRayleigh = 1;
@@ -136,6 +139,14 @@ int addEETruss(ClientData clientData, Tcl_Interp *interp,  int argc,
                     return TCL_ERROR;
                 }
             }
+            else if ((numArgs = theOptions.parse(argc-i, &argv[i])) != 0)  {
+                if (numArgs < 0)  {
+                    opserr << "WARNING invalid channel option\n";
+                    opserr << "expElement truss element: " << tag << endln;
+                    return TCL_ERROR;
+                }
+                i += numArgs-1;
+            }
         }
     }
     else  {
@@ -195,7 +206,7 @@ int addEETruss(ClientData clientData, Tcl_Interp *interp,  int argc,
         } else  {
             theExpElement = new EETruss(tag, ndm, iNode, jNode,
                 ipPort, ipAddr, ssl, udp, dataSize, theTangStif,
-                iMod, doRayleigh, rho, cMass);
+                iMod, doRayleigh, rho, cMass, &theOptions);
         }
     } else if (strcmp(argv[eleArgStart], "corotTruss") == 0)  {
         if (theSite != 0)  {
@@ -204,7 +215,7 @@ int addEETruss(ClientData clientData, Tcl_Interp *interp,  int argc,
         } else  {
             theExpElement = new EETrussCorot(tag, ndm, iNode, jNode,
                 ipPort, ipAddr, ssl, udp, dataSize, theTangStif,
-                iMod, doRayleigh, rho, cMass);
+                iMod, doRayleigh, rho, cMass, &theOptions);
         }
     }
     
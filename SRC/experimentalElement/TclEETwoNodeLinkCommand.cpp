@@ -39,6 +39,7 @@
 #include <elementAPI.h>
 
 #include <EETwoNodeLink.h>
+#include <ChannelOptions.h>
 
 extern ExperimentalSite *getExperimentalSite(int tag);
 extern ExperimentalTangentStiff *getExperimentalTangentStiff(int tag);
@@ -75,6 +76,8 @@ int addEETwoNodeLink(ClientData clientData, Tcl_Interp *interp, int argc,
     ExperimentalTangentStiff *theTangStif = 0;
     char *ipAddr = 0;
     int ssl = 0, udp = 0;
+    int numArgs;
+    ChannelOptions theOptions;
     int dataSize = OF_Network_dataSize;
     Vector Mratio(0), shearDistI(0);
     bool iMod = false;
@@ -181,6 +184,14 @@ int addEETwoNodeLink(ClientData clientData, Tcl_Interp *interp, int argc,
                     return TCL_ERROR;
                 }
             }
+            else if ((numArgs = theOptions.parse(argc-i, &argv[i])) != 0)  {
+                if (numArgs < 0)  {
+                    opserr << "WARNING invalid channel option\n";
+                    opserr << "expElement twoNodeLink element: " << tag << endln;
+                    return TCL_ERROR;
+                }
+                i += numArgs-1;
+            }
         }
     }
     else  {
@@ -347,7 +358,7 @@ int addEETwoNodeLink(ClientData clientData, Tcl_Interp *interp, int argc,
     } else  {
         theExpElement = new EETwoNodeLink(tag, ndm, iNode, jNode, theDirIDs,
             ipPort, ipAddr, ssl, udp, dataSize, theTangStif, y, x, Mratio,
-            shearDistI, iMod, doRayleigh, mass);
+            shearDistI, iMod, doRayleigh, mass, &theOptions);
     }
     
     if (theExpElement == 0)  {
@@ -0,0 +1,202 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// $Revision$
+// $Date$
+// $URL$
+
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the implementatation of
+// ExpCheckpointRecorder.
+
+#include <ExpCheckpointRecorder.h>
+#include <ExpCheckpoint.h>
+#include <ExperimentalSite.h>
+#include <ExperimentalElement.h>
+#include <Domain.h>
+#include <Node.h>
+#include <NodeIter.h>
+#include <ElementIter.h>
+
+#include <string.h>
+
+
+ExpCheckpointRecorder::ExpCheckpointRecorder(const char *filename,
+    int numsteps, int numsites, ExperimentalSite** thesites,
+    Domain &thedomain)
+    : Recorder(RECORDER_TAGS_ExpCheckpointRecorder),
+    fileName(0), numSteps(numsteps), numSites(numsites),
+    theSites(thesites), theDomain(&thedomain), numCommits(0)
+{
+    fileName = new char [strlen(filename)+1];
+    strcpy(fileName, filename);
+    
+    if (numSteps < 1)
+        numSteps = 1;
+}
+
+
+ExpCheckpointRecorder::~ExpCheckpointRecorder()
+{
+    if (fileName != 0)
+        delete [] fileName;
+    if (theSites != 0)
+        delete [] theSites;
+}
+
+
+int ExpCheckpointRecorder::record(int commitTag, double timeStamp)
+{
+    if (++numCommits < numSteps)
+        return 0;
+    numCommits = 0;
+    
+    // the domain increments its commitTag after the recorders
+    if (this->saveModel(fileName, *theDomain, numSites, theSites,
+        commitTag+1) < 0)  {
+        opserr << "ExpCheckpointRecorder::record() - "
+            << "failed to write checkpoint at time " << timeStamp << endln;
+        return -1;
+    }
+    
+    return 0;
+}
+
+
+int ExpCheckpointRecorder::restart()
+{
+    numCommits = 0;
+    
+    return 0;
+}
+
+
+int ExpCheckpointRecorder::saveModel(const char *fileName,
+    Domain &theDomain, int numSites, ExperimentalSite **theSites,
+    int commitTag)
+{
+    ExpCheckpoint theCheckpoint(fileName);
+    if (theCheckpoint.openWrite() < 0)
+        return -1;
+    
+    // save the time of the domain
+    theCheckpoint.save(commitTag);
+    theCheckpoint.save(theDomain.getCurrentTime());
+    
+    // save the committed response of the nodes
+    Node *theNode;
+    NodeIter &theNodes = theDomain.getNodes();
+    while ((theNode = theNodes()) != 0)  {
+        theCheckpoint.beginObject("Node", theNode->getTag());
+        theCheckpoint.save(&theNode->getDisp());
+        theCheckpoint.save(&theNode->getVel());
+        theCheckpoint.save(&theNode->getAccel());
+    }
+    
+    // save the sites
+    for (int i=0; i<numSites; i++)
+        theSites[i]->saveState(theCheckpoint);
+    
+    // save the experimental elements
+    Element *theEle;
+    ElementIter &theElements = theDomain.getElements();
+    while ((theEle = theElements()) != 0)  {
+        ExperimentalElement *theExpEle = dynamic_cast<ExperimentalElement *>(theEle);
+        if (theExpEle != 0)
+            theExpEle->saveState(theCheckpoint);
+    }
+    
+    return theCheckpoint.close();
+}
+
+
+int ExpCheckpointRecorder::restoreModel(const char *fileName,
+    Domain &theDomain, int numSites, ExperimentalSite **theSites)
+{
+    int i, commitTag = 0;
+    double time = 0.0;
+    bool failed = false;
+    
+    ExpCheckpoint theCheckpoint(fileName);
+    if (theCheckpoint.openRead() < 0)
+        return -1;
+    
+    if (theCheckpoint.restore(commitTag) < 0 ||
+        theCheckpoint.restore(time) < 0)
+        failed = true;
+    
+    // restore the committed response of the nodes
+    Node *theNode;
+    NodeIter &theNodes = theDomain.getNodes();
+    while (!failed && (theNode = theNodes()) != 0)  {
+        Vector disp(theNode->getDisp().Size());
+        Vector vel(theNode->getVel().Size());
+        Vector accel(theNode->getAccel().Size());
+        if (theCheckpoint.checkObject("Node", theNode->getTag()) < 0 ||
+            theCheckpoint.restore(&disp) < 0 ||
+            theCheckpoint.restore(&vel) < 0 ||
+            theCheckpoint.restore(&accel) < 0)  {
+            failed = true;
+            break;
+        }
+        theNode->setTrialDisp(disp);
+        theNode->setTrialVel(vel);
+        theNode->setTrialAccel(accel);
+        theNode->commitState();
+    }
+    
+    // restore the sites, this sends the last
+    // committed trial response to the specimens
+    for (i=0; i<numSites && !failed; i++)  {
+        if (theSites[i]->restoreState(theCheckpoint) < 0)
+            failed = true;
+    }
+    
+    // restore the experimental elements
+    Element *theEle;
+    ElementIter &theElements = theDomain.getElements();
+    while (!failed && (theEle = theElements()) != 0)  {
+        ExperimentalElement *theExpEle = dynamic_cast<ExperimentalElement *>(theEle);
+        if (theExpEle != 0 && theExpEle->restoreState(theCheckpoint) < 0)
+            failed = true;
+    }
+    
+    // the whole file has to be used up
+    if (!failed && !theCheckpoint.atEnd())  {
+        opserr << "ExpCheckpointRecorder::restoreModel() - "
+            << fileName << " contains more objects than the model\n";
+        failed = true;
+    }
+    if (failed)  {
+        opserr << "ExpCheckpointRecorder::restoreModel() - "
+            << "failed to restore checkpoint " << fileName << endln;
+        theCheckpoint.close();
+        return -1;
+    }
+    
+    theDomain.setCommitTag(commitTag);
+    theDomain.setCurrentTime(time);
+    theDomain.setCommittedTime(time);
+    
+    return theCheckpoint.close();
+}
@@ -0,0 +1,78 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// $Revision$
+// $Date$
+// $URL$
+
+#ifndef ExpCheckpointRecorder_h
+#define ExpCheckpointRecorder_h
+
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the class definition for
+// ExpCheckpointRecorder. ExpCheckpointRecorder is added to the domain
+// and writes a checkpoint of the hybrid test every numSteps commits,
+// after all the nodes and elements have been committed. The static
+// saveModel and restoreModel methods write and read a checkpoint of
+// the committed response of the nodes, the sites and the experimental
+// elements of a domain, which has to be defined in the same way for
+// restoring.
+
+#include <Recorder.h>
+
+class Domain;
+class ExperimentalSite;
+
+#define RECORDER_TAGS_ExpCheckpointRecorder 105
+
+class ExpCheckpointRecorder: public Recorder
+{
+public:
+    // constructors
+    ExpCheckpointRecorder(const char *fileName, int numSteps,
+        int numSites, ExperimentalSite** theSites, Domain &theDomain);
+    
+    // destructor
+    ~ExpCheckpointRecorder();
+    
+    int record(int commitTag, double timeStamp);
+    int restart();
+    
+    // methods to save and restore a checkpoint of a hybrid test
+    static int saveModel(const char *fileName, Domain &theDomain,
+        int numSites, ExperimentalSite **theSites, int commitTag);
+    static int restoreModel(const char *fileName, Domain &theDomain,
+        int numSites, ExperimentalSite **theSites);
+    
+protected:
+
+private:
+    char *fileName;
+    int numSteps;
+    int numSites;
+    ExperimentalSite **theSites;
+    Domain *theDomain;
+    int numCommits;
+};
+
+#endif
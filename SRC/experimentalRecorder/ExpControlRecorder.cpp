@@ -31,6 +31,7 @@
 
 #include <ExpControlRecorder.h>
 #include <ExperimentalControl.h>
+#include <ExpResponse.h>
 
 
 ExpControlRecorder::ExpControlRecorder(int numcontrols,
@@ -71,7 +72,7 @@ ExpControlRecorder::ExpControlRecorder(int numcontrols,
     // Set the response objects:
     //   1. create an array of pointers and zero them
     //   2. iterate over the controls invoking setResponse() to get the new objects & determine size of data
-    theResponses = new Response *[numControls];
+    theResponses = new ExpResponse *[numControls];
     if (theResponses == 0)  {
         opserr << "ExpControlRecorder::ExpControlRecorder() - out of memory\n";
         exit(OF_ReturnType_failed);
@@ -81,7 +82,12 @@ ExpControlRecorder::ExpControlRecorder(int numcontrols,
     
     // loop over controls & set Responses
     for (int i=0; i<numControls; i++)  {
-        theResponses[i] = theControls[i]->setResponse((const char **)responseArgs, numArgs, *theOutputStream);
+        Response *theResponse = theControls[i]->setResponse((const char **)responseArgs, numArgs, *theOutputStream);
+        theResponses[i] = dynamic_cast<ExpResponse *>(theResponse);
+        if (theResponses[i] == 0 && theResponse != 0)  {
+            opserr << "ExpControlRecorder::ExpControlRecorder() - unsupported response type\n";
+            delete theResponse;
+        }
         if (theResponses[i] != 0) {
             // from the response type determine numCols for each
             Information &siteInfo = theResponses[i]->getInformation();
@@ -143,17 +149,10 @@ int ExpControlRecorder::record(int commitTag, double timeStamp)
         // for each control if responses exist, put them in response vector
         for (int i=0; i<numControls; i++)  {
             if (theResponses[i] != 0)  {
-                // ask the control for the response
-                int res;
-                if ((res = theResponses[i]->getResponse()) < 0)  {
-                    result += res;
-                } else  {
-                    Information &siteInfo = theResponses[i]->getInformation();
-                    const Vector &siteData = siteInfo.getData();
-                    for (int j=0; j<siteData.Size(); j++)
-                        (*data)(loc++) = siteData(j);
-                }
-            } 
+                // gather the response, bound responses are copied
+                // directly from the storage of the control
+                result += theResponses[i]->gather(*data, loc);
+            }
         }
         
         // send the response vector to the output handler for o/p
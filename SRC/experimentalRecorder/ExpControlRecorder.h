@@ -36,7 +36,7 @@
 #include <Recorder.h>
 
 class ExperimentalControl;
-class Response;
+class ExpResponse;
 
 #define RECORDER_TAGS_ExpControlRecorder 102
 
@@ -66,7 +66,7 @@ private:
     OPS_Stream *theOutputStream;
     double deltaT;
     
-    Response **theResponses;
+    ExpResponse **theResponses;
     Vector *data;
     double nextTimeStampToRecord;
 };
@@ -31,6 +31,7 @@
 
 #include <ExpSetupRecorder.h>
 #include <ExperimentalSetup.h>
+#include <ExpResponse.h>
 
 
 ExpSetupRecorder::ExpSetupRecorder(int numsetups,
@@ -71,7 +72,7 @@ ExpSetupRecorder::ExpSetupRecorder(int numsetups,
     // Set the response objects:
     //   1. create an array of pointers and zero them
     //   2. iterate over the setups invoking setResponse() to get the new objects & determine size of data
-    theResponses = new Response *[numSetups];
+    theResponses = new ExpResponse *[numSetups];
     if (theResponses == 0)  {
         opserr << "ExpSetupRecorder::ExpSetupRecorder() - out of memory\n";
         exit(OF_ReturnType_failed);
@@ -81,7 +82,12 @@ ExpSetupRecorder::ExpSetupRecorder(int numsetups,
     
     // loop over setups & set Responses
     for (int i=0; i<numSetups; i++)  {
-        theResponses[i] = theSetups[i]->setResponse((const char **)responseArgs, numArgs, *theOutputStream);
+        Response *theResponse = theSetups[i]->setResponse((const char **)responseArgs, numArgs, *theOutputStream);
+        theResponses[i] = dynamic_cast<ExpResponse *>(theResponse);
+        if (theResponses[i] == 0 && theResponse != 0)  {
+            opserr << "ExpSetupRecorder::ExpSetupRecorder() - unsupported response type\n";
+            delete theResponse;
+        }
         if (theResponses[i] != 0) {
             // from the response type determine numCols for each
             Information &siteInfo = theResponses[i]->getInformation();
@@ -143,17 +149,10 @@ int ExpSetupRecorder::record(int commitTag, double timeStamp)
         // for each setup if responses exist, put them in response vector
         for (int i=0; i<numSetups; i++)  {
             if (theResponses[i] != 0)  {
-                // ask the setup for the response
-                int res;
-                if ((res = theResponses[i]->getResponse()) < 0)  {
-                    result += res;
-                } else  {
-                    Information &siteInfo = theResponses[i]->getInformation();
-                    const Vector &siteData = siteInfo.getData();
-                    for (int j=0; j<siteData.Size(); j++)
-                        (*data)(loc++) = siteData(j);
-                }
-            } 
+                // gather the response, bound responses are copied
+                // directly from the storage of the setup
+                result += theResponses[i]->gather(*data, loc);
+            }
         }
         
         // send the response vector to the output handler for o/p
@@ -36,7 +36,7 @@
 #include <Recorder.h>
 
 class ExperimentalSetup;
-class Response;
+class ExpResponse;
 
 #define RECORDER_TAGS_ExpSetupRecorder 101
 
@@ -66,7 +66,7 @@ private:
     OPS_Stream *theOutputStream;
     double deltaT;
     
-    Response **theResponses;
+    ExpResponse **theResponses;
     Vector *data;
     double nextTimeStampToRecord;
 };
@@ -31,6 +31,7 @@
 
 #include <ExpSignalFilterRecorder.h>
 #include <ExperimentalSignalFilter.h>
+#include <ExpResponse.h>
 
 
 ExpSignalFilterRecorder::ExpSignalFilterRecorder(int numfilters,
@@ -71,7 +72,7 @@ ExpSignalFilterRecorder::ExpSignalFilterRecorder(int numfilters,
     // Set the response objects:
     //   1. create an array of pointers and zero them
     //   2. iterate over the signal filters invoking setResponse() to get the new objects & determine size of data
-    theResponses = new Response *[numFilters];
+    theResponses = new ExpResponse *[numFilters];
     if (theResponses == 0)  {
         opserr << "ExpSignalFilterRecorder::ExpSignalFilterRecorder() - out of memory\n";
         exit(OF_ReturnType_failed);
@@ -81,7 +82,12 @@ ExpSignalFilterRecorder::ExpSignalFilterRecorder(int numfilters,
     
     // loop over signal filters & set Responses
     for (int i=0; i<numFilters; i++)  {
-        theResponses[i] = theFilters[i]->setResponse((const char **)responseArgs, numArgs, *theOutputStream);
+        Response *theResponse = theFilters[i]->setResponse((const char **)responseArgs, numArgs, *theOutputStream);
+        theResponses[i] = dynamic_cast<ExpResponse *>(theResponse);
+        if (theResponses[i] == 0 && theResponse != 0)  {
+            opserr << "ExpSignalFilterRecorder::ExpSignalFilterRecorder() - unsupported response type\n";
+            delete theResponse;
+        }
         if (theResponses[i] != 0) {
             // from the response type determine numCols for each
             Information &siteInfo = theResponses[i]->getInformation();
@@ -143,17 +149,10 @@ int ExpSignalFilterRecorder::record(int commitTag, double timeStamp)
         // for each signal filter if responses exist, put them in response vector
         for (int i=0; i<numFilters; i++)  {
             if (theResponses[i] != 0)  {
-                // ask the signal filter for the response
-                int res;
-                if ((res = theResponses[i]->getResponse()) < 0)  {
-                    result += res;
-                } else  {
-                    Information &siteInfo = theResponses[i]->getInformation();
-                    const Vector &siteData = siteInfo.getData();
-                    for (int j=0; j<siteData.Size(); j++)
-                        (*data)(loc++) = siteData(j);
-                }
-            } 
+                // gather the response, bound responses are copied
+                // directly from the storage of the signal filter
+                result += theResponses[i]->gather(*data, loc);
+            }
         }
         
         // send the response vector to the output handler for o/p
@@ -36,7 +36,7 @@
 #include <Recorder.h>
 
 class ExperimentalSignalFilter;
-class Response;
+class ExpResponse;
 
 #define RECORDER_TAGS_ExpSignalFilterRecorder 103
 
@@ -66,7 +66,7 @@ private:
     OPS_Stream *theOutputStream;
     double deltaT;
     
-    Response **theResponses;
+    ExpResponse **theResponses;
     Vector *data;
     double nextTimeStampToRecord;
 };
@@ -31,6 +31,7 @@
 
 #include <ExpSiteRecorder.h>
 #include <ExperimentalSite.h>
+#include <ExpResponse.h>
 
 
 ExpSiteRecorder::ExpSiteRecorder(int numsites,
@@ -71,7 +72,7 @@ ExpSiteRecorder::ExpSiteRecorder(int numsites,
     // Set the response objects:
     //   1. create an array of pointers and zero them
     //   2. iterate over the sites invoking setResponse() to get the new objects & determine size of data
-    theResponses = new Response *[numSites];
+    theResponses = new ExpResponse *[numSites];
     if (theResponses == 0)  {
         opserr << "ExpSiteRecorder::ExpSiteRecorder() - out of memory\n";
         exit(OF_ReturnType_failed);
@@ -81,7 +82,12 @@ ExpSiteRecorder::ExpSiteRecorder(int numsites,
     
     // loop over sites & set Responses
     for (int i=0; i<numSites; i++)  {
-        theResponses[i] = theSites[i]->setResponse((const char **)responseArgs, numArgs, *theOutputStream);
+        Response *theResponse = theSites[i]->setResponse((const char **)responseArgs, numArgs, *theOutputStream);
+        theResponses[i] = dynamic_cast<ExpResponse *>(theResponse);
+        if (theResponses[i] == 0 && theResponse != 0)  {
+            opserr << "ExpSiteRecorder::ExpSiteRecorder() - unsupported response type\n";
+            delete theResponse;
+        }
         if (theResponses[i] != 0) {
             // from the response type determine numCols for each
             Information &siteInfo = theResponses[i]->getInformation();
@@ -143,17 +149,10 @@ int ExpSiteRecorder::record(int commitTag, double timeStamp)
         // for each site if responses exist, put them in response vector
         for (int i=0; i<numSites; i++)  {
             if (theResponses[i] != 0)  {
-                // ask the site for the response
-                int res;
-                if ((res = theResponses[i]->getResponse()) < 0)  {
-                    result += res;
-                } else  {
-                    Information &siteInfo = theResponses[i]->getInformation();
-                    const Vector &siteData = siteInfo.getData();
-                    for (int j=0; j<siteData.Size(); j++)
-                        (*data)(loc++) = siteData(j);
-                }
-            } 
+                // gather the response, bound responses are copied
+                // directly from the storage of the site
+                result += theResponses[i]->gather(*data, loc);
+            }
         }
         
         // send the response vector to the output handler for o/p
@@ -32,6 +32,7 @@
 
 #include <ExpTangentStiffRecorder.h>
 #include <ExperimentalTangentStiff.h>
+#include <ExpResponse.h>
 
 
 ExpTangentStiffRecorder::ExpTangentStiffRecorder(int numtangstiffs,
@@ -72,7 +73,7 @@ ExpTangentStiffRecorder::ExpTangentStiffRecorder(int numtangstiffs,
     // Set the response objects:
     //   1. create an array of pointers and zero them
     //   2. iterate over the tangent stiffnesses invoking setResponse() to get the new objects & determine size of data
-    theResponses = new Response *[numTangStiffs];
+    theResponses = new ExpResponse *[numTangStiffs];
     if (theResponses == 0)  {
         opserr << "ExpTangentStiffRecorder::ExpTangentStiffRecorder() - out of memory\n";
         exit(OF_ReturnType_failed);
@@ -82,7 +83,12 @@ ExpTangentStiffRecorder::ExpTangentStiffRecorder(int numtangstiffs,
     
     // loop over tangent stiffnesses & set Responses
     for (int i=0; i<numTangStiffs; i++)  {
-        theResponses[i] = theTangStiffs[i]->setResponse((const char **)responseArgs, numArgs, *theOutputStream);
+        Response *theResponse = theTangStiffs[i]->setResponse((const char **)responseArgs, numArgs, *theOutputStream);
+        theResponses[i] = dynamic_cast<ExpResponse *>(theResponse);
+        if (theResponses[i] == 0 && theResponse != 0)  {
+            opserr << "ExpTangentStiffRecorder::ExpTangentStiffRecorder() - unsupported response type\n";
+            delete theResponse;
+        }
         if (theResponses[i] != 0) {
             // from the response type determine numCols for each
             Information &siteInfo = theResponses[i]->getInformation();
@@ -144,17 +150,10 @@ int ExpTangentStiffRecorder::record(int commitTag, double timeStamp)
         // for each tangent stiffness if responses exist, put them in response vector
         for (int i=0; i<numTangStiffs; i++)  {
             if (theResponses[i] != 0)  {
-                // ask the tangent stiffness for the response
-                int res;
-                if ((res = theResponses[i]->getResponse()) < 0)  {
-                    result += res;
-                } else  {
-                    Information &siteInfo = theResponses[i]->getInformation();
-                    const Vector &siteData = siteInfo.getData();
-                    for (int j=0; j<siteData.Size(); j++)
-                        (*data)(loc++) = siteData(j);
-                }
-            } 
+                // gather the response, bound responses are copied
+                // directly from the storage of the tangent stiffness
+                result += theResponses[i]->gather(*data, loc);
+            }
         }
         
         // send the response vector to the output handler for o/p
@@ -50,9 +50,11 @@
 #include <XmlFileStream.h>
 #include <BinaryFileStream.h>
 #include <TCP_Stream.h>
+#include <TelemetryStream.h>
 #include <DatabaseStream.h>
+#include <DataCodec.h>
 
-enum outputMode {STANDARD_STREAM, DATA_STREAM, XML_STREAM, DATABASE_STREAM, BINARY_STREAM, DATA_STREAM_CSV, TCP_STREAM};
+enum outputMode {STANDARD_STREAM, DATA_STREAM, XML_STREAM, DATABASE_STREAM, BINARY_STREAM, DATA_STREAM_CSV, TCP_STREAM, TELEMETRY_STREAM};
 
 extern SimulationInformation *theSimulationInfo;
 extern ExperimentalSite *getExperimentalSite(int tag);
@@ -62,6 +64,106 @@ extern ExperimentalControl *getExperimentalControl(int tag);
 extern ExperimentalSignalFilter *getExperimentalSignalFilter(int tag);
 extern ExperimentalTangentStiff *getExperimentalTangentStiff(int tag);
 
+// options of the live telemetry stream
+struct TelemetryOptions  {
+    int port;
+    const char *mcastAddr;
+    int bufferSize;
+    int decimation;
+    int maxSubscribers;
+};
+
+
+// parse -telemetry port <-mcast addr> <-buffer size> <-decimate n>
+// <-maxSubscribers n> starting at argv[argi] and return the number
+// of arguments used or -1 on error
+static int parseTelemetryOptions(Tcl_Interp *interp, int argc,
+    TCL_Char **argv, int argi, TelemetryOptions &options)
+{
+    options.mcastAddr = 0;
+    options.bufferSize = 64;
+    options.decimation = 1;
+    options.maxSubscribers = 8;
+    
+    if (argi+1 >= argc || Tcl_GetInt(interp, argv[argi+1], &options.port) != TCL_OK)  {
+        opserr << "WARNING invalid port\n";
+        opserr << "Want: -telemetry port <-mcast addr> <-buffer size> "
+            << "<-decimate n> <-maxSubscribers n>\n";
+        return -1;
+    }
+    int i = argi+2;
+    while (i+1 < argc)  {
+        int *value = 0;
+        if (strcmp(argv[i],"-mcast") == 0)  {
+            options.mcastAddr = argv[i+1];
+            i += 2;
+            continue;
+        }
+        else if (strcmp(argv[i],"-buffer") == 0)
+            value = &options.bufferSize;
+        else if (strcmp(argv[i],"-decimate") == 0)
+            value = &options.decimation;
+        else if (strcmp(argv[i],"-maxSubscribers") == 0)
+            value = &options.maxSubscribers;
+        else
+            break;
+        if (Tcl_GetInt(interp, argv[i+1], value) != TCL_OK || *value < 1)  {
+            opserr << "WARNING invalid value for " << argv[i] << " option\n";
+            return -1;
+        }
+        i += 2;
+    }
+    
+    return i-argi;
+}
+
+
+// parse -compress or -quantize res1 <res2 ...> starting at argv[argi]
+// and return the number of arguments used or -1 on error
+static int parseCodecOptions(Tcl_Interp *interp, int argc,
+    TCL_Char **argv, int argi, Vector &resolution)
+{
+    if (strcmp(argv[argi],"-compress") == 0)
+        return 1;
+    
+    double res;
+    int numRes = 0;
+    while (argi+1+numRes < argc &&
+        Tcl_GetDouble(interp, argv[argi+1+numRes], &res) == TCL_OK)
+        numRes++;
+    Tcl_ResetResult(interp);
+    if (numRes == 0)  {
+        opserr << "WARNING no resolutions specified\n";
+        opserr << "Want: -quantize res1 <res2 ...>\n";
+        return -1;
+    }
+    resolution.resize(numRes);
+    for (int i=0; i<numRes; i++)  {
+        Tcl_GetDouble(interp, argv[argi+1+i], &resolution(i));
+        if (resolution(i) < 0.0)  {
+            opserr << "WARNING invalid resolution " << argv[argi+1+i] << endln;
+            return -1;
+        }
+    }
+    
+    return 1+numRes;
+}
+
+
+// let the binary and tcp streams write compressed frames
+static void setStreamCodec(OPS_Stream *theStream, outputMode eMode,
+    const Vector &resolution)
+{
+    DataCodec theCodec(resolution);
+    if (eMode == BINARY_STREAM)
+        ((BinaryFileStream *)theStream)->setCodec(theCodec);
+    else if (eMode == TCP_STREAM)
+        ((TCP_Stream *)theStream)->setCodec(theCodec);
+    else
+        opserr << "WARNING -compress and -quantize are only supported "
+            << "with -binary and -tcp, output is not compressed\n";
+}
+
 
 int TclCreateExpRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
     TCL_Char **argv, Domain *theDomain, Recorder **theRecorder)
@@ -92,6 +194,9 @@ int TclCreateExpRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
         bool closeOnWrite = false;
         const char *inetAddr = 0;
         int inetPort;
+        TelemetryOptions telemetry;
+        bool compress = false;
+        Vector codecRes(0);
         int i, j, argi = 2;
         int flags = 0;
         int sizeData = 0;
@@ -228,6 +333,22 @@ int TclCreateExpRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
                 argi += 3;
             }
             
+            else if ((strcmp(argv[argi],"-compress") == 0) || (strcmp(argv[argi],"-quantize") == 0))  {
+                int numArgs = parseCodecOptions(interp, argc, argv, argi, codecRes);
+                if (numArgs < 0)
+                    return TCL_ERROR;
+                compress = true;
+                argi += numArgs;
+            }
+            
+            else if (strcmp(argv[argi],"-telemetry") == 0)  {
+                int numArgs = parseTelemetryOptions(interp, argc, argv, argi, telemetry);
+                if (numArgs < 0)
+                    return TCL_ERROR;
+                eMode = TELEMETRY_STREAM;
+                argi += numArgs;
+            }
+            
             else if (strcmp(argv[argi],"-database") == 0)  {
                 theRecorderDatabase = OPS_GetFEDatastore();
                 if (theRecorderDatabase != 0)  {
@@ -267,11 +388,18 @@ int TclCreateExpRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
             theOutputStream = new BinaryFileStream(fileName);
         } else if (eMode == TCP_STREAM && inetAddr != 0)  {
             theOutputStream = new TCP_Stream(inetPort, inetAddr);
+        } else if (eMode == TELEMETRY_STREAM)  {
+            theOutputStream = new TelemetryStream(telemetry.port,
+                telemetry.mcastAddr, telemetry.bufferSize,
+                telemetry.decimation, telemetry.maxSubscribers);
         } else if (eMode == DATABASE_STREAM && tableName != 0)  {
             theOutputStream = new DatabaseStream(OPS_GetFEDatastore(), tableName);
         } else
             theOutputStream = new StandardStream();
         
+        if (compress)
+            setStreamCodec(theOutputStream, eMode, codecRes);
+        
         // set precision for stream
         theOutputStream->setPrecision(precision);
         
@@ -312,6 +440,9 @@ int TclCreateExpRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
         bool closeOnWrite = false;
         const char *inetAddr = 0;
         int inetPort;
+        TelemetryOptions telemetry;
+        bool compress = false;
+        Vector codecRes(0);
         int i, j, argi = 2;
         int flags = 0;
         int sizeData = 0;
@@ -448,6 +579,22 @@ int TclCreateExpRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
                 argi += 3;
             }
             
+            else if ((strcmp(argv[argi],"-compress") == 0) || (strcmp(argv[argi],"-quantize") == 0))  {
+                int numArgs = parseCodecOptions(interp, argc, argv, argi, codecRes);
+                if (numArgs < 0)
+                    return TCL_ERROR;
+                compress = true;
+                argi += numArgs;
+            }
+            
+            else if (strcmp(argv[argi],"-telemetry") == 0)  {
+                int numArgs = parseTelemetryOptions(interp, argc, argv, argi, telemetry);
+                if (numArgs < 0)
+                    return TCL_ERROR;
+                eMode = TELEMETRY_STREAM;
+                argi += numArgs;
+            }
+            
             else if (strcmp(argv[argi],"-database") == 0)  {
                 theRecorderDatabase = OPS_GetFEDatastore();
                 if (theRecorderDatabase != 0)  {
@@ -487,11 +634,18 @@ int TclCreateExpRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
             theOutputStream = new BinaryFileStream(fileName);
         } else if (eMode == TCP_STREAM && inetAddr != 0)  {
             theOutputStream = new TCP_Stream(inetPort, inetAddr);
+        } else if (eMode == TELEMETRY_STREAM)  {
+            theOutputStream = new TelemetryStream(telemetry.port,
+                telemetry.mcastAddr, telemetry.bufferSize,
+                telemetry.decimation, telemetry.maxSubscribers);
         } else if (eMode == DATABASE_STREAM && tableName != 0)  {
             theOutputStream = new DatabaseStream(OPS_GetFEDatastore(), tableName);
         } else
             theOutputStream = new StandardStream();
         
+        if (compress)
+            setStreamCodec(theOutputStream, eMode, codecRes);
+        
         // set precision for stream
         theOutputStream->setPrecision(precision);
         
@@ -532,6 +686,9 @@ int TclCreateExpRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
         bool closeOnWrite = false;
         const char *inetAddr = 0;
         int inetPort;
+        TelemetryOptions telemetry;
+        bool compress = false;
+        Vector codecRes(0);
         int i, j, argi = 2;
         int flags = 0;
         int sizeData = 0;
@@ -668,6 +825,22 @@ int TclCreateExpRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
                 argi += 3;
             }
             
+            else if ((strcmp(argv[argi],"-compress") == 0) || (strcmp(argv[argi],"-quantize") == 0))  {
+                int numArgs = parseCodecOptions(interp, argc, argv, argi, codecRes);
+                if (numArgs < 0)
+                    return TCL_ERROR;
+                compress = true;
+                argi += numArgs;
+            }
+            
+            else if (strcmp(argv[argi],"-telemetry") == 0)  {
+                int numArgs = parseTelemetryOptions(interp, argc, argv, argi, telemetry);
+                if (numArgs < 0)
+                    return TCL_ERROR;
+                eMode = TELEMETRY_STREAM;
+                argi += numArgs;
+            }
+            
             else if (strcmp(argv[argi],"-database") == 0)  {
                 theRecorderDatabase = OPS_GetFEDatastore();
                 if (theRecorderDatabase != 0)  {
@@ -707,11 +880,18 @@ int TclCreateExpRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
             theOutputStream = new BinaryFileStream(fileName);
         } else if (eMode == TCP_STREAM && inetAddr != 0)  {
             theOutputStream = new TCP_Stream(inetPort, inetAddr);
+        } else if (eMode == TELEMETRY_STREAM)  {
+            theOutputStream = new TelemetryStream(telemetry.port,
+                telemetry.mcastAddr, telemetry.bufferSize,
+                telemetry.decimation, telemetry.maxSubscribers);
         } else if (eMode == DATABASE_STREAM && tableName != 0)  {
             theOutputStream = new DatabaseStream(OPS_GetFEDatastore(), tableName);
         } else
             theOutputStream = new StandardStream();
         
+        if (compress)
+            setStreamCodec(theOutputStream, eMode, codecRes);
+        
         // set precision for stream
         theOutputStream->setPrecision(precision);
         
@@ -752,6 +932,9 @@ int TclCreateExpRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
         bool closeOnWrite = false;
         const char *inetAddr = 0;
         int inetPort;
+        TelemetryOptions telemetry;
+        bool compress = false;
+        Vector codecRes(0);
         int i, j, argi = 2;
         int flags = 0;
         int sizeData = 0;
@@ -888,6 +1071,22 @@ int TclCreateExpRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
                 argi += 3;
             }
             
+            else if ((strcmp(argv[argi],"-compress") == 0) || (strcmp(argv[argi],"-quantize") == 0))  {
+                int numArgs = parseCodecOptions(interp, argc, argv, argi, codecRes);
+                if (numArgs < 0)
+                    return TCL_ERROR;
+                compress = true;
+                argi += numArgs;
+            }
+            
+            else if (strcmp(argv[argi],"-telemetry") == 0)  {
+                int numArgs = parseTelemetryOptions(interp, argc, argv, argi, telemetry);
+                if (numArgs < 0)
+                    return TCL_ERROR;
+                eMode = TELEMETRY_STREAM;
+                argi += numArgs;
+            }
+            
             else if (strcmp(argv[argi],"-database") == 0)  {
                 theRecorderDatabase = OPS_GetFEDatastore();
                 if (theRecorderDatabase != 0)  {
@@ -927,11 +1126,18 @@ int TclCreateExpRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
             theOutputStream = new BinaryFileStream(fileName);
         } else if (eMode == TCP_STREAM && inetAddr != 0)  {
             theOutputStream = new TCP_Stream(inetPort, inetAddr);
+        } else if (eMode == TELEMETRY_STREAM)  {
+            theOutputStream = new TelemetryStream(telemetry.port,
+                telemetry.mcastAddr, telemetry.bufferSize,
+                telemetry.decimation, telemetry.maxSubscribers);
         } else if (eMode == DATABASE_STREAM && tableName != 0)  {
             theOutputStream = new DatabaseStream(OPS_GetFEDatastore(), tableName);
         } else
             theOutputStream = new StandardStream();
         
+        if (compress)
+            setStreamCodec(theOutputStream, eMode, codecRes);
+        
         // set precision for stream
         theOutputStream->setPrecision(precision);
         
@@ -972,6 +1178,9 @@ int TclCreateExpRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
         bool closeOnWrite = false;
         const char *inetAddr = 0;
         int inetPort;
+        TelemetryOptions telemetry;
+        bool compress = false;
+        Vector codecRes(0);
         int i, j, argi = 2;
         int flags = 0;
         int sizeData = 0;
@@ -1108,6 +1317,22 @@ int TclCreateExpRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
                 argi += 3;
             }
             
+            else if ((strcmp(argv[argi],"-compress") == 0) || (strcmp(argv[argi],"-quantize") == 0))  {
+                int numArgs = parseCodecOptions(interp, argc, argv, argi, codecRes);
+                if (numArgs < 0)
+                    return TCL_ERROR;
+                compress = true;
+                argi += numArgs;
+            }
+            
+            else if (strcmp(argv[argi],"-telemetry") == 0)  {
+                int numArgs = parseTelemetryOptions(interp, argc, argv, argi, telemetry);
+                if (numArgs < 0)
+                    return TCL_ERROR;
+                eMode = TELEMETRY_STREAM;
+                argi += numArgs;
+            }
+            
             else if (strcmp(argv[argi],"-database") == 0)  {
                 theRecorderDatabase = OPS_GetFEDatastore();
                 if (theRecorderDatabase != 0)  {
@@ -1147,11 +1372,18 @@ int TclCreateExpRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
             theOutputStream = new BinaryFileStream(fileName);
         } else if (eMode == TCP_STREAM && inetAddr != 0)  {
             theOutputStream = new TCP_Stream(inetPort, inetAddr);
+        } else if (eMode == TELEMETRY_STREAM)  {
+            theOutputStream = new TelemetryStream(telemetry.port,
+                telemetry.mcastAddr, telemetry.bufferSize,
+                telemetry.decimation, telemetry.maxSubscribers);
         } else if (eMode == DATABASE_STREAM && tableName != 0)  {
             theOutputStream = new DatabaseStream(OPS_GetFEDatastore(), tableName);
         } else
             theOutputStream = new StandardStream();
         
+        if (compress)
+            setStreamCodec(theOutputStream, eMode, codecRes);
+        
         // set precision for stream
         theOutputStream->setPrecision(precision);
         
@@ -31,11 +31,12 @@
 
 #include <ExpControlResponse.h>
 #include <ExperimentalControl.h>
+#include <Vector.h>
 
 
 ExpControlResponse::ExpControlResponse(ExperimentalControl *ec,
     int id)
-    : Response(), theControl(ec), responseID(id)
+    : ExpResponse(), theControl(ec), responseID(id)
 {
 
 }
@@ -43,7 +44,7 @@ ExpControlResponse::ExpControlResponse(ExperimentalControl *ec,
 
 ExpControlResponse::ExpControlResponse(ExperimentalControl *ec,
     int id, int val)
-    : Response(val), theControl(ec), responseID(id)
+    : ExpResponse(val), theControl(ec), responseID(id)
 {
 
 }
@@ -51,7 +52,7 @@ ExpControlResponse::ExpControlResponse(ExperimentalControl *ec,
 
 ExpControlResponse::ExpControlResponse(ExperimentalControl *ec,
     int id, double val)
-    : Response(val), theControl(ec), responseID(id)
+    : ExpResponse(val), theControl(ec), responseID(id)
 {
 
 }
@@ -59,7 +60,7 @@ ExpControlResponse::ExpControlResponse(ExperimentalControl *ec,
 
 ExpControlResponse::ExpControlResponse(ExperimentalControl *ec,
     int id, const ID &val)
-    : Response(val), theControl(ec), responseID(id)
+    : ExpResponse(val), theControl(ec), responseID(id)
 {
 
 }
@@ -67,7 +68,7 @@ ExpControlResponse::ExpControlResponse(ExperimentalControl *ec,
 
 ExpControlResponse::ExpControlResponse(ExperimentalControl *ec,
     int id, const Vector &val)
-    : Response(val), theControl(ec), responseID(id)
+    : ExpResponse(val), theControl(ec), responseID(id)
 {
 
 }
@@ -75,12 +76,28 @@ ExpControlResponse::ExpControlResponse(ExperimentalControl *ec,
 
 ExpControlResponse::ExpControlResponse(ExperimentalControl *ec,
     int id, const Matrix &val)
-    : Response(val), theControl(ec), responseID(id)
+    : ExpResponse(val), theControl(ec), responseID(id)
 {
 
 }
 
 
+ExpControlResponse::ExpControlResponse(ExperimentalControl *ec,
+    int id, Vector *const *data)
+    : ExpResponse(**data), theControl(ec), responseID(id)
+{
+    this->bind(data);
+}
+
+
+ExpControlResponse::ExpControlResponse(ExperimentalControl *ec,
+    int id, double *const *data, int size)
+    : ExpResponse(Vector(size)), theControl(ec), responseID(id)
+{
+    this->bind(data);
+}
+
+
 ExpControlResponse::~ExpControlResponse()
 {
 
@@ -33,14 +33,14 @@
 // Description: This file contains the class definition for
 // ExpControlResponse.
 
-#include <Response.h>
+#include <ExpResponse.h>
 
 class ExperimentalControl;
 class ID;
 class Vector;
 class Matrix;
 
-class ExpControlResponse : public Response
+class ExpControlResponse : public ExpResponse
 {
 public:
     ExpControlResponse(ExperimentalControl *ec, int id);
@@ -49,6 +49,8 @@ public:
     ExpControlResponse(ExperimentalControl *ec, int id, const ID &val);
     ExpControlResponse(ExperimentalControl *ec, int id, const Vector &val);
     ExpControlResponse(ExperimentalControl *ec, int id, const Matrix &val);
+    ExpControlResponse(ExperimentalControl *ec, int id, Vector *const *data);
+    ExpControlResponse(ExperimentalControl *ec, int id, double *const *data, int size);
     ~ExpControlResponse();
     
     int getResponse();
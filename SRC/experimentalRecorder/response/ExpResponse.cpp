@@ -0,0 +1,145 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmx.net)              **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// $Revision$
+// $Date$
+// $URL$
+
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the implementation of ExpResponse.
+
+#include <ExpResponse.h>
+#include <Vector.h>
+
+
+ExpResponse::ExpResponse()
+    : Response(), boundVector(0), boundData(0),
+    boundSize(0), boundStride(1)
+{
+
+}
+
+
+ExpResponse::ExpResponse(int val)
+    : Response(val), boundVector(0), boundData(0),
+    boundSize(0), boundStride(1)
+{
+
+}
+
+
+ExpResponse::ExpResponse(double val)
+    : Response(val), boundVector(0), boundData(0),
+    boundSize(0), boundStride(1)
+{
+
+}
+
+
+ExpResponse::ExpResponse(const ID &val)
+    : Response(val), boundVector(0), boundData(0),
+    boundSize(0), boundStride(1)
+{
+
+}
+
+
+ExpResponse::ExpResponse(const Vector &val)
+    : Response(val), boundVector(0), boundData(0),
+    boundSize(0), boundStride(1)
+{
+
+}
+
+
+ExpResponse::ExpResponse(const Matrix &val)
+    : Response(val), boundVector(0), boundData(0),
+    boundSize(0), boundStride(1)
+{
+
+}
+
+
+ExpResponse::~ExpResponse()
+{
+
+}
+
+
+void ExpResponse::bind(Vector *const *data)
+{
+    // the number of values is fixed by the response
+    // size that the recorder allocated its columns for
+    boundVector = data;
+    boundData = 0;
+    boundSize = myInfo.getData().Size();
+    boundStride = 1;
+}
+
+
+void ExpResponse::bind(double *const *data, int stride)
+{
+    boundVector = 0;
+    boundData = data;
+    boundSize = myInfo.getData().Size();
+    boundStride = stride;
+}
+
+
+bool ExpResponse::isBound() const
+{
+    return (boundVector != 0 || boundData != 0);
+}
+
+
+int ExpResponse::gather(Vector &data, int &loc)
+{
+    // copy bound responses straight from the storage
+    if (boundVector != 0)  {
+        const Vector *theVector = *boundVector;
+        if (theVector == 0 || theVector->Size() != boundSize)
+            return -1;
+        for (int j=0; j<boundSize; j++)
+            data(loc++) = (*theVector)(j);
+        return 0;
+    }
+    if (boundData != 0)  {
+        const double *theData = *boundData;
+        if (theData == 0)
+            return -1;
+        for (int j=0; j<boundSize; j++)
+            data(loc++) = theData[j*boundStride];
+        return 0;
+    }
+    
+    // otherwise ask the object for the response
+    int res = this->getResponse();
+    if (res < 0)
+        return res;
+    
+    const Vector &theData = myInfo.getData();
+    for (int j=0; j<theData.Size(); j++)
+        data(loc++) = theData(j);
+    
+    return 0;
+}
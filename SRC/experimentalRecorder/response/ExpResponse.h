@@ -0,0 +1,74 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmx.net)              **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// $Revision$
+// $Date$
+// $URL$
+
+#ifndef ExpResponse_h
+#define ExpResponse_h
+
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the class definition for
+// ExpResponse. ExpResponse is the base class of the responses of the
+// experimental objects. A response can be bound to the storage of the
+// object that holds the recorded quantity, given as the address of
+// the Vector or array pointer of the object, so that it stays valid
+// if the object reallocates the storage. The recorders then gather
+// bound responses directly from that storage instead of going through
+// getResponse() and the Information object.
+
+#include <Response.h>
+
+class ID;
+class Vector;
+class Matrix;
+
+class ExpResponse : public Response
+{
+public:
+    ExpResponse();
+    ExpResponse(int val);
+    ExpResponse(double val);
+    ExpResponse(const ID &val);
+    ExpResponse(const Vector &val);
+    ExpResponse(const Matrix &val);
+    virtual ~ExpResponse();
+    
+    // methods to bind the response to the storage of the object
+    void bind(Vector *const *data);
+    void bind(double *const *data, int stride = 1);
+    bool isBound() const;
+    
+    // method to copy the response into the data vector of a recorder
+    // starting at loc, loc is advanced past the copied values
+    int gather(Vector &data, int &loc);
+    
+private:
+    Vector *const *boundVector;     // address of bound Vector pointer
+    double *const *boundData;       // address of bound array pointer
+    int boundSize;                  // number of bound values
+    int boundStride;                // stride of the bound array
+};
+
+#endif
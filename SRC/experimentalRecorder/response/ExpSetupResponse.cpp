@@ -35,7 +35,7 @@
 
 ExpSetupResponse::ExpSetupResponse(ExperimentalSetup *es,
     int id)
-    : Response(), theSetup(es), responseID(id)
+    : ExpResponse(), theSetup(es), responseID(id)
 {
 
 }
@@ -43,7 +43,7 @@ ExpSetupResponse::ExpSetupResponse(ExperimentalSetup *es,
 
 ExpSetupResponse::ExpSetupResponse(ExperimentalSetup *es,
     int id, int val)
-    : Response(val), theSetup(es), responseID(id)
+    : ExpResponse(val), theSetup(es), responseID(id)
 {
 
 }
@@ -51,7 +51,7 @@ ExpSetupResponse::ExpSetupResponse(ExperimentalSetup *es,
 
 ExpSetupResponse::ExpSetupResponse(ExperimentalSetup *es,
     int id, double val)
-    : Response(val), theSetup(es), responseID(id)
+    : ExpResponse(val), theSetup(es), responseID(id)
 {
 
 }
@@ -59,7 +59,7 @@ ExpSetupResponse::ExpSetupResponse(ExperimentalSetup *es,
 
 ExpSetupResponse::ExpSetupResponse(ExperimentalSetup *es,
     int id, const ID &val)
-    : Response(val), theSetup(es), responseID(id)
+    : ExpResponse(val), theSetup(es), responseID(id)
 {
 
 }
@@ -67,7 +67,7 @@ ExpSetupResponse::ExpSetupResponse(ExperimentalSetup *es,
 
 ExpSetupResponse::ExpSetupResponse(ExperimentalSetup *es,
     int id, const Vector &val)
-    : Response(val), theSetup(es), responseID(id)
+    : ExpResponse(val), theSetup(es), responseID(id)
 {
 
 }
@@ -75,12 +75,20 @@ ExpSetupResponse::ExpSetupResponse(ExperimentalSetup *es,
 
 ExpSetupResponse::ExpSetupResponse(ExperimentalSetup *es,
     int id, const Matrix &val)
-    : Response(val), theSetup(es), responseID(id)
+    : ExpResponse(val), theSetup(es), responseID(id)
 {
 
 }
 
 
+ExpSetupResponse::ExpSetupResponse(ExperimentalSetup *es,
+    int id, Vector *const *data)
+    : ExpResponse(**data), theSetup(es), responseID(id)
+{
+    this->bind(data);
+}
+
+
 ExpSetupResponse::~ExpSetupResponse()
 {
 
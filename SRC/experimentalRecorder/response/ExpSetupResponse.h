@@ -33,14 +33,14 @@
 // Description: This file contains the class definition for
 // ExpSetupResponse.
 
-#include <Response.h>
+#include <ExpResponse.h>
 
 class ExperimentalSetup;
 class ID;
 class Vector;
 class Matrix;
 
-class ExpSetupResponse : public Response
+class ExpSetupResponse : public ExpResponse
 {
 public:
     ExpSetupResponse(ExperimentalSetup *es, int id);
@@ -49,6 +49,7 @@ public:
     ExpSetupResponse(ExperimentalSetup *es, int id, const ID &val);
     ExpSetupResponse(ExperimentalSetup *es, int id, const Vector &val);
     ExpSetupResponse(ExperimentalSetup *es, int id, const Matrix &val);
+    ExpSetupResponse(ExperimentalSetup *es, int id, Vector *const *data);
     ~ExpSetupResponse();
     
     int getResponse();
@@ -35,7 +35,7 @@
 
 ExpSignalFilterResponse::ExpSignalFilterResponse(ExperimentalSignalFilter *esf,
     int id)
-    : Response(), theFilter(esf), responseID(id)
+    : ExpResponse(), theFilter(esf), responseID(id)
 {
 
 }
@@ -43,7 +43,7 @@ ExpSignalFilterResponse::ExpSignalFilterResponse(ExperimentalSignalFilter *esf,
 
 ExpSignalFilterResponse::ExpSignalFilterResponse(ExperimentalSignalFilter *esf,
     int id, int val)
-    : Response(val), theFilter(esf), responseID(id)
+    : ExpResponse(val), theFilter(esf), responseID(id)
 {
 
 }
@@ -51,7 +51,7 @@ ExpSignalFilterResponse::ExpSignalFilterResponse(ExperimentalSignalFilter *esf,
 
 ExpSignalFilterResponse::ExpSignalFilterResponse(ExperimentalSignalFilter *esf,
     int id, double val)
-    : Response(val), theFilter(esf), responseID(id)
+    : ExpResponse(val), theFilter(esf), responseID(id)
 {
 
 }
@@ -59,7 +59,7 @@ ExpSignalFilterResponse::ExpSignalFilterResponse(ExperimentalSignalFilter *esf,
 
 ExpSignalFilterResponse::ExpSignalFilterResponse(ExperimentalSignalFilter *esf,
     int id, const ID &val)
-    : Response(val), theFilter(esf), responseID(id)
+    : ExpResponse(val), theFilter(esf), responseID(id)
 {
 
 }
@@ -67,7 +67,7 @@ ExpSignalFilterResponse::ExpSignalFilterResponse(ExperimentalSignalFilter *esf,
 
 ExpSignalFilterResponse::ExpSignalFilterResponse(ExperimentalSignalFilter *esf,
     int id, const Vector &val)
-    : Response(val), theFilter(esf), responseID(id)
+    : ExpResponse(val), theFilter(esf), responseID(id)
 {
 
 }
@@ -75,7 +75,7 @@ ExpSignalFilterResponse::ExpSignalFilterResponse(ExperimentalSignalFilter *esf,
 
 ExpSignalFilterResponse::ExpSignalFilterResponse(ExperimentalSignalFilter *esf,
     int id, const Matrix &val)
-    : Response(val), theFilter(esf), responseID(id)
+    : ExpResponse(val), theFilter(esf), responseID(id)
 {
 
 }
@@ -33,14 +33,14 @@
 // Description: This file contains the class definition for
 // ExpSignalFilterResponse.
 
-#include <Response.h>
+#include <ExpResponse.h>
 
 class ExperimentalSignalFilter;
 class ID;
 class Vector;
 class Matrix;
 
-class ExpSignalFilterResponse : public Response
+class ExpSignalFilterResponse : public ExpResponse
 {
 public:
     ExpSignalFilterResponse(ExperimentalSignalFilter *esf, int id);
@@ -35,7 +35,7 @@
 
 ExpSiteResponse::ExpSiteResponse(ExperimentalSite *es,
     int id)
-    : Response(), theSite(es), responseID(id)
+    : ExpResponse(), theSite(es), responseID(id)
 {
 
 }
@@ -43,7 +43,7 @@ ExpSiteResponse::ExpSiteResponse(ExperimentalSite *es,
 
 ExpSiteResponse::ExpSiteResponse(ExperimentalSite *es,
     int id, int val)
-    : Response(val), theSite(es), responseID(id)
+    : ExpResponse(val), theSite(es), responseID(id)
 {
 
 }
@@ -51,7 +51,7 @@ ExpSiteResponse::ExpSiteResponse(ExperimentalSite *es,
 
 ExpSiteResponse::ExpSiteResponse(ExperimentalSite *es,
     int id, double val)
-    : Response(val), theSite(es), responseID(id)
+    : ExpResponse(val), theSite(es), responseID(id)
 {
 
 }
@@ -59,7 +59,7 @@ ExpSiteResponse::ExpSiteResponse(ExperimentalSite *es,
 
 ExpSiteResponse::ExpSiteResponse(ExperimentalSite *es,
     int id, const ID &val)
-    : Response(val), theSite(es), responseID(id)
+    : ExpResponse(val), theSite(es), responseID(id)
 {
 
 }
@@ -67,7 +67,7 @@ ExpSiteResponse::ExpSiteResponse(ExperimentalSite *es,
 
 ExpSiteResponse::ExpSiteResponse(ExperimentalSite *es,
     int id, const Vector &val)
-    : Response(val), theSite(es), responseID(id)
+    : ExpResponse(val), theSite(es), responseID(id)
 {
 
 }
@@ -75,12 +75,20 @@ ExpSiteResponse::ExpSiteResponse(ExperimentalSite *es,
 
 ExpSiteResponse::ExpSiteResponse(ExperimentalSite *es,
     int id, const Matrix &val)
-    : Response(val), theSite(es), responseID(id)
+    : ExpResponse(val), theSite(es), responseID(id)
 {
 
 }
 
 
+ExpSiteResponse::ExpSiteResponse(ExperimentalSite *es,
+    int id, Vector *const *data)
+    : ExpResponse(**data), theSite(es), responseID(id)
+{
+    this->bind(data);
+}
+
+
 ExpSiteResponse::~ExpSiteResponse()
 {
 
@@ -33,14 +33,14 @@
 // Description: This file contains the class definition for
 // ExpSiteResponse.
 
-#include <Response.h>
+#include <ExpResponse.h>
 
 class ExperimentalSite;
 class ID;
 class Vector;
 class Matrix;
 
-class ExpSiteResponse : public Response
+class ExpSiteResponse : public ExpResponse
 {
 public:
     ExpSiteResponse(ExperimentalSite *es, int id);
@@ -49,6 +49,7 @@ public:
     ExpSiteResponse(ExperimentalSite *es, int id, const ID &val);
     ExpSiteResponse(ExperimentalSite *es, int id, const Vector &val);
     ExpSiteResponse(ExperimentalSite *es, int id, const Matrix &val);
+    ExpSiteResponse(ExperimentalSite *es, int id, Vector *const *data);
     ~ExpSiteResponse();
     
     int getResponse();
@@ -35,7 +35,7 @@
 
 ExpTangentStiffResponse::ExpTangentStiffResponse(ExperimentalTangentStiff *ets,
     int id)
-    : Response(), theTangStiff(ets), responseID(id)
+    : ExpResponse(), theTangStiff(ets), responseID(id)
 {
 
 }
@@ -43,7 +43,7 @@ ExpTangentStiffResponse::ExpTangentStiffResponse(ExperimentalTangentStiff *ets,
 
 ExpTangentStiffResponse::ExpTangentStiffResponse(ExperimentalTangentStiff *ets,
     int id, int val)
-    : Response(val), theTangStiff(ets), responseID(id)
+    : ExpResponse(val), theTangStiff(ets), responseID(id)
 {
 
 }
@@ -51,7 +51,7 @@ ExpTangentStiffResponse::ExpTangentStiffResponse(ExperimentalTangentStiff *ets,
 
 ExpTangentStiffResponse::ExpTangentStiffResponse(ExperimentalTangentStiff *ets,
     int id, double val)
-    : Response(val), theTangStiff(ets), responseID(id)
+    : ExpResponse(val), theTangStiff(ets), responseID(id)
 {
 
 }
@@ -59,7 +59,7 @@ ExpTangentStiffResponse::ExpTangentStiffResponse(ExperimentalTangentStiff *ets,
 
 ExpTangentStiffResponse::ExpTangentStiffResponse(ExperimentalTangentStiff *ets,
     int id, const ID &val)
-    : Response(val), theTangStiff(ets), responseID(id)
+    : ExpResponse(val), theTangStiff(ets), responseID(id)
 {
 
 }
@@ -67,7 +67,7 @@ ExpTangentStiffResponse::ExpTangentStiffResponse(ExperimentalTangentStiff *ets,
 
 ExpTangentStiffResponse::ExpTangentStiffResponse(ExperimentalTangentStiff *ets,
     int id, const Vector &val)
-    : Response(val), theTangStiff(ets), responseID(id)
+    : ExpResponse(val), theTangStiff(ets), responseID(id)
 {
 
 }
@@ -75,7 +75,7 @@ ExpTangentStiffResponse::ExpTangentStiffResponse(ExperimentalTangentStiff *ets,
 
 ExpTangentStiffResponse::ExpTangentStiffResponse(ExperimentalTangentStiff *ets,
     int id, const Matrix &val)
-    : Response(val), theTangStiff(ets), responseID(id)
+    : ExpResponse(val), theTangStiff(ets), responseID(id)
 {
 
 }
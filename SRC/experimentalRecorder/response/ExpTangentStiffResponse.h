@@ -33,14 +33,14 @@
 // Description: This file contains the class definition for
 // ExpTangentStiffResponse.
 
-#include <Response.h>
+#include <ExpResponse.h>
 
 class ExperimentalTangentStiff;
 class ID;
 class Vector;
 class Matrix;
 
-class ExpTangentStiffResponse : public Response
+class ExpTangentStiffResponse : public ExpResponse
 {
 public:
     ExpTangentStiffResponse(ExperimentalTangentStiff *ets, int id);
@@ -652,7 +652,7 @@ int ESAggregator::transfTrialResponse(const Vector* disp,
         }
         
         // transform trial response of individual setup
-        rValue = theSetups[i]->transfTrialResponse(tDispAll[i],
+        rValue = theSetups[i]->mapTrialResponse(tDispAll[i],
             tVelAll[i], tAccelAll[i], tForceAll[i], tTimeAll[i]);
         if (rValue != OF_ReturnType_completed)  {
             opserr << "ESAggregator::transfTrialResponse() - "
@@ -787,7 +787,7 @@ int ESAggregator::transfDaqResponse(Vector* disp,
         }
         
         // transform daq response of individual setup
-        rValue = theSetups[i]->transfDaqResponse(oDispAll[i],
+        rValue = theSetups[i]->mapDaqResponse(oDispAll[i],
             oVelAll[i], oAccelAll[i], oForceAll[i], oTimeAll[i]);
         if (rValue != OF_ReturnType_completed)  {
             opserr << "ESAggregator::transfDaqResponse() - "
@@ -866,6 +866,29 @@ ExperimentalSetup* ESAggregator::getCopy()
 }
 
 
+int ESAggregator::saveState(ExpCheckpoint &theCheckpoint)
+{
+    int rValue = 0;
+    
+    for (int i=0; i<numSetups; i++)
+        rValue += theSetups[i]->saveState(theCheckpoint);
+    rValue += this->ExperimentalSetup::saveState(theCheckpoint);
+    
+    return (rValue < 0) ? OF_ReturnType_failed : OF_ReturnType_completed;
+}
+
+
+int ESAggregator::restoreState(ExpCheckpoint &theCheckpoint)
+{
+    for (int i=0; i<numSetups; i++)  {
+        if (theSetups[i]->restoreState(theCheckpoint) < 0)
+            return OF_ReturnType_failed;
+    }
+    
+    return this->ExperimentalSetup::restoreState(theCheckpoint);
+}
+
+
 void ESAggregator::Print(OPS_Stream &s, int flag)
 {
 	s << "ExperimentalSetup: " << this->getTag(); 
@@ -132,6 +132,12 @@ ExperimentalSetup* ESNoTransformation::getCopy()
 }
 
 
+bool ESNoTransformation::isLinear() const
+{
+    return true;
+}
+
+
 void ESNoTransformation::Print(OPS_Stream &s, int flag)
 {
     s << "ExperimentalSetup: " << this->getTag(); 
@@ -107,6 +107,12 @@ ExperimentalSetup* ESOneActuator::getCopy()
 }
 
 
+bool ESOneActuator::isLinear() const
+{
+    return true;
+}
+
+
 void ESOneActuator::Print(OPS_Stream &s, int flag)
 {
     s << "ExperimentalSetup: " << this->getTag(); 
@@ -174,6 +174,12 @@ ExperimentalSetup* ESThreeActuators2d::getCopy()
 }
 
 
+bool ESThreeActuators2d::isLinear() const
+{
+    return (nlGeom == 0);
+}
+
+
 void ESThreeActuators2d::Print(OPS_Stream &s, int flag)
 {
     s << "ExperimentalSetup: " << this->getTag(); 
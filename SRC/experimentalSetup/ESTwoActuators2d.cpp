@@ -165,6 +165,12 @@ ExperimentalSetup* ESTwoActuators2d::getCopy()
 }
 
 
+bool ESTwoActuators2d::isLinear() const
+{
+    return (nlGeom == 0);
+}
+
+
 void ESTwoActuators2d::Print(OPS_Stream &s, int flag)
 {
     s << "ExperimentalSetup: " << this->getTag(); 
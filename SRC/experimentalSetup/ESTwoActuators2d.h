@@ -66,6 +66,8 @@ public:
     
     virtual ExperimentalSetup *getCopy();
     
+    virtual bool isLinear() const;
+    
     // public methods for output
     void Print(OPS_Stream &s, int flag = 0);
     
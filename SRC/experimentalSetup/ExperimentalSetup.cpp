@@ -34,6 +34,12 @@
 
 #include "ExperimentalSetup.h"
 
+#include <ExpCheckpoint.h>
+#include <SparseTransf.h>
+#include <Matrix.h>
+
+#include <math.h>
+
 
 ExperimentalSetup::ExperimentalSetup(int tag,
     ExperimentalControl *control)
@@ -46,8 +52,14 @@ ExperimentalSetup::ExperimentalSetup(int tag,
     tDispFact(0), tVelFact(0), tAccelFact(0), tForceFact(0), tTimeFact(0),
     oDispFact(0), oVelFact(0), oAccelFact(0), oForceFact(0), oTimeFact(0),
     cDispFact(0), cVelFact(0), cAccelFact(0), cForceFact(0), cTimeFact(0),
-    dDispFact(0), dVelFact(0), dAccelFact(0), dForceFact(0), dTimeFact(0)
+    dDispFact(0), dVelFact(0), dAccelFact(0), dForceFact(0), dTimeFact(0),
+    linState(0)
 {
+    for (int i=0; i<OF_Resp_All; i++)  {
+        trialMap[i] = new SparseTransf();
+        daqMap[i] = new SparseTransf();
+    }
+    
     sizeTrial = new ID(OF_Resp_All);
     sizeOut = new ID(OF_Resp_All);
     if (sizeTrial == 0 || sizeOut == 0)  {
@@ -76,8 +88,14 @@ ExperimentalSetup::ExperimentalSetup(const ExperimentalSetup& es)
     tDispFact(0), tVelFact(0), tAccelFact(0), tForceFact(0), tTimeFact(0),
     oDispFact(0), oVelFact(0), oAccelFact(0), oForceFact(0), oTimeFact(0),
     cDispFact(0), cVelFact(0), cAccelFact(0), cForceFact(0), cTimeFact(0),
-    dDispFact(0), dVelFact(0), dAccelFact(0), dForceFact(0), dTimeFact(0)
+    dDispFact(0), dVelFact(0), dAccelFact(0), dForceFact(0), dTimeFact(0),
+    linState(0)
 {
+    for (int i=0; i<OF_Resp_All; i++)  {
+        trialMap[i] = new SparseTransf();
+        daqMap[i] = new SparseTransf();
+    }
+    
     if (es.theControl != 0)  {
         theControl = (es.theControl)->getCopy();
         if (theControl == 0)  {
@@ -163,6 +181,11 @@ ExperimentalSetup::~ExperimentalSetup()
     if (theControl != 0) 
         delete theControl;
     
+    for (int i=0; i<OF_Resp_All; i++)  {
+        delete trialMap[i];
+        delete daqMap[i];
+    }
+    
     if (tDisp != 0) 
         delete tDisp;
     if (tVel != 0) 
@@ -442,7 +465,7 @@ int ExperimentalSetup::setTrialResponse(const Vector* disp,
     const Vector* time)
 {
     // transform data
-    this->transfTrialResponse(disp, vel, accel, force, time);
+    this->mapTrialResponse(disp, vel, accel, force, time);
     
     if (theControl != 0)  {
         int rValue;
@@ -519,7 +542,7 @@ int ExperimentalSetup::getDaqResponse(Vector* disp,
     }
     
     // transform data
-    this->transfDaqResponse(disp, vel, accel, force, time);
+    this->mapDaqResponse(disp, vel, accel, force, time);
     
     return OF_ReturnType_completed;
 }
@@ -619,6 +642,194 @@ int ExperimentalSetup::transfDaqResponse(Vector* disp,
 }
 
 
+int ExperimentalSetup::mapTrialResponse(const Vector* disp, 
+    const Vector* vel,
+    const Vector* accel,
+    const Vector* force,
+    const Vector* time)
+{
+    if (linState == 0)
+        this->compileLinearMap();
+    if (linState != 1)
+        return this->transfTrialResponse(disp, vel, accel, force, time);
+    
+    // transform data in a single pass per response type
+    const Vector *trial[OF_Resp_All] = {disp, vel, accel, force, time};
+    Vector *ctrl[OF_Resp_All] = {cDisp, cVel, cAccel, cForce, cTime};
+    for (int i=0; i<OF_Resp_All; i++)  {
+        if (trial[i] != 0 && ctrl[i] != 0)
+            trialMap[i]->apply(*trial[i], *ctrl[i]);
+    }
+    
+    return OF_ReturnType_completed;
+}
+
+
+int ExperimentalSetup::mapDaqResponse(Vector* disp,
+    Vector* vel,
+    Vector* accel,
+    Vector* force,
+    Vector* time)
+{
+    if (linState == 0)
+        this->compileLinearMap();
+    if (linState != 1)
+        return this->transfDaqResponse(disp, vel, accel, force, time);
+    
+    // transform data in a single pass per response type
+    Vector *daq[OF_Resp_All] = {dDisp, dVel, dAccel, dForce, dTime};
+    Vector *out[OF_Resp_All] = {disp, vel, accel, force, time};
+    for (int i=0; i<OF_Resp_All; i++)  {
+        if (daq[i] != 0 && out[i] != 0)
+            daqMap[i]->apply(*daq[i], *out[i]);
+    }
+    
+    return OF_ReturnType_completed;
+}
+
+
+bool ExperimentalSetup::isLinear() const
+{
+    return false;
+}
+
+
+void ExperimentalSetup::resetLinearMap()
+{
+    // sizes or factors changed, so compile again on next use
+    if (linState != -2)
+        linState = 0;
+}
+
+
+void ExperimentalSetup::compileLinearMap()
+{
+    linState = -1;
+    if (this->isLinear() == false)
+        return;
+    
+    Vector **trial[OF_Resp_All] = {&tDisp, &tVel, &tAccel, &tForce, &tTime};
+    Vector **ctrl[OF_Resp_All] = {&cDisp, &cVel, &cAccel, &cForce, &cTime};
+    Vector **daq[OF_Resp_All] = {&dDisp, &dVel, &dAccel, &dForce, &dTime};
+    Vector **out[OF_Resp_All] = {&oDisp, &oVel, &oAccel, &oForce, &oTime};
+    const double tol = 1.0E-12;
+    bool linear = true;
+    int r, i, j;
+    
+    // save the current ctrl and daq responses
+    Vector *ctrlSave[OF_Resp_All], *daqSave[OF_Resp_All];
+    for (r=0; r<OF_Resp_All; r++)  {
+        ctrlSave[r] = (*ctrl[r] != 0) ? new Vector(**ctrl[r]) : 0;
+        daqSave[r] = (*daq[r] != 0) ? new Vector(**daq[r]) : 0;
+    }
+    
+    // all response types are passed to the transformations, because
+    // some of them need the other types (e.g. velocities the
+    // displacements), the types that are not probed are set to zero
+    Vector *in[OF_Resp_All], *res[OF_Resp_All];
+    for (r=0; r<OF_Resp_All; r++)  {
+        in[r] = ((*sizeTrial)(r) > 0 && *trial[r] != 0 && *ctrl[r] != 0) ?
+            new Vector((*sizeTrial)(r)) : 0;
+        res[r] = ((*sizeOut)(r) > 0 && *out[r] != 0 && *daq[r] != 0) ?
+            new Vector((*sizeOut)(r)) : 0;
+    }
+    
+    // probe the transformations column by column, the
+    // last probe with all ones checks the superposition
+    for (r=0; r<OF_Resp_All && linear; r++)  {
+        int nT = (*sizeTrial)(r);
+        int nC = (*sizeCtrl)(r);
+        if (in[r] != 0 && nC > 0)  {
+            Matrix T(nC, nT);
+            for (j=0; j<=nT && linear; j++)  {
+                for (i=0; i<OF_Resp_All; i++)  {
+                    if (in[i] != 0)
+                        in[i]->Zero();
+                }
+                for (i=0; i<nT; i++)  {
+                    if (i == j || j == nT)
+                        (*in[r])(i) = 1.0;
+                }
+                (*ctrl[r])->Zero();
+                this->transfTrialResponse(in[0], in[1], in[2], in[3], in[4]);
+                for (i=0; i<nC; i++)  {
+                    double c = (**ctrl[r])(i);
+                    if (j < nT)  {
+                        T(i,j) = c;
+                    } else  {
+                        double sum = 0.0;
+                        for (int k=0; k<nT; k++)
+                            sum += T(i,k);
+                        if (fabs(sum - c) > tol*(1.0 + fabs(c)))
+                            linear = false;
+                    }
+                }
+            }
+            trialMap[r]->setMatrix(T);
+        } else  {
+            trialMap[r]->setMatrix(Matrix());
+        }
+    }
+    for (r=0; r<OF_Resp_All && linear; r++)  {
+        int nD = (*sizeDaq)(r);
+        int nO = (*sizeOut)(r);
+        if (res[r] != 0 && nD > 0)  {
+            Matrix D(nO, nD);
+            for (j=0; j<=nD && linear; j++)  {
+                for (i=0; i<OF_Resp_All; i++)  {
+                    if (*daq[i] != 0)
+                        (*daq[i])->Zero();
+                }
+                for (i=0; i<nD; i++)  {
+                    if (i == j || j == nD)
+                        (**daq[r])(i) = 1.0;
+                }
+                res[r]->Zero();
+                this->transfDaqResponse(res[0], res[1], res[2], res[3], res[4]);
+                for (i=0; i<nO; i++)  {
+                    double o = (*res[r])(i);
+                    if (j < nD)  {
+                        D(i,j) = o;
+                    } else  {
+                        double sum = 0.0;
+                        for (int k=0; k<nD; k++)
+                            sum += D(i,k);
+                        if (fabs(sum - o) > tol*(1.0 + fabs(o)))
+                            linear = false;
+                    }
+                }
+            }
+            daqMap[r]->setMatrix(D);
+        } else  {
+            daqMap[r]->setMatrix(Matrix());
+        }
+    }
+    
+    // restore the ctrl and daq responses
+    for (r=0; r<OF_Resp_All; r++)  {
+        if (in[r] != 0)
+            delete in[r];
+        if (res[r] != 0)
+            delete res[r];
+        if (ctrlSave[r] != 0)  {
+            **ctrl[r] = *ctrlSave[r];
+            delete ctrlSave[r];
+        }
+        if (daqSave[r] != 0)  {
+            **daq[r] = *daqSave[r];
+            delete daqSave[r];
+        }
+        if (*trial[r] != 0)
+            (*trial[r])->Zero();
+        if (*out[r] != 0)
+            (*out[r])->Zero();
+    }
+    
+    if (linear == true)
+        linState = 1;
+}
+
+
 int ExperimentalSetup::commitState()
 {
     if (theControl != 0)  {
@@ -635,6 +846,26 @@ int ExperimentalSetup::commitState()
 }
 
 
+int ExperimentalSetup::saveState(ExpCheckpoint &theCheckpoint)
+{
+    // the transformations have no history, so only
+    // the state of the control needs to be saved
+    if (theControl != 0)
+        return theControl->saveState(theCheckpoint);
+    
+    return OF_ReturnType_completed;
+}
+
+
+int ExperimentalSetup::restoreState(ExpCheckpoint &theCheckpoint)
+{
+    if (theControl != 0)
+        return theControl->restoreState(theCheckpoint);
+    
+    return OF_ReturnType_completed;
+}
+
+
 Response* ExperimentalSetup::setResponse(const char **argv, int argc,
     OPS_Stream &output)
 {
@@ -656,7 +887,7 @@ Response* ExperimentalSetup::setResponse(const char **argv, int argc,
             sprintf(outputData,"trialDisp%d",i+1);
             output.tag("ResponseType",outputData);
         }
-        theResponse = new ExpSetupResponse(this, 1, *tDisp);
+        theResponse = new ExpSetupResponse(this, 1, &tDisp);
     }
     
     // trial velocities
@@ -669,7 +900,7 @@ Response* ExperimentalSetup::setResponse(const char **argv, int argc,
             sprintf(outputData,"trialVel%d",i+1);
             output.tag("ResponseType",outputData);
         }
-        theResponse = new ExpSetupResponse(this, 2, *tVel);
+        theResponse = new ExpSetupResponse(this, 2, &tVel);
     }
     
     // trial accelerations
@@ -682,7 +913,7 @@ Response* ExperimentalSetup::setResponse(const char **argv, int argc,
             sprintf(outputData,"trialAccel%d",i+1);
             output.tag("ResponseType",outputData);
         }
-        theResponse = new ExpSetupResponse(this, 3, *tAccel);
+        theResponse = new ExpSetupResponse(this, 3, &tAccel);
     }
     
     // trial forces
@@ -694,7 +925,7 @@ Response* ExperimentalSetup::setResponse(const char **argv, int argc,
             sprintf(outputData,"trialForce%d",i+1);
             output.tag("ResponseType",outputData);
         }
-        theResponse = new ExpSetupResponse(this, 4, *tForce);
+        theResponse = new ExpSetupResponse(this, 4, &tForce);
     }
     
     // trial times
@@ -706,7 +937,7 @@ Response* ExperimentalSetup::setResponse(const char **argv, int argc,
             sprintf(outputData,"trialTime%d",i+1);
             output.tag("ResponseType",outputData);
         }
-        theResponse = new ExpSetupResponse(this, 5, *tTime);
+        theResponse = new ExpSetupResponse(this, 5, &tTime);
     }
     
     // output displacements
@@ -719,7 +950,7 @@ Response* ExperimentalSetup::setResponse(const char **argv, int argc,
             sprintf(outputData,"outDisp%d",i+1);
             output.tag("ResponseType",outputData);
         }
-        theResponse = new ExpSetupResponse(this, 6, *oDisp);
+        theResponse = new ExpSetupResponse(this, 6, &oDisp);
     }
     
     // output velocities
@@ -732,7 +963,7 @@ Response* ExperimentalSetup::setResponse(const char **argv, int argc,
             sprintf(outputData,"outVel%d",i+1);
             output.tag("ResponseType",outputData);
         }
-        theResponse = new ExpSetupResponse(this, 7, *oVel);
+        theResponse = new ExpSetupResponse(this, 7, &oVel);
     }
     
     // output accelerations
@@ -745,7 +976,7 @@ Response* ExperimentalSetup::setResponse(const char **argv, int argc,
             sprintf(outputData,"outAccel%d",i+1);
             output.tag("ResponseType",outputData);
         }
-        theResponse = new ExpSetupResponse(this, 8, *oAccel);
+        theResponse = new ExpSetupResponse(this, 8, &oAccel);
     }
     
     // output forces
@@ -757,7 +988,7 @@ Response* ExperimentalSetup::setResponse(const char **argv, int argc,
             sprintf(outputData,"outForce%d",i+1);
             output.tag("ResponseType",outputData);
         }
-        theResponse = new ExpSetupResponse(this, 9, *oForce);
+        theResponse = new ExpSetupResponse(this, 9, &oForce);
     }
     
     // output times
@@ -769,7 +1000,7 @@ Response* ExperimentalSetup::setResponse(const char **argv, int argc,
             sprintf(outputData,"outTime%d",i+1);
             output.tag("ResponseType",outputData);
         }
-        theResponse = new ExpSetupResponse(this, 10, *oTime);
+        theResponse = new ExpSetupResponse(this, 10, &oTime);
     }
     
     // control displacements
@@ -782,7 +1013,7 @@ Response* ExperimentalSetup::setResponse(const char **argv, int argc,
             sprintf(outputData,"ctrlDisp%d",i+1);
             output.tag("ResponseType",outputData);
         }
-        theResponse = new ExpSetupResponse(this, 11, *cDisp);
+        theResponse = new ExpSetupResponse(this, 11, &cDisp);
     }
     
     // control velocities
@@ -795,7 +1026,7 @@ Response* ExperimentalSetup::setResponse(const char **argv, int argc,
             sprintf(outputData,"ctrlVel%d",i+1);
             output.tag("ResponseType",outputData);
         }
-        theResponse = new ExpSetupResponse(this, 12, *cVel);
+        theResponse = new ExpSetupResponse(this, 12, &cVel);
     }
     
     // control accelerations
@@ -808,7 +1039,7 @@ Response* ExperimentalSetup::setResponse(const char **argv, int argc,
             sprintf(outputData,"ctrlAccel%d",i+1);
             output.tag("ResponseType",outputData);
         }
-        theResponse = new ExpSetupResponse(this, 13, *cAccel);
+        theResponse = new ExpSetupResponse(this, 13, &cAccel);
     }
     
     // control forces
@@ -820,7 +1051,7 @@ Response* ExperimentalSetup::setResponse(const char **argv, int argc,
             sprintf(outputData,"ctrlForce%d",i+1);
             output.tag("ResponseType",outputData);
         }
-        theResponse = new ExpSetupResponse(this, 14, *cForce);
+        theResponse = new ExpSetupResponse(this, 14, &cForce);
     }
     
     // control times
@@ -832,7 +1063,7 @@ Response* ExperimentalSetup::setResponse(const char **argv, int argc,
             sprintf(outputData,"ctrlTime%d",i+1);
             output.tag("ResponseType",outputData);
         }
-        theResponse = new ExpSetupResponse(this, 15, *cTime);
+        theResponse = new ExpSetupResponse(this, 15, &cTime);
     }
     
     // daq displacements
@@ -845,7 +1076,7 @@ Response* ExperimentalSetup::setResponse(const char **argv, int argc,
             sprintf(outputData,"daqDisp%d",i+1);
             output.tag("ResponseType",outputData);
         }
-        theResponse = new ExpSetupResponse(this, 16, *dDisp);
+        theResponse = new ExpSetupResponse(this, 16, &dDisp);
     }
     
     // daq velocities
@@ -858,7 +1089,7 @@ Response* ExperimentalSetup::setResponse(const char **argv, int argc,
             sprintf(outputData,"daqVel%d",i+1);
             output.tag("ResponseType",outputData);
         }
-        theResponse = new ExpSetupResponse(this, 17, *dVel);
+        theResponse = new ExpSetupResponse(this, 17, &dVel);
     }
     
     // daq accelerations
@@ -871,7 +1102,7 @@ Response* ExperimentalSetup::setResponse(const char **argv, int argc,
             sprintf(outputData,"daqAccel%d",i+1);
             output.tag("ResponseType",outputData);
         }
-        theResponse = new ExpSetupResponse(this, 18, *dAccel);
+        theResponse = new ExpSetupResponse(this, 18, &dAccel);
     }
     
     // daq forces
@@ -883,7 +1114,7 @@ Response* ExperimentalSetup::setResponse(const char **argv, int argc,
             sprintf(outputData,"daqForce%d",i+1);
             output.tag("ResponseType",outputData);
         }
-        theResponse = new ExpSetupResponse(this, 19, *dForce);
+        theResponse = new ExpSetupResponse(this, 19, &dForce);
     }
     
     // daq times
@@ -895,9 +1126,14 @@ Response* ExperimentalSetup::setResponse(const char **argv, int argc,
             sprintf(outputData,"daqTime%d",i+1);
             output.tag("ResponseType",outputData);
         }
-        theResponse = new ExpSetupResponse(this, 20, *dTime);
+        theResponse = new ExpSetupResponse(this, 20, &dTime);
     }
     
+    // recorders read the intermediate responses,
+    // which the fused linear transformations skip
+    if (theResponse != 0)
+        linState = -2;
+    
     output.endTag();
     
     return theResponse;
@@ -981,6 +1217,7 @@ void ExperimentalSetup::setTrialDispFactor(const Vector& f)
         exit(OF_ReturnType_failed);
     }
     *tDispFact = f;
+    this->resetLinearMap();
 }
 
 
@@ -992,6 +1229,7 @@ void ExperimentalSetup::setTrialVelFactor(const Vector& f)
         exit(OF_ReturnType_failed);
     }
     *tVelFact = f;
+    this->resetLinearMap();
 }
 
 
@@ -1003,6 +1241,7 @@ void ExperimentalSetup::setTrialAccelFactor(const Vector& f)
         exit(OF_ReturnType_failed);
     }
     *tAccelFact = f;
+    this->resetLinearMap();
 }
 
 
@@ -1014,6 +1253,7 @@ void ExperimentalSetup::setTrialForceFactor(const Vector& f)
         exit(OF_ReturnType_failed);
     }
     *tForceFact = f;
+    this->resetLinearMap();
 }
 
 
@@ -1025,6 +1265,7 @@ void ExperimentalSetup::setTrialTimeFactor(const Vector& f)
         exit(OF_ReturnType_failed);
     }
     *tTimeFact = f;
+    this->resetLinearMap();
 }
 
 
@@ -1036,6 +1277,7 @@ void ExperimentalSetup::setOutDispFactor(const Vector& f)
         exit(OF_ReturnType_failed);
     }
     *oDispFact = f;
+    this->resetLinearMap();
 }
 
 
@@ -1047,6 +1289,7 @@ void ExperimentalSetup::setOutVelFactor(const Vector& f)
         exit(OF_ReturnType_failed);
     }
     *oVelFact = f;
+    this->resetLinearMap();
 }
 
 
@@ -1058,6 +1301,7 @@ void ExperimentalSetup::setOutAccelFactor(const Vector& f)
         exit(OF_ReturnType_failed);
     }
     *oAccelFact = f;
+    this->resetLinearMap();
 }
 
 
@@ -1069,6 +1313,7 @@ void ExperimentalSetup::setOutForceFactor(const Vector& f)
         exit(OF_ReturnType_failed);
     }
     *oForceFact = f;
+    this->resetLinearMap();
 }
 
 
@@ -1080,6 +1325,7 @@ void ExperimentalSetup::setOutTimeFactor(const Vector& f)
         exit(OF_ReturnType_failed);
     }
     *oTimeFact = f;
+    this->resetLinearMap();
 }
 
 
@@ -1091,6 +1337,7 @@ void ExperimentalSetup::setCtrlDispFactor(const Vector& f)
         exit(OF_ReturnType_failed);
     }
     *cDispFact = f;
+    this->resetLinearMap();
 }
 
 
@@ -1102,6 +1349,7 @@ void ExperimentalSetup::setCtrlVelFactor(const Vector& f)
         exit(OF_ReturnType_failed);
     }
     *cVelFact = f;
+    this->resetLinearMap();
 }
 
 
@@ -1113,6 +1361,7 @@ void ExperimentalSetup::setCtrlAccelFactor(const Vector& f)
         exit(OF_ReturnType_failed);
     }
     *cAccelFact = f;
+    this->resetLinearMap();
 }
 
 
@@ -1124,6 +1373,7 @@ void ExperimentalSetup::setCtrlForceFactor(const Vector& f)
         exit(OF_ReturnType_failed);
     }
     *cForceFact = f;
+    this->resetLinearMap();
 }
 
 
@@ -1135,6 +1385,7 @@ void ExperimentalSetup::setCtrlTimeFactor(const Vector& f)
         exit(OF_ReturnType_failed);
     }
     *cTimeFact = f;
+    this->resetLinearMap();
 }
 
 
@@ -1146,6 +1397,7 @@ void ExperimentalSetup::setDaqDispFactor(const Vector& f)
         exit(OF_ReturnType_failed);
     }
     *dDispFact = f;
+    this->resetLinearMap();
 }
 
 
@@ -1157,6 +1409,7 @@ void ExperimentalSetup::setDaqVelFactor(const Vector& f)
         exit(OF_ReturnType_failed);
     }
     *dVelFact = f;
+    this->resetLinearMap();
 }
 
 
@@ -1168,6 +1421,7 @@ void ExperimentalSetup::setDaqAccelFactor(const Vector& f)
         exit(OF_ReturnType_failed);
     }
     *dAccelFact = f;
+    this->resetLinearMap();
 }
 
 
@@ -1179,6 +1433,7 @@ void ExperimentalSetup::setDaqForceFactor(const Vector& f)
         exit(OF_ReturnType_failed);
     }
     *dForceFact = f;
+    this->resetLinearMap();
 }
 
 
@@ -1190,6 +1445,7 @@ void ExperimentalSetup::setDaqTimeFactor(const Vector& f)
         exit(OF_ReturnType_failed);
     }
     *dTimeFact = f;
+    this->resetLinearMap();
 }
 
 
@@ -1243,6 +1499,8 @@ int ExperimentalSetup::getDaqSize(int rType)
 
 void ExperimentalSetup::setTrial()
 {
+    this->resetLinearMap();
+    
     if (tDisp != 0)  {
         delete tDisp;
         tDisp = 0;
@@ -1360,6 +1618,8 @@ void ExperimentalSetup::setTrial()
 
 void ExperimentalSetup::setOut()
 {
+    this->resetLinearMap();
+    
     if (oDisp != 0)  {
         delete oDisp;
         oDisp = 0;
@@ -1477,6 +1737,8 @@ void ExperimentalSetup::setOut()
 
 void ExperimentalSetup::setCtrl()
 {
+    this->resetLinearMap();
+    
     if (cDisp != 0)  {
         delete cDisp;
         cDisp = 0;
@@ -1594,6 +1856,8 @@ void ExperimentalSetup::setCtrl()
 
 void ExperimentalSetup::setDaq()
 {
+    this->resetLinearMap();
+    
     if (dDisp != 0)  {
         delete dDisp;
         dDisp = 0;
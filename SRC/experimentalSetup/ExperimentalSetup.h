@@ -34,7 +34,14 @@
 // Revision: A
 //
 // Description: This file contains the class definition for 
-// ExperimentalSetup. 
+// ExperimentalSetup. Setups whose transformations are linear can
+// report so with isLinear(). For those, mapTrialResponse() and
+// mapDaqResponse() compile each chain of trial/ctrl or daq/out
+// factors and the setup transformation into one SparseTransf per
+// response type. They then apply it in a single pass. Other setups
+// fall back to transfTrialResponse() and transfDaqResponse(). So do
+// setups with recorders, because recorders read the intermediate
+// responses that the fused transformations skip.
 
 #include <FrescoGlobals.h>
 #include <ExpSetupResponse.h>
@@ -45,6 +52,8 @@
 #include <Vector.h>
 
 class Response;
+class ExpCheckpoint;
+class SparseTransf;
 
 class ExperimentalSetup : public TaggedObject
 {
@@ -99,10 +108,30 @@ public:
         Vector* force,
         Vector* time);
     
+    // public methods to transform the responses with the fused
+    // linear transformations if available
+    int mapTrialResponse(const Vector* disp,
+        const Vector* vel,
+        const Vector* accel,
+        const Vector* force,
+        const Vector* time);
+    int mapDaqResponse(Vector* disp,
+        Vector* vel,
+        Vector* accel,
+        Vector* force,
+        Vector* time);
+    
+    // method to check if the transformations are linear
+    virtual bool isLinear() const;
+    
     virtual int commitState();
     
     virtual ExperimentalSetup *getCopy() = 0;
     
+    // public methods to save and restore the state for a checkpoint
+    virtual int saveState(ExpCheckpoint &theCheckpoint);
+    virtual int restoreState(ExpCheckpoint &theCheckpoint);
+    
     // public methods for experimental setup recorder
     virtual Response *setResponse(const char **argv, int argc,
         OPS_Stream &output);
@@ -225,6 +254,16 @@ protected:
     virtual void setOut();
     virtual void setCtrl();
     virtual void setDaq();
+    
+private:
+    void resetLinearMap();
+    void compileLinearMap();
+    
+    // fused linear transformations
+    // linState: -2 = disabled, -1 = not linear, 0 = to compile, 1 = compiled
+    int linState;
+    SparseTransf *trialMap[OF_Resp_All];
+    SparseTransf *daqMap[OF_Resp_All];
 };
 
 #endif
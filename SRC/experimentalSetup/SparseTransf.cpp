@@ -0,0 +1,107 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// $Revision$
+// $Date$
+// $URL$
+
+// $Revision$
+// $Date$
+// $URL$
+
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the implementation of
+// SparseTransf.
+
+#include "SparseTransf.h"
+
+
+SparseTransf::SparseTransf()
+    : numRows(0), numCols(0), numEntries(0),
+    rowPtr(0), colIdx(0), value(0)
+{
+    rowPtr = new int [1];
+    rowPtr[0] = 0;
+}
+
+
+SparseTransf::~SparseTransf()
+{
+    if (rowPtr != 0)
+        delete [] rowPtr;
+    if (colIdx != 0)
+        delete [] colIdx;
+    if (value != 0)
+        delete [] value;
+}
+
+
+int SparseTransf::setMatrix(const Matrix &T)
+{
+    int i, j, k;
+    
+    // count the stored entries
+    numRows = T.noRows();
+    numCols = T.noCols();
+    numEntries = 0;
+    for (i=0; i<numRows; i++)
+        for (j=0; j<numCols; j++)
+            if (T(i,j) != 0.0)
+                numEntries++;
+    
+    if (rowPtr != 0)
+        delete [] rowPtr;
+    if (colIdx != 0)
+        delete [] colIdx;
+    if (value != 0)
+        delete [] value;
+    rowPtr = new int [numRows+1];
+    colIdx = new int [numEntries > 0 ? numEntries : 1];
+    value = new double [numEntries > 0 ? numEntries : 1];
+    
+    // fill the compressed rows
+    for (i=0, k=0; i<numRows; i++)  {
+        rowPtr[i] = k;
+        for (j=0; j<numCols; j++)  {
+            if (T(i,j) != 0.0)  {
+                colIdx[k] = j;
+                value[k] = T(i,j);
+                k++;
+            }
+        }
+    }
+    rowPtr[numRows] = k;
+    
+    return 0;
+}
+
+
+void SparseTransf::apply(const Vector &in, Vector &out) const
+{
+    for (int i=0; i<numRows; i++)  {
+        double sum = 0.0;
+        for (int k=rowPtr[i]; k<rowPtr[i+1]; k++)
+            sum += value[k]*in(colIdx[k]);
+        out(i) = sum;
+    }
+}
@@ -0,0 +1,74 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// $Revision$
+// $Date$
+// $URL$
+
+// $Revision$
+// $Date$
+// $URL$
+
+#ifndef SparseTransf_h
+#define SparseTransf_h
+
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the class definition for
+// SparseTransf. A SparseTransf stores a linear transformation in
+// compressed row format and applies it in a single pass. It is used
+// by ExperimentalSetup to hold the fused transformations of linear
+// setups, including all trial, ctrl, daq and out factors.
+
+#include <Vector.h>
+#include <Matrix.h>
+
+class SparseTransf
+{
+public:
+    // constructors
+    SparseTransf();
+    
+    // destructor
+    ~SparseTransf();
+    
+    // method to set the transformation from a dense matrix,
+    // entries that are exactly zero are not stored
+    int setMatrix(const Matrix &T);
+    
+    // method to apply the transformation, out = T*in
+    void apply(const Vector &in, Vector &out) const;
+    
+    int getNumRows() const {return numRows;};
+    int getNumCols() const {return numCols;};
+    int getNumEntries() const {return numEntries;};
+    
+private:
+    int numRows;        // number of rows
+    int numCols;        // number of columns
+    int numEntries;     // number of stored entries
+    int *rowPtr;        // start of each row in colIdx and value
+    int *colIdx;        // column indices of the stored entries
+    double *value;      // values of the stored entries
+};
+
+#endif
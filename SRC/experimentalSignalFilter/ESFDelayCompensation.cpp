@@ -0,0 +1,304 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// $Revision$
+// $Date$
+// $URL$
+
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the implementation of
+// ESFDelayCompensation.
+
+#include "ESFDelayCompensation.h"
+
+#include <ExpCheckpoint.h>
+
+#include <math.h>
+
+// forgetting factor of the mean square velocity and the fraction
+// of it that regularizes the adaptation step, so that the small
+// velocities around the turning points hardly change the estimate
+static const double velForget = 0.9;
+static const double velReg = 0.1;
+
+
+ESFDelayCompensation::ESFDelayCompensation(int tag, double _dt,
+    double _delay, int _order, double _gain, double _maxDelay,
+    int _numSig)
+    : ExperimentalSignalFilter(tag),
+    dt(_dt), initDelay(_delay), order(_order), gain(_gain),
+    maxDelay(_maxDelay), numSig(0), sigID(0),
+    hist(0), numHist(0), delay(0), velMS(0), gotTarget(0),
+    fbWarning(true)
+{
+    if (dt <= 0.0 || initDelay < 0.0)  {
+        opserr << "ESFDelayCompensation::ESFDelayCompensation() - "
+            << "dt must be positive and delay must not be negative\n";
+        exit(OF_ReturnType_failed);
+    }
+    if (order < 1 || order > 3)  {
+        opserr << "ESFDelayCompensation::ESFDelayCompensation() - "
+            << "order must be 1, 2 or 3\n";
+        exit(OF_ReturnType_failed);
+    }
+
+    // by default the delay is limited to twice the larger of the
+    // initial delay and the time spanned by the polynomial
+    if (maxDelay <= 0.0)
+        maxDelay = 2.0*((initDelay > order*dt) ? initDelay : order*dt);
+    if (initDelay > maxDelay)
+        initDelay = maxDelay;
+
+    this->setSize(_numSig);
+}
+
+
+ESFDelayCompensation::ESFDelayCompensation(const ESFDelayCompensation& esf)
+    : ExperimentalSignalFilter(esf),
+    dt(esf.dt), initDelay(esf.initDelay), order(esf.order),
+    gain(esf.gain), maxDelay(esf.maxDelay), numSig(0), sigID(0),
+    hist(0), numHist(0), delay(0), velMS(0), gotTarget(0),
+    fbWarning(true)
+{
+    this->setSize(esf.numSig);
+}
+
+
+ESFDelayCompensation::~ESFDelayCompensation()
+{
+    this->deleteArrays();
+}
+
+
+double ESFDelayCompensation::filtering(double data)
+{
+    int j, m;
+
+    // shift the history of the signal and add the new target
+    double *h = &hist[sigID*(order+1)];
+    for (j=order; j>0; j--)
+        h[j] = h[j-1];
+    h[0] = data;
+    if (numHist[sigID] <= order)
+        numHist[sigID]++;
+
+    // a target that was not fed back before the next one means
+    // that the control does not pass the measured displacements
+    if (gotTarget[sigID] && gain > 0.0 && fbWarning)  {
+        opserr << "WARNING ESFDelayCompensation::filtering() - "
+            << "no feedback received, the delay is not adapted "
+            << "for filter: " << this->getTag() << endln;
+        fbWarning = false;
+    }
+    gotTarget[sigID] = true;
+
+    // extrapolate the polynomial through the targets at
+    // -p, ..., -1, 0 by the delay in units of dt
+    int p = numHist[sigID] - 1;
+    double s = delay[sigID]/dt;
+    double cmd = 0.0;
+    for (j=0; j<=p; j++)  {
+        double w = 1.0;
+        for (m=0; m<=p; m++)  {
+            if (m != j)
+                w *= (s + m)/(m - j);
+        }
+        cmd += w*h[j];
+    }
+
+    sigID = (sigID+1) % numSig;
+
+    return cmd;
+}
+
+
+Vector& ESFDelayCompensation::converting(Vector* td)
+{
+    opserr << "\nWARNING ESFDelayCompensation::converting(Vector* td) - " << endln
+        << "No conversion performed. The input vector is returned instead." << endln;
+    return *td;
+}
+
+
+Vector& ESFDelayCompensation::converting(Vector* td, Vector* tf)
+{
+    opserr << "\nWARNING ESFDelayCompensation::converting(Vector* td, Vector* tf) - " << endln
+        << "No conversion performed. The input vector is returned instead." << endln;
+    return *tf;
+}
+
+
+int ESFDelayCompensation::setSize(const int sz)
+{
+    if (sz < 1)  {
+        opserr << "ESFDelayCompensation::setSize() - "
+            << "number of signals must be positive\n";
+        return OF_ReturnType_failed;
+    }
+
+    // the history is restarted with the new size
+    this->deleteArrays();
+    numSig = sz;
+    sigID = 0;
+    hist = new double [numSig*(order+1)];
+    numHist = new int [numSig];
+    delay = new double [numSig];
+    velMS = new double [numSig];
+    gotTarget = new bool [numSig];
+    for (int i=0; i<numSig; i++)  {
+        for (int j=0; j<=order; j++)
+            hist[i*(order+1)+j] = 0.0;
+        numHist[i] = 0;
+        delay[i] = initDelay;
+        velMS[i] = 0.0;
+        gotTarget[i] = false;
+    }
+
+    return OF_ReturnType_completed;
+}
+
+
+void ESFDelayCompensation::update()
+{
+    // does nothing
+}
+
+
+int ESFDelayCompensation::setFeedback(const Vector &data)
+{
+    // the feedback is only used if it corresponds one to one
+    // to the signals, the history is kept in any case
+    if (data.Size() != numSig)  {
+        if (gain > 0.0 && fbWarning)  {
+            opserr << "WARNING ESFDelayCompensation::setFeedback() - "
+                << data.Size() << " feedback values for " << numSig
+                << " signals, the delay is not adapted for filter: "
+                << this->getTag() << endln;
+            fbWarning = false;
+        }
+        return OF_ReturnType_failed;
+    }
+
+    // the feedback ends the step, so the next call
+    // to filtering is for the first signal again
+    sigID = 0;
+
+    for (int i=0; i<numSig; i++)  {
+        // adapt once per target and only if the
+        // velocity of the targets is known
+        if (!gotTarget[i])
+            continue;
+        gotTarget[i] = false;
+        if (numHist[i] < 2)
+            continue;
+
+        double *h = &hist[i*(order+1)];
+        double vel = (h[0] - h[1])/dt;
+        velMS[i] = velForget*velMS[i] + (1.0-velForget)*vel*vel;
+        if (gain <= 0.0 || vel*vel + velReg*velMS[i] <= 0.0)
+            continue;
+
+        // the tracking error is approximately the velocity
+        // times the delay that is not yet compensated
+        double error = h[0] - data(i);
+        delay[i] += gain*error*vel/(vel*vel + velReg*velMS[i]);
+        if (delay[i] < 0.0)
+            delay[i] = 0.0;
+        else if (delay[i] > maxDelay)
+            delay[i] = maxDelay;
+    }
+
+    return OF_ReturnType_completed;
+}
+
+
+ExperimentalSignalFilter* ESFDelayCompensation::getCopy()
+{
+    return new ESFDelayCompensation(*this);
+}
+
+
+int ESFDelayCompensation::saveState(ExpCheckpoint &theCheckpoint)
+{
+    theCheckpoint.save(numSig);
+    theCheckpoint.save(hist, numSig*(order+1));
+    for (int i=0; i<numSig; i++)
+        theCheckpoint.save(numHist[i]);
+    theCheckpoint.save(delay, numSig);
+    return theCheckpoint.save(velMS, numSig);
+}
+
+
+int ESFDelayCompensation::restoreState(ExpCheckpoint &theCheckpoint)
+{
+    int n = 0;
+    if (theCheckpoint.restore(n) < 0 || n < 1)
+        return OF_ReturnType_failed;
+    if (n != numSig)
+        this->setSize(n);
+
+    theCheckpoint.restore(hist, numSig*(order+1));
+    for (int i=0; i<numSig; i++)  {
+        theCheckpoint.restore(numHist[i]);
+        gotTarget[i] = false;
+    }
+    theCheckpoint.restore(delay, numSig);
+    sigID = 0;
+
+    return theCheckpoint.restore(velMS, numSig);
+}
+
+
+void ESFDelayCompensation::Print(OPS_Stream &s, int flag)
+{
+    s << "Filter: " << this->getTag();
+    s << "  type: ESFDelayCompensation\n";
+    s << "  dt: " << dt << ", initial delay: " << initDelay
+        << ", order: " << order << endln;
+    s << "  gain: " << gain << ", maximum delay: " << maxDelay << endln;
+    s << "  estimated delays:";
+    for (int i=0; i<numSig; i++)
+        s << " " << delay[i];
+    s << endln;
+}
+
+
+void ESFDelayCompensation::deleteArrays()
+{
+    if (hist != 0)
+        delete [] hist;
+    if (numHist != 0)
+        delete [] numHist;
+    if (delay != 0)
+        delete [] delay;
+    if (velMS != 0)
+        delete [] velMS;
+    if (gotTarget != 0)
+        delete [] gotTarget;
+
+    hist = 0;
+    numHist = 0;
+    delay = 0;
+    velMS = 0;
+    gotTarget = 0;
+}
@@ -0,0 +1,100 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// $Revision$
+// $Date$
+// $URL$
+
+#ifndef ESFDelayCompensation_h
+#define ESFDelayCompensation_h
+
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the class definition for
+// ESFDelayCompensation. ESFDelayCompensation is a ctrl filter that
+// compensates the delay of the actuators by extrapolating the target
+// displacements with a polynomial through the last targets, so that
+// the actuators reach the targets at the end of each step. The delay
+// can be estimated online from the measured displacements, which the
+// control passes to the filter after each acquire: the tracking error
+// of each signal is approximately its velocity times the remaining
+// delay, so the estimate is corrected by a normalized least mean
+// squares step. The filter is called once per signal and keeps the
+// history of each signal separately, so numSig needs to be the number
+// of ctrl displacements and the feedback needs to have the same size.
+
+#include "ExperimentalSignalFilter.h"
+
+class ESFDelayCompensation : public ExperimentalSignalFilter
+{
+public:
+    // constructors
+    ESFDelayCompensation(int tag, double dt, double delay,
+        int order = 2, double gain = 0.0, double maxDelay = 0.0,
+        int numSig = 1);
+    ESFDelayCompensation(const ESFDelayCompensation& esf);
+
+    // destructor
+    virtual ~ESFDelayCompensation();
+
+    // method to get class type
+    const char *getClassType() const {return "ESFDelayCompensation";};
+
+    virtual double filtering(double data);
+    virtual Vector& converting(Vector* td);
+    virtual Vector& converting(Vector* td, Vector* tf);
+    virtual int setSize(const int sz);
+    virtual void update();
+    virtual int setFeedback(const Vector &data);
+
+    virtual ExperimentalSignalFilter *getCopy();
+
+    // public methods to save and restore the state for a checkpoint
+    virtual int saveState(ExpCheckpoint &theCheckpoint);
+    virtual int restoreState(ExpCheckpoint &theCheckpoint);
+
+    // public methods for output
+    void Print(OPS_Stream &s, int flag = 0);
+
+    // method to get the estimated delay of a signal
+    double getDelay(int sigID) const {return delay[sigID];};
+
+private:
+    void deleteArrays();
+
+    double dt;          // time between two targets
+    double initDelay;   // initial delay
+    int order;          // order of the extrapolation polynomial
+    double gain;        // adaptation gain (0 = fixed delay)
+    double maxDelay;    // largest delay that is compensated
+
+    int numSig;         // number of signals
+    int sigID;          // signal of the next call to filtering
+    double *hist;       // last order+1 targets of each signal, newest first
+    int *numHist;       // number of targets in the history of each signal
+    double *delay;      // estimated delay of each signal
+    double *velMS;      // mean square of the target velocity of each signal
+    bool *gotTarget;    // flag if a new target has not been fed back yet
+    bool fbWarning;     // flag for warning about missing feedback
+};
+
+#endif
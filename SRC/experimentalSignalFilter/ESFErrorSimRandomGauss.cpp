@@ -35,6 +35,8 @@
 
 #include "ESFErrorSimRandomGauss.h"
 
+#include <ExpCheckpoint.h>
+
 #include <stdlib.h>
 #include <math.h>
 #include <time.h>
@@ -111,6 +113,36 @@ ExperimentalSignalFilter* ESFErrorSimRandomGauss::getCopy()
 }
 
 
+int ESFErrorSimRandomGauss::saveState(ExpCheckpoint &theCheckpoint)
+{
+    // save the state of the random number generator so that the
+    // restarted test continues with the same sequence
+    theCheckpoint.save(data);
+    theCheckpoint.save(idseed);
+    theCheckpoint.save(sw);
+    theCheckpoint.save(inext);
+    theCheckpoint.save(inextp);
+    for (int i=0; i<56; i++)
+        theCheckpoint.save(ma[i]);
+    theCheckpoint.save(amp);
+    return theCheckpoint.save(theta);
+}
+
+
+int ESFErrorSimRandomGauss::restoreState(ExpCheckpoint &theCheckpoint)
+{
+    theCheckpoint.restore(data);
+    theCheckpoint.restore(idseed);
+    theCheckpoint.restore(sw);
+    theCheckpoint.restore(inext);
+    theCheckpoint.restore(inextp);
+    for (int i=0; i<56; i++)
+        theCheckpoint.restore(ma[i]);
+    theCheckpoint.restore(amp);
+    return theCheckpoint.restore(theta);
+}
+
+
 void ESFErrorSimRandomGauss::Print(OPS_Stream &s, int flag)
 {
     s << "Filter: " << this->getTag(); 
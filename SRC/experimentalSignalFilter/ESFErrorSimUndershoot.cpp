@@ -35,6 +35,8 @@
 
 #include "ESFErrorSimUndershoot.h"
 
+#include <ExpCheckpoint.h>
+
 #include <math.h>
 
 
@@ -88,6 +90,20 @@ ExperimentalSignalFilter* ESFErrorSimUndershoot::getCopy()
 }
 
 
+int ESFErrorSimUndershoot::saveState(ExpCheckpoint &theCheckpoint)
+{
+    theCheckpoint.save(data);
+    return theCheckpoint.save(predata);
+}
+
+
+int ESFErrorSimUndershoot::restoreState(ExpCheckpoint &theCheckpoint)
+{
+    theCheckpoint.restore(data);
+    return theCheckpoint.restore(predata);
+}
+
+
 void ESFErrorSimUndershoot::Print(OPS_Stream &s, int flag)
 {
     s << "Filter: " << this->getTag(); 
@@ -35,12 +35,18 @@
 
 #include "ESFKrylovForceConverter.h"
 
+#include <ExpCheckpoint.h>
+
+#include <math.h>
+
 
 ESFKrylovForceConverter::ESFKrylovForceConverter(int tag, 
     int ss, Matrix& initStif)
     : ExperimentalSignalFilter(tag), firstWarning(true),
-    size(0), szSubspace(ss), dispPast(0), forcePast(0), convertFrc(0), incrDisp(0), 
-    incrForce(0), cn(0), kInit(initStif), iDMatrix(0,0), iFMatrix(0,0)
+    size(0), szSubspace(ss), maxHist(0), numHist(0), firstHist(0),
+    dispPast(0), forcePast(0), convertFrc(0), incrDisp(0), 
+    incrForce(0), cn(0), v(0), w(0), kInit(initStif),
+    qMatrix(0,0), rMatrix(0,0), iFMatrix(0,0)
 {
     // does nothing
 }
@@ -48,8 +54,9 @@ ESFKrylovForceConverter::ESFKrylovForceConverter(int tag,
 
 ESFKrylovForceConverter::ESFKrylovForceConverter(const ESFKrylovForceConverter& esf)
     : ExperimentalSignalFilter(esf), firstWarning(0), size(0), szSubspace(0), 
-    dispPast(0), forcePast(0), convertFrc(0), incrDisp(0), incrForce(0), cn(0), kInit(0,0), 
-    iDMatrix(0,0), iFMatrix(0,0)
+    maxHist(0), numHist(0), firstHist(0),
+    dispPast(0), forcePast(0), convertFrc(0), incrDisp(0), incrForce(0), cn(0),
+    v(0), w(0), kInit(0,0), qMatrix(0,0), rMatrix(0,0), iFMatrix(0,0)
 {
     szSubspace = esf.szSubspace;
     firstWarning = esf.firstWarning;
@@ -72,11 +79,12 @@ int ESFKrylovForceConverter::setSize(const int sz)
     forcePast.resize(size);
     incrDisp.resize(size);
     incrForce.resize(size);
+    v.resize(size);
     
     // check stiffness matrix size
     this->setInitialStiff();
     
-    return OF_ReturnType_completed;
+    return this->resetHistory();
 }
 
 
@@ -93,6 +101,33 @@ int ESFKrylovForceConverter::setInitialStiff()
 }
 
 
+int ESFKrylovForceConverter::resetHistory()
+{
+    // more than size increments can not be linearly independent
+    maxHist = szSubspace;
+    if (maxHist > size)  {
+        opserr << "WARNING ESFKrylovForceConverter::resetHistory() - "
+            << "number of subspace vectors reduced from " << szSubspace
+            << " to " << size << " for filter: " << this->getTag() << endln;
+        maxHist = size;
+    }
+    numHist = 0;
+    firstHist = 0;
+    
+    // allocate the history once
+    if (maxHist > 0)  {
+        cn.resize(maxHist);
+        w.resize(maxHist);
+        qMatrix.resize(size, maxHist);
+        rMatrix.resize(maxHist, maxHist);
+        iFMatrix.resize(size, maxHist);
+        rMatrix.Zero();
+    }
+    
+    return OF_ReturnType_completed;
+}
+
+
 double ESFKrylovForceConverter::filtering(double data)
 {
     if (firstWarning == true)  {
@@ -109,55 +144,42 @@ double ESFKrylovForceConverter::filtering(double data)
 
 Vector& ESFKrylovForceConverter::converting(Vector* trialDisp)
 {
-    int szCn = cn.Size();
-    Matrix iDMatrixT;
-    Vector v(size), incrV(size), incrP(size), incrQ(size);
-    
-    int i;
+    int i, j, k;
     for (i=0; i<size; i++)
         incrDisp(i) = (*trialDisp)(i) - dispPast(i);
-    if (szCn == 0) {
+    
+    if (numHist == 0)  {
         // initial condition
-        convertFrc.addMatrixVector(0.0, kInit, incrDisp, 1.0);
-    } else if (szCn <= size) {
-        // least squares for over-determined system
-        Matrix tempDTD(szCn, szCn);
-        Vector incrDT(szCn);
-        
-        this->matTranspose(&iDMatrixT, &iDMatrix);
-        tempDTD.addMatrixProduct(0.0, iDMatrixT, iDMatrix, 1.0);
-        incrDT.addMatrixVector(0.0, iDMatrixT, incrDisp, 1.0);
-        tempDTD.Solve(incrDT, cn);
-        
-        incrV.addMatrixVector(0.0, iDMatrix, cn, 1.0);
-        for (i=0; i<size; i++)
-            v(i) = incrDisp(i) - incrV(i);
-        incrQ.addMatrixVector(0.0, kInit, v, 1.0);
-        incrP.addMatrixVector(0.0, iFMatrix, cn, 1.0);
-        
-        for (i=0; i<size; i++)
-            convertFrc(i) = forcePast(i) + incrP(i) + incrQ(i);
-    } else {
-        // Lagrange multiplier to find the min sol for under-determined system
-        Matrix tempDDT(size, size);
-        Vector incrDT(size);
-        int i;
+        convertFrc = forcePast;
+        convertFrc.addMatrixVector(1.0, kInit, incrDisp, 1.0);
+        return convertFrc;
+    }
+    
+    // least squares solution with D = Q*R: w = Q^T*incrDisp,
+    // R*cn = w and the remainder v = incrDisp - Q*w
+    v = incrDisp;
+    for (j=0; j<numHist; j++)  {
+        double sum = 0.0;
         for (i=0; i<size; i++)
-            incrDisp(i) = (*trialDisp)(i) - dispPast(i);
-        
-        this->matTranspose(&iDMatrixT, &iDMatrix);
-        tempDDT.addMatrixProduct(0.0, iDMatrix, iDMatrixT, 1.0);
-        tempDDT.Solve(incrDisp, incrDT);
-        cn.addMatrixVector(0.0, iDMatrix, incrDT, 1.0);
-        
-        incrV.addMatrixVector(0.0, iDMatrix, cn, 1.0);
+            sum += qMatrix(i,j)*incrDisp(i);
+        w(j) = sum;
         for (i=0; i<size; i++)
-            v(i) = incrDisp(i) - incrV(i);
-        incrQ.addMatrixVector(0.0, kInit, v, 1.0);
-        incrP.addMatrixVector(0.0, iFMatrix, cn, 1.0);
-        
+            v(i) -= qMatrix(i,j)*sum;
+    }
+    for (j=numHist-1; j>=0; j--)  {
+        double sum = w(j);
+        for (k=j+1; k<numHist; k++)
+            sum -= rMatrix(j,k)*cn(k);
+        cn(j) = sum/rMatrix(j,j);
+    }
+    
+    // force from the history and from the stiffness for the remainder
+    convertFrc = forcePast;
+    convertFrc.addMatrixVector(1.0, kInit, v, 1.0);
+    for (j=0; j<numHist; j++)  {
+        int col = (firstHist + j) % maxHist;
         for (i=0; i<size; i++)
-            convertFrc(i) = forcePast(i) + incrP(i) + incrQ(i);
+            convertFrc(i) += iFMatrix(i,col)*cn(j);
     }
     
     return convertFrc;
@@ -166,7 +188,7 @@ Vector& ESFKrylovForceConverter::converting(Vector* trialDisp)
 
 Vector& ESFKrylovForceConverter::converting(Vector* daqDisp, Vector* daqForce)
 {	
-    convertFrc = this->converting(daqDisp);
+    this->converting(daqDisp);
     
     this->updateIncrMat(daqDisp, daqForce);
     
@@ -187,10 +209,40 @@ ExperimentalSignalFilter* ESFKrylovForceConverter::getCopy()
 }
 
 
+int ESFKrylovForceConverter::saveState(ExpCheckpoint &theCheckpoint)
+{
+    theCheckpoint.save(int(firstWarning));
+    theCheckpoint.save(&dispPast);
+    theCheckpoint.save(&forcePast);
+    theCheckpoint.save(&kInit);
+    theCheckpoint.save(numHist);
+    theCheckpoint.save(firstHist);
+    theCheckpoint.save(&qMatrix);
+    theCheckpoint.save(&rMatrix);
+    return theCheckpoint.save(&iFMatrix);
+}
+
+
+int ESFKrylovForceConverter::restoreState(ExpCheckpoint &theCheckpoint)
+{
+    theCheckpoint.restore(firstWarning);
+    theCheckpoint.restore(&dispPast);
+    theCheckpoint.restore(&forcePast);
+    theCheckpoint.restore(&kInit);
+    theCheckpoint.restore(numHist);
+    theCheckpoint.restore(firstHist);
+    theCheckpoint.restore(&qMatrix);
+    theCheckpoint.restore(&rMatrix);
+    return theCheckpoint.restore(&iFMatrix);
+}
+
+
 void ESFKrylovForceConverter::Print(OPS_Stream &s, int flag)
 {
     s << "Experimental Signal Filter: " << this->getTag(); 
     s << "  type: ESFKrylovForceConverter\n";
+    s << "  numSubspace: " << szSubspace << ", history: "
+        << numHist << "/" << maxHist << endln;
 }
 
 
@@ -209,65 +261,90 @@ int ESFKrylovForceConverter::updateIncrMat(const Vector* daqDisp, const Vector*
         incrForce(i) = (*daqForce)(i) - forcePast(i);
     }
     
-    // using incremental disp and force
-    int dimCiDM = iDMatrix.noCols();
+    // a zero increment does not add to the subspace
+    double norm = incrDisp.Norm();
+    if (maxHist == 0 || norm == 0.0)
+        return OF_ReturnType_completed;
     
-    Matrix tempDM(size, dimCiDM);
-    Matrix tempFM(size, dimCiDM);
-    // FIX ME add size check
+    // drop the oldest increment if the history is full, so that
+    // the basis keeps following the latest increments
+    if (numHist == maxHist)
+        this->removeOldestIncr();
     
-    // append the incremental vectors to matrices
-    if (dimCiDM < szSubspace) {
-        // copy all entries from the existing matrices
-        for (i=0; i<size; i++) {
-            for (j=0; j<dimCiDM; j++) {
-                tempDM(i,j) = iDMatrix(i,j);
-                tempFM(i,j) = iFMatrix(i,j);
-            }
-        }
-        iDMatrix.resize(size, dimCiDM +1);
-        iFMatrix.resize(size, dimCiDM +1);
-        cn.resize(dimCiDM+1);
-        for (i=0; i<size; i++) {
-            for (j=0; j<dimCiDM; j++) {
-                iDMatrix(i,j) = tempDM(i,j);
-                iFMatrix(i,j) = tempFM(i,j);
-            }
-        }
-        for (i=0; i<size; i++) {
-            iDMatrix(i, dimCiDM) = incrDisp(i);
-            iFMatrix(i, dimCiDM) = incrForce(i);
-        }
-    } else if (dimCiDM == szSubspace) {
-        for (i=0; i<size; i++) {
-            for (j=0; j<(dimCiDM-1); j++) {
-                iDMatrix(i,j) = iDMatrix(i,j+1);
-                iFMatrix(i,j) = iFMatrix(i,j+1);
-            }
-        }
-        for (i=0; i<size; i++) {
-            iDMatrix(i, dimCiDM-1) = incrDisp(i);
-            iFMatrix(i, dimCiDM-1) = incrForce(i);
-        }
+    // skip increments that are linearly dependent on the history
+    double rho = this->orthogonalizeIncr();
+    if (rho <= 1.0E-10*norm)
+        return OF_ReturnType_completed;
+    for (j=0; j<numHist; j++)
+        rMatrix(j,numHist) = w(j);
+    
+    // append the incremental vectors to the history
+    int col = (firstHist + numHist) % maxHist;
+    for (i=0; i<size; i++)  {
+        qMatrix(i,numHist) = v(i)/rho;
+        iFMatrix(i,col) = incrForce(i);
     }
+    rMatrix(numHist,numHist) = rho;
+    numHist++;
     
     return OF_ReturnType_completed;
 }
 
 
-int ESFKrylovForceConverter::matTranspose(Matrix* kT, const Matrix* k)
+double ESFKrylovForceConverter::orthogonalizeIncr()
 {
-    int dimR = k->noRows();
-    int dimC = k->noCols();
-    kT->resize(dimC,dimR);
+    // orthogonalize the increment against the basis, the second
+    // pass restores the orthogonality lost to round-off
+    int i, j, pass;
+    v = incrDisp;
+    for (j=0; j<numHist; j++)
+        w(j) = 0.0;
+    for (pass=0; pass<2; pass++)  {
+        for (j=0; j<numHist; j++)  {
+            double sum = 0.0;
+            for (i=0; i<size; i++)
+                sum += qMatrix(i,j)*v(i);
+            w(j) += sum;
+            for (i=0; i<size; i++)
+                v(i) -= qMatrix(i,j)*sum;
+        }
+    }
     
-    int i, j;
-    //transpose matrix
-    for (i=0; i<dimC; i++) {
-        for (j=0; j<dimR; j++) {
-            (*kT)(i,j) = (*k)(j,i);
+    return v.Norm();
+}
+
+
+int ESFKrylovForceConverter::removeOldestIncr()
+{
+    // deleting the first column of R leaves an upper Hessenberg matrix
+    // that is made triangular again with Givens rotations, which are
+    // also applied to the columns of Q to keep D = Q*R
+    int i, j, l;
+    for (j=0; j<numHist-1; j++)  {
+        for (i=0; i<=j+1; i++)
+            rMatrix(i,j) = rMatrix(i,j+1);
+    }
+    for (j=0; j<numHist-1; j++)  {
+        double a = rMatrix(j,j);
+        double b = rMatrix(j+1,j);
+        double r = sqrt(a*a + b*b);
+        if (r == 0.0)
+            continue;
+        double c = a/r, s = b/r;
+        for (l=j; l<numHist-1; l++)  {
+            double t1 = rMatrix(j,l), t2 = rMatrix(j+1,l);
+            rMatrix(j,l) = c*t1 + s*t2;
+            rMatrix(j+1,l) = -s*t1 + c*t2;
+        }
+        for (i=0; i<size; i++)  {
+            double t1 = qMatrix(i,j), t2 = qMatrix(i,j+1);
+            qMatrix(i,j) = c*t1 + s*t2;
+            qMatrix(i,j+1) = -s*t1 + c*t2;
         }
     }
     
+    firstHist = (firstHist + 1) % maxHist;
+    numHist--;
+    
     return OF_ReturnType_completed;
 }
@@ -34,7 +34,10 @@
 // ESFKrylovForceConverter.  This class converts the trial displacements
 // to trial forces and measured displacements to measured forces using 
 // the Krylov subspaces.  It used the converting method and does nothing 
-// with the filtering method. 
+// with the filtering method. The subspace of the incremental displacements
+// is kept as a QR factorization that is updated with each new increment
+// and the incremental forces are kept in a circular buffer, so that each
+// conversion only costs O(size*numSubspace).
 
 #include "ExperimentalSignalFilter.h"
 #include "ExperimentalTangentStiff.h"
@@ -61,6 +64,10 @@ public:
     
     virtual ExperimentalSignalFilter *getCopy();
     
+    // public methods to save and restore the state for a checkpoint
+    virtual int saveState(ExpCheckpoint &theCheckpoint);
+    virtual int restoreState(ExpCheckpoint &theCheckpoint);
+    
     // public methods for output
     void Print(OPS_Stream &s, int flag = 0);
 
@@ -68,14 +75,21 @@ private:
     bool firstWarning;	// flag for updating the stiffness matrix
     int size;			// size of ctrl and daq vectors
     int szSubspace;		// number of spaces vectors to use
+    int maxHist;		// length of history (at most size)
+    int numHist;		// number of increments in history
+    int firstHist;		// column of the oldest increment in iFMatrix
     Vector dispPast, forcePast, convertFrc, incrDisp, incrForce, cn;
+    Vector v, w;		// work vectors
     Matrix kInit;	    // tangent stiffness matrix
-    Matrix iDMatrix;	// the incremental displacement Matrix
-    Matrix iFMatrix;	// the incremental force Matrix
+    Matrix qMatrix;	    // orthonormal basis of the incremental displacements
+    Matrix rMatrix;	    // triangular factor of the incremental displacements
+    Matrix iFMatrix;	// circular buffer of the incremental forces
     
     int setInitialStiff();
+    int resetHistory();
     int updateIncrMat(const Vector* daqDisp, const Vector* daqForce);
-    int matTranspose(Matrix* kT, const Matrix* k);
+    double orthogonalizeIncr();
+    int removeOldestIncr();
 };
 
 #endif
@@ -35,6 +35,8 @@
 
 #include "ESFTangForceConverter.h"
 
+#include <ExpCheckpoint.h>
+
 
 ESFTangForceConverter::ESFTangForceConverter(int tag, Matrix& initStif,
     ExperimentalTangentStiff* tangStif)
@@ -174,6 +176,34 @@ ExperimentalSignalFilter* ESFTangForceConverter::getCopy()
 }
 
 
+int ESFTangForceConverter::saveState(ExpCheckpoint &theCheckpoint)
+{
+    theCheckpoint.save(int(firstWarning));
+    theCheckpoint.save(&dispPast);
+    theCheckpoint.save(&forcePast);
+    theCheckpoint.save(&kInit);
+    theCheckpoint.save(&kPrev);
+    if (theTangStiff != 0)
+        return theTangStiff->saveState(theCheckpoint);
+    
+    return 0;
+}
+
+
+int ESFTangForceConverter::restoreState(ExpCheckpoint &theCheckpoint)
+{
+    theCheckpoint.restore(firstWarning);
+    theCheckpoint.restore(&dispPast);
+    theCheckpoint.restore(&forcePast);
+    theCheckpoint.restore(&kInit);
+    theCheckpoint.restore(&kPrev);
+    if (theTangStiff != 0)
+        return theTangStiff->restoreState(theCheckpoint);
+    
+    return 0;
+}
+
+
 void ESFTangForceConverter::Print(OPS_Stream &s, int flag)
 {
     s << "Experimental Signal Filter: " << this->getTag(); 
@@ -62,6 +62,10 @@ public:
     
     virtual ExperimentalSignalFilter *getCopy();
     
+    // public methods to save and restore the state for a checkpoint
+    virtual int saveState(ExpCheckpoint &theCheckpoint);
+    virtual int restoreState(ExpCheckpoint &theCheckpoint);
+    
     // public methods for output
     void Print(OPS_Stream &s, int flag = 0);
 
@@ -35,6 +35,8 @@
 
 #include "ExperimentalSignalFilter.h"
 
+#include <ExpCheckpoint.h>
+
 
 ExperimentalSignalFilter::ExperimentalSignalFilter(int tag)
     : TaggedObject(tag)
@@ -84,3 +86,23 @@ int ExperimentalSignalFilter::getResponse(int responseID,
     // each subclass must implement its own response
     return -1;
 }
+
+
+int ExperimentalSignalFilter::setFeedback(const Vector &data)
+{
+    // filters that do not adapt ignore the feedback
+    return 0;
+}
+
+
+int ExperimentalSignalFilter::saveState(ExpCheckpoint &theCheckpoint)
+{
+    // objects without a history have no state to save
+    return 0;
+}
+
+
+int ExperimentalSignalFilter::restoreState(ExpCheckpoint &theCheckpoint)
+{
+    return 0;
+}
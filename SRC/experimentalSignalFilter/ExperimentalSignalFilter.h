@@ -44,6 +44,7 @@
 #include <Vector.h>
 
 class Response;
+class ExpCheckpoint;
 
 class ExperimentalSignalFilter : public TaggedObject
 {
@@ -64,12 +65,20 @@ public:
     virtual int setSize(const int sz) = 0;
     virtual void update() = 0;
     
+    // method for filters that adapt to the measured response,
+    // the control passes the daq signals after each acquire
+    virtual int setFeedback(const Vector &data);
+    
     virtual ExperimentalSignalFilter *getCopy() = 0;
     
     // public methods for experimental signal filter recorder
     virtual Response *setResponse(const char **argv, int argc,
         OPS_Stream &output);
     virtual int getResponse(int responseID, Information &info);
+    
+    // public methods to save and restore the state for a checkpoint
+    virtual int saveState(ExpCheckpoint &theCheckpoint);
+    virtual int restoreState(ExpCheckpoint &theCheckpoint);
 };
 
 #endif
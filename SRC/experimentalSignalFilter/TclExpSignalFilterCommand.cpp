@@ -34,6 +34,7 @@
 #include <tcl.h>
 #include <ArrayOfTaggedObjects.h>
 
+#include <ESFDelayCompensation.h>
 #include <ESFErrorSimRandomGauss.h>
 #include <ESFErrorSimUndershoot.h>
 #include <ESFKrylovForceConverter.h>
@@ -175,6 +176,83 @@ int TclExpSignalFilterCommand(ClientData clientData, Tcl_Interp *interp,
         theFilter = new ESFErrorSimUndershoot(tag, error);
     }
     
+    // ----------------------------------------------------------------------------	
+    else if (strcmp(argv[1],"DelayCompensation") == 0)  {
+        if (argc < 5)  {
+            opserr << "WARNING invalid number of arguments\n";
+            printCommand(argc,argv);
+            opserr << "Want: expSignalFilter DelayCompensation tag dt delay "
+                << "<-order n> <-adapt gain> <-maxDelay t> <-numSig n>\n";
+            return TCL_ERROR;
+        }
+        
+        int tag, order = 2, numSig = 1, argi = 2;
+        double dt, delay, gain = 0.0, maxDelay = 0.0;
+        
+        if (Tcl_GetInt(interp, argv[argi], &tag) != TCL_OK)  {
+            opserr << "WARNING invalid DelayCompensation tag\n";
+            return TCL_ERROR;
+        }
+        argi++;
+        if (Tcl_GetDouble(interp, argv[argi], &dt) != TCL_OK || dt <= 0.0)  {
+            opserr << "WARNING invalid dt\n";
+            opserr << "expSignalFilter DelayCompensation " << tag << endln;
+            return TCL_ERROR;
+        }
+        argi++;
+        if (Tcl_GetDouble(interp, argv[argi], &delay) != TCL_OK || delay < 0.0)  {
+            opserr << "WARNING invalid delay\n";
+            opserr << "expSignalFilter DelayCompensation " << tag << endln;
+            return TCL_ERROR;
+        }
+        argi++;
+        while (argi < argc)  {
+            if (strcmp(argv[argi],"-order") == 0 && argi+1 < argc)  {
+                argi++;
+                if (Tcl_GetInt(interp, argv[argi], &order) != TCL_OK ||
+                    order < 1 || order > 3)  {
+                    opserr << "WARNING invalid order, want: 1, 2 or 3\n";
+                    opserr << "expSignalFilter DelayCompensation " << tag << endln;
+                    return TCL_ERROR;
+                }
+            }
+            else if (strcmp(argv[argi],"-adapt") == 0 && argi+1 < argc)  {
+                argi++;
+                if (Tcl_GetDouble(interp, argv[argi], &gain) != TCL_OK || gain < 0.0)  {
+                    opserr << "WARNING invalid adaptation gain\n";
+                    opserr << "expSignalFilter DelayCompensation " << tag << endln;
+                    return TCL_ERROR;
+                }
+            }
+            else if (strcmp(argv[argi],"-maxDelay") == 0 && argi+1 < argc)  {
+                argi++;
+                if (Tcl_GetDouble(interp, argv[argi], &maxDelay) != TCL_OK)  {
+                    opserr << "WARNING invalid maxDelay\n";
+                    opserr << "expSignalFilter DelayCompensation " << tag << endln;
+                    return TCL_ERROR;
+                }
+            }
+            else if (strcmp(argv[argi],"-numSig") == 0 && argi+1 < argc)  {
+                argi++;
+                if (Tcl_GetInt(interp, argv[argi], &numSig) != TCL_OK || numSig < 1)  {
+                    opserr << "WARNING invalid numSig\n";
+                    opserr << "expSignalFilter DelayCompensation " << tag << endln;
+                    return TCL_ERROR;
+                }
+            }
+            else  {
+                opserr << "WARNING unknown option: " << argv[argi] << endln;
+                opserr << "expSignalFilter DelayCompensation " << tag << endln;
+                return TCL_ERROR;
+            }
+            argi++;
+        }
+        
+        // parsing was successful, allocate the signal filter
+        theFilter = new ESFDelayCompensation(tag, dt, delay, order,
+            gain, maxDelay, numSig);
+    }
+    
     // ----------------------------------------------------------------------------	
     else if (strcmp(argv[1],"KrylovForceConverter") == 0)  {
         if (argc < 6)  {
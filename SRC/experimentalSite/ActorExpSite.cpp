@@ -34,6 +34,11 @@
 
 #include "ActorExpSite.h"
 
+#include <DataCodec.h>
+#include <Message.h>
+
+#include <math.h>
+
 
 ActorExpSite::ActorExpSite(int tag, 
     ExperimentalSetup *setup,
@@ -42,7 +47,8 @@ ActorExpSite::ActorExpSite(int tag,
     : ExperimentalSite(tag, setup), 
     Actor(theChannel, *theObjectBroker, 0),
     theControl(0), dataSize(0),
-    sendV(OF_Network_dataSize), recvV(OF_Network_dataSize)
+    sendV(OF_Network_dataSize), recvV(OF_Network_dataSize),
+    zeroV(OF_Network_dataSize), theCodec(0), codecBuf(0)
 { 
     if (theSetup == 0)  {
         opserr << "ActorExpSite::ActorExpSite() - "
@@ -60,7 +66,8 @@ ActorExpSite::ActorExpSite(int tag,
     : ExperimentalSite(tag, (ExperimentalSetup*)0), 
     Actor(theChannel, *theObjectBroker, 0),
     theControl(control), dataSize(0),
-    sendV(OF_Network_dataSize), recvV(OF_Network_dataSize)
+    sendV(OF_Network_dataSize), recvV(OF_Network_dataSize),
+    zeroV(OF_Network_dataSize), theCodec(0), codecBuf(0)
 { 
     if (theControl == 0)  {
         opserr << "ActorExpSite::ActorExpSite() - "
@@ -74,7 +81,8 @@ ActorExpSite::ActorExpSite(int tag,
 ActorExpSite::ActorExpSite(const ActorExpSite& es)
     : ExperimentalSite(es), Actor(es), 
     theControl(0), dataSize(0),
-    sendV(OF_Network_dataSize), recvV(OF_Network_dataSize)
+    sendV(OF_Network_dataSize), recvV(OF_Network_dataSize),
+    zeroV(OF_Network_dataSize), theCodec(0), codecBuf(0)
 {  
     if (es.theControl != 0)  {
         theControl = (es.theControl)->getCopy();
@@ -89,6 +97,14 @@ ActorExpSite::ActorExpSite(const ActorExpSite& es)
     dataSize = es.dataSize;    
     sendV.resize(dataSize);
     recvV.resize(dataSize);
+    zeroV.resize(dataSize);
+    zeroV.Zero();
+    
+    if (es.theCodec != 0)  {
+        theCodec = new DataCodec(*es.theCodec);
+        codecBuf = new char [DataCodec::lengthSize
+            + DataCodec::getMaxFrameSize(dataSize)];
+    }
 }
 
 
@@ -96,6 +112,10 @@ ActorExpSite::~ActorExpSite()
 {
     if (theControl != 0) 
         delete theControl;
+    if (theCodec != 0)
+        delete theCodec;
+    if (codecBuf != 0)
+        delete [] codecBuf;
 }
 
 
@@ -178,8 +198,12 @@ int ActorExpSite::runTill(int exitWhen)
             break;
         case OF_RemoteTest_getDaqResponse:
             this->checkDaqResponse();
-            this->setSendDaqResponse();
-            this->sendVector(sendV);
+            this->sendDaqResponse();
+            if (exitWhen == action)
+                exitYet = true;
+            break;
+        case OF_RemoteTest_trajectory:
+            this->execTrajectory();
             if (exitWhen == action)
                 exitYet = true;
             break;
@@ -208,6 +232,20 @@ int ActorExpSite::setup()
     this->recvID(*sizeTrial);
     this->recvID(*sizeOut);
     
+    // the setup message requests compression with the flag at
+    // index 3 and the number of resolutions that follow at index 4
+    if (theCodec != 0)  {
+        delete theCodec;
+        theCodec = 0;
+    }
+    if (recvV.Size() > 4 && recvV(3) == 1.0)  {
+        int numRes = (int)recvV(4);
+        Vector resolution(numRes > 0 ? numRes : 0);
+        if (numRes > 0)
+            this->recvVector(resolution);
+        theCodec = new DataCodec(resolution);
+    }
+    
     this->setSize(*sizeTrial, *sizeOut);
     
     return OF_ReturnType_completed;
@@ -235,6 +273,16 @@ int ActorExpSite::setSize(ID sizeT, ID sizeO)
     // resize channel Vectors
     sendV.resize(dataSize);
     recvV.resize(dataSize);
+    zeroV.resize(dataSize);
+    zeroV.Zero();
+    
+    if (codecBuf != 0)  {
+        delete [] codecBuf;
+        codecBuf = 0;
+    }
+    if (theCodec != 0)
+        codecBuf = new char [DataCodec::lengthSize
+            + DataCodec::getMaxFrameSize(dataSize)];
     
     return OF_ReturnType_completed;
 }
@@ -365,6 +413,39 @@ int ActorExpSite::setSendDaqResponse()
 }
 
 
+int ActorExpSite::sendDaqResponse()
+{
+    int numOut = getOutSize(OF_Resp_Disp) + getOutSize(OF_Resp_Vel)
+        + getOutSize(OF_Resp_Accel) + getOutSize(OF_Resp_Force)
+        + getOutSize(OF_Resp_Time);
+    
+    // send a compressed frame in a single message so that the
+    // length and the frame do not wait for each other
+    if (theCodec != 0)  {
+        this->setSendDaqResponse();
+        Vector daq(&sendV(0), numOut);
+        int numBytes = theCodec->encode(daq, &codecBuf[DataCodec::lengthSize]);
+        DataCodec::putFrameLength(codecBuf, numBytes);
+        Message msg(codecBuf, DataCodec::lengthSize+numBytes);
+        
+        return this->sendMessage(msg);
+    }
+    
+    // send the daq response straight from the vectors, the
+    // message keeps its fixed size and is padded with zeros
+    Vector pad(&zeroV(0), dataSize-numOut);
+    const Vector *theVectors[6] = {
+        getOutSize(OF_Resp_Disp) != 0 ? oDisp : 0,
+        getOutSize(OF_Resp_Vel) != 0 ? oVel : 0,
+        getOutSize(OF_Resp_Accel) != 0 ? oAccel : 0,
+        getOutSize(OF_Resp_Force) != 0 ? oForce : 0,
+        getOutSize(OF_Resp_Time) != 0 ? oTime : 0,
+        &pad};
+    
+    return this->sendv(theVectors, 6);
+}
+
+
 int ActorExpSite::commitState(Vector* time)
 {
     int rValue = 0;
@@ -390,6 +471,97 @@ int ActorExpSite::commitState(Vector* time)
 }
 
 
+int ActorExpSite::execTrajectory()
+{
+    Vector info(4);
+    this->recvVector(info);
+    int numPoints = (int)info(0);
+    int chunkSize = (int)info(1);
+    int numLimits = (int)info(2);
+    int numAhead = (int)info(3);
+    
+    int numTrial = 0, numOut = 0;
+    for (int i=0; i<OF_Resp_All; i++)  {
+        numTrial += getTrialSize(i);
+        numOut += getOutSize(i);
+    }
+    
+    Vector *limits = 0;
+    if (numLimits > 0)  {
+        limits = new Vector(numLimits);
+        this->recvVector(*limits);
+        if (numLimits != numOut)  {
+            opserr << "ActorExpSite::execTrajectory() - "
+                << "invalid number of limits.\n";
+            exit(OF_ReturnType_failed);
+        }
+    }
+    
+    Vector chunk(chunkSize*numTrial);
+    Vector row(1+numOut);
+    Vector *trialVectors[5] = {tDisp, tVel, tAccel, tForce, tTime};
+    Vector *outVectors[5] = {oDisp, oVel, oAccel, oForce, oTime};
+    int numChunks = (numPoints + chunkSize - 1)/chunkSize;
+    int abortChunk = -1;
+    int numDone = 0;
+    int c, i, j, k, p;
+    
+    for (c=0; c<numChunks; c++)  {
+        // the chunks the ShadowExpSite keeps in flight
+        // have to be received even after an abort
+        if (abortChunk >= 0 && c > abortChunk+numAhead)
+            break;
+        int first = c*chunkSize;
+        int last = (first+chunkSize < numPoints) ? first+chunkSize : numPoints;
+        Vector chunkV(&chunk(0), (last-first)*numTrial);
+        this->recvVector(chunkV);
+        if (abortChunk >= 0)
+            continue;
+        
+        for (p=0; p<last-first; p++)  {
+            // execute the point
+            for (i=0, j=p*numTrial; i<5; i++)  {
+                if (trialVectors[i] != 0)  {
+                    trialVectors[i]->Extract(chunkV, j);
+                    j += trialVectors[i]->Size();
+                }
+            }
+            this->setTrialResponse(tDisp, tVel, tAccel, tForce, tTime);
+            this->checkDaqResponse();
+            
+            // stream the daq response back with its status
+            row(0) = OF_ReturnType_completed;
+            for (i=0, j=1; i<5; i++)  {
+                if (outVectors[i] != 0)  {
+                    for (k=0; k<outVectors[i]->Size(); k++, j++)  {
+                        row(j) = (*outVectors[i])(k);
+                        if (limits != 0 && (*limits)(j-1) > 0.0
+                            && fabs(row(j)) > (*limits)(j-1))
+                            row(0) = OF_ReturnType_failed;
+                    }
+                }
+            }
+            this->sendVector(row);
+            
+            if (row(0) == OF_ReturnType_failed)  {
+                opserr << "WARNING ActorExpSite::execTrajectory() - "
+                    << "daq response exceeded the limits at point "
+                    << numDone+1 << ", trajectory aborted.\n";
+                abortChunk = c;
+                break;
+            }
+            this->commitState();
+            numDone++;
+        }
+    }
+    
+    if (limits != 0)
+        delete limits;
+    
+    return (abortChunk < 0) ? OF_ReturnType_completed : OF_ReturnType_failed;
+}
+
+
 ExperimentalSite* ActorExpSite::getCopy()
 {
     ActorExpSite *theCopy = new ActorExpSite(*this);
@@ -408,4 +580,6 @@ void ActorExpSite::Print(OPS_Stream &s, int flag)
         s << "\tExperimentalControl tag: " << theControl->getTag() << endln;
         s << *theControl;
     }
+    if (theCodec != 0)
+        theCodec->Print(s);
 }
@@ -36,12 +36,19 @@
 // Description: This file contains the class definition for 
 // ActorExpSite. An ActorExpSite can communicate with a RemoteExpSite.
 // This object inherits from Actor, and runs on the server program.
+// If the ShadowExpSite requests compression during the setup, the
+// daq response is sent as a DataCodec frame prefixed with its length.
+// Trajectories uploaded by the ShadowExpSite are executed without
+// waiting for further requests, the daq response of each point is
+// sent back as soon as it is acquired and the trajectory is aborted
+// once it exceeds the limits.
 
 #include "ExperimentalSite.h"
 
 #include <Actor.h>
 
 class ExperimentalControl;
+class DataCodec;
 
 class ActorExpSite : public ExperimentalSite, public Actor
 {
@@ -79,6 +86,7 @@ public:
     
     virtual int checkDaqResponse();
     virtual int setSendDaqResponse();
+    virtual int sendDaqResponse();
     
     virtual int commitState(Vector *time = 0);
     
@@ -97,6 +105,14 @@ protected:
     // vectors in Channel
     Vector sendV;
     Vector recvV;
+    Vector zeroV;  // padding of messages sent with sendv
+    
+    // compression of the daq response
+    DataCodec *theCodec;
+    char *codecBuf;
+    
+private:
+    int execTrajectory();
 };
 
 #endif
@@ -0,0 +1,350 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// $Revision$
+// $Date$
+// $URL$
+
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the implementation of
+// ExpCheckpoint.
+
+#include "ExpCheckpoint.h"
+
+#include <OPS_Globals.h>
+#include <Vector.h>
+#include <Matrix.h>
+
+#include <string.h>
+#ifdef _WIN32
+#include <windows.h>
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+static const char ckpMagic[4] = {'O','F','C','K'};
+static const int ckpVersion = 1;
+
+
+ExpCheckpoint::ExpCheckpoint(const char *filename)
+    : fileName(0), tmpName(0), theFile(0),
+    writing(false), failed(false)
+{
+    fileName = new char [strlen(filename)+1];
+    strcpy(fileName, filename);
+    tmpName = new char [strlen(filename)+5];
+    strcpy(tmpName, filename);
+    strcat(tmpName, ".tmp");
+}
+
+
+ExpCheckpoint::~ExpCheckpoint()
+{
+    if (theFile != 0)
+        this->close();
+    
+    if (fileName != 0)
+        delete [] fileName;
+    if (tmpName != 0)
+        delete [] tmpName;
+}
+
+
+int ExpCheckpoint::openWrite()
+{
+    if (theFile != 0)
+        this->close();
+    
+    theFile = fopen(tmpName, "wb");
+    if (theFile == 0)  {
+        opserr << "ExpCheckpoint::openWrite() - "
+            << "could not open file " << tmpName << endln;
+        return -1;
+    }
+    writing = true;
+    failed = false;
+    
+    this->write(ckpMagic, 4);
+    this->save(ckpVersion);
+    
+    return failed ? -1 : 0;
+}
+
+
+int ExpCheckpoint::openRead()
+{
+    if (theFile != 0)
+        this->close();
+    
+    theFile = fopen(fileName, "rb");
+    if (theFile == 0)  {
+        opserr << "ExpCheckpoint::openRead() - "
+            << "could not open file " << fileName << endln;
+        return -1;
+    }
+    writing = false;
+    failed = false;
+    
+    char magic[4];
+    int version = 0;
+    this->read(magic, 4);
+    this->restore(version);
+    if (failed || memcmp(magic, ckpMagic, 4) != 0 || version != ckpVersion)  {
+        opserr << "ExpCheckpoint::openRead() - "
+            << fileName << " is not a valid checkpoint file\n";
+        fclose(theFile);
+        theFile = 0;
+        return -1;
+    }
+    
+    return 0;
+}
+
+
+int ExpCheckpoint::close()
+{
+    if (theFile == 0)
+        return 0;
+    
+    // make sure the checkpoint is on disk before it replaces the last one
+    if (writing && !failed)  {
+        if (fflush(theFile) != 0)
+            failed = true;
+#ifdef _WIN32
+        else if (_commit(_fileno(theFile)) != 0)
+            failed = true;
+#else
+        else if (fsync(fileno(theFile)) != 0)
+            failed = true;
+#endif
+    }
+    if (fclose(theFile) != 0)
+        failed = true;
+    theFile = 0;
+    
+    // replace the last checkpoint only if this one is complete,
+    // the replacement is atomic so that one of them always exists
+    if (writing)  {
+        if (!failed)  {
+#ifdef _WIN32
+            if (MoveFileExA(tmpName, fileName,
+                MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) == 0)
+                failed = true;
+#else
+            if (rename(tmpName, fileName) != 0)
+                failed = true;
+#endif
+        }
+        if (failed)  {
+            opserr << "ExpCheckpoint::close() - "
+                << "could not write checkpoint file " << fileName << endln;
+            remove(tmpName);
+        }
+    }
+    
+    return failed ? -1 : 0;
+}
+
+
+int ExpCheckpoint::beginObject(const char *classType, int tag)
+{
+    int length = (int)strlen(classType);
+    this->save(length);
+    this->write(classType, length);
+    this->save(tag);
+    
+    return failed ? -1 : 0;
+}
+
+
+int ExpCheckpoint::save(int value)
+{
+    return this->write(&value, sizeof(int));
+}
+
+
+int ExpCheckpoint::save(double value)
+{
+    return this->write(&value, sizeof(double));
+}
+
+
+int ExpCheckpoint::save(const double *data, int size)
+{
+    return this->write(data, size*sizeof(double));
+}
+
+
+int ExpCheckpoint::save(const Vector *v)
+{
+    // a null vector is written with size -1
+    if (v == 0)
+        return this->save(-1);
+    
+    int size = v->Size();
+    this->save(size);
+    for (int i=0; i<size; i++)
+        this->save((*v)(i));
+    
+    return failed ? -1 : 0;
+}
+
+
+int ExpCheckpoint::save(const Matrix *m)
+{
+    // a null matrix is written with size -1
+    if (m == 0)
+        return this->save(-1);
+    
+    int numRows = m->noRows();
+    int numCols = m->noCols();
+    this->save(numRows);
+    this->save(numCols);
+    for (int j=0; j<numCols; j++)
+        for (int i=0; i<numRows; i++)
+            this->save((*m)(i,j));
+    
+    return failed ? -1 : 0;
+}
+
+
+int ExpCheckpoint::checkObject(const char *classType, int tag)
+{
+    char type[64];
+    int length = 0, t = 0;
+    this->restore(length);
+    if (failed || length < 0 || length >= 64)  {
+        failed = true;
+    } else  {
+        this->read(type, length);
+        type[length] = '\0';
+        this->restore(t);
+    }
+    if (failed || strcmp(type, classType) != 0 || t != tag)  {
+        opserr << "ExpCheckpoint::checkObject() - "
+            << "checkpoint does not match " << classType
+            << " with tag " << tag << endln;
+        failed = true;
+        return -1;
+    }
+    
+    return 0;
+}
+
+
+int ExpCheckpoint::restore(int &value)
+{
+    return this->read(&value, sizeof(int));
+}
+
+
+int ExpCheckpoint::restore(bool &value)
+{
+    int i = 0;
+    this->restore(i);
+    value = (i != 0);
+    
+    return failed ? -1 : 0;
+}
+
+
+int ExpCheckpoint::restore(double &value)
+{
+    return this->read(&value, sizeof(double));
+}
+
+
+int ExpCheckpoint::restore(double *data, int size)
+{
+    return this->read(data, size*sizeof(double));
+}
+
+
+int ExpCheckpoint::restore(Vector *v)
+{
+    int size = 0;
+    this->restore(size);
+    if (failed || size != ((v != 0) ? v->Size() : -1))  {
+        opserr << "ExpCheckpoint::restore() - "
+            << "vector size does not match checkpoint\n";
+        failed = true;
+        return -1;
+    }
+    for (int i=0; i<size; i++)
+        this->restore((*v)(i));
+    
+    return failed ? -1 : 0;
+}
+
+
+int ExpCheckpoint::restore(Matrix *m)
+{
+    int numRows = 0, numCols = 0;
+    this->restore(numRows);
+    if (numRows >= 0)
+        this->restore(numCols);
+    if (failed || (m == 0 && numRows != -1) ||
+        (m != 0 && (numRows != m->noRows() || numCols != m->noCols())))  {
+        opserr << "ExpCheckpoint::restore() - "
+            << "matrix size does not match checkpoint\n";
+        failed = true;
+        return -1;
+    }
+    for (int j=0; j<numCols; j++)
+        for (int i=0; i<numRows; i++)
+            this->restore((*m)(i,j));
+    
+    return failed ? -1 : 0;
+}
+
+
+bool ExpCheckpoint::atEnd()
+{
+    char extra;
+    
+    if (theFile == 0 || writing)
+        return false;
+    
+    return (fread(&extra, 1, 1, theFile) != 1);
+}
+
+
+int ExpCheckpoint::write(const void *data, int size)
+{
+    if (theFile == 0 || !writing ||
+        (size > 0 && fwrite(data, size, 1, theFile) != 1))
+        failed = true;
+    
+    return failed ? -1 : 0;
+}
+
+
+int ExpCheckpoint::read(void *data, int size)
+{
+    if (theFile == 0 || writing ||
+        (size > 0 && fread(data, size, 1, theFile) != 1))
+        failed = true;
+    
+    return failed ? -1 : 0;
+}
@@ -0,0 +1,94 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// $Revision$
+// $Date$
+// $URL$
+
+#ifndef ExpCheckpoint_h
+#define ExpCheckpoint_h
+
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the class definition for
+// ExpCheckpoint. ExpCheckpoint is a compact binary file that holds
+// the committed state of the experimental sites, setups, controls,
+// signal filters, tangent stiffness estimators and elements, so that
+// an aborted hybrid test can be restarted from the last checkpoint.
+// Each object writes its state between a header with its class type
+// and tag, which is checked again when the state is restored. The
+// file is first written under a temporary name and only renamed once
+// it is complete, so a crash during a checkpoint leaves the previous
+// checkpoint intact.
+
+#include <stdio.h>
+
+class Vector;
+class Matrix;
+
+class ExpCheckpoint
+{
+public:
+    // constructor
+    ExpCheckpoint(const char *fileName);
+    
+    // destructor
+    ~ExpCheckpoint();
+    
+    // methods to open and close the file
+    int openWrite();
+    int openRead();
+    int close();
+    
+    // methods to write the state
+    int beginObject(const char *classType, int tag);
+    int save(int value);
+    int save(double value);
+    int save(const double *data, int size);
+    int save(const Vector *v);
+    int save(const Matrix *m);
+    
+    // methods to read the state, the sizes of the vectors and
+    // matrices have to match the ones that were written
+    int checkObject(const char *classType, int tag);
+    int restore(int &value);
+    int restore(bool &value);
+    int restore(double &value);
+    int restore(double *data, int size);
+    int restore(Vector *v);
+    int restore(Matrix *m);
+    
+    // method to check if all the state has been read
+    bool atEnd();
+    
+private:
+    int write(const void *data, int size);
+    int read(void *data, int size);
+    
+    char *fileName;     // name of the checkpoint file
+    char *tmpName;      // name of the file while it is written
+    FILE *theFile;      // the open file
+    bool writing;       // flag if the file is open for writing
+    bool failed;        // flag if a read or write failed
+};
+
+#endif
@@ -36,6 +36,10 @@
 #include "ExperimentalSite.h"
 
 #include <Recorder.h>
+#include <ExpCheckpoint.h>
+#include <Matrix.h>
+
+#include <math.h>
 
 
 ExperimentalSite::ExperimentalSite(int tag, 
@@ -317,6 +321,126 @@ int ExperimentalSite::commitState(Vector* time)
 }
 
 
+int ExperimentalSite::runTrajectory(const Matrix &trial, Matrix &out,
+    int &numDone, int chunkSize, const Vector *limits)
+{
+    int numPoints = trial.noRows();
+    int numTrial = 0, numOut = 0;
+    int i, j, k, r;
+    for (r=0; r<OF_Resp_All; r++)  {
+        numTrial += getTrialSize(r);
+        numOut += getOutSize(r);
+    }
+    
+    numDone = 0;
+    if (trial.noCols() != numTrial || out.noRows() != numPoints
+        || out.noCols() != numOut)  {
+        opserr << "ExperimentalSite::runTrajectory() - "
+            << "invalid size of trajectory.\n";
+        return OF_ReturnType_failed;
+    }
+    if (limits != 0 && limits->Size() != numOut)  {
+        opserr << "ExperimentalSite::runTrajectory() - "
+            << "invalid number of limits.\n";
+        return OF_ReturnType_failed;
+    }
+    
+    Vector *in[OF_Resp_All], *res[OF_Resp_All];
+    for (r=0; r<OF_Resp_All; r++)  {
+        in[r] = (getTrialSize(r) != 0) ? new Vector(getTrialSize(r)) : 0;
+        res[r] = (getOutSize(r) != 0) ? new Vector(getOutSize(r)) : 0;
+    }
+    
+    // the points are executed one by one, sites that talk to
+    // a remote site stream them in chunks instead
+    int rValue = OF_ReturnType_completed;
+    for (k=0; k<numPoints && rValue == OF_ReturnType_completed; k++)  {
+        for (r=0, j=0; r<OF_Resp_All; r++)  {
+            for (i=0; i<getTrialSize(r); i++, j++)
+                (*in[r])(i) = trial(k,j);
+        }
+        this->setTrialResponse(in[0], in[1], in[2], in[3], in[4]);
+        this->getDaqResponse(res[0], res[1], res[2], res[3], res[4]);
+        for (r=0, j=0; r<OF_Resp_All; r++)  {
+            for (i=0; i<getOutSize(r); i++, j++)  {
+                out(k,j) = (*res[r])(i);
+                if (limits != 0 && (*limits)(j) > 0.0
+                    && fabs(out(k,j)) > (*limits)(j))
+                    rValue = OF_ReturnType_failed;
+            }
+        }
+        if (rValue == OF_ReturnType_completed)  {
+            this->commitState();
+            numDone++;
+        }
+    }
+    if (rValue != OF_ReturnType_completed)  {
+        opserr << "WARNING ExperimentalSite::runTrajectory() - "
+            << "daq response exceeded the limits at point "
+            << numDone+1 << ", trajectory aborted.\n";
+    }
+    
+    for (r=0; r<OF_Resp_All; r++)  {
+        if (in[r] != 0)
+            delete in[r];
+        if (res[r] != 0)
+            delete res[r];
+    }
+    
+    return rValue;
+}
+
+
+int ExperimentalSite::saveState(ExpCheckpoint &theCheckpoint)
+{
+    theCheckpoint.beginObject(this->getClassType(), this->getTag());
+    theCheckpoint.save(commitTag);
+    theCheckpoint.save(tDisp);
+    theCheckpoint.save(tVel);
+    theCheckpoint.save(tAccel);
+    theCheckpoint.save(tForce);
+    theCheckpoint.save(tTime);
+    
+    // then save the setup
+    if (theSetup != 0)
+        return theSetup->saveState(theCheckpoint);
+    
+    return OF_ReturnType_completed;
+}
+
+
+int ExperimentalSite::restoreState(ExpCheckpoint &theCheckpoint)
+{
+    if (theCheckpoint.checkObject(this->getClassType(), this->getTag()) < 0 ||
+        theCheckpoint.restore(commitTag) < 0 ||
+        theCheckpoint.restore(tDisp) < 0 ||
+        theCheckpoint.restore(tVel) < 0 ||
+        theCheckpoint.restore(tAccel) < 0 ||
+        theCheckpoint.restore(tForce) < 0 ||
+        theCheckpoint.restore(tTime) < 0)  {
+        opserr << "ExperimentalSite::restoreState() - "
+            << "failed to restore state of site " << this->getTag() << endln;
+        return OF_ReturnType_failed;
+    }
+    
+    // then restore the setup
+    if (theSetup != 0)  {
+        if (theSetup->restoreState(theCheckpoint) < 0)  {
+            opserr << "ExperimentalSite::restoreState() - "
+                << "failed to restore state of the setup.\n";
+            return OF_ReturnType_failed;
+        }
+    }
+    
+    // the specimen is not at the checkpoint after a restart,
+    // so the last committed trial response is sent again
+    if (this->setTrialResponse(tDisp, tVel, tAccel, tForce, tTime) < 0)
+        return OF_ReturnType_failed;
+    
+    return this->checkDaqResponse();
+}
+
+
 Response* ExperimentalSite::setResponse(const char **argv, int argc,
     OPS_Stream &output)
 {
@@ -338,7 +462,7 @@ Response* ExperimentalSite::setResponse(const char **argv, int argc,
             sprintf(outputData,"trialDisp%d",i+1);
             output.tag("ResponseType",outputData);
         }
-        theResponse = new ExpSiteResponse(this, 1, *tDisp);
+        theResponse = new ExpSiteResponse(this, 1, &tDisp);
     }
     
     // trial velocities
@@ -351,7 +475,7 @@ Response* ExperimentalSite::setResponse(const char **argv, int argc,
             sprintf(outputData,"trialVel%d",i+1);
             output.tag("ResponseType",outputData);
         }
-        theResponse = new ExpSiteResponse(this, 2, *tVel);
+        theResponse = new ExpSiteResponse(this, 2, &tVel);
     }
     
     // trial accelerations
@@ -364,7 +488,7 @@ Response* ExperimentalSite::setResponse(const char **argv, int argc,
             sprintf(outputData,"trialAccel%d",i+1);
             output.tag("ResponseType",outputData);
         }
-        theResponse = new ExpSiteResponse(this, 3, *tAccel);
+        theResponse = new ExpSiteResponse(this, 3, &tAccel);
     }
     
     // trial forces
@@ -376,7 +500,7 @@ Response* ExperimentalSite::setResponse(const char **argv, int argc,
             sprintf(outputData,"trialForce%d",i+1);
             output.tag("ResponseType",outputData);
         }
-        theResponse = new ExpSiteResponse(this, 4, *tForce);
+        theResponse = new ExpSiteResponse(this, 4, &tForce);
     }
     
     // trial times
@@ -388,7 +512,7 @@ Response* ExperimentalSite::setResponse(const char **argv, int argc,
             sprintf(outputData,"trialTime%d",i+1);
             output.tag("ResponseType",outputData);
         }
-        theResponse = new ExpSiteResponse(this, 5, *tTime);
+        theResponse = new ExpSiteResponse(this, 5, &tTime);
     }
     
     // output displacements
@@ -401,7 +525,7 @@ Response* ExperimentalSite::setResponse(const char **argv, int argc,
             sprintf(outputData,"outDisp%d",i+1);
             output.tag("ResponseType",outputData);
         }
-        theResponse = new ExpSiteResponse(this, 6, *oDisp);
+        theResponse = new ExpSiteResponse(this, 6, &oDisp);
     }
     
     // output velocities
@@ -414,7 +538,7 @@ Response* ExperimentalSite::setResponse(const char **argv, int argc,
             sprintf(outputData,"outVel%d",i+1);
             output.tag("ResponseType",outputData);
         }
-        theResponse = new ExpSiteResponse(this, 7, *oVel);
+        theResponse = new ExpSiteResponse(this, 7, &oVel);
     }
     
     // output accelerations
@@ -427,7 +551,7 @@ Response* ExperimentalSite::setResponse(const char **argv, int argc,
             sprintf(outputData,"outAccel%d",i+1);
             output.tag("ResponseType",outputData);
         }
-        theResponse = new ExpSiteResponse(this, 8, *oAccel);
+        theResponse = new ExpSiteResponse(this, 8, &oAccel);
     }
     
     // output forces
@@ -439,7 +563,7 @@ Response* ExperimentalSite::setResponse(const char **argv, int argc,
             sprintf(outputData,"outForce%d",i+1);
             output.tag("ResponseType",outputData);
         }
-        theResponse = new ExpSiteResponse(this, 9, *oForce);
+        theResponse = new ExpSiteResponse(this, 9, &oForce);
     }
     
     // output times
@@ -451,7 +575,7 @@ Response* ExperimentalSite::setResponse(const char **argv, int argc,
             sprintf(outputData,"outTime%d",i+1);
             output.tag("ResponseType",outputData);
         }
-        theResponse = new ExpSiteResponse(this, 10, *oTime);
+        theResponse = new ExpSiteResponse(this, 10, &oTime);
     }
     
     output.endTag();
@@ -37,6 +37,11 @@
 // ExperimentalSite. An ExperimentalSite is an interface class
 // for OpenFresco and responsible for managing data and 
 // communicating between computational and experimental sites.
+// With runTrajectory() a known history of trial responses (e.g. a
+// quasi-static cyclic protocol) is executed point by point, each
+// point is committed and the test is aborted as soon as the output
+// response exceeds the given limits (the daq response for sites that
+// check the limits remotely, see ShadowExpSite).
 
 #include <FrescoGlobals.h>
 #include <ExpSiteResponse.h>
@@ -46,8 +51,10 @@
 #include <ID.h>
 #include <Vector.h>
 
+class Matrix;
 class Response;
 class Recorder;
+class ExpCheckpoint;
 
 class ExperimentalSite : public TaggedObject
 {
@@ -98,8 +105,21 @@ public:
     
     virtual int commitState(Vector *time = 0);
     
+    // public method to run a trajectory, each row of trial holds the
+    // trial response of one point and the daq response is returned in
+    // the same row of out, limits are absolute values per channel of
+    // the output response (0 = no limit), numDone returns the number
+    // of committed points and a negative return value tells that the
+    // trajectory was aborted
+    virtual int runTrajectory(const Matrix &trial, Matrix &out,
+        int &numDone, int chunkSize = 0, const Vector *limits = 0);
+    
     virtual ExperimentalSite *getCopy() = 0;
     
+    // public methods to save and restore the state for a checkpoint
+    virtual int saveState(ExpCheckpoint &theCheckpoint);
+    virtual int restoreState(ExpCheckpoint &theCheckpoint);
+    
     // public methods for experimental site recorder
     virtual Response *setResponse(const char **argv, int argc,
         OPS_Stream &output);
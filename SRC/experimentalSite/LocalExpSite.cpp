@@ -37,27 +37,45 @@
 
 
 LocalExpSite::LocalExpSite(int tag, 
-    ExperimentalSetup *setup)
-    : ExperimentalSite(tag, setup)
+    ExperimentalSetup *setup,
+    int nSubSteps, int ord, bool avg)
+    : ExperimentalSite(tag, setup),
+    numSubSteps(nSubSteps), order(ord), average(avg),
+    weights(0), history(0), target(0), cmd(0),
+    cDisp(0), cVel(0), cAccel(0), cForce(0), cTime(0), daqSum(0)
 {
     if (theSetup == 0)  {
         opserr << "LocalExpSite::LocalExpSite() - "
             << "must have an instance of ExperimentalSetup.\n";
         exit(OF_ReturnType_failed);
     }
+    if (numSubSteps < 1)  {
+        opserr << "LocalExpSite::LocalExpSite() - "
+            << "number of sub-steps must be at least 1.\n";
+        exit(OF_ReturnType_failed);
+    }
+    if (order < 1 || order > 3)  {
+        opserr << "LocalExpSite::LocalExpSite() - "
+            << "interpolation order must be 1, 2 or 3.\n";
+        exit(OF_ReturnType_failed);
+    }
 }
 
 
 LocalExpSite::LocalExpSite(const LocalExpSite& es)
-    : ExperimentalSite(es)
+    : ExperimentalSite(es),
+    weights(0), history(0), target(0), cmd(0),
+    cDisp(0), cVel(0), cAccel(0), cForce(0), cTime(0), daqSum(0)
 {
-    // does nothing
+    numSubSteps = es.numSubSteps;
+    order       = es.order;
+    average     = es.average;
 }
 
 
 LocalExpSite::~LocalExpSite()
 {
-    // does nothing
+    this->deleteSubSteps();
 }
 
 
@@ -75,6 +93,53 @@ int LocalExpSite::setSize(ID sizeT, ID sizeO)
     
     theSetup->checkSize(sizeT, sizeO);
     
+    if (numSubSteps == 1)
+        return OF_ReturnType_completed;
+    
+    // allocate the history of the targets and the sub-step
+    // command, which is viewed as the individual trial responses
+    this->deleteSubSteps();
+    int i, j, m, n, sizeCmd = 0;
+    for (i=0; i<OF_Resp_All; i++)
+        sizeCmd += sizeT(i);
+    
+    history = new Vector* [order];
+    for (m=0; m<order; m++)
+        history[m] = new Vector(sizeCmd);
+    target = new Vector(sizeCmd);
+    cmd = new Vector(sizeCmd);
+    
+    Vector **views[OF_Resp_All] = {&cDisp, &cVel, &cAccel, &cForce, &cTime};
+    for (i=0, j=0; i<OF_Resp_All; i++)  {
+        if (sizeT(i) != 0)
+            *views[i] = new Vector(&(*cmd)(j), sizeT(i));
+        j += sizeT(i);
+    }
+    
+    int sizeDaq = 0;
+    for (i=0; i<OF_Resp_Time; i++)
+        sizeDaq += sizeO(i);
+    if (average)
+        daqSum = new Vector(sizeDaq);
+    
+    // the targets are equally spaced with the last committed one at
+    // x = 0 and the new one at x = 1, so the Lagrange weights of the
+    // sub-steps at x = j/numSubSteps only depend on the order
+    weights = new double [numSubSteps*(order+1)];
+    for (j=0; j<numSubSteps; j++)  {
+        double x = double(j+1)/numSubSteps;
+        for (m=0; m<=order; m++)  {
+            double w = 1.0;
+            for (n=0; n<=order; n++)
+                if (n != m)
+                    w *= (x - (n-order+1))/double(m-n);
+            weights[j*(order+1)+m] = w;
+        }
+    }
+    
+    // the specimen starts from rest
+    this->resetHistory();
+    
     return OF_ReturnType_completed;
 }
 
@@ -91,6 +156,10 @@ int LocalExpSite::setTrialResponse(const Vector* disp,
     // set daq flag
     daqFlag = false;
     
+    // execute the sub-steps locally
+    if (numSubSteps > 1)
+        return this->runSubSteps();
+    
     int rValue;
     // set trial response at the setup
     rValue = theSetup->setTrialResponse(tDisp, tVel, tAccel, tForce, tTime);
@@ -127,6 +196,25 @@ int LocalExpSite::checkDaqResponse()
 }
 
 
+int LocalExpSite::commitState(Vector* time)
+{
+    // call the base class method
+    int rValue = this->ExperimentalSite::commitState(time);
+    
+    // shift the committed target into the history
+    if (numSubSteps > 1)  {
+        Vector *oldest = history[0];
+        for (int m=0; m<order-1; m++)
+            history[m] = history[m+1];
+        history[order-1] = oldest;
+        this->assembleTarget();
+        *oldest = *target;
+    }
+    
+    return rValue;
+}
+
+
 ExperimentalSite* LocalExpSite::getCopy()
 {
     LocalExpSite *theCopy = new LocalExpSite(*this);
@@ -135,10 +223,146 @@ ExperimentalSite* LocalExpSite::getCopy()
 }
 
 
+int LocalExpSite::restoreState(ExpCheckpoint &theCheckpoint)
+{
+    // the base class moves the specimen back to the checkpoint
+    // with the sub-steps starting from the current history
+    int rValue = this->ExperimentalSite::restoreState(theCheckpoint);
+    
+    // then continue from the restored target
+    if (rValue >= 0 && numSubSteps > 1)  {
+        this->assembleTarget();
+        for (int m=0; m<order; m++)
+            *history[m] = *target;
+    }
+    
+    return rValue;
+}
+
+
 void LocalExpSite::Print(OPS_Stream &s, int flag)
 {
     s << "ExperimentalSite: " << this->getTag(); 
     s << " type: LocalExpSite\n";
+    if (numSubSteps > 1)  {
+        s << "\tnumSubSteps: " << numSubSteps
+            << ", order: " << order
+            << ", average: " << (average ? "yes" : "no") << endln;
+    }
     s << "\tExperimentalSetup tag: " << theSetup->getTag() << endln;
     s << *theSetup;
 }
+
+
+void LocalExpSite::deleteSubSteps()
+{
+    if (weights != 0)
+        delete [] weights;
+    if (history != 0)  {
+        for (int m=0; m<order; m++)
+            delete history[m];
+        delete [] history;
+    }
+    if (target != 0)
+        delete target;
+    if (cDisp != 0)
+        delete cDisp;
+    if (cVel != 0)
+        delete cVel;
+    if (cAccel != 0)
+        delete cAccel;
+    if (cForce != 0)
+        delete cForce;
+    if (cTime != 0)
+        delete cTime;
+    if (cmd != 0)
+        delete cmd;
+    if (daqSum != 0)
+        delete daqSum;
+    
+    weights = 0; history = 0; target = 0; cmd = 0;
+    cDisp = 0; cVel = 0; cAccel = 0; cForce = 0; cTime = 0;
+    daqSum = 0;
+}
+
+
+void LocalExpSite::assembleTarget()
+{
+    Vector *trial[OF_Resp_All] = {tDisp, tVel, tAccel, tForce, tTime};
+    target->Zero();
+    for (int i=0, j=0; i<OF_Resp_All; i++)  {
+        if (trial[i] != 0)  {
+            target->Assemble(*trial[i], j);
+            j += trial[i]->Size();
+        }
+    }
+}
+
+
+void LocalExpSite::resetHistory()
+{
+    for (int m=0; m<order; m++)
+        history[m]->Zero();
+}
+
+
+int LocalExpSite::runSubSteps()
+{
+    int i, j, k, m, rValue;
+    Vector *daq[OF_Resp_Time] = {oDisp, oVel, oAccel, oForce};
+    
+    this->assembleTarget();
+    if (average)
+        daqSum->Zero();
+    
+    for (k=0; k<numSubSteps; k++)  {
+        // interpolate the command of the sub-step
+        const double *w = &weights[k*(order+1)];
+        cmd->addVector(0.0, *target, w[order]);
+        for (m=0; m<order; m++)
+            cmd->addVector(1.0, *history[m], w[m]);
+        
+        // execute the sub-step
+        rValue = theSetup->setTrialResponse(cDisp, cVel, cAccel, cForce, cTime);
+        if (rValue != OF_ReturnType_completed)  {
+            opserr << "LocalExpSite::setTrialResponse() - "
+                << "failed to set trial response at the setup "
+                << "in sub-step " << k+1 << ".\n";
+            exit(OF_ReturnType_failed);
+        }
+        rValue = theSetup->getDaqResponse(oDisp, oVel, oAccel, oForce, oTime);
+        if (rValue != OF_ReturnType_completed)  {
+            opserr << "LocalExpSite::setTrialResponse() - "
+                << "failed to get daq response from the setup "
+                << "in sub-step " << k+1 << ".\n";
+            exit(OF_ReturnType_failed);
+        }
+        
+        if (average)  {
+            for (i=0, j=0; i<OF_Resp_Time; i++)  {
+                if (daq[i] != 0)  {
+                    for (m=0; m<daq[i]->Size(); m++)
+                        (*daqSum)(j++) += (*daq[i])(m);
+                }
+            }
+        }
+    }
+    
+    // the time is the one of the last sub-step
+    if (average)  {
+        for (i=0, j=0; i<OF_Resp_Time; i++)  {
+            if (daq[i] != 0)  {
+                for (m=0; m<daq[i]->Size(); m++)
+                    (*daq[i])(m) = (*daqSum)(j++)/numSubSteps;
+            }
+        }
+    }
+    
+    // save data in basic sys
+    this->ExperimentalSite::setDaqResponse(oDisp, oVel, oAccel, oForce, oTime);
+    
+    // set daq flag
+    daqFlag = true;
+    
+    return OF_ReturnType_completed;
+}
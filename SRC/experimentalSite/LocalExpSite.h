@@ -37,6 +37,14 @@
 // LocalExpSite. A LocalExpSite is a concrete class
 // for OpenFresco and responsible for managing data and 
 // communicating between computational and experimental sites.
+// In the multi-rate mode (numSubSteps > 1) each trial response is
+// interpolated into numSubSteps commands that are executed locally,
+// so that a fast numerical or simulated substructure runs at a finer
+// rate than the global analysis. The commands lie on the polynomial
+// of the given order through the last committed trial responses and
+// the new one. The daq response is the one of the last sub-step or,
+// if averaging is requested, the mean over all sub-steps (the time is
+// always the one of the last sub-step).
 
 #include "ExperimentalSite.h"
 
@@ -45,7 +53,10 @@ class LocalExpSite : public ExperimentalSite
 public:
     // constructors
     LocalExpSite(int tag, 
-        ExperimentalSetup* setup);
+        ExperimentalSetup* setup,
+        int numSubSteps = 1,
+        int order = 1,
+        bool average = false);
     LocalExpSite(const LocalExpSite &es);
     
     // destructor
@@ -66,10 +77,32 @@ public:
     
     virtual int checkDaqResponse();
     
+    virtual int commitState(Vector *time = 0);
+    
     virtual ExperimentalSite *getCopy();
     
+    // public methods to save and restore the state for a checkpoint
+    virtual int restoreState(ExpCheckpoint &theCheckpoint);
+    
     // public methods for output
     void Print(OPS_Stream &s, int flag = 0);
+    
+private:
+    void deleteSubSteps();
+    void assembleTarget();
+    void resetHistory();
+    int runSubSteps();
+    
+    int numSubSteps;    // number of sub-steps per trial response
+    int order;          // order of the interpolation polynomial
+    bool average;       // flag to average the daq response
+    
+    double *weights;    // numSubSteps x (order+1) interpolation weights
+    Vector **history;   // last order committed targets, oldest first
+    Vector *target;     // new target (all trial responses assembled)
+    Vector *cmd;        // command of the current sub-step
+    Vector *cDisp, *cVel, *cAccel, *cForce, *cTime; // views into cmd
+    Vector *daqSum;     // sum of the daq responses of the sub-steps
 };
 
 #endif
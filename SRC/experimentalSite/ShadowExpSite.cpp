@@ -34,6 +34,14 @@
 
 #include "ShadowExpSite.h"
 
+#include <DataCodec.h>
+#include <Message.h>
+#include <Matrix.h>
+
+// largest chunk that is kept in flight, which needs to fit into
+// the socket buffers while the daq responses are streamed back
+static const int maxChunkAhead = 8192;
+
 
 ShadowExpSite::ShadowExpSite(int tag,
     Channel& theChannel, int datasize,
@@ -41,8 +49,10 @@ ShadowExpSite::ShadowExpSite(int tag,
     : ExperimentalSite(tag, (ExperimentalSetup*)0),
     Shadow(theChannel, *theObjectBroker), dataSize(datasize),
     sendV(OF_Network_dataSize), recvV(OF_Network_dataSize),
+    zeroV(OF_Network_dataSize),
     bDisp(0), bVel(0), bAccel(0), bForce(0), bTime(0),
-    rDisp(0), rVel(0), rAccel(0), rForce(0), rTime(0)
+    rDisp(0), rVel(0), rAccel(0), rForce(0), rTime(0),
+    theCodec(0), codecRes(0), codecV(0), codecBuf(0)
 {
     sendV(0) = OF_RemoteTest_open;
     sendV(1) = tag;
@@ -69,8 +79,10 @@ ShadowExpSite::ShadowExpSite(int tag,
     : ExperimentalSite(tag, setup),
     Shadow(theChannel, *theObjectBroker), dataSize(datasize),
     sendV(OF_Network_dataSize), recvV(OF_Network_dataSize),
+    zeroV(OF_Network_dataSize),
     bDisp(0), bVel(0), bAccel(0), bForce(0), bTime(0),
-    rDisp(0), rVel(0), rAccel(0), rForce(0), rTime(0)
+    rDisp(0), rVel(0), rAccel(0), rForce(0), rTime(0),
+    theCodec(0), codecRes(0), codecV(0), codecBuf(0)
 {
     if (theSetup == 0)  {
         opserr << "ShadowExpSite::ShadowExpSite() - "
@@ -100,12 +112,19 @@ ShadowExpSite::ShadowExpSite(int tag,
 ShadowExpSite::ShadowExpSite(const ShadowExpSite& es)
     : ExperimentalSite(es), Shadow(es), dataSize(0),
     sendV(OF_Network_dataSize), recvV(OF_Network_dataSize),
+    zeroV(OF_Network_dataSize),
     bDisp(0), bVel(0), bAccel(0), bForce(0), bTime(0),
-    rDisp(0), rVel(0), rAccel(0), rForce(0), rTime(0)
+    rDisp(0), rVel(0), rAccel(0), rForce(0), rTime(0),
+    theCodec(0), codecRes(0), codecV(0), codecBuf(0)
 {
     dataSize = es.dataSize;
     sendV.resize(dataSize);
     recvV.resize(dataSize);
+    zeroV.resize(dataSize);
+    zeroV.Zero();
+    
+    if (es.codecRes != 0)
+        this->setCompression(*es.codecRes);
 }
 
 
@@ -131,6 +150,18 @@ ShadowExpSite::~ShadowExpSite()
         delete rForce;
     if (rTime != 0)
         delete rTime;
+    if (theCodec != 0)  {
+        opserr << "\nShadowExpSite " << this->getTag()
+            << " - compression ratio of daq responses: "
+            << theCodec->getRatio() << endln;
+        delete theCodec;
+    }
+    if (codecRes != 0)
+        delete codecRes;
+    if (codecV != 0)
+        delete codecV;
+    if (codecBuf != 0)
+        delete [] codecBuf;
     
     sendV(0) = OF_RemoteTest_DIE;
     sendV(1) = this->getTag();
@@ -146,6 +177,19 @@ int ShadowExpSite::setup()
 {    
     sendV(0) = OF_RemoteTest_setup;
     sendV(1) = dataSize;
+    
+    // request compression with the flag at index 3 and
+    // the number of resolutions that follow at index 4
+    if (theCodec != 0 && sendV.Size() > 4)  {
+        sendV(3) = 1.0;
+        sendV(4) = codecRes->Size();
+    } else if (theCodec != 0)  {
+        opserr << "WARNING ShadowExpSite::setup() - dataSize "
+            << "too small to request compression, "
+            << "daq responses are not compressed.\n";
+        delete theCodec;
+        theCodec = 0;
+    }
     this->sendVector(sendV);
     
     if (theSetup != 0)  {
@@ -160,6 +204,13 @@ int ShadowExpSite::setup()
         this->sendID(*sizeOut);
     }
     
+    if (theCodec != 0)  {
+        sendV(3) = 0.0;
+        sendV(4) = 0.0;
+        if (codecRes->Size() > 0)
+            this->sendVector(*codecRes);
+    }
+    
     return OF_ReturnType_completed;
 }
 
@@ -202,6 +253,16 @@ int ShadowExpSite::setSize(ID sizeT, ID sizeO)
     // resize channel Vectors
     sendV.resize(dataSize);
     recvV.resize(dataSize);
+    zeroV.resize(dataSize);
+    zeroV.Zero();
+    
+    if (codecBuf != 0)  {
+        delete [] codecBuf;
+        codecBuf = 0;
+    }
+    if (theCodec != 0)
+        codecBuf = new char [DataCodec::lengthSize
+            + DataCodec::getMaxFrameSize(dataSize)];
     
     return OF_ReturnType_completed;
 }
@@ -222,25 +283,15 @@ int ShadowExpSite::setTrialResponse(const Vector* disp,
     int rValue;
     if (theSetup != 0)  {
         // transform trial response
-        rValue = theSetup->transfTrialResponse(tDisp, tVel, tAccel, tForce, tTime);
+        rValue = theSetup->mapTrialResponse(tDisp, tVel, tAccel, tForce, tTime);
         if (rValue != OF_ReturnType_completed)  {
             opserr << "ShadowExpSite::setTrialResponse() - "
                 << "failed to set trial response at the setup.\n";
             exit(OF_ReturnType_failed);
         }
         
-        if (bDisp == 0)  {
-            if (getCtrlSize(OF_Resp_Disp) != 0)
-                bDisp = new Vector(getCtrlSize(OF_Resp_Disp));
-            if (getCtrlSize(OF_Resp_Vel) != 0)
-                bVel = new Vector(getCtrlSize(OF_Resp_Vel));
-            if (getCtrlSize(OF_Resp_Accel) != 0)
-                bAccel = new Vector(getCtrlSize(OF_Resp_Accel));
-            if (getCtrlSize(OF_Resp_Force) != 0)
-                bForce = new Vector(getCtrlSize(OF_Resp_Force));
-            if (getCtrlSize(OF_Resp_Time) != 0)
-                bTime = new Vector(getCtrlSize(OF_Resp_Time));
-        }
+        if (bDisp == 0)
+            this->newCtrlDaqVectors();
         
         // get trial response from the setup
         rValue = theSetup->getTrialResponse(bDisp, bVel, bAccel, bForce, bTime);
@@ -250,66 +301,38 @@ int ShadowExpSite::setTrialResponse(const Vector* disp,
             exit(OF_ReturnType_failed);
         }
         
-        int ndim = 1, size;
-        sendV.Zero();
-        size = getCtrlSize(OF_Resp_Disp);
-        if (size != 0)  {
-            sendV.Assemble(*bDisp, ndim);
-            ndim += size;
-        }
-        size = getCtrlSize(OF_Resp_Vel);
-        if (size != 0)  {
-            sendV.Assemble(*bVel, ndim);
-            ndim += size;
-        }
-        size = getCtrlSize(OF_Resp_Accel);
-        if (size != 0)  {
-            sendV.Assemble(*bAccel, ndim);
-            ndim += size;
-        }
-        size = getCtrlSize(OF_Resp_Force);
-        if (size != 0)  {
-            sendV.Assemble(*bForce, ndim);
-            ndim += size;
-        }
-        size = getCtrlSize(OF_Resp_Time);
-        if (size != 0)  {
-            sendV.Assemble(*bTime, ndim);
-        }
+        // send the trial response straight from the vectors
+        rValue = this->sendTrialResponse(bDisp, bVel, bAccel, bForce, bTime,
+            getCtrlSize(OF_Resp_Disp) + getCtrlSize(OF_Resp_Vel)
+            + getCtrlSize(OF_Resp_Accel) + getCtrlSize(OF_Resp_Force)
+            + getCtrlSize(OF_Resp_Time));
     } else  {
-        int ndim = 1, size;
-        sendV.Zero();
-        size = getTrialSize(OF_Resp_Disp);
-        if (size != 0)  {
-            sendV.Assemble(*tDisp, ndim);
-            ndim += size;
-        }
-        size = getTrialSize(OF_Resp_Vel);
-        if (size != 0)  {
-            sendV.Assemble(*tVel, ndim);
-            ndim += size;
-        }
-        size = getTrialSize(OF_Resp_Accel);
-        if (size != 0)  {
-            sendV.Assemble(*tAccel, ndim);
-            ndim += size;
-        }
-        size = getTrialSize(OF_Resp_Force);
-        if (size != 0)  {
-            sendV.Assemble(*tForce, ndim);
-            ndim += size;
-        }
-        size = getTrialSize(OF_Resp_Time);
-        if (size != 0)  {
-            sendV.Assemble(*tTime, ndim);
-        }
+        // send the trial response straight from the vectors
+        rValue = this->sendTrialResponse(tDisp, tVel, tAccel, tForce, tTime,
+            getTrialSize(OF_Resp_Disp) + getTrialSize(OF_Resp_Vel)
+            + getTrialSize(OF_Resp_Accel) + getTrialSize(OF_Resp_Force)
+            + getTrialSize(OF_Resp_Time));
+    }
+    if (rValue != 0)  {
+        opserr << "ShadowExpSite::setTrialResponse() - "
+            << "failed to send trial response.\n";
+        exit(OF_ReturnType_failed);
     }
     
-    // set trial response
+    return OF_ReturnType_completed;
+}
+
+
+int ShadowExpSite::sendTrialResponse(Vector *disp, Vector *vel,
+    Vector *accel, Vector *force, Vector *time, int numCtrl)
+{
+    // the message keeps its fixed size, the tail is padded with zeros
     sendV(0) = OF_RemoteTest_setTrialResponse;
-    this->sendVector(sendV);
+    Vector header(&sendV(0), 1);
+    Vector pad(&zeroV(0), dataSize-1-numCtrl);
+    const Vector *theVectors[7] = {&header, disp, vel, accel, force, time, &pad};
     
-    return OF_ReturnType_completed;
+    return this->sendv(theVectors, 7);
 }
 
 
@@ -319,46 +342,32 @@ int ShadowExpSite::checkDaqResponse()
         sendV(0) = OF_RemoteTest_getDaqResponse;
         this->sendVector(sendV);
         
-        if (rDisp == 0)  {
-            if (getDaqSize(OF_Resp_Disp) != 0)
-                rDisp = new Vector(getDaqSize(OF_Resp_Disp));
-            if (getDaqSize(OF_Resp_Vel) != 0)
-                rVel = new Vector(getDaqSize(OF_Resp_Vel));
-            if (getDaqSize(OF_Resp_Accel) != 0)
-                rAccel = new Vector(getDaqSize(OF_Resp_Accel));
-            if (getDaqSize(OF_Resp_Force) != 0)
-                rForce = new Vector(getDaqSize(OF_Resp_Force));
-            if (getDaqSize(OF_Resp_Time) != 0)
-                rTime = new Vector(getDaqSize(OF_Resp_Time));
-        }
-        this->recvVector(recvV);
+        if (rDisp == 0)
+            this->newCtrlDaqVectors();
         
-        int ndim = 0;
-        if (rDisp != 0)  {
-            rDisp->Extract(recvV, 0);
-            ndim += getDaqSize(OF_Resp_Disp);
-        }
-        if (rVel != 0)  {
-            rVel->Extract(recvV, ndim);
-            ndim += getDaqSize(OF_Resp_Vel);
-        }
-        if (rAccel != 0)  {
-            rAccel->Extract(recvV, ndim);
-            ndim += getDaqSize(OF_Resp_Accel);
-        }
-        if (rForce != 0)  {
-            rForce->Extract(recvV, ndim);
-            ndim += getDaqSize(OF_Resp_Force);
+        // receive the daq response straight into the vectors
+        int numDaq = getDaqSize(OF_Resp_Disp) + getDaqSize(OF_Resp_Vel)
+            + getDaqSize(OF_Resp_Accel) + getDaqSize(OF_Resp_Force)
+            + getDaqSize(OF_Resp_Time);
+        int rValue;
+        if (theCodec != 0)  {
+            rValue = this->recvCodedDaqResponse(numDaq);
+        } else  {
+            Vector pad(&recvV(0), dataSize-numDaq);
+            Vector *theVectors[6] = {rDisp, rVel, rAccel, rForce, rTime, &pad};
+            rValue = this->recvv(theVectors, 6);
         }
-        if (rTime != 0)  {
-            rTime->Extract(recvV, ndim);
+        if (rValue != 0)  {
+            opserr << "ShadowExpSite::checkDaqResponse() - "
+                << "failed to receive daq response.\n";
+            exit(OF_ReturnType_failed);
         }
         
         if (theSetup != 0)  {
             // set daq response at the setup
             theSetup->setDaqResponse(rDisp, rVel, rAccel, rForce, rTime);
             // transform daq response
-            theSetup->transfDaqResponse(oDisp, oVel, oAccel, oForce, oTime);
+            theSetup->mapDaqResponse(oDisp, oVel, oAccel, oForce, oTime);
         } else  {
             if (oDisp != 0) 
                 *oDisp = *rDisp;
@@ -409,6 +418,119 @@ int ShadowExpSite::commitState(Vector* time)
 }
 
 
+int ShadowExpSite::runTrajectory(const Matrix &trial, Matrix &out,
+    int &numDone, int chunkSize, const Vector *limits)
+{
+    int numPoints = trial.noRows();
+    int numTrial = 0, numOut = 0, numCtrl = 0, numDaq = 0;
+    for (int i=0; i<OF_Resp_All; i++)  {
+        numTrial += getTrialSize(i);
+        numOut += getOutSize(i);
+        numCtrl += getCtrlSize(i);
+        numDaq += getDaqSize(i);
+    }
+    
+    numDone = 0;
+    if (trial.noCols() != numTrial || out.noRows() != numPoints
+        || out.noCols() != numOut)  {
+        opserr << "ShadowExpSite::runTrajectory() - "
+            << "invalid size of trajectory.\n";
+        return OF_ReturnType_failed;
+    }
+    // the limits are checked by the ActorExpSite
+    // and therefore apply to the daq response
+    if (limits != 0 && limits->Size() != numDaq)  {
+        opserr << "ShadowExpSite::runTrajectory() - "
+            << "invalid number of limits, need one per daq channel.\n";
+        return OF_ReturnType_failed;
+    }
+    if (numPoints == 0)
+        return OF_ReturnType_completed;
+    
+    if (chunkSize <= 0)
+        chunkSize = 256;
+    if (chunkSize > numPoints)
+        chunkSize = numPoints;
+    int numChunks = (numPoints + chunkSize - 1)/chunkSize;
+    
+    this->newCtrlDaqVectors();
+    daqFlag = false;
+    
+    // announce the trajectory and send the limits
+    sendV(0) = OF_RemoteTest_trajectory;
+    this->sendVector(sendV);
+    // keep one chunk in flight so that the ActorExpSite never waits
+    // for the next points, unless the chunk is too large to be sent
+    // while the ActorExpSite streams back the daq responses
+    int numAhead = (chunkSize*numCtrl*(int)sizeof(double) <= maxChunkAhead) ? 1 : 0;
+    Vector info(4);
+    info(0) = numPoints;
+    info(1) = chunkSize;
+    info(2) = (limits != 0) ? numDaq : 0;
+    info(3) = numAhead;
+    this->sendVector(info);
+    if (limits != 0)
+        this->sendVector(*limits);
+    
+    Vector chunk(chunkSize*numCtrl);
+    Vector row(1+numDaq);
+    int c, k;
+    for (c=0; c<numChunks && c<=numAhead; c++)  {
+        int first = c*chunkSize;
+        int last = (first+chunkSize < numPoints) ? first+chunkSize : numPoints;
+        double *data = &chunk(0);
+        for (k=first; k<last; k++)
+            this->packTrialResponse(trial, k, &data[(k-first)*numCtrl]);
+        Vector chunkV(data, (last-first)*numCtrl);
+        this->sendVector(chunkV);
+    }
+    
+    // receive the streamed daq responses, a negative status
+    // tells that the point exceeded the limits
+    int rValue = OF_ReturnType_completed;
+    for (c=0; c<numChunks && rValue == OF_ReturnType_completed; c++)  {
+        int first = c*chunkSize;
+        int last = (first+chunkSize < numPoints) ? first+chunkSize : numPoints;
+        for (k=first; k<last && rValue == OF_ReturnType_completed; k++)  {
+            if (this->recvVector(row) != 0)  {
+                opserr << "ShadowExpSite::runTrajectory() - "
+                    << "failed to receive daq response.\n";
+                exit(OF_ReturnType_failed);
+            }
+            this->unpackDaqResponse(&row(1), out, k);
+            if (row(0) < 0.0)  {
+                rValue = OF_ReturnType_failed;
+            } else  {
+                this->setTrialRow(trial, k);
+                this->ExperimentalSite::commitState();
+                numDone++;
+            }
+        }
+        
+        // send the next chunk that is not yet in flight
+        if (rValue == OF_ReturnType_completed && c+1+numAhead < numChunks)  {
+            first = (c+1+numAhead)*chunkSize;
+            last = (first+chunkSize < numPoints) ? first+chunkSize : numPoints;
+            double *data = &chunk(0);
+            for (k=first; k<last; k++)
+                this->packTrialResponse(trial, k, &data[(k-first)*numCtrl]);
+            Vector chunkV(data, (last-first)*numCtrl);
+            this->sendVector(chunkV);
+        }
+    }
+    if (rValue != OF_ReturnType_completed)  {
+        opserr << "WARNING ShadowExpSite::runTrajectory() - "
+            << "daq response exceeded the limits at point "
+            << numDone+1 << ", trajectory aborted.\n";
+    }
+    
+    // the site holds the last executed point
+    daqFlag = true;
+    
+    return rValue;
+}
+
+
 ExperimentalSite* ShadowExpSite::getCopy()
 {
     ShadowExpSite *theCopy = new ShadowExpSite(*this);
@@ -417,6 +539,162 @@ ExperimentalSite* ShadowExpSite::getCopy()
 }
 
 
+int ShadowExpSite::setCompression(const Vector &resolution)
+{
+    if (theCodec != 0)
+        delete theCodec;
+    if (codecRes != 0)
+        delete codecRes;
+    
+    // the decoder gets the resolutions with the key frames,
+    // the ActorExpSite gets them during the setup
+    theCodec = new DataCodec();
+    codecRes = new Vector(resolution);
+    
+    return OF_ReturnType_completed;
+}
+
+
+int ShadowExpSite::recvCodedDaqResponse(int numDaq)
+{
+    // receive the length first and then the frame itself
+    Message msgLength(codecBuf, DataCodec::lengthSize);
+    if (this->recvMessage(msgLength) != 0)
+        return -1;
+    int numBytes = DataCodec::getFrameLength(codecBuf);
+    if (numBytes < 1 || numBytes > DataCodec::getMaxFrameSize(dataSize))  {
+        opserr << "ShadowExpSite::recvCodedDaqResponse() - "
+            << "invalid frame length " << numBytes << endln;
+        return -1;
+    }
+    Message msgFrame(codecBuf, numBytes);
+    if (this->recvMessage(msgFrame) != 0)
+        return -1;
+    
+    if (codecV == 0)
+        codecV = new Vector(numDaq);
+    if (theCodec->decode(codecBuf, numBytes, *codecV) != numBytes ||
+        codecV->Size() != numDaq)  {
+        opserr << "ShadowExpSite::recvCodedDaqResponse() - "
+            << "invalid frame received\n";
+        return -1;
+    }
+    
+    // distribute the decoded channels to the vectors
+    int ndim = 0;
+    Vector *theVectors[5] = {rDisp, rVel, rAccel, rForce, rTime};
+    for (int i=0; i<5; i++)  {
+        if (theVectors[i] != 0)  {
+            theVectors[i]->Extract(*codecV, ndim);
+            ndim += theVectors[i]->Size();
+        }
+    }
+    
+    return 0;
+}
+
+
+void ShadowExpSite::newCtrlDaqVectors()
+{
+    if (bDisp == 0 && getCtrlSize(OF_Resp_Disp) != 0)
+        bDisp = new Vector(getCtrlSize(OF_Resp_Disp));
+    if (bVel == 0 && getCtrlSize(OF_Resp_Vel) != 0)
+        bVel = new Vector(getCtrlSize(OF_Resp_Vel));
+    if (bAccel == 0 && getCtrlSize(OF_Resp_Accel) != 0)
+        bAccel = new Vector(getCtrlSize(OF_Resp_Accel));
+    if (bForce == 0 && getCtrlSize(OF_Resp_Force) != 0)
+        bForce = new Vector(getCtrlSize(OF_Resp_Force));
+    if (bTime == 0 && getCtrlSize(OF_Resp_Time) != 0)
+        bTime = new Vector(getCtrlSize(OF_Resp_Time));
+    
+    if (rDisp == 0 && getDaqSize(OF_Resp_Disp) != 0)
+        rDisp = new Vector(getDaqSize(OF_Resp_Disp));
+    if (rVel == 0 && getDaqSize(OF_Resp_Vel) != 0)
+        rVel = new Vector(getDaqSize(OF_Resp_Vel));
+    if (rAccel == 0 && getDaqSize(OF_Resp_Accel) != 0)
+        rAccel = new Vector(getDaqSize(OF_Resp_Accel));
+    if (rForce == 0 && getDaqSize(OF_Resp_Force) != 0)
+        rForce = new Vector(getDaqSize(OF_Resp_Force));
+    if (rTime == 0 && getDaqSize(OF_Resp_Time) != 0)
+        rTime = new Vector(getDaqSize(OF_Resp_Time));
+}
+
+
+void ShadowExpSite::setTrialRow(const Matrix &trial, int row)
+{
+    Vector *theVectors[5] = {tDisp, tVel, tAccel, tForce, tTime};
+    for (int i=0, j=0; i<5; i++)  {
+        if (theVectors[i] != 0)  {
+            for (int k=0; k<theVectors[i]->Size(); k++, j++)
+                (*theVectors[i])(k) = trial(row,j);
+        }
+    }
+}
+
+
+void ShadowExpSite::packTrialResponse(const Matrix &trial, int row,
+    double *data)
+{
+    this->setTrialRow(trial, row);
+    
+    Vector **theVectors;
+    Vector *trialVectors[5] = {tDisp, tVel, tAccel, tForce, tTime};
+    Vector *ctrlVectors[5] = {bDisp, bVel, bAccel, bForce, bTime};
+    if (theSetup != 0)  {
+        theSetup->mapTrialResponse(tDisp, tVel, tAccel, tForce, tTime);
+        theSetup->getTrialResponse(bDisp, bVel, bAccel, bForce, bTime);
+        theVectors = ctrlVectors;
+    } else  {
+        theVectors = trialVectors;
+    }
+    
+    for (int i=0, j=0; i<5; i++)  {
+        if (theVectors[i] != 0)  {
+            for (int k=0; k<theVectors[i]->Size(); k++, j++)
+                data[j] = (*theVectors[i])(k);
+        }
+    }
+}
+
+
+void ShadowExpSite::unpackDaqResponse(const double *data,
+    Matrix &out, int row)
+{
+    Vector *daqVectors[5] = {rDisp, rVel, rAccel, rForce, rTime};
+    int i, j, k;
+    for (i=0, j=0; i<5; i++)  {
+        if (daqVectors[i] != 0)  {
+            for (k=0; k<daqVectors[i]->Size(); k++, j++)
+                (*daqVectors[i])(k) = data[j];
+        }
+    }
+    
+    if (theSetup != 0)  {
+        theSetup->setDaqResponse(rDisp, rVel, rAccel, rForce, rTime);
+        theSetup->mapDaqResponse(oDisp, oVel, oAccel, oForce, oTime);
+    } else  {
+        if (oDisp != 0) 
+            *oDisp = *rDisp;
+        if (oVel != 0) 
+            *oVel = *rVel;
+        if (oAccel != 0) 
+            *oAccel = *rAccel;
+        if (oForce != 0) 
+            *oForce = *rForce;
+        if (oTime != 0) 
+            *oTime = *rTime;
+    }
+    
+    Vector *outVectors[5] = {oDisp, oVel, oAccel, oForce, oTime};
+    for (i=0, j=0; i<5; i++)  {
+        if (outVectors[i] != 0)  {
+            for (k=0; k<outVectors[i]->Size(); k++, j++)
+                out(row,j) = (*outVectors[i])(k);
+        }
+    }
+}
+
+
 void ShadowExpSite::Print(OPS_Stream &s, int flag)
 {
     s << "ExperimentalSite: " << this->getTag(); 
@@ -425,4 +703,6 @@ void ShadowExpSite::Print(OPS_Stream &s, int flag)
         s << "\tExperimentalSetup tag: " << theSetup->getTag() << endln;
         s << *theSetup;
     }
+    if (theCodec != 0)
+        theCodec->Print(s);
 }
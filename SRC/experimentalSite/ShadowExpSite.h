@@ -36,11 +36,25 @@
 // Description: This file contains the class definition for 
 // ShadowExpSite. A ShadowExpSite can communicate to an ActorExpSite.
 // This object inherits from Shadow, and runs on the client program.
+// With setCompression() the ActorExpSite is asked during the setup to
+// send the daq response as DataCodec frames, which keeps slow links
+// between the sites from limiting the rate of the test.
+// runTrajectory() uploads the trial responses in chunks to the
+// ActorExpSite, which executes them without waiting for the
+// ShadowExpSite and streams the daq response of each point back. Small
+// chunks are sent one ahead of the daq responses being read, larger
+// ones only after the daq responses of the previous chunk arrived,
+// since they might not fit into the socket buffers. The ActorExpSite
+// checks the limits before the setup transforms the daq response, so
+// unlike on the other sites they apply to the daq and not the output
+// response, one limit per daq channel.
 
 #include "ExperimentalSite.h"
 
 #include <Shadow.h>
 
+class DataCodec;
+
 class ShadowExpSite : public ExperimentalSite, public Shadow
 {
 public:
@@ -76,8 +90,15 @@ public:
     
     virtual int commitState(Vector *time = 0);
     
+    virtual int runTrajectory(const Matrix &trial, Matrix &out,
+        int &numDone, int chunkSize = 0, const Vector *limits = 0);
+    
     virtual ExperimentalSite *getCopy();
     
+    // method to request compressed daq responses, channels with
+    // a resolution of zero (or no resolutions) are lossless
+    int setCompression(const Vector &resolution);
+    
     // public methods for output
     void Print(OPS_Stream &s, int flag = 0);
     
@@ -88,9 +109,25 @@ protected:
     // vectors in Channel
     Vector sendV;
     Vector recvV;
+    Vector zeroV;  // padding of messages sent with sendv
     
     Vector *bDisp, *bVel, *bAccel, *bForce, *bTime;
     Vector *rDisp, *rVel, *rAccel, *rForce, *rTime;
+    
+    // decompression of the daq response
+    DataCodec *theCodec;
+    Vector *codecRes;
+    Vector *codecV;
+    char *codecBuf;
+    
+private:
+    void newCtrlDaqVectors();
+    void setTrialRow(const Matrix &trial, int row);
+    void packTrialResponse(const Matrix &trial, int row, double *data);
+    void unpackDaqResponse(const double *data, Matrix &out, int row);
+    int sendTrialResponse(Vector *disp, Vector *vel, Vector *accel,
+        Vector *force, Vector *time, int numCtrl);
+    int recvCodedDaqResponse(int numDaq);
 };
 
 #endif
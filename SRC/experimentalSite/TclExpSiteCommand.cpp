@@ -31,12 +31,19 @@
 // invokes the expSite command in the interpreter. 
 
 #include <string.h>
+#include <stdio.h>
 #include <tcl.h>
 #include <ArrayOfTaggedObjects.h>
 #include <Vector.h>
+#include <Matrix.h>
 #include <TCP_Socket.h>
 #include <TCP_SocketSSL.h>
 #include <UDP_Socket.h>
+#include <SHM_Channel.h>
+#include <ImpairedChannel.h>
+#include <ChannelOptions.h>
+#include <Domain.h>
+#include <ExpCheckpointRecorder.h>
 
 #include <LocalExpSite.h>
 #include <ShadowExpSite.h>
@@ -142,14 +149,16 @@ int TclExpSiteCommand(ClientData clientData, Tcl_Interp *interp,
     
     // ----------------------------------------------------------------------------	
     if (strcmp(argv[1],"LocalSite") == 0)  {
-        if (argc != 4)  {
+        if (argc < 4)  {
             opserr << "WARNING invalid number of arguments\n";
             printCommand(argc,argv);
-            opserr << "Want: expSite LocalSite tag setupTag\n";
+            opserr << "Want: expSite LocalSite tag setupTag <-subSteps numSubSteps> <-order order> <-average>\n";
             return TCL_ERROR;
         }
         
-        int tag, setupTag;
+        int tag, setupTag, argi;
+        int numSubSteps = 1, order = 1;
+        bool average = false;
         ExperimentalSite *theSite = 0;
         
         if (Tcl_GetInt(interp, argv[2], &tag) != TCL_OK)  {
@@ -168,9 +177,39 @@ int TclExpSiteCommand(ClientData clientData, Tcl_Interp *interp,
             opserr << "expSite LocalSite " << tag << endln;
             return TCL_ERROR;
         }
+        argi = 4;
+        while (argi < argc)  {
+            if (strcmp(argv[argi],"-subSteps") == 0)  {
+                argi++;
+                if (argi == argc || Tcl_GetInt(interp, argv[argi], &numSubSteps) != TCL_OK ||
+                    numSubSteps < 1)  {
+                    opserr << "WARNING invalid numSubSteps\n";
+                    opserr << "expSite LocalSite " << tag << endln;
+                    return TCL_ERROR;
+                }
+            }
+            else if (strcmp(argv[argi],"-order") == 0)  {
+                argi++;
+                if (argi == argc || Tcl_GetInt(interp, argv[argi], &order) != TCL_OK ||
+                    order < 1 || order > 3)  {
+                    opserr << "WARNING invalid order, want: 1, 2 or 3\n";
+                    opserr << "expSite LocalSite " << tag << endln;
+                    return TCL_ERROR;
+                }
+            }
+            else if (strcmp(argv[argi],"-average") == 0)  {
+                average = true;
+            }
+            else  {
+                opserr << "WARNING unknown option " << argv[argi] << endln;
+                opserr << "expSite LocalSite " << tag << endln;
+                return TCL_ERROR;
+            }
+            argi++;
+        }
         
         // parsing was successful, allocate the site
-        theSite = new LocalExpSite(tag, theSetup);
+        theSite = new LocalExpSite(tag, theSetup, numSubSteps, order, average);
         
         if (theSite == 0)  {
             opserr << "WARNING could not create experimental site " << argv[1] << endln;
@@ -189,15 +228,19 @@ int TclExpSiteCommand(ClientData clientData, Tcl_Interp *interp,
         if (5 > argc && argc > 9)  {
             opserr << "WARNING invalid number of arguments\n";
             printCommand(argc,argv);
-            opserr << "Want: expSite ShadowSite tag <-setup setupTag> ipAddr ipPort <-udp> <-ssl> <-dataSize size>\n";
+            opserr << "Want: expSite ShadowSite tag <-setup setupTag> ipAddr ipPort <-udp> <-ssl> <-shm> <-dataSize size> <-compress> <-quantize res1 res2 ...> <channelOptions>\n";
             return TCL_ERROR;
         }
         
         int tag, setupTag, ipPort, argi;
         char *ipAddr;
-        int ssl = 0, udp = 0;
+        int ssl = 0, udp = 0, shm = 0;
         int noDelay = 0;
         int dataSize = OF_Network_dataSize;
+        int compress = 0;
+        Vector resolution(0);
+        int numArgs;
+        ChannelOptions theOptions;
         ExperimentalSetup *theSetup = 0;
         Channel *theChannel = 0;
         ShadowExpSite *theSite = 0;
@@ -242,6 +285,9 @@ int TclExpSiteCommand(ClientData clientData, Tcl_Interp *interp,
             else if (strcmp(argv[i], "-udp") == 0 && ssl == 0)  {
                 udp = 1;
             }
+            else if (strcmp(argv[i], "-shm") == 0)  {
+                shm = 1;
+            }
             else if (strcmp(argv[i], "-noDelay") == 0)  {
                 noDelay = 1;
             }
@@ -252,10 +298,62 @@ int TclExpSiteCommand(ClientData clientData, Tcl_Interp *interp,
                     return TCL_ERROR;
                 }
             }
+            else if (strcmp(argv[i], "-compress") == 0)  {
+                compress = 1;
+            }
+            else if (strcmp(argv[i], "-quantize") == 0)  {
+                // read in a list of resolutions until the next flag
+                double res;
+                int numRes = 0;
+                compress = 1;
+                while (i+1+numRes < argc &&
+                    Tcl_GetDouble(interp, argv[i+1+numRes], &res) == TCL_OK)
+                    numRes++;
+                Tcl_ResetResult(interp);
+                if (numRes == 0)  {
+                    opserr << "WARNING no ShadowSite resolutions specified\n";
+                    opserr << "expSite ShadowSite " << tag << endln;
+                    return TCL_ERROR;
+                }
+                resolution.resize(numRes);
+                for (int j=0; j<numRes; j++)  {
+                    Tcl_GetDouble(interp, argv[++i], &resolution(j));
+                    if (resolution(j) < 0.0)  {
+                        opserr << "WARNING invalid ShadowSite resolution\n";
+                        opserr << "expSite ShadowSite " << tag << endln;
+                        return TCL_ERROR;
+                    }
+                }
+            }
+            else if ((numArgs = theOptions.parse(argc-i, &argv[i])) != 0)  {
+                if (numArgs < 0)  {
+                    opserr << "WARNING invalid ShadowSite channel option\n";
+                    opserr << "expSite ShadowSite " << tag << endln;
+                    return TCL_ERROR;
+                }
+                i += numArgs-1;
+            }
+        }
+        
+        // the frames of a compressed daq response are received in
+        // two parts, which is not possible with datagrams
+        if (compress && udp)  {
+            opserr << "WARNING ShadowSite -compress and -quantize "
+                << "are not supported with -udp\n";
+            opserr << "expSite ShadowSite " << tag << endln;
+            return TCL_ERROR;
         }
         
         // setup the connection
-        if (ssl)  {
+        if (shm)  {
+            theChannel = new SHM_Channel(ipPort,ipAddr);
+            if (!theChannel)  {
+                opserr << "WARNING could not create shared memory channel\n";
+                opserr << "expSite ShadowSite " << tag << endln;
+                return TCL_ERROR;
+            }
+        }
+        else if (ssl)  {
             theChannel = new TCP_SocketSSL(ipPort,ipAddr,true,noDelay);
             if (!theChannel)  {
                 opserr << "WARNING could not create SSL channel\n";
@@ -280,6 +378,9 @@ int TclExpSiteCommand(ClientData clientData, Tcl_Interp *interp,
             }
         }
         
+        theChannel->setChannelOptions(theOptions);
+        theChannel = ImpairedChannel::wrap(theChannel, theOptions);
+        
         // parsing was successful, allocate the site
         if (theSetup == 0)
             theSite = new ShadowExpSite(tag, *theChannel, dataSize);
@@ -290,6 +391,8 @@ int TclExpSiteCommand(ClientData clientData, Tcl_Interp *interp,
             opserr << "WARNING could not create experimental site " << argv[1] << endln;
             return TCL_ERROR;
         }
+        if (compress)
+            theSite->setCompression(resolution);
         
         // now add the site to the modelBuilder
         if (addExperimentalSite(*theSite) < 0)  {
@@ -304,17 +407,19 @@ int TclExpSiteCommand(ClientData clientData, Tcl_Interp *interp,
     
     // ----------------------------------------------------------------------------	
     else if (strcmp(argv[1],"ActorSite") == 0)  {
-        if (6 > argc || argc > 8)  {
+        if (6 > argc)  {
             opserr << "WARNING invalid number of arguments\n";
             printCommand(argc,argv);
-            opserr << "Want: expSite ActorSite tag -setup setupTag ipPort <-udp> <-ssl>\n"
-                << "  or: expSite ActorSite tag -control ctrlTag ipPort <-udp> <-ssl>\n";
+            opserr << "Want: expSite ActorSite tag -setup setupTag ipPort <-udp> <-ssl> <-shm> <channelOptions>\n"
+                << "  or: expSite ActorSite tag -control ctrlTag ipPort <-udp> <-ssl> <-shm> <channelOptions>\n";
             return TCL_ERROR;
         }
         
         int tag, setupTag, ctrlTag, ipPort, argi;
-        int ssl = 0, udp = 0;
+        int ssl = 0, udp = 0, shm = 0;
         int noDelay = 0;
+        int numArgs;
+        ChannelOptions theOptions;
         ExperimentalSetup *theSetup = 0;
         ExperimentalControl *theControl = 0;
         Channel *theChannel = 0;
@@ -371,13 +476,35 @@ int TclExpSiteCommand(ClientData clientData, Tcl_Interp *interp,
             else if (strcmp(argv[i], "-udp") == 0 && ssl == 0)  {
                 udp = 1;
             }
+            else if (strcmp(argv[i], "-shm") == 0)  {
+                shm = 1;
+            }
             else if (strcmp(argv[i], "-noDelay") == 0)  {
                 noDelay = 1;
             }
+            else if ((numArgs = theOptions.parse(argc-i, &argv[i])) != 0)  {
+                if (numArgs < 0)  {
+                    opserr << "WARNING invalid ActorSite channel option\n";
+                    opserr << "expSite ActorSite " << tag << endln;
+                    return TCL_ERROR;
+                }
+                i += numArgs-1;
+            }
         }
         
         // parsing was successful, setup the connection and allocate the site
-        if (ssl)  {
+        if (shm)  {
+            theChannel = new SHM_Channel(ipPort);
+            if (theChannel != 0) {
+                opserr << "\nShared Memory Channel successfully created: "
+                    << "Waiting for ShadowExpSite...\n";
+            } else {
+                opserr << "WARNING could not create shared memory channel\n";
+                opserr << "expSite ActorSite " << tag << endln;
+                return TCL_ERROR;
+            }
+        }
+        else if (ssl)  {
             theChannel = new TCP_SocketSSL(ipPort,true,noDelay);
             if (theChannel != 0) {
                 opserr << "\nSSL Channel successfully created: "
@@ -411,6 +538,9 @@ int TclExpSiteCommand(ClientData clientData, Tcl_Interp *interp,
             }
         }
         
+        theChannel->setChannelOptions(theOptions);
+        theChannel = ImpairedChannel::wrap(theChannel, theOptions);
+        
         // parsing was successful, allocate the site
         if (theControl == 0)
             theSite = new ActorExpSite(tag, theSetup, *theChannel);
@@ -441,6 +571,246 @@ int TclExpSiteCommand(ClientData clientData, Tcl_Interp *interp,
 }
 
 
+int TclExpCheckpointCommand(ClientData clientData, Tcl_Interp *interp,
+    int argc, TCL_Char **argv, Domain *theDomain)
+{
+    // make sure there is a minimum number of arguments
+    if (argc < 3)  {
+        opserr << "WARNING insufficient number of checkpoint arguments\n";
+        printCommand(argc, argv);
+        opserr << "Want: expCheckpoint save fileName\n"
+            << "  or: expCheckpoint restore fileName\n"
+            << "  or: expCheckpoint every numSteps fileName\n";
+        return TCL_ERROR;
+    }
+    if (theDomain == 0)  {
+        opserr << "WARNING expCheckpoint - no domain has been defined\n";
+        return TCL_ERROR;
+    }
+    
+    // collect the sites in the order in which they were defined
+    int numSites = 0;
+    if (theExperimentalSites != 0)
+        numSites = theExperimentalSites->getNumComponents();
+    ExperimentalSite **theSites = new ExperimentalSite* [numSites > 0 ? numSites : 1];
+    TaggedObject *mc;
+    if (numSites > 0)  {
+        TaggedObjectIter &mcIter = theExperimentalSites->getComponents();
+        for (int i=0; i<numSites && (mc = mcIter()) != 0; i++)
+            theSites[i] = (ExperimentalSite *)mc;
+    }
+    
+    int rValue = TCL_OK;
+    if (strcmp(argv[1], "save") == 0)  {
+        if (ExpCheckpointRecorder::saveModel(argv[2], *theDomain,
+            numSites, theSites, theDomain->getCommitTag()) < 0)  {
+            opserr << "WARNING could not save checkpoint " << argv[2] << endln;
+            rValue = TCL_ERROR;
+        }
+    }
+    else if (strcmp(argv[1], "restore") == 0)  {
+        // has to be called after the model has been defined and
+        // before the analysis is created so that the integrator
+        // starts from the restored response of the nodes
+        if (ExpCheckpointRecorder::restoreModel(argv[2], *theDomain,
+            numSites, theSites) < 0)  {
+            opserr << "WARNING could not restore checkpoint " << argv[2] << endln;
+            rValue = TCL_ERROR;
+        }
+    }
+    else if (strcmp(argv[1], "every") == 0)  {
+        int numSteps;
+        if (argc < 4)  {
+            opserr << "WARNING insufficient number of checkpoint arguments\n";
+            printCommand(argc, argv);
+            opserr << "Want: expCheckpoint every numSteps fileName\n";
+            rValue = TCL_ERROR;
+        }
+        else if (Tcl_GetInt(interp, argv[2], &numSteps) != TCL_OK || numSteps < 1)  {
+            opserr << "WARNING invalid numSteps\n";
+            opserr << "expCheckpoint every: " << argv[2] << endln;
+            rValue = TCL_ERROR;
+        }
+        else  {
+            // the recorder takes ownership of the site array
+            Recorder *theRecorder = new ExpCheckpointRecorder(argv[3],
+                numSteps, numSites, theSites, *theDomain);
+            if (theRecorder == 0 || theDomain->addRecorder(*theRecorder) < 0)  {
+                opserr << "WARNING could not add checkpoint recorder\n";
+                if (theRecorder != 0)
+                    delete theRecorder;
+                return TCL_ERROR;
+            }
+            return TCL_OK;
+        }
+    }
+    else  {
+        opserr << "WARNING unknown expCheckpoint option: "
+            << argv[1] << ": check the manual\n";
+        rValue = TCL_ERROR;
+    }
+    
+    delete [] theSites;
+    
+    return rValue;
+}
+
+
+int TclExpTrajectoryCommand(ClientData clientData, Tcl_Interp *interp,
+    int argc, TCL_Char **argv)
+{
+    // make sure there is a minimum number of arguments
+    if (argc < 4)  {
+        opserr << "WARNING insufficient number of trajectory arguments\n";
+        printCommand(argc, argv);
+        opserr << "Want: expTrajectory siteTag inFile outFile <-dof ndf> "
+            << "<-chunk numPoints> <-limits lim1 lim2 ...>\n";
+        return TCL_ERROR;
+    }
+    
+    int siteTag, ndf = 0, chunkSize = 0;
+    Vector *limits = 0;
+    
+    if (Tcl_GetInt(interp, argv[1], &siteTag) != TCL_OK)  {
+        opserr << "WARNING invalid expTrajectory siteTag\n";
+        return TCL_ERROR;
+    }
+    ExperimentalSite *theSite = getExperimentalSite(siteTag);
+    if (theSite == 0)  {
+        opserr << "WARNING experimental site not found\n";
+        opserr << "expTrajectory: " << siteTag << endln;
+        return TCL_ERROR;
+    }
+    for (int i=4; i<argc; i++)  {
+        if (strcmp(argv[i], "-dof") == 0 && i+1 < argc)  {
+            if (Tcl_GetInt(interp, argv[++i], &ndf) != TCL_OK || ndf < 1)  {
+                opserr << "WARNING invalid expTrajectory ndf\n";
+                return TCL_ERROR;
+            }
+        }
+        else if (strcmp(argv[i], "-chunk") == 0 && i+1 < argc)  {
+            if (Tcl_GetInt(interp, argv[++i], &chunkSize) != TCL_OK || chunkSize < 1)  {
+                opserr << "WARNING invalid expTrajectory chunk\n";
+                return TCL_ERROR;
+            }
+        }
+        else if (strcmp(argv[i], "-limits") == 0)  {
+            // read in a list of limits until the next flag
+            double lim;
+            int numLim = 0;
+            while (i+1+numLim < argc &&
+                Tcl_GetDouble(interp, argv[i+1+numLim], &lim) == TCL_OK)
+                numLim++;
+            Tcl_ResetResult(interp);
+            if (numLim == 0)  {
+                opserr << "WARNING no expTrajectory limits specified\n";
+                return TCL_ERROR;
+            }
+            if (limits != 0)
+                delete limits;
+            limits = new Vector(numLim);
+            for (int j=0; j<numLim; j++)
+                Tcl_GetDouble(interp, argv[++i], &(*limits)(j));
+        }
+        else  {
+            opserr << "WARNING unknown expTrajectory option: "
+                << argv[i] << endln;
+            if (limits != 0)
+                delete limits;
+            return TCL_ERROR;
+        }
+    }
+    
+    // the usual quasi-static test commands displacements
+    // and acquires displacements and forces
+    if (ndf > 0)  {
+        ID sizeT(OF_Resp_All), sizeO(OF_Resp_All);
+        sizeT(OF_Resp_Disp) = ndf;
+        sizeO(OF_Resp_Disp) = ndf;
+        sizeO(OF_Resp_Force) = ndf;
+        theSite->setSize(sizeT, sizeO);
+    }
+    int numTrial = 0, numOut = 0;
+    for (int i=0; i<OF_Resp_All; i++)  {
+        numTrial += theSite->getTrialSize(i);
+        numOut += theSite->getOutSize(i);
+    }
+    if (numTrial == 0)  {
+        opserr << "WARNING expTrajectory - size of experimental site "
+            << siteTag << " not set, use -dof\n";
+        if (limits != 0)
+            delete limits;
+        return TCL_ERROR;
+    }
+    
+    // read the trial responses, one point per line
+    FILE *inFile = fopen(argv[2], "r");
+    if (inFile == 0)  {
+        opserr << "WARNING expTrajectory - could not open file "
+            << argv[2] << endln;
+        if (limits != 0)
+            delete limits;
+        return TCL_ERROR;
+    }
+    double value;
+    int numValues = 0;
+    while (fscanf(inFile, "%lf", &value) == 1)
+        numValues++;
+    if (numValues % numTrial != 0)  {
+        opserr << "WARNING expTrajectory - number of values in file "
+            << argv[2] << " is not a multiple of " << numTrial << endln;
+        fclose(inFile);
+        if (limits != 0)
+            delete limits;
+        return TCL_ERROR;
+    }
+    int numPoints = numValues/numTrial;
+    Matrix trial(numPoints, numTrial);
+    rewind(inFile);
+    for (int k=0; k<numPoints; k++)
+        for (int j=0; j<numTrial; j++)
+            fscanf(inFile, "%lf", &trial(k,j));
+    fclose(inFile);
+    
+    // run the trajectory
+    Matrix out(numPoints, numOut);
+    int numDone = 0;
+    int rValue = theSite->runTrajectory(trial, out, numDone, chunkSize, limits);
+    if (limits != 0)
+        delete limits;
+    if (rValue < 0)  {
+        opserr << "WARNING expTrajectory - trajectory of experimental site "
+            << siteTag << " failed after " << numDone << " points\n";
+    }
+    
+    // write the daq responses of the committed points
+    // (also when the trajectory was aborted)
+    FILE *outFile = fopen(argv[3], "w");
+    if (outFile == 0)  {
+        opserr << "WARNING expTrajectory - could not open file "
+            << argv[3] << endln;
+        return TCL_ERROR;
+    }
+    for (int k=0; k<numDone; k++)  {
+        for (int j=0; j<numOut; j++)
+            fprintf(outFile, j == 0 ? "%.10e" : " %.10e", out(k,j));
+        fprintf(outFile, "\n");
+    }
+    fclose(outFile);
+    
+    // return the number of committed points, which is less
+    // than the number of points if the trajectory was aborted
+    char buffer[40];
+    sprintf(buffer, "%d", numDone);
+    Tcl_SetResult(interp, buffer, TCL_VOLATILE);
+    
+    if (rValue < 0)
+        return TCL_ERROR;
+    
+    return TCL_OK;
+}
+
+
 int TclRemoveExpSite(ClientData clientData, Tcl_Interp *interp,
     int argc, TCL_Char **argv)
 {
@@ -35,6 +35,8 @@
 
 #include "ETTranspose.h"
 
+#include <ExpCheckpoint.h>
+
 
 ETTranspose::ETTranspose(int tag , int nC)
     : ExperimentalTangentStiff(tag), numCol(nC),
@@ -143,6 +145,38 @@ ExperimentalTangentStiff* ETTranspose::getCopy()
 }
 
 
+int ETTranspose::saveState(ExpCheckpoint &theCheckpoint)
+{
+    // the history grows up to numCol columns, so the dimensions
+    // are written ahead of the matrices
+    theCheckpoint.save(iDMatrix.noRows());
+    theCheckpoint.save(iDMatrix.noCols());
+    theCheckpoint.save(&iDMatrix);
+    
+    return theCheckpoint.save(&iFMatrix);
+}
+
+
+int ETTranspose::restoreState(ExpCheckpoint &theCheckpoint)
+{
+    int numRows = 0, numCols = 0;
+    theCheckpoint.restore(numRows);
+    if (theCheckpoint.restore(numCols) < 0 ||
+        numRows < 0 || numCols < 0 || numCols > numCol)  {
+        opserr << "ETTranspose::restoreState() - "
+            << "invalid history size in checkpoint\n";
+        return -1;
+    }
+    if (iDMatrix.noRows() != numRows || iDMatrix.noCols() != numCols)  {
+        iDMatrix = Matrix(numRows, numCols);
+        iFMatrix = Matrix(numRows, numCols);
+    }
+    theCheckpoint.restore(&iDMatrix);
+    
+    return theCheckpoint.restore(&iFMatrix);
+}
+
+
 void ETTranspose::Print(OPS_Stream &s, int flag)
 {
     s << "Experimental Tangent: " << this->getTag(); 
@@ -32,6 +32,8 @@
 
 #include "ExperimentalTangentStiff.h"
 
+#include <ExpCheckpoint.h>
+
 
 ExperimentalTangentStiff::ExperimentalTangentStiff(int tag)
     : TaggedObject(tag)
@@ -81,3 +83,16 @@ int ExperimentalTangentStiff::getResponse(int responseID,
     // each subclass must implement its own response
     return OF_ReturnType_failed;
 }
+
+
+int ExperimentalTangentStiff::saveState(ExpCheckpoint &theCheckpoint)
+{
+    // objects without a history have no state to save
+    return 0;
+}
+
+
+int ExperimentalTangentStiff::restoreState(ExpCheckpoint &theCheckpoint)
+{
+    return 0;
+}
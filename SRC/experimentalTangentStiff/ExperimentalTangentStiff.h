@@ -42,6 +42,7 @@
 #include <Matrix.h>
 
 class Response;
+class ExpCheckpoint;
 
 class ExperimentalTangentStiff : public TaggedObject
 {
@@ -71,6 +72,10 @@ public:
     virtual Response *setResponse(const char **argv, int argc,
         OPS_Stream &output);
     virtual int getResponse(int responseID, Information &info);
+    
+    // public methods to save and restore the state for a checkpoint
+    virtual int saveState(ExpCheckpoint &theCheckpoint);
+    virtual int restoreState(ExpCheckpoint &theCheckpoint);
 };
 
 #endif
@@ -31,6 +31,7 @@
 #include <Channel.h>
 #include <Message.h>
 #include <Matrix.h>
+#include <DataCodec.h>
 
 using std::cerr;
 using std::ios;
@@ -43,7 +44,8 @@ BinaryFileStream::BinaryFileStream()
   :OPS_Stream(OPS_STREAM_TAGS_BinaryFileStream), 
    fileOpen(0), fileName(0), sendSelfCount(0),
    theChannels(0), numDataRows(0),
-   mapping(0), maxCount(0), sizeColumns(0), theColumns(0), theData(0), theRemoteData(0)
+   mapping(0), maxCount(0), sizeColumns(0), theColumns(0), theData(0), theRemoteData(0),
+   theCodec(0), codecBuf(0), codecBufSize(0)
 {
 
 }
@@ -52,7 +54,8 @@ BinaryFileStream::BinaryFileStream(const char *file, openMode mode)
   :OPS_Stream(OPS_STREAM_TAGS_BinaryFileStream), 
    fileOpen(0), fileName(0), sendSelfCount(0),
    theChannels(0), numDataRows(0),
-   mapping(0), maxCount(0), sizeColumns(0), theColumns(0), theData(0), theRemoteData(0)
+   mapping(0), maxCount(0), sizeColumns(0), theColumns(0), theData(0), theRemoteData(0),
+   theCodec(0), codecBuf(0), codecBufSize(0)
 {
   this->setFile(file, mode);
 }
@@ -76,6 +79,11 @@ BinaryFileStream::~BinaryFileStream()
   if (fileName != 0)
     delete [] fileName;
 
+  if (theCodec != 0)
+    delete theCodec;
+  if (codecBuf != 0)
+    delete [] codecBuf;
+
   if (sendSelfCount > 0) {
 
     for (int i=0; i<=sendSelfCount; i++) {
@@ -164,6 +172,14 @@ BinaryFileStream::open(void)
   } else
     fileOpen = 1;
 
+  // coded files start with a tag, appended rows start with a key frame
+  if (theCodec != 0) {
+    theCodec->reset();
+    theFile.seekp(0, ios::end);
+    if (theFile.tellp() == 0)
+      theFile.write(DataCodec::magic, DataCodec::magicSize);
+  }
+
   return 0;
 }
 
@@ -324,7 +340,18 @@ BinaryFileStream::write(const double *s, int n)
   if (fileOpen == 0)
     this->open();
 
-  if (fileOpen != 0) {
+  if (fileOpen != 0 && theCodec != 0) {
+    int bufSize = DataCodec::getMaxFrameSize(n);
+    if (bufSize > codecBufSize) {
+      if (codecBuf != 0)
+	delete [] codecBuf;
+      codecBuf = new char[bufSize];
+      codecBufSize = bufSize;
+    }
+    Vector data((double *)s, n);
+    theFile.write(codecBuf, theCodec->encode(data, codecBuf));
+    theFile.flush();
+  } else if (fileOpen != 0) {
     //    for (int i=0; i<n; i++)
     theFile.write((char *)(&s[0]), 8*n);
 
@@ -585,6 +612,20 @@ BinaryFileStream::recvSelf(int commitTag, Channel &theChannel, FEM_ObjectBroker
 }
 
 
+int
+BinaryFileStream::setCodec(const DataCodec &codec)
+{
+  if (theCodec != 0)
+    delete theCodec;
+  theCodec = new DataCodec(codec);
+
+  // a file that is already open continues with a key frame
+  theCodec->reset();
+
+  return 0;
+}
+
+
 int 
 binaryToText(const char *inputFilename, const char *outputFilename)
 {
@@ -31,6 +31,7 @@
 using std::ofstream;
 class Matrix;
 class Message;
+class DataCodec;
 
 
 int binaryToText(const char *inputFilename, const char *outputFilename);
@@ -92,6 +93,10 @@ class BinaryFileStream : public OPS_Stream
   int recvSelf(int commitTag, Channel &theChannel, 
 	       FEM_ObjectBroker &theBroker);
 
+  // write each row as a DataCodec frame instead of raw doubles
+  // (not in parallel), use compressedToText() to read the file
+  int setCodec(const DataCodec &theCodec);
+
  private:
   ofstream theFile;
   int fileOpen;
@@ -108,6 +113,10 @@ class BinaryFileStream : public OPS_Stream
   ID **theColumns;
   double **theData;
   Vector **theRemoteData;
+
+  DataCodec *theCodec;
+  char *codecBuf;
+  int codecBufSize;
 };
 
 #endif
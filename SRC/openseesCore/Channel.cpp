@@ -37,6 +37,7 @@
 #include <Message.h>
 #include <MovableObject.h>
 #include <FEM_ObjectBroker.h>
+#include <Vector.h>
 int Channel::numChannel = 0;
 
 Channel::Channel ()
@@ -50,6 +51,65 @@ Channel::~Channel()
     
 }    
 
+int
+Channel::setChannelOptions(const ChannelOptions &theOptions)
+{
+  // channels without sockets have no options to set
+  return -1;
+}
+
+int
+Channel::sendv(int dbTag, int commitTag,
+	       const Vector *const *theVectors, int numVectors,
+	       ChannelAddress *theAddress)
+{
+  // channels without scatter/gather support stage the data of
+  // the vectors in one vector and send that
+  int i, size = 0;
+  for (i=0; i<numVectors; i++)
+    if (theVectors[i] != 0)
+      size += theVectors[i]->Size();
+
+  Vector theVector(size);
+  size = 0;
+  for (i=0; i<numVectors; i++) {
+    if (theVectors[i] != 0) {
+      theVector.Assemble(*theVectors[i], size);
+      size += theVectors[i]->Size();
+    }
+  }
+
+  return this->sendVector(dbTag, commitTag, theVector, theAddress);
+}
+
+int
+Channel::recvv(int dbTag, int commitTag,
+	       Vector *const *theVectors, int numVectors,
+	       ChannelAddress *theAddress)
+{
+  // channels without scatter/gather support receive the data in
+  // one vector and extract the vectors from that
+  int i, size = 0;
+  for (i=0; i<numVectors; i++)
+    if (theVectors[i] != 0)
+      size += theVectors[i]->Size();
+
+  Vector theVector(size);
+  int res = this->recvVector(dbTag, commitTag, theVector, theAddress);
+  if (res < 0)
+    return res;
+
+  size = 0;
+  for (i=0; i<numVectors; i++) {
+    if (theVectors[i] != 0) {
+      theVectors[i]->Extract(theVector, size);
+      size += theVectors[i]->Size();
+    }
+  }
+
+  return res;
+}
+
 int
 Channel::isDatastore(void)
 {
@@ -40,6 +40,7 @@
 
 
 class ChannelAddress;
+class ChannelOptions;
 class Message;
 class MovableObject;
 class Matrix;
@@ -58,6 +59,7 @@ class Channel
     virtual int setUpConnection(void) =0;
     virtual int setNextAddress(const ChannelAddress &theAddress) =0;
     virtual ChannelAddress *getLastSendersAddress(void) =0;
+    virtual int setChannelOptions(const ChannelOptions &theOptions);
 
     virtual int isDatastore(void);
     virtual int getDbTag(void);
@@ -100,6 +102,16 @@ class Channel
     virtual int recvVector(int dbTag, int commitTag, 
 			Vector &theVector, 
 			ChannelAddress *theAddress =0) =0;  
+
+    // methods to send/receive one message that is made up of the
+    // data of several vectors (gather/scatter), null vectors are skipped
+    virtual int sendv(int dbTag, int commitTag, 
+			const Vector *const *theVectors, int numVectors, 
+			ChannelAddress *theAddress =0);  
+
+    virtual int recvv(int dbTag, int commitTag, 
+			Vector *const *theVectors, int numVectors, 
+			ChannelAddress *theAddress =0);  
     
     virtual int sendID(int dbTag, int commitTag, 
 		    const ID &theID, 
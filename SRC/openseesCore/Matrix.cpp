@@ -42,6 +42,17 @@ using std::nothrow;
 #define MATRIX_WORK_AREA 400
 #define INT_WORK_AREA 20
 
+// largest system solved without LAPACK
+#define MATRIX_SMALL_SIZE 6
+
+// the work areas are kept per thread so that Solve() and Invert()
+// can be called concurrently, they are allocated on first use
+#ifdef _MSC_VER
+#define MATRIX_THREAD_LOCAL __declspec(thread)
+#else
+#define MATRIX_THREAD_LOCAL __thread
+#endif
+
 #ifdef _WIN32
 #ifdef _USRDLL
 #define _DLL
@@ -50,13 +61,141 @@ using std::nothrow;
 
 #include <math.h>
 
-int Matrix::sizeDoubleWork = MATRIX_WORK_AREA;
-int Matrix::sizeIntWork = INT_WORK_AREA;
 double Matrix::MATRIX_NOT_VALID_ENTRY =0.0;
-double *Matrix::matrixWork = 0;
-int    *Matrix::intWork =0;
 
-//double *Matrix::matrixWork = (double *)malloc(400*sizeof(double));
+static MATRIX_THREAD_LOCAL double *matrixWork = 0;
+static MATRIX_THREAD_LOCAL int    *intWork = 0;
+static MATRIX_THREAD_LOCAL int sizeDoubleWork = 0;
+static MATRIX_THREAD_LOCAL int sizeIntWork = 0;
+
+
+// make sure the work areas of the calling thread can hold
+// numDouble doubles and numInt ints
+static int
+getWorkArea(int numDouble, int numInt)
+{
+  if (numDouble < MATRIX_WORK_AREA)
+    numDouble = MATRIX_WORK_AREA;
+  if (numInt < INT_WORK_AREA)
+    numInt = INT_WORK_AREA;
+
+  if (numDouble > sizeDoubleWork) {
+    if (matrixWork != 0)
+      delete [] matrixWork;
+    matrixWork = new (nothrow) double[numDouble];
+    sizeDoubleWork = numDouble;
+    if (matrixWork == 0) {
+      opserr << "WARNING: Matrix - out of memory creating work area's\n";
+      sizeDoubleWork = 0;
+      return -3;
+    }
+  }
+
+  if (numInt > sizeIntWork) {
+    if (intWork != 0)
+      delete [] intWork;
+    intWork = new (nothrow) int[numInt];
+    sizeIntWork = numInt;
+    if (intWork == 0) {
+      opserr << "WARNING: Matrix - out of memory creating work area's\n";
+      sizeIntWork = 0;
+      return -3;
+    }
+  }
+
+  return 0;
+}
+
+
+// LU factorization with partial pivoting of the column major N x N
+// matrix A, followed by the solution of the nrhs right hand sides in
+// X. The loops have fixed bounds so that the compiler unrolls them.
+// Like dgesv, -(k+1) is returned if the pivot in column k is zero.
+template <int N>
+static int
+solveSmall(const double *A, double *X, int nrhs)
+{
+  double LU[N*N];
+  int piv[N];
+  int i, j, k, r;
+
+  for (i=0; i<N*N; i++)
+    LU[i] = A[i];
+
+  for (k=0; k<N; k++) {
+    int p = k;
+    double maxA = fabs(LU[k+k*N]);
+    for (i=k+1; i<N; i++) {
+      if (fabs(LU[i+k*N]) > maxA) {
+	maxA = fabs(LU[i+k*N]);
+	p = i;
+      }
+    }
+    piv[k] = p;
+    if (maxA == 0.0)
+      return -(k+1);
+    if (p != k) {
+      for (j=0; j<N; j++) {
+	double tmp = LU[k+j*N];
+	LU[k+j*N] = LU[p+j*N];
+	LU[p+j*N] = tmp;
+      }
+    }
+    double invPivot = 1.0/LU[k+k*N];
+    for (i=k+1; i<N; i++) {
+      double l = LU[i+k*N] *= invPivot;
+      for (j=k+1; j<N; j++)
+	LU[i+j*N] -= l*LU[k+j*N];
+    }
+  }
+
+  for (r=0; r<nrhs; r++) {
+    double *x = X + r*N;
+    for (k=0; k<N; k++) {
+      if (piv[k] != k) {
+	double tmp = x[k];
+	x[k] = x[piv[k]];
+	x[piv[k]] = tmp;
+      }
+    }
+    for (i=1; i<N; i++)
+      for (j=0; j<i; j++)
+	x[i] -= LU[i+j*N]*x[j];
+    for (i=N-1; i>=0; i--) {
+      for (j=i+1; j<N; j++)
+	x[i] -= LU[i+j*N]*x[j];
+      x[i] /= LU[i+i*N];
+    }
+  }
+
+  return 0;
+}
+
+
+static int
+solveSmall(int n, const double *A, double *X, int nrhs)
+{
+  switch (n) {
+  case 1:
+    if (A[0] == 0.0)
+      return -1;
+    for (int r=0; r<nrhs; r++)
+      X[r] /= A[0];
+    return 0;
+  case 2:
+    return solveSmall<2>(A, X, nrhs);
+  case 3:
+    return solveSmall<3>(A, X, nrhs);
+  case 4:
+    return solveSmall<4>(A, X, nrhs);
+  case 5:
+    return solveSmall<5>(A, X, nrhs);
+  case 6:
+    return solveSmall<6>(A, X, nrhs);
+  default:
+    return -1;
+  }
+}
 
 //
 // CONSTRUCTORS
@@ -65,15 +204,6 @@ int    *Matrix::intWork =0;
 Matrix::Matrix()
 :numRows(0), numCols(0), dataSize(0), data(0), fromFree(0)
 {
-  // allocate work areas if the first
-  if (matrixWork == 0) {
-    matrixWork = new (nothrow) double[sizeDoubleWork];
-    intWork = new (nothrow) int[sizeIntWork];
-    if (matrixWork == 0 || intWork == 0) {
-      opserr << "WARNING: Matrix::Matrix() - out of memory creating work area's\n";
-      exit(-1);
-    }
-  }
 }
 
 
@@ -81,16 +211,6 @@ Matrix::Matrix(int nRows,int nCols)
 :numRows(nRows), numCols(nCols), dataSize(0), data(0), fromFree(0)
 {
 
-  // allocate work areas if the first matrix
-  if (matrixWork == 0) {
-    matrixWork = new (nothrow) double[sizeDoubleWork];
-    intWork = new (nothrow) int[sizeIntWork];
-    if (matrixWork == 0 || intWork == 0) {
-      opserr << "WARNING: Matrix::Matrix() - out of memory creating work area's\n";
-      exit(-1);
-    }
-  }
-
 #ifdef _G3DEBUG
     if (nRows < 0) {
       opserr << "WARNING: Matrix::Matrix(int,int): tried to init matrix ";
@@ -125,16 +245,6 @@ Matrix::Matrix(int nRows,int nCols)
 Matrix::Matrix(double *theData, int row, int col) 
 :numRows(row),numCols(col),dataSize(row*col),data(theData),fromFree(1)
 {
-  // allocate work areas if the first matrix
-  if (matrixWork == 0) {
-    matrixWork = new (nothrow) double[sizeDoubleWork];
-    intWork = new (nothrow) int[sizeIntWork];
-    if (matrixWork == 0 || intWork == 0) {
-      opserr << "WARNING: Matrix::Matrix() - out of memory creating work area's\n";
-      exit(-1);
-    }
-  }
-
 #ifdef _G3DEBUG
     if (row < 0) {
       opserr << "WARNING: Matrix::Matrix(int,int): tried to init matrix with numRows: ";
@@ -154,16 +264,6 @@ Matrix::Matrix(double *theData, int row, int col)
 Matrix::Matrix(const Matrix &other)
 :numRows(0), numCols(0), dataSize(0), data(0), fromFree(0)
 {
-  // allocate work areas if the first matrix
-  if (matrixWork == 0) {
-    matrixWork = new (nothrow) double[sizeDoubleWork];
-    intWork = new (nothrow) int[sizeIntWork];
-    if (matrixWork == 0 || intWork == 0) {
-      opserr << "WARNING: Matrix::Matrix() - out of memory creating work area's\n";
-      exit(-1);
-    }
-  }
-
     numRows = other.numRows;
     numCols = other.numCols;
     dataSize = other.dataSize;
@@ -384,36 +484,16 @@ Matrix::Solve(const Vector &b, Vector &x) const
     }
 #endif
     
-    // check work area can hold all the data
-    if (dataSize > sizeDoubleWork) {
-
-      if (matrixWork != 0) {
-	delete [] matrixWork;
-      }
-      matrixWork = new (nothrow) double[dataSize];
-      sizeDoubleWork = dataSize;
-      
-      if (matrixWork == 0) {
-	opserr << "WARNING: Matrix::Solve() - out of memory creating work area's\n";
-	sizeDoubleWork = 0;      
-	return -3;
-      }
+    // small systems are solved directly
+    if (n <= MATRIX_SMALL_SIZE) {
+      x = b;
+      return solveSmall(n, data, x.theData, 1);
     }
 
     // check work area can hold all the data
-    if (n > sizeIntWork) {
-
-      if (intWork != 0) {
-	delete [] intWork;
-      }
-      intWork = new (nothrow) int[n];
-      sizeIntWork = n;
-      
-      if (intWork == 0) {
-	opserr << "WARNING: Matrix::Solve() - out of memory creating work area's\n";
-	sizeIntWork = 0;      
-	return -3;
-      }
+    if (getWorkArea(dataSize, n) != 0) {
+      opserr << "WARNING: Matrix::Solve() - out of memory creating work area's\n";
+      return -3;
     }
 
     
@@ -479,36 +559,16 @@ Matrix::Solve(const Matrix &b, Matrix &x) const
     }
 #endif
 
-    // check work area can hold all the data
-    if (dataSize > sizeDoubleWork) {
-
-      if (matrixWork != 0) {
-	delete [] matrixWork;
-      }
-      matrixWork = new (nothrow) double[dataSize];
-      sizeDoubleWork = dataSize;
-      
-      if (matrixWork == 0) {
-	opserr << "WARNING: Matrix::Solve() - out of memory creating work area's\n";
-	sizeDoubleWork = 0;      
-	return -3;
-      }
+    // small systems are solved directly
+    if (n <= MATRIX_SMALL_SIZE) {
+      x = b;
+      return solveSmall(n, data, x.data, nrhs);
     }
 
     // check work area can hold all the data
-    if (n > sizeIntWork) {
-
-      if (intWork != 0) {
-	delete [] intWork;
-      }
-      intWork = new (nothrow) int[n];
-      sizeIntWork = n;
-      
-      if (intWork == 0) {
-	opserr << "WARNING: Matrix::Solve() - out of memory creating work area's\n";
-	sizeIntWork = 0;      
-	return -3;
-      }
+    if (getWorkArea(dataSize, n) != 0) {
+      opserr << "WARNING: Matrix::Solve() - out of memory creating work area's\n";
+      return -3;
     }
     
     x = b;
@@ -578,36 +638,24 @@ Matrix::Invert(Matrix &theInverse) const
     }
 #endif
 
-    // check work area can hold all the data
-    if (dataSize > sizeDoubleWork) {
-
-      if (matrixWork != 0) {
-	delete [] matrixWork;
-      }
-      matrixWork = new (nothrow) double[dataSize];
-      sizeDoubleWork = dataSize;
-      
-      if (matrixWork == 0) {
-	opserr << "WARNING: Matrix::Solve() - out of memory creating work area's\n";
-	sizeDoubleWork = 0;      
-	return -3;
-      }
+    // small matrices are inverted directly, the copy of the
+    // data allows this and theInverse to be the same matrix
+    if (n <= MATRIX_SMALL_SIZE) {
+      double A[MATRIX_SMALL_SIZE*MATRIX_SMALL_SIZE];
+      int i;
+      for (i=0; i<dataSize; i++)
+	A[i] = data[i];
+      theInverse = *this;
+      theInverse.Zero();
+      for (i=0; i<n; i++)
+	theInverse.data[i+i*n] = 1.0;
+      return solveSmall(n, A, theInverse.data, n);
     }
 
     // check work area can hold all the data
-    if (n > sizeIntWork) {
-
-      if (intWork != 0) {
-	delete [] intWork;
-      }
-      intWork = new (nothrow) int[n];
-      sizeIntWork = n;
-      
-      if (intWork == 0) {
-	opserr << "WARNING: Matrix::Solve() - out of memory creating work area's\n";
-	sizeIntWork = 0;      
-	return -3;
-      }
+    if (getWorkArea(dataSize, n) != 0) {
+      opserr << "WARNING: Matrix::Invert() - out of memory creating work area's\n";
+      return -3;
     }
     
     // copy the data
@@ -962,7 +1010,8 @@ Matrix::addMatrixTripleProduct(double thisFact,
     int dimB = B.numCols;
     int sizeWork = dimB * numCols;
 
-    if (sizeWork > sizeDoubleWork) {
+    if ((sizeWork > sizeDoubleWork && sizeWork > MATRIX_WORK_AREA) ||
+	getWorkArea(sizeWork, 0) != 0) {
       this->addMatrix(thisFact, T^B*T, otherFact);
       return 0;
     }
@@ -1060,7 +1109,8 @@ Matrix::addMatrixTripleProduct(double thisFact,
     // cheack work area can hold the temporary matrix
     int sizeWork = B.numRows * numCols;
 
-    if (sizeWork > sizeDoubleWork) {
+    if ((sizeWork > sizeDoubleWork && sizeWork > MATRIX_WORK_AREA) ||
+	getWorkArea(sizeWork, 0) != 0) {
       this->addMatrix(thisFact, A^B*C, otherFact);
       return 0;
     }
@@ -146,6 +146,7 @@ class Matrix
     friend class UDP_Socket;
     friend class TCP_Socket;
     friend class TCP_SocketSSL;
+    friend class SHM_Channel;
     friend class TCP_SocketNoDelay;
     friend class MPI_Channel;
     friend class MySqlDatastore;
@@ -155,10 +156,6 @@ class Matrix
 
   private:
     static double MATRIX_NOT_VALID_ENTRY;
-    static double *matrixWork;
-    static int *intWork;
-    static int sizeDoubleWork;
-    static int sizeIntWork;
 
     int numRows;
     int numCols;
@@ -50,6 +50,7 @@ class Message
     friend class UDP_Socket;
     friend class TCP_Socket;
     friend class TCP_SocketSSL;
+    friend class SHM_Channel;
     friend class TCP_SocketNoDelay;
     friend class MPI_Channel;
     
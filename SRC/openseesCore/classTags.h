@@ -986,6 +986,7 @@
 #define OPS_STREAM_TAGS_ChannelStream           9
 #define OPS_STREAM_TAGS_DataTurbineStream      10
 #define OPS_STREAM_TAGS_DataFileStreamAdd      11
+#define OPS_STREAM_TAGS_TelemetryStream        12
 
 
 #define DomDecompALGORITHM_TAGS_DomainDecompAlgo 1
@@ -0,0 +1,186 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// $Revision$
+// $Date$
+// $URL$
+
+// Created: 10/26
+// Revision: A
+//
+// Purpose: This file is a standalone micro-benchmark for Matrix::Solve
+// and Matrix::Invert. For each size it reports the time per call of
+// the Matrix methods and of a direct LAPACK dgesv call, and it checks
+// the residuals of solves that run concurrently on several threads.
+//
+// usage: matrixBench <numCalls> <numThreads>
+
+// standard C++ includes
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <pthread.h>
+#include <time.h>
+
+#include <OPS_Globals.h>
+#include <StandardStream.h>
+
+#include <Matrix.h>
+#include <Vector.h>
+
+// init the global variabled defined in OPS_Globals.h
+StandardStream sserr;
+OPS_Stream *opserrPtr = &sserr;
+
+extern "C" int dgesv_(int *N, int *NRHS, double *A, int *LDA,
+    int *iPiv, double *B, int *LDB, int *INFO);
+
+
+static double getTime()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + 1.0E-9*ts.tv_nsec;
+}
+
+
+// diagonally dominant test matrix with a known solution of ones
+static void setupSystem(int n, int seed, Matrix &A, Vector &b)
+{
+    srand(seed);
+    int i, j;
+    for (i=0; i<n; i++)  {
+        for (j=0; j<n; j++)
+            A(i,j) = rand()/(double)RAND_MAX - 0.5;
+        A(i,i) += n;
+    }
+    b.Zero();
+    for (i=0; i<n; i++)
+        for (j=0; j<n; j++)
+            b(i) += A(i,j);
+}
+
+
+struct threadData {
+    int n;
+    int numCalls;
+    int seed;
+    double maxErr;
+};
+
+
+static void *solveThread(void *arg)
+{
+    threadData *data = (threadData *)arg;
+    int n = data->n;
+    Matrix A(n,n), AInv(n,n);
+    Vector b(n), x(n);
+    setupSystem(n, data->seed, A, b);
+    
+    data->maxErr = 0.0;
+    for (int k=0; k<data->numCalls; k++)  {
+        A.Solve(b, x);
+        A.Invert(AInv);
+        for (int i=0; i<n; i++)  {
+            double err = fabs(x(i) - 1.0);
+            if (err > data->maxErr)
+                data->maxErr = err;
+        }
+    }
+    
+    return 0;
+}
+
+
+int main(int argc, char **argv)
+{
+    int numCalls = 100000, numThreads = 4;
+    if (argc > 1)
+        numCalls = atoi(argv[1]);
+    if (argc > 2)
+        numThreads = atoi(argv[2]);
+    if (numCalls < 1 || numThreads < 1)  {
+        fprintf(stderr, "usage: matrixBench <numCalls> <numThreads>\n");
+        return -1;
+    }
+    
+    fprintf(stdout, "%4s %14s %14s %14s %14s\n", "n",
+        "Solve [ns]", "Invert [ns]", "dgesv [ns]", "maxErr");
+    
+    for (int n=1; n<=12; n++)  {
+        Matrix A(n,n), AInv(n,n);
+        Vector b(n), x(n);
+        setupSystem(n, n, A, b);
+        
+        // Matrix methods
+        double t0 = getTime();
+        for (int k=0; k<numCalls; k++)
+            A.Solve(b, x);
+        double tSolve = getTime() - t0;
+        
+        t0 = getTime();
+        for (int k=0; k<numCalls; k++)
+            A.Invert(AInv);
+        double tInvert = getTime() - t0;
+        
+        // direct LAPACK call including the copies Solve needs
+        double *work = new double[n*n];
+        int *iPiv = new int[n];
+        Vector y(n);
+        int nrhs = 1, info;
+        t0 = getTime();
+        for (int k=0; k<numCalls; k++)  {
+            for (int i=0; i<n; i++)
+                for (int j=0; j<n; j++)
+                    work[i+j*n] = A(i,j);
+            y = b;
+            dgesv_(&n, &nrhs, work, &n, iPiv, &y(0), &n, &info);
+        }
+        double tLapack = getTime() - t0;
+        delete [] work;
+        delete [] iPiv;
+        
+        // concurrent solves on several threads
+        pthread_t *threads = new pthread_t[numThreads];
+        threadData *data = new threadData[numThreads];
+        int numThreadCalls = numCalls/10 > 0 ? numCalls/10 : 1;
+        for (int i=0; i<numThreads; i++)  {
+            data[i].n = n;
+            data[i].numCalls = numThreadCalls;
+            data[i].seed = n + 100*i;
+            pthread_create(&threads[i], NULL, solveThread, &data[i]);
+        }
+        double maxErr = 0.0;
+        for (int i=0; i<numThreads; i++)  {
+            pthread_join(threads[i], NULL);
+            if (data[i].maxErr > maxErr)
+                maxErr = data[i].maxErr;
+        }
+        delete [] threads;
+        delete [] data;
+        
+        fprintf(stdout, "%4d %14.1f %14.1f %14.1f %14.2e\n", n,
+            1.0E9*tSolve/numCalls, 1.0E9*tInvert/numCalls,
+            1.0E9*tLapack/numCalls, maxErr);
+    }
+    
+    return 0;
+}
@@ -231,6 +231,24 @@ Actor::recvVector(Vector &theVector, ChannelAddress *theAddress )
 	return theChannel->recvVector(0, commitTag, theVector,theAddress);	
 }
 
+int
+Actor::sendv(const Vector *const *theVectors, int numVectors, ChannelAddress *theAddress )
+{
+    if (theAddress == 0)
+	return theChannel->sendv(0, commitTag, theVectors, numVectors, theRemoteShadowsAddress);
+    else
+	return theChannel->sendv(0, commitTag, theVectors, numVectors, theAddress);	
+}
+
+int
+Actor::recvv(Vector *const *theVectors, int numVectors, ChannelAddress *theAddress )
+{
+    if (theAddress == 0)
+	return theChannel->recvv(0, commitTag, theVectors, numVectors, theRemoteShadowsAddress);
+    else
+	return theChannel->recvv(0, commitTag, theVectors, numVectors, theAddress);	
+}
+
 int
 Actor::sendID(const ID &theID, ChannelAddress *theAddress )
 {
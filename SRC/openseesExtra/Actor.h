@@ -86,6 +86,10 @@ class Actor
 			   ChannelAddress *theAddress =0);   
     virtual int recvVector(Vector &theVector, 
 			   ChannelAddress *theAddress =0);  
+    virtual int sendv(const Vector *const *theVectors, int numVectors, 
+		      ChannelAddress *theAddress =0);   
+    virtual int recvv(Vector *const *theVectors, int numVectors, 
+		      ChannelAddress *theAddress =0);  
     
     virtual int sendID(const ID &theID, 
 		       ChannelAddress *theAddress =0);   
@@ -0,0 +1,345 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// $Revision$
+// $Date$
+// $URL$
+
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the implementation of
+// ChannelOptions.
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include "ChannelOptions.h"
+#include <OPS_Globals.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+#ifndef _WIN32
+#include <errno.h>
+#include <time.h>
+#endif
+
+
+static int getIntArg(const char *arg, int minValue, int *value)
+{
+    char *end;
+    long l = strtol(arg, &end, 10);
+    if (end == arg || *end != '\0' || l < minValue)
+        return -1;
+    *value = (int)l;
+    return 0;
+}
+
+
+static int getDoubleArg(const char *arg, double minValue, double *value)
+{
+    char *end;
+    double d = strtod(arg, &end);
+    if (end == arg || *end != '\0' || d < minValue)
+        return -1;
+    *value = d;
+    return 0;
+}
+
+
+static double getTime()
+{
+#ifdef _WIN32
+    LARGE_INTEGER freq, count;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&count);
+    return (double)count.QuadPart/(double)freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + 1.0E-9*ts.tv_nsec;
+#endif
+}
+
+
+ChannelOptions::ChannelOptions()
+    : sndBuf(0), rcvBuf(0), quickAck(0), busyPoll(0), spin(0),
+    priority(-1), cpu(-1),
+    netDelay(0.0), netJitter(0.0), netDist(0), netRate(0.0),
+    netLoss(0.0), netRto(0.2), netReorder(0.0), netGap(0.0), netSeed(0)
+{
+    // does nothing
+}
+
+
+int ChannelOptions::parse(int argc, const char *const *argv)
+{
+    if (argc < 1)
+        return 0;
+
+    if (strcmp(argv[0], "-quickAck") == 0)  {
+        quickAck = 1;
+        return 1;
+    }
+
+    // network impairment options
+    if (strcmp(argv[0], "-netDist") == 0)  {
+        if (argc > 1 && strcmp(argv[1], "uniform") == 0)
+            netDist = 0;
+        else if (argc > 1 && strcmp(argv[1], "normal") == 0)
+            netDist = 1;
+        else if (argc > 1 && strcmp(argv[1], "pareto") == 0)
+            netDist = 2;
+        else  {
+            opserr << "ChannelOptions::parse() - invalid value for "
+                << "-netDist option, want: uniform, normal or pareto\n";
+            return -1;
+        }
+        return 2;
+    }
+    if (strcmp(argv[0], "-netReorder") == 0)  {
+        if (argc < 3 || getDoubleArg(argv[1], 0.0, &netReorder) != 0 ||
+            netReorder > 1.0 || getDoubleArg(argv[2], 0.0, &netGap) != 0)  {
+            opserr << "ChannelOptions::parse() - invalid values for "
+                << "-netReorder option, want: probability gap\n";
+            return -1;
+        }
+        return 3;
+    }
+    double *dValue = 0;
+    if (strcmp(argv[0], "-netDelay") == 0)
+        dValue = &netDelay;
+    else if (strcmp(argv[0], "-netJitter") == 0)
+        dValue = &netJitter;
+    else if (strcmp(argv[0], "-netRate") == 0)
+        dValue = &netRate;
+    else if (strcmp(argv[0], "-netLoss") == 0)
+        dValue = &netLoss;
+    else if (strcmp(argv[0], "-netRto") == 0)
+        dValue = &netRto;
+    if (dValue != 0)  {
+        if (argc < 2 || getDoubleArg(argv[1], 0.0, dValue) != 0 ||
+            (dValue == &netLoss && netLoss > 1.0))  {
+            opserr << "ChannelOptions::parse() - invalid value for "
+                << argv[0] << " option\n";
+            return -1;
+        }
+        return 2;
+    }
+
+    int *value = 0;
+    if (strcmp(argv[0], "-sndBuf") == 0)
+        value = &sndBuf;
+    else if (strcmp(argv[0], "-rcvBuf") == 0)
+        value = &rcvBuf;
+    else if (strcmp(argv[0], "-busyPoll") == 0)
+        value = &busyPoll;
+    else if (strcmp(argv[0], "-spin") == 0)
+        value = &spin;
+    else if (strcmp(argv[0], "-priority") == 0)
+        value = &priority;
+    else if (strcmp(argv[0], "-cpu") == 0)
+        value = &cpu;
+    else if (strcmp(argv[0], "-netSeed") == 0)
+        value = &netSeed;
+    else
+        return 0;
+
+    if (argc < 2 || getIntArg(argv[1], 0, value) != 0)  {
+        opserr << "ChannelOptions::parse() - invalid value for "
+            << argv[0] << " option\n";
+        return -1;
+    }
+
+    return 2;
+}
+
+
+int ChannelOptions::applyTo(socket_type sockfd, bool stream) const
+{
+    int rValue = 0;
+
+    if (sndBuf > 0)  {
+        if (setsockopt(sockfd, SOL_SOCKET, SO_SNDBUF,
+            (char *) &sndBuf, sizeof(int)) < 0)  {
+            opserr << "ChannelOptions::applyTo() - "
+                << "could not set SO_SNDBUF option\n";
+            rValue = -1;
+        }
+    }
+    if (rcvBuf > 0)  {
+        if (setsockopt(sockfd, SOL_SOCKET, SO_RCVBUF,
+            (char *) &rcvBuf, sizeof(int)) < 0)  {
+            opserr << "ChannelOptions::applyTo() - "
+                << "could not set SO_RCVBUF option\n";
+            rValue = -1;
+        }
+    }
+    if (quickAck && stream)  {
+#ifdef TCP_QUICKACK
+        if (setsockopt(sockfd, IPPROTO_TCP, TCP_QUICKACK,
+            (char *) &quickAck, sizeof(int)) < 0)  {
+            opserr << "ChannelOptions::applyTo() - "
+                << "could not set TCP_QUICKACK option\n";
+            rValue = -1;
+        }
+#else
+        opserr << "ChannelOptions::applyTo() - "
+            << "TCP_QUICKACK option not supported on this platform\n";
+#endif
+    }
+    if (busyPoll > 0)  {
+#ifdef SO_BUSY_POLL
+        if (setsockopt(sockfd, SOL_SOCKET, SO_BUSY_POLL,
+            (char *) &busyPoll, sizeof(int)) < 0)  {
+            opserr << "ChannelOptions::applyTo() - "
+                << "could not set SO_BUSY_POLL option\n";
+            rValue = -1;
+        }
+#else
+        opserr << "ChannelOptions::applyTo() - "
+            << "SO_BUSY_POLL option not supported on this platform\n";
+#endif
+    }
+    if (priority >= 0)  {
+#ifdef SO_PRIORITY
+        if (setsockopt(sockfd, SOL_SOCKET, SO_PRIORITY,
+            (char *) &priority, sizeof(int)) < 0)  {
+            opserr << "ChannelOptions::applyTo() - "
+                << "could not set SO_PRIORITY option\n";
+            rValue = -1;
+        }
+#else
+        opserr << "ChannelOptions::applyTo() - "
+            << "SO_PRIORITY option not supported on this platform\n";
+#endif
+    }
+
+    return rValue;
+}
+
+
+int ChannelOptions::bindThread() const
+{
+    if (cpu < 0)
+        return 0;
+
+#ifdef _WIN32
+    if (cpu >= (int)(8*sizeof(DWORD_PTR)) ||
+        SetThreadAffinityMask(GetCurrentThread(),
+        ((DWORD_PTR)1) << cpu) == 0)  {
+        opserr << "ChannelOptions::bindThread() - "
+            << "could not bind thread to cpu " << cpu << endln;
+        return -1;
+    }
+#elif defined(__linux__)
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(cpu, &cpuSet);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet) != 0)  {
+        opserr << "ChannelOptions::bindThread() - "
+            << "could not bind thread to cpu " << cpu << endln;
+        return -1;
+    }
+#else
+    opserr << "ChannelOptions::bindThread() - "
+        << "cpu affinity not supported on this platform\n";
+#endif
+
+    return 0;
+}
+
+
+void ChannelOptions::rearmQuickAck(socket_type sockfd) const
+{
+    // the kernel falls back to delayed acknowledgments after a
+    // while, so the option has to be set again after each receive
+#ifdef TCP_QUICKACK
+    if (quickAck)
+        setsockopt(sockfd, IPPROTO_TCP, TCP_QUICKACK,
+            (char *) &quickAck, sizeof(int));
+#endif
+}
+
+
+int ChannelOptions::spinUntilReadable(socket_type sockfd) const
+{
+    if (spin <= 0)
+        return 0;
+
+    double tEnd = getTime() + 1.0E-6*spin;
+    do  {
+#ifdef _WIN32
+        fd_set readSet;
+        struct timeval timeout = {0, 0};
+        FD_ZERO(&readSet);
+        FD_SET(sockfd, &readSet);
+        int rValue = select(0, &readSet, NULL, NULL, &timeout);
+        if (rValue != 0)
+            return (rValue > 0) ? 1 : 0;
+#else
+        // peek without blocking, a closed connection or an error
+        // is left for the blocking receive to report
+        char data;
+        int rValue = recv(sockfd, &data, 1, MSG_PEEK | MSG_DONTWAIT);
+        if (rValue > 0)
+            return 1;
+        if (rValue == 0 || (errno != EAGAIN && errno != EWOULDBLOCK))
+            return 0;
+#endif
+    } while (getTime() < tEnd);
+
+    return 0;
+}
+
+
+bool ChannelOptions::isSet() const
+{
+    return (sndBuf > 0 || rcvBuf > 0 || quickAck != 0 || busyPoll > 0 ||
+        spin > 0 || priority >= 0 || cpu >= 0 || this->isImpaired());
+}
+
+
+bool ChannelOptions::isImpaired() const
+{
+    return (netDelay > 0.0 || netJitter > 0.0 || netRate > 0.0 ||
+        netLoss > 0.0 || netReorder > 0.0);
+}
+
+
+void ChannelOptions::Print(OPS_Stream &s) const
+{
+    s << "  sndBuf: " << sndBuf << ", rcvBuf: " << rcvBuf
+        << ", quickAck: " << quickAck << ", busyPoll: " << busyPoll
+        << ", spin: " << spin << ", priority: " << priority << ", cpu: " << cpu << endln;
+    if (this->isImpaired())  {
+        s << "  netDelay: " << netDelay << ", netJitter: " << netJitter
+            << ", netDist: " << netDist << ", netRate: " << netRate << endln;
+        s << "  netLoss: " << netLoss << ", netRto: " << netRto
+            << ", netReorder: " << netReorder << ", netGap: " << netGap
+            << ", netSeed: " << netSeed << endln;
+    }
+}
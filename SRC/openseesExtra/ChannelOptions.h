@@ -0,0 +1,100 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// $Revision$
+// $Date$
+// $URL$
+
+#ifndef ChannelOptions_h
+#define ChannelOptions_h
+
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the class definition for
+// ChannelOptions. ChannelOptions holds the socket and thread settings
+// (buffer sizes, quick acknowledgments, busy polling, receive spinning,
+// priority and cpu affinity of the receiving thread) that are applied
+// by the TCP_Socket, TCP_SocketSSL and UDP_Socket channels when they
+// set up their connection. With a spin budget the TCP_Socket and
+// UDP_Socket channels poll the socket without blocking before each
+// receive and only fall back to the blocking receive once the budget
+// is used up, which avoids the wakeup latency of the scheduler at the
+// cost of a busy cpu. Options that are not available on a platform
+// are ignored with a warning. The network impairment options (-net...)
+// are not applied by the channels themselves, they make the commands
+// wrap the channel in an ImpairedChannel that emulates a slow network.
+
+#include <Socket.h>
+
+class ChannelOptions
+{
+public:
+    // constructor
+    ChannelOptions();
+
+    // method to parse the channel option at argv[0], returns the
+    // number of arguments used, 0 if argv[0] is not a channel option
+    // and -1 if the value of the option is invalid
+    int parse(int argc, const char *const *argv);
+
+    // method to apply the options to a socket
+    int applyTo(socket_type sockfd, bool stream) const;
+
+    // method to bind the calling thread to the requested cpu
+    int bindThread() const;
+
+    // method to re-enable quick acknowledgments after a receive
+    void rearmQuickAck(socket_type sockfd) const;
+
+    // method to spin on the socket until data is available or the
+    // spin budget is used up, returns 1 if data is available
+    int spinUntilReadable(socket_type sockfd) const;
+
+    // method to check if any option is set
+    bool isSet() const;
+
+    // method to check if any network impairment option is set
+    bool isImpaired() const;
+
+    // method to print the options
+    void Print(OPS_Stream &s) const;
+
+    int sndBuf;     // send buffer size in bytes (0 = system default)
+    int rcvBuf;     // receive buffer size in bytes (0 = system default)
+    int quickAck;   // disable delayed acknowledgments (TCP only)
+    int busyPoll;   // busy poll time in microseconds (0 = off)
+    int spin;       // receive spin budget in microseconds (0 = off)
+    int priority;   // socket priority (-1 = system default)
+    int cpu;        // cpu of the receiving thread (-1 = not bound)
+
+    double netDelay;    // mean one way delay of the sent messages in sec
+    double netJitter;   // variation of the delay in sec
+    int netDist;        // distribution of the variation (0 = uniform, 1 = normal, 2 = pareto)
+    double netRate;     // bandwidth in bits per sec (0 = unlimited)
+    double netLoss;     // probability that a message is lost
+    double netRto;      // time until a lost message is resent in sec (0 = send fails)
+    double netReorder;  // probability that a message is overtaken
+    double netGap;      // time an overtaken message arrives late in sec
+    int netSeed;        // seed of the random numbers
+};
+
+#endif
@@ -0,0 +1,472 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// $Revision$
+// $Date$
+// $URL$
+
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the implementation of DataCodec.
+
+#include "DataCodec.h"
+#include <Vector.h>
+#include <OPS_Globals.h>
+
+#include <math.h>
+#include <string.h>
+#include <fstream>
+#include <iomanip>
+using namespace std;
+
+// flags of the first byte of a frame
+#define CODEC_KEY_FRAME  0x01
+#define CODEC_RES_TABLE  0x02
+
+// control byte of a lossless value that did not change
+#define CODEC_UNCHANGED  0x80
+
+// largest quantized value, larger values are clamped
+#define CODEC_MAX_QUANT  9007199254740992.0  // 2^53
+
+const char DataCodec::magic[DataCodec::magicSize+1] = "OFZ1";
+
+
+static unsigned long long toBits(double x)
+{
+    unsigned long long bits;
+    memcpy(&bits, &x, sizeof(double));
+    return bits;
+}
+
+
+static double fromBits(unsigned long long bits)
+{
+    double x;
+    memcpy(&x, &bits, sizeof(double));
+    return x;
+}
+
+
+static int putVarint(char *buf, unsigned long long value)
+{
+    int n = 0;
+    while (value >= 0x80)  {
+        buf[n++] = (char)((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    buf[n++] = (char)value;
+    return n;
+}
+
+
+static int getVarint(const char *buf, int numBytes, unsigned long long &value)
+{
+    value = 0;
+    for (int n=0, shift=0; n<numBytes && shift<64; n++, shift+=7)  {
+        unsigned char c = (unsigned char)buf[n];
+        value |= (unsigned long long)(c & 0x7F) << shift;
+        if ((c & 0x80) == 0)
+            return n+1;
+    }
+    return -1;
+}
+
+
+static void putBits(char *buf, unsigned long long bits)
+{
+    for (int i=7; i>=0; i--)
+        *buf++ = (char)(bits >> 8*i);
+}
+
+
+static unsigned long long getBits(const char *buf)
+{
+    unsigned long long bits = 0;
+    for (int i=0; i<8; i++)
+        bits = (bits << 8) | (unsigned char)buf[i];
+    return bits;
+}
+
+
+DataCodec::DataCodec(int interval)
+    : resolution(0), keyInterval(interval), size(0),
+    chRes(0), prevValue(0), prevQuant(0), frameCount(0),
+    haveKey(false), numFrames(0), rawBytes(0.0), codedBytes(0.0)
+{
+    if (keyInterval < 0)
+        keyInterval = 0;
+}
+
+
+DataCodec::DataCodec(const Vector &res, int interval)
+    : resolution(0), keyInterval(interval), size(0),
+    chRes(0), prevValue(0), prevQuant(0), frameCount(0),
+    haveKey(false), numFrames(0), rawBytes(0.0), codedBytes(0.0)
+{
+    if (keyInterval < 0)
+        keyInterval = 0;
+    
+    if (res.Size() > 0)  {
+        resolution = new Vector(res);
+        for (int i=0; i<res.Size(); i++)  {
+            if (!(res(i) >= 0.0))  {
+                opserr << "DataCodec::DataCodec() - "
+                    << "resolutions must not be negative, "
+                    << "using lossless coding for channel " << i << endln;
+                (*resolution)(i) = 0.0;
+            }
+        }
+    }
+}
+
+
+DataCodec::DataCodec(const DataCodec &codec)
+    : resolution(0), keyInterval(codec.keyInterval), size(0),
+    chRes(0), prevValue(0), prevQuant(0), frameCount(0),
+    haveKey(false), numFrames(0), rawBytes(0.0), codedBytes(0.0)
+{
+    if (codec.resolution != 0)
+        resolution = new Vector(*codec.resolution);
+}
+
+
+DataCodec::~DataCodec()
+{
+    if (resolution != 0)
+        delete resolution;
+    if (chRes != 0)
+        delete [] chRes;
+    if (prevValue != 0)
+        delete [] prevValue;
+    if (prevQuant != 0)
+        delete [] prevQuant;
+}
+
+
+int DataCodec::encode(const Vector &data, char *buf)
+{
+    int n = data.Size();
+    if (n != size)
+        this->resize(n, true);
+    
+    // decide if this becomes a key frame
+    bool key = (haveKey == false || frameCount == 0 ||
+        (keyInterval > 0 && frameCount >= keyInterval));
+    bool quantized = false;
+    for (int i=0; i<size && !quantized; i++)
+        quantized = (chRes[i] > 0.0);
+    
+    int pos = 0;
+    buf[pos++] = (char)(key ? (CODEC_KEY_FRAME |
+        (quantized ? CODEC_RES_TABLE : 0)) : 0);
+    if (key)  {
+        pos += putVarint(&buf[pos], (unsigned long long)size);
+        if (quantized)  {
+            for (int i=0; i<size; i++, pos+=8)
+                putBits(&buf[pos], toBits(chRes[i]));
+        }
+        for (int i=0; i<size; i++)  {
+            prevValue[i] = 0.0;
+            prevQuant[i] = 0;
+        }
+        frameCount = 0;
+        haveKey = true;
+    }
+    
+    for (int i=0; i<size; i++)  {
+        double x = data(i);
+        if (chRes[i] > 0.0)  {
+            // quantize and store the zigzag coded difference
+            double r = floor(x/chRes[i] + 0.5);
+            if (r != r)
+                r = 0.0;
+            else if (r > CODEC_MAX_QUANT)
+                r = CODEC_MAX_QUANT;
+            else if (r < -CODEC_MAX_QUANT)
+                r = -CODEC_MAX_QUANT;
+            long long q = (long long)r;
+            long long d = q - prevQuant[i];
+            pos += putVarint(&buf[pos],
+                ((unsigned long long)d << 1) ^ (unsigned long long)(d >> 63));
+            prevQuant[i] = q;
+        } else  {
+            // store the bytes of the XOR that are not zero
+            unsigned long long bits = toBits(x) ^ toBits(prevValue[i]);
+            if (bits == 0)  {
+                buf[pos++] = (char)CODEC_UNCHANGED;
+            } else  {
+                int lead = 0, trail = 0;
+                while ((bits >> (56-8*lead) & 0xFF) == 0)
+                    lead++;
+                while ((bits >> 8*trail & 0xFF) == 0)
+                    trail++;
+                buf[pos++] = (char)(lead << 4 | trail);
+                for (int j=7-lead; j>=trail; j--)
+                    buf[pos++] = (char)(bits >> 8*j);
+            }
+            prevValue[i] = x;
+        }
+    }
+    frameCount++;
+    
+    numFrames++;
+    rawBytes += 8.0*size;
+    codedBytes += pos;
+    
+    return pos;
+}
+
+
+int DataCodec::decode(const char *buf, int numBytes, Vector &data)
+{
+    if (numBytes < 1)
+        return -1;
+    
+    int pos = 0;
+    int flags = (unsigned char)buf[pos++];
+    if (flags & CODEC_KEY_FRAME)  {
+        unsigned long long n;
+        int len = getVarint(&buf[pos], numBytes-pos, n);
+        if (len < 0 || n > (unsigned long long)numBytes)  {
+            opserr << "DataCodec::decode() - invalid key frame\n";
+            return -1;
+        }
+        pos += len;
+        if ((int)n != size)
+            this->resize((int)n, false);
+        for (int i=0; i<size; i++)  {
+            chRes[i] = 0.0;
+            prevValue[i] = 0.0;
+            prevQuant[i] = 0;
+        }
+        if (flags & CODEC_RES_TABLE)  {
+            if (pos + 8*size > numBytes)  {
+                opserr << "DataCodec::decode() - invalid key frame\n";
+                return -1;
+            }
+            for (int i=0; i<size; i++, pos+=8)
+                chRes[i] = fromBits(getBits(&buf[pos]));
+        }
+        haveKey = true;
+    } else if (haveKey == false)  {
+        opserr << "DataCodec::decode() - frame received before key frame\n";
+        return -1;
+    }
+    
+    if (data.Size() != size)
+        data.resize(size);
+    
+    for (int i=0; i<size; i++)  {
+        if (chRes[i] > 0.0)  {
+            unsigned long long z;
+            int len = getVarint(&buf[pos], numBytes-pos, z);
+            if (len < 0)  {
+                opserr << "DataCodec::decode() - frame is truncated\n";
+                return -1;
+            }
+            pos += len;
+            prevQuant[i] += (long long)(z >> 1) ^ -(long long)(z & 1);
+            data(i) = prevQuant[i]*chRes[i];
+        } else  {
+            if (pos >= numBytes)  {
+                opserr << "DataCodec::decode() - frame is truncated\n";
+                return -1;
+            }
+            int ctrl = (unsigned char)buf[pos++];
+            if (ctrl != CODEC_UNCHANGED)  {
+                int lead = ctrl >> 4, trail = ctrl & 0x0F;
+                if (lead + trail >= 8 || pos + 8-lead-trail > numBytes)  {
+                    opserr << "DataCodec::decode() - invalid frame\n";
+                    return -1;
+                }
+                unsigned long long bits = 0;
+                for (int j=7-lead; j>=trail; j--)
+                    bits |= (unsigned long long)(unsigned char)buf[pos++] << 8*j;
+                prevValue[i] = fromBits(toBits(prevValue[i]) ^ bits);
+            }
+            data(i) = prevValue[i];
+        }
+    }
+    
+    numFrames++;
+    rawBytes += 8.0*size;
+    codedBytes += pos;
+    
+    return pos;
+}
+
+
+void DataCodec::reset()
+{
+    haveKey = false;
+    frameCount = 0;
+}
+
+
+int DataCodec::getNumFrames() const
+{
+    return numFrames;
+}
+
+
+double DataCodec::getRatio() const
+{
+    if (codedBytes <= 0.0)
+        return 1.0;
+    
+    return rawBytes/codedBytes;
+}
+
+
+void DataCodec::Print(OPS_Stream &s) const
+{
+    s << "  DataCodec: ";
+    if (resolution == 0)
+        s << "lossless";
+    else  {
+        s << "resolution: [";
+        for (int i=0; i<resolution->Size(); i++)
+            s << " " << (*resolution)(i);
+        s << " ]";
+    }
+    s << ", keyInterval: " << keyInterval << endln;
+    s << "  frames: " << numFrames << ", compression ratio: "
+        << this->getRatio() << endln;
+}
+
+
+int DataCodec::getMaxFrameSize(int size)
+{
+    // flag, number of channels, resolutions and at most
+    // ten bytes per quantized or nine per lossless value
+    return 1 + 5 + 8*size + 10*size;
+}
+
+
+void DataCodec::putFrameLength(char *buf, int length)
+{
+    for (int i=0; i<lengthSize; i++)
+        buf[i] = (char)(length >> 8*(lengthSize-1-i));
+}
+
+
+int DataCodec::getFrameLength(const char *buf)
+{
+    int length = 0;
+    for (int i=0; i<lengthSize; i++)
+        length = (length << 8) | (unsigned char)buf[i];
+    
+    return length;
+}
+
+
+int DataCodec::resize(int newSize, bool encoder)
+{
+    if (chRes != 0)
+        delete [] chRes;
+    if (prevValue != 0)
+        delete [] prevValue;
+    if (prevQuant != 0)
+        delete [] prevQuant;
+    
+    size = newSize;
+    chRes = new double [size > 0 ? size : 1];
+    prevValue = new double [size > 0 ? size : 1];
+    prevQuant = new long long [size > 0 ? size : 1];
+    
+    // the encoder takes the resolutions from the requested ones,
+    // the decoder gets them with the next key frame
+    for (int i=0; i<size; i++)  {
+        chRes[i] = 0.0;
+        if (encoder && resolution != 0)  {
+            int n = resolution->Size();
+            chRes[i] = (*resolution)(i < n ? i : n-1);
+        }
+        prevValue[i] = 0.0;
+        prevQuant[i] = 0;
+    }
+    
+    // a change of size always starts with a key frame
+    haveKey = false;
+    frameCount = 0;
+    
+    return 0;
+}
+
+
+int compressedToText(const char *inputFilename, const char *outputFilename)
+{
+    ifstream input(inputFilename, ios::in | ios::binary);
+    if (!input.is_open())  {
+        opserr << "WARNING compressedToText() - could not open file "
+            << inputFilename << endln;
+        return -1;
+    }
+    ofstream output(outputFilename, ios::out);
+    if (!output.is_open())  {
+        opserr << "WARNING compressedToText() - could not open file "
+            << outputFilename << endln;
+        return -1;
+    }
+    
+    // read the whole file, the frames are self-delimiting
+    input.seekg(0, ios::end);
+    int numBytes = (int)input.tellg();
+    input.seekg(0, ios::beg);
+    char *buf = new char [numBytes > 0 ? numBytes : 1];
+    input.read(buf, numBytes);
+    input.close();
+    
+    if (numBytes < DataCodec::magicSize ||
+        strncmp(buf, DataCodec::magic, DataCodec::magicSize) != 0)  {
+        opserr << "WARNING compressedToText() - file " << inputFilename
+            << " was not written with a DataCodec\n";
+        delete [] buf;
+        return -1;
+    }
+    
+    DataCodec theCodec;
+    Vector data(1);
+    int pos = DataCodec::magicSize;
+    output << setprecision(16);
+    while (pos < numBytes)  {
+        int len = theCodec.decode(&buf[pos], numBytes-pos, data);
+        if (len < 0)  {
+            opserr << "WARNING compressedToText() - invalid frame at byte "
+                << pos << endln;
+            delete [] buf;
+            return -1;
+        }
+        pos += len;
+        for (int i=0; i<data.Size(); i++)  {
+            output << data(i);
+            if (i < data.Size()-1)
+                output << " ";
+        }
+        output << "\n";
+    }
+    output.close();
+    delete [] buf;
+    
+    return 0;
+}
@@ -0,0 +1,118 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// $Revision$
+// $Date$
+// $URL$
+
+#ifndef DataCodec_h
+#define DataCodec_h
+
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the class definition for DataCodec.
+// DataCodec compresses a stream of equally sized vectors of doubles
+// by coding each sample against the previous sample of the same
+// channel. Channels with a resolution of zero are coded without loss
+// by storing only the bytes of the XOR with the previous value that
+// are not zero. Channels with a resolution greater than zero are
+// quantized to integer multiples of that resolution first and only
+// the difference to the previous integer is stored as a variable
+// length integer, which for transducer data with ~18 bits of real
+// resolution typically takes one to three bytes per sample. The
+// resolutions are given per channel, if fewer resolutions than
+// channels are given the last one applies to the remaining channels.
+//
+// Every frame starts with a flag byte. Key frames (the first frame,
+// every keyInterval-th frame and whenever the number of channels
+// changes) are coded against zero and also store the number of
+// channels and, if any channel is quantized, the resolutions. A
+// decoder therefore needs no setup and can resynchronize at any key
+// frame. Frames are self-delimiting, the byte order of the coded
+// data is independent of the platform. To send frames over stream
+// channels the encoder can prefix each frame with its length.
+
+class Vector;
+class OPS_Stream;
+
+class DataCodec
+{
+public:
+    // constructors
+    DataCodec(int keyInterval = 256);
+    DataCodec(const Vector &resolution, int keyInterval = 256);
+    DataCodec(const DataCodec &codec);
+    
+    // destructor
+    ~DataCodec();
+    
+    // method to encode a vector into buf, returns the number of
+    // bytes written (at most getMaxFrameSize(data.Size()) bytes)
+    int encode(const Vector &data, char *buf);
+    
+    // method to decode one frame of numBytes bytes from buf into data
+    // (resized if needed), returns the number of bytes used or -1
+    int decode(const char *buf, int numBytes, Vector &data);
+    
+    // method to start over with a key frame
+    void reset();
+    
+    // methods to get the statistics
+    int getNumFrames() const;
+    double getRatio() const;
+    
+    // method to print the settings and statistics
+    void Print(OPS_Stream &s) const;
+    
+    // maximum number of bytes of a frame with size values
+    static int getMaxFrameSize(int size);
+    
+    // methods to write and read the length prefix of a frame
+    static const int lengthSize = 4;
+    static void putFrameLength(char *buf, int length);
+    static int getFrameLength(const char *buf);
+    
+    // tag at the start of files that contain coded frames
+    static const int magicSize = 4;
+    static const char magic[magicSize+1];
+    
+private:
+    int resize(int newSize, bool encoder);
+    
+    Vector *resolution; // requested resolutions (0 = lossless)
+    int keyInterval;    // frames between key frames (0 = only first)
+    int size;           // number of channels of the last frame
+    double *chRes;      // resolution of each channel
+    double *prevValue;  // last value of each channel
+    long long *prevQuant; // last quantized value of each channel
+    int frameCount;     // frames since the last key frame
+    bool haveKey;       // flag if a key frame has been coded
+    int numFrames;      // number of frames coded
+    double rawBytes;    // bytes of the uncoded frames
+    double codedBytes;  // bytes of the coded frames
+};
+
+// convert a file written by a BinaryFileStream with a DataCodec
+// into a text file with one row per line
+int compressedToText(const char *inputFilename, const char *outputFilename);
+
+#endif
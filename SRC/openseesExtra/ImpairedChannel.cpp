@@ -0,0 +1,640 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// $Revision$
+// $Date$
+// $URL$
+
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the implementation of
+// ImpairedChannel.
+
+#include "ImpairedChannel.h"
+#include <OPS_Globals.h>
+#include <Matrix.h>
+#include <Vector.h>
+#include <ID.h>
+#include <Message.h>
+#include <MovableObject.h>
+
+#include <math.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <time.h>
+#endif
+
+// types of the messages held back
+enum {pendingMsg, pendingMatrix, pendingVector, pendingVectors, pendingID};
+
+
+// copy of a sent message that is held back until its arrival time
+struct ImpairedChannel::Pending
+{
+    Pending(int t, int dbtag, int committag)
+        : type(t), dbTag(dbtag), commitTag(committag), tArrival(0.0),
+        data(0), size(0), theMatrix(0), theVector(0), theVectors(0),
+        numVectors(0), theID(0), next(0)
+    { }
+    ~Pending()
+    {
+        if (data != 0)
+            delete [] data;
+        if (theMatrix != 0)
+            delete theMatrix;
+        if (theVector != 0)
+            delete theVector;
+        for (int i=0; i<numVectors; i++)  {
+            if (theVectors[i] != 0)
+                delete theVectors[i];
+        }
+        if (theVectors != 0)
+            delete [] theVectors;
+        if (theID != 0)
+            delete theID;
+    }
+    
+    int type;               // type of the message
+    int dbTag, commitTag;   // tags passed to the wrapped channel
+    double tArrival;        // time when the message arrives
+    char *data;             // data of a Message
+    int size;               // size of the data of a Message
+    Matrix *theMatrix;
+    Vector *theVector;
+    Vector **theVectors;
+    int numVectors;
+    ID *theID;
+    Pending *next;          // next message in the queue
+};
+
+
+static double getTime()
+{
+#ifdef _WIN32
+    LARGE_INTEGER freq, count;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&count);
+    return (double)count.QuadPart/(double)freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + 1.0E-9*ts.tv_nsec;
+#endif
+}
+
+
+// sleep until the time is reached, the last 100 microseconds
+// are spun so that the arrival times are accurate
+static void sleepUntil(double tEnd)
+{
+    double tLeft;
+    while ((tLeft = tEnd - getTime()) > 0.0)  {
+        if (tLeft > 2.0E-4)  {
+            tLeft -= 1.0E-4;
+#ifdef _WIN32
+            Sleep((DWORD)(1000.0*tLeft));
+#else
+            struct timespec ts;
+            ts.tv_sec = (time_t)tLeft;
+            ts.tv_nsec = (long)(1.0E9*(tLeft - ts.tv_sec));
+            nanosleep(&ts, NULL);
+#endif
+        }
+    }
+}
+
+
+ImpairedChannel::ImpairedChannel(Channel *channel,
+    const ChannelOptions &theOptions)
+    : theChannel(channel), options(theOptions),
+    rngState((unsigned long long)theOptions.netSeed),
+    linkFree(0.0), lastArrival(0.0),
+    numMsgs(0), numLost(0), numReordered(0),
+    numBytes(0.0), totalDelay(0.0),
+    first(0), last(0), failed(false), stopFlag(false), running(false)
+{
+    if (theChannel == 0)  {
+        opserr << "ImpairedChannel::ImpairedChannel() - "
+            << "null channel passed\n";
+        exit(-1);
+    }
+    
+#ifdef _WIN32
+    InitializeCriticalSection(&theMutex);
+    InitializeConditionVariable(&theCond);
+#else
+    pthread_mutex_init(&theMutex, NULL);
+    pthread_cond_init(&theCond, NULL);
+#endif
+}
+
+
+ImpairedChannel::~ImpairedChannel()
+{
+    // the messages in flight are delivered first
+    this->stopThread();
+    
+    if (theChannel != 0)
+        delete theChannel;
+    
+#ifdef _WIN32
+    DeleteCriticalSection(&theMutex);
+#else
+    pthread_cond_destroy(&theCond);
+    pthread_mutex_destroy(&theMutex);
+#endif
+}
+
+
+Channel *ImpairedChannel::wrap(Channel *theChannel,
+    const ChannelOptions &options)
+{
+    if (theChannel == 0 || !options.isImpaired())
+        return theChannel;
+
+    return new ImpairedChannel(theChannel, options);
+}
+
+
+char *ImpairedChannel::addToProgram()
+{
+    return theChannel->addToProgram();
+}
+
+
+int ImpairedChannel::setUpConnection()
+{
+    int rValue = theChannel->setUpConnection();
+
+    // the link starts idle once connected
+    linkFree = lastArrival = getTime();
+
+    return rValue;
+}
+
+
+int ImpairedChannel::setChannelOptions(const ChannelOptions &theOptions)
+{
+    options = theOptions;
+
+    return theChannel->setChannelOptions(theOptions);
+}
+
+
+int ImpairedChannel::setNextAddress(const ChannelAddress &theAddress)
+{
+    return theChannel->setNextAddress(theAddress);
+}
+
+
+ChannelAddress *ImpairedChannel::getLastSendersAddress()
+{
+    return theChannel->getLastSendersAddress();
+}
+
+
+int ImpairedChannel::isDatastore()
+{
+    return theChannel->isDatastore();
+}
+
+
+int ImpairedChannel::getDbTag()
+{
+    return theChannel->getDbTag();
+}
+
+
+int ImpairedChannel::sendObj(int commitTag,
+    MovableObject &theObject, ChannelAddress *theAddress)
+{
+    // the object sends its data through this channel,
+    // so that each of its messages is held back
+    if (theAddress != 0 && theChannel->setNextAddress(*theAddress) < 0)
+        return -1;
+
+    return theObject.sendSelf(commitTag, *this);
+}
+
+
+int ImpairedChannel::recvObj(int commitTag,
+    MovableObject &theObject, FEM_ObjectBroker &theBroker,
+    ChannelAddress *theAddress)
+{
+    if (theAddress != 0 && theChannel->setNextAddress(*theAddress) < 0)
+        return -1;
+
+    return theObject.recvSelf(commitTag, *this, theBroker);
+}
+
+
+int ImpairedChannel::sendMsg(int dbTag, int commitTag,
+    const Message &msg, ChannelAddress *theAddress)
+{
+    int size = ((Message &)msg).getSize();
+    Pending *theMsg = new Pending(pendingMsg, dbTag, commitTag);
+    theMsg->data = new char [size > 0 ? size : 1];
+    if (size > 0)
+        memcpy(theMsg->data, ((Message &)msg).getData(), size);
+    theMsg->size = size;
+
+    return this->send(theMsg, size, theAddress);
+}
+
+
+int ImpairedChannel::recvMsg(int dbTag, int commitTag,
+    Message &msg, ChannelAddress *theAddress)
+{
+    return theChannel->recvMsg(dbTag, commitTag, msg, theAddress);
+}
+
+
+int ImpairedChannel::recvMsgUnknownSize(int dbTag, int commitTag,
+    Message &msg, ChannelAddress *theAddress)
+{
+    return theChannel->recvMsgUnknownSize(dbTag, commitTag, msg, theAddress);
+}
+
+
+int ImpairedChannel::sendMatrix(int dbTag, int commitTag,
+    const Matrix &theMatrix, ChannelAddress *theAddress)
+{
+    Pending *theMsg = new Pending(pendingMatrix, dbTag, commitTag);
+    theMsg->theMatrix = new Matrix(theMatrix);
+
+    return this->send(theMsg,
+        theMatrix.noRows()*theMatrix.noCols()*sizeof(double), theAddress);
+}
+
+
+int ImpairedChannel::recvMatrix(int dbTag, int commitTag,
+    Matrix &theMatrix, ChannelAddress *theAddress)
+{
+    return theChannel->recvMatrix(dbTag, commitTag, theMatrix, theAddress);
+}
+
+
+int ImpairedChannel::sendVector(int dbTag, int commitTag,
+    const Vector &theVector, ChannelAddress *theAddress)
+{
+    Pending *theMsg = new Pending(pendingVector, dbTag, commitTag);
+    theMsg->theVector = new Vector(theVector);
+
+    return this->send(theMsg, theVector.Size()*sizeof(double), theAddress);
+}
+
+
+int ImpairedChannel::recvVector(int dbTag, int commitTag,
+    Vector &theVector, ChannelAddress *theAddress)
+{
+    return theChannel->recvVector(dbTag, commitTag, theVector, theAddress);
+}
+
+
+int ImpairedChannel::sendv(int dbTag, int commitTag,
+    const Vector *const *theVectors, int numVectors,
+    ChannelAddress *theAddress)
+{
+    Pending *theMsg = new Pending(pendingVectors, dbTag, commitTag);
+    theMsg->theVectors = new Vector* [numVectors > 0 ? numVectors : 1];
+    theMsg->numVectors = numVectors;
+    int nbytes = 0;
+    for (int i=0; i<numVectors; i++)  {
+        theMsg->theVectors[i] = 0;
+        if (theVectors[i] != 0)  {
+            theMsg->theVectors[i] = new Vector(*theVectors[i]);
+            nbytes += theVectors[i]->Size()*sizeof(double);
+        }
+    }
+
+    return this->send(theMsg, nbytes, theAddress);
+}
+
+
+int ImpairedChannel::recvv(int dbTag, int commitTag,
+    Vector *const *theVectors, int numVectors,
+    ChannelAddress *theAddress)
+{
+    return theChannel->recvv(dbTag, commitTag, theVectors, numVectors, theAddress);
+}
+
+
+int ImpairedChannel::sendID(int dbTag, int commitTag,
+    const ID &theID, ChannelAddress *theAddress)
+{
+    Pending *theMsg = new Pending(pendingID, dbTag, commitTag);
+    theMsg->theID = new ID(theID);
+
+    return this->send(theMsg, theID.Size()*sizeof(int), theAddress);
+}
+
+
+int ImpairedChannel::recvID(int dbTag, int commitTag,
+    ID &theID, ChannelAddress *theAddress)
+{
+    return theChannel->recvID(dbTag, commitTag, theID, theAddress);
+}
+
+
+void ImpairedChannel::Print(OPS_Stream &s)
+{
+    s << "ImpairedChannel: " << this->getTag() << endln;
+    options.Print(s);
+    s << "  messages: " << numMsgs << ", bytes: " << numBytes
+        << ", lost: " << numLost << ", overtaken: " << numReordered << endln;
+    if (numMsgs > 0)
+        s << "  mean time held back: " << totalDelay/numMsgs << " sec\n";
+}
+
+
+int ImpairedChannel::send(Pending *msg, int nbytes,
+    ChannelAddress *theAddress)
+{
+    // a lost message that is not resent fails the send
+    msg->tArrival = this->impair(nbytes);
+    if (msg->tArrival < 0.0)  {
+        delete msg;
+        return -1;
+    }
+
+    // messages to an explicit address are sent after the queued ones,
+    // as are all of them if the delivery thread can not be started
+    if (theAddress != 0 || (!running && this->startThread() < 0))  {
+        this->flush();
+        sleepUntil(msg->tArrival);
+        int rValue = this->deliver(msg, theAddress);
+        delete msg;
+        return rValue;
+    }
+
+    // a failed delivery is reported by the next send
+    this->lock();
+    int rValue = failed ? -1 : 0;
+    failed = false;
+    if (last != 0)
+        last->next = msg;
+    else
+        first = msg;
+    last = msg;
+    this->unlock();
+    this->notify();
+
+    return rValue;
+}
+
+
+int ImpairedChannel::deliver(Pending *msg, ChannelAddress *theAddress)
+{
+    if (msg->type == pendingMsg)  {
+        Message theMsg(msg->data, msg->size);
+        return theChannel->sendMsg(msg->dbTag, msg->commitTag,
+            theMsg, theAddress);
+    }
+    else if (msg->type == pendingMatrix)
+        return theChannel->sendMatrix(msg->dbTag, msg->commitTag,
+            *msg->theMatrix, theAddress);
+    else if (msg->type == pendingVector)
+        return theChannel->sendVector(msg->dbTag, msg->commitTag,
+            *msg->theVector, theAddress);
+    else if (msg->type == pendingVectors)
+        return theChannel->sendv(msg->dbTag, msg->commitTag,
+            msg->theVectors, msg->numVectors, theAddress);
+    else
+        return theChannel->sendID(msg->dbTag, msg->commitTag,
+            *msg->theID, theAddress);
+}
+
+
+void ImpairedChannel::flush()
+{
+    this->lock();
+    while (first != 0)
+        this->wait();
+    this->unlock();
+}
+
+
+double ImpairedChannel::impair(int nbytes)
+{
+    double tNow = getTime();
+    numMsgs++;
+    numBytes += nbytes;
+
+    // the message is sent once the link is free
+    double tSent = (linkFree > tNow) ? linkFree : tNow;
+    if (options.netRate > 0.0)
+        tSent += 8.0*nbytes/options.netRate;
+    linkFree = tSent;
+
+    // the variation of the uniform and normal distributions has zero
+    // mean, the pareto one is a positive tail with mean netJitter
+    double delay = options.netDelay;
+    if (options.netJitter > 0.0)  {
+        if (options.netDist == 0)
+            delay += options.netJitter*(2.0*this->getRandom() - 1.0);
+        else if (options.netDist == 1)
+            delay += options.netJitter*this->getNormal();
+        else  {
+            const double shape = 3.0;
+            double scale = (shape - 1.0)*options.netJitter;
+            delay += scale*pow(1.0 - this->getRandom(), -1.0/shape) - scale;
+        }
+        if (delay < 0.0)
+            delay = 0.0;
+    }
+
+    if (options.netLoss > 0.0 && this->getRandom() < options.netLoss)  {
+        numLost++;
+        if (options.netRto <= 0.0)
+            return -1.0;
+        delay += options.netRto;
+    }
+    if (options.netReorder > 0.0 && this->getRandom() < options.netReorder)  {
+        numReordered++;
+        delay += options.netGap;
+    }
+
+    // no message arrives before the previous one
+    double tArrival = tSent + delay;
+    if (tArrival < lastArrival)
+        tArrival = lastArrival;
+    lastArrival = tArrival;
+
+    totalDelay += tArrival - tNow;
+
+    return tArrival;
+}
+
+
+int ImpairedChannel::startThread()
+{
+    stopFlag = false;
+    running = true;
+
+#ifdef _WIN32
+    theThread = CreateThread(NULL, 0, threadFunc, this, 0, NULL);
+    if (theThread == NULL)  {
+        opserr << "ImpairedChannel::startThread() - "
+            << "could not create delivery thread\n";
+        running = false;
+        return -1;
+    }
+#else
+    if (pthread_create(&theThread, NULL, threadFunc, this) != 0)  {
+        opserr << "ImpairedChannel::startThread() - "
+            << "could not create delivery thread\n";
+        running = false;
+        return -1;
+    }
+#endif
+
+    return 0;
+}
+
+
+void ImpairedChannel::stopThread()
+{
+    if (!running)
+        return;
+
+    this->lock();
+    stopFlag = true;
+    this->unlock();
+    this->notify();
+
+#ifdef _WIN32
+    WaitForSingleObject(theThread, INFINITE);
+    CloseHandle(theThread);
+    theThread = NULL;
+#else
+    pthread_join(theThread, NULL);
+#endif
+
+    running = false;
+}
+
+
+#ifdef _WIN32
+DWORD WINAPI ImpairedChannel::threadFunc(LPVOID arg)
+{
+    ((ImpairedChannel *)arg)->runThread();
+    return 0;
+}
+#else
+void *ImpairedChannel::threadFunc(void *arg)
+{
+    ((ImpairedChannel *)arg)->runThread();
+    return 0;
+}
+#endif
+
+
+void ImpairedChannel::runThread()
+{
+    // forward the queued messages at their arrival times, which
+    // do not decrease, until the queue is empty after the stop
+    this->lock();
+    while (true)  {
+        while (first == 0 && !stopFlag)
+            this->wait();
+        if (first == 0)
+            break;
+        Pending *msg = first;
+        this->unlock();
+
+        sleepUntil(msg->tArrival);
+        int rValue = this->deliver(msg, 0);
+
+        this->lock();
+        if (rValue < 0)
+            failed = true;
+        first = msg->next;
+        if (first == 0)
+            last = 0;
+        delete msg;
+        this->notify();
+    }
+    this->unlock();
+}
+
+
+void ImpairedChannel::lock()
+{
+#ifdef _WIN32
+    EnterCriticalSection(&theMutex);
+#else
+    pthread_mutex_lock(&theMutex);
+#endif
+}
+
+
+void ImpairedChannel::unlock()
+{
+#ifdef _WIN32
+    LeaveCriticalSection(&theMutex);
+#else
+    pthread_mutex_unlock(&theMutex);
+#endif
+}
+
+
+void ImpairedChannel::notify()
+{
+#ifdef _WIN32
+    WakeAllConditionVariable(&theCond);
+#else
+    pthread_cond_broadcast(&theCond);
+#endif
+}
+
+
+void ImpairedChannel::wait()
+{
+#ifdef _WIN32
+    SleepConditionVariableCS(&theCond, &theMutex, INFINITE);
+#else
+    pthread_cond_wait(&theCond, &theMutex);
+#endif
+}
+
+
+double ImpairedChannel::getRandom()
+{
+    // splitmix64, the same seed gives the same impairments
+    unsigned long long z = (rngState += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z = z ^ (z >> 31);
+
+    return (z >> 11)*(1.0/9007199254740992.0);
+}
+
+
+double ImpairedChannel::getNormal()
+{
+    // Box-Muller transformation
+    double u1 = 1.0 - this->getRandom();
+    double u2 = this->getRandom();
+
+    return sqrt(-2.0*log(u1))*cos(2.0*3.14159265358979323846*u2);
+}
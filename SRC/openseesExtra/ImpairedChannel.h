@@ -0,0 +1,184 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// $Revision$
+// $Date$
+// $URL$
+
+#ifndef ImpairedChannel_h
+#define ImpairedChannel_h
+
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the class definition for
+// ImpairedChannel. ImpairedChannel wraps another channel and holds
+// back each sent message until it would have arrived over a slow
+// network, so that distributed tests can be reproduced on one
+// machine. The link is modeled by a bandwidth, a delay with a
+// uniform, normal or pareto distributed variation, lost messages that
+// are resent after a retransmission timeout and messages that are
+// overtaken and arrive late by a gap. If the timeout is 0, a lost
+// message is not sent at all and the send returns an error. Since a
+// stream keeps the order of the messages, no message arrives before
+// the previous one. The sends return right away and a delivery thread
+// forwards the copied messages at their arrival times, so that several
+// messages can be in flight at once. Messages to an explicit address
+// are sent after the queued ones by the calling thread. The
+// impairments are set with the -net... channel options and apply to
+// the messages sent by the wrapped side, which takes ownership of the
+// wrapped channel.
+
+#include <Channel.h>
+#include <ChannelOptions.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+class ImpairedChannel : public Channel
+{
+public:
+    // constructor
+    ImpairedChannel(Channel *theChannel, const ChannelOptions &options);
+
+    // destructor
+    ~ImpairedChannel();
+
+    // method to wrap the channel if any network impairment option
+    // is set, otherwise the channel is returned unchanged
+    static Channel *wrap(Channel *theChannel, const ChannelOptions &options);
+
+    char *addToProgram();
+
+    virtual int setUpConnection();
+    virtual int setChannelOptions(const ChannelOptions &theOptions);
+
+    int setNextAddress(const ChannelAddress &otherChannelAddress);
+    virtual ChannelAddress *getLastSendersAddress();
+
+    virtual int isDatastore();
+    virtual int getDbTag();
+
+    int sendObj(int commitTag,
+        MovableObject &theObject,
+        ChannelAddress *theAddress = 0);
+    int recvObj(int commitTag,
+        MovableObject &theObject,
+        FEM_ObjectBroker &theBroker,
+        ChannelAddress *theAddress = 0);
+
+    int sendMsg(int dbTag, int commitTag,
+        const Message &,
+        ChannelAddress *theAddress = 0);
+    int recvMsg(int dbTag, int commitTag,
+        Message &,
+        ChannelAddress *theAddress = 0);
+    int recvMsgUnknownSize(int dbTag, int commitTag,
+        Message &,
+        ChannelAddress *theAddress = 0);
+
+    int sendMatrix(int dbTag, int commitTag,
+        const Matrix &theMatrix,
+        ChannelAddress *theAddress = 0);
+    int recvMatrix(int dbTag, int commitTag,
+        Matrix &theMatrix,
+        ChannelAddress *theAddress = 0);
+
+    int sendVector(int dbTag, int commitTag,
+        const Vector &theVector,
+        ChannelAddress *theAddress = 0);
+    int recvVector(int dbTag, int commitTag,
+        Vector &theVector,
+        ChannelAddress *theAddress = 0);
+
+    int sendv(int dbTag, int commitTag,
+        const Vector *const *theVectors, int numVectors,
+        ChannelAddress *theAddress = 0);
+    int recvv(int dbTag, int commitTag,
+        Vector *const *theVectors, int numVectors,
+        ChannelAddress *theAddress = 0);
+
+    int sendID(int dbTag, int commitTag,
+        const ID &theID,
+        ChannelAddress *theAddress = 0);
+    int recvID(int dbTag, int commitTag,
+        ID &theID,
+        ChannelAddress *theAddress = 0);
+
+    // method to print the statistics of the sent messages
+    void Print(OPS_Stream &s);
+
+private:
+    struct Pending;
+
+    double impair(int nbytes);
+    int send(Pending *msg, int nbytes, ChannelAddress *theAddress);
+    int deliver(Pending *msg, ChannelAddress *theAddress);
+    void flush();
+    double getRandom();
+    double getNormal();
+
+    // methods for the delivery thread
+    int startThread();
+    void stopThread();
+#ifdef _WIN32
+    static DWORD WINAPI threadFunc(LPVOID arg);
+#else
+    static void *threadFunc(void *arg);
+#endif
+    void runThread();
+    void lock();
+    void unlock();
+    void notify();
+    void wait();
+
+    Channel *theChannel;    // wrapped channel
+    ChannelOptions options; // network impairment options
+    unsigned long long rngState;    // state of the random numbers
+    double linkFree;        // time when the link has sent the last message
+    double lastArrival;     // arrival time of the last message
+
+    int numMsgs;            // number of sent messages
+    int numLost;            // number of lost messages
+    int numReordered;       // number of overtaken messages
+    double numBytes;        // number of sent bytes
+    double totalDelay;      // total time the messages were held back
+
+    Pending *first, *last;  // queue of the messages in flight
+    bool failed;            // flag if the delivery of a message failed
+    bool stopFlag;          // flag to stop the thread
+    bool running;           // flag if the thread is running
+
+#ifdef _WIN32
+    HANDLE theThread;
+    CRITICAL_SECTION theMutex;
+    CONDITION_VARIABLE theCond;
+#else
+    pthread_t theThread;
+    pthread_mutex_t theMutex;
+    pthread_cond_t theCond;
+#endif
+};
+
+#endif
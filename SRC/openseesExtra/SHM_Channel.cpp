@@ -0,0 +1,765 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// $Revision$
+// $Date$
+// $URL$
+
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the implementation of
+// SHM_Channel.
+
+#include "SHM_Channel.h"
+#include <OPS_Globals.h>
+#include <Matrix.h>
+#include <Vector.h>
+#include <ID.h>
+#include <Message.h>
+#include <MovableObject.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+#ifdef __linux__
+#include <limits.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+// size of the ring buffer of each direction in bytes (power of two),
+// longer messages are passed on in several parts
+#define SHM_RING_SIZE (1 << 20)
+#define SHM_MAGIC 0x4f465348
+// time to wait for the other process to create the segment in seconds
+#define SHM_CONNECT_TIMEOUT 10.0
+
+// the counters of each ring are kept in cache lines of their own
+// so that the two processes do not invalidate each others lines
+struct SHM_Ring
+{
+    volatile unsigned int head;             // bytes written
+    volatile unsigned int dataSeq;          // futex word of the reader
+    volatile unsigned int readerWaiting;    // flag if the reader sleeps
+    char pad1[52];
+    volatile unsigned int tail;             // bytes read
+    volatile unsigned int spaceSeq;         // futex word of the writer
+    volatile unsigned int writerWaiting;    // flag if the writer sleeps
+    char pad2[52];
+};
+
+// the data of the two rings follows the segment header
+struct SHM_Segment
+{
+    unsigned int magic;
+    unsigned int ringSize;
+    volatile unsigned int state;    // 0 = created, 1 = ready, 2 = connected
+    volatile unsigned int closed;   // flag if one of the processes is done
+    char pad[48];
+    SHM_Ring ring[2];               // ring 0 is written by the creator
+};
+
+static const size_t segmentSize = sizeof(SHM_Segment) + 2*SHM_RING_SIZE;
+
+
+static inline unsigned int loadAcquire(volatile unsigned int *p)
+{
+#ifdef _WIN32
+    unsigned int value = *p;
+    MemoryBarrier();
+    return value;
+#else
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+#endif
+}
+
+
+static inline void storeRelease(volatile unsigned int *p, unsigned int value)
+{
+#ifdef _WIN32
+    MemoryBarrier();
+    *p = value;
+#else
+    __atomic_store_n(p, value, __ATOMIC_RELEASE);
+#endif
+}
+
+
+static inline void fullFence()
+{
+#ifdef _WIN32
+    MemoryBarrier();
+#else
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+#endif
+}
+
+
+static inline void increment(volatile unsigned int *p)
+{
+#ifdef _WIN32
+    InterlockedIncrement((volatile LONG *)p);
+#else
+    __atomic_fetch_add(p, 1, __ATOMIC_SEQ_CST);
+#endif
+}
+
+
+static inline void cpuRelax()
+{
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    __asm__ __volatile__("pause");
+#elif defined(_WIN32)
+    YieldProcessor();
+#endif
+}
+
+
+// sleep as long as the word still has the value, the futex is
+// shared between the processes, other platforms yield the cpu
+static void waitWhile(volatile unsigned int *p, unsigned int value)
+{
+#ifdef __linux__
+    syscall(SYS_futex, (unsigned int *)p, FUTEX_WAIT, value, NULL, NULL, 0);
+#elif defined(_WIN32)
+    SwitchToThread();
+#else
+    sched_yield();
+#endif
+}
+
+
+static void wakeAll(volatile unsigned int *p)
+{
+#ifdef __linux__
+    syscall(SYS_futex, (unsigned int *)p, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+#endif
+}
+
+
+static void sleepMsec(int msec)
+{
+#ifdef _WIN32
+    Sleep(msec);
+#else
+    struct timespec ts = {msec/1000, (msec%1000)*1000000L};
+    nanosleep(&ts, NULL);
+#endif
+}
+
+
+static double getTime()
+{
+#ifdef _WIN32
+    LARGE_INTEGER freq, count;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&count);
+    return (double)count.QuadPart/(double)freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + 1.0E-9*ts.tv_nsec;
+#endif
+}
+
+
+static void getSegmentName(unsigned int port, char *name)
+{
+#ifdef _WIN32
+    sprintf(name, "Local\\OpenFresco_%u", port);
+#else
+    sprintf(name, "/OpenFresco_%u", port);
+#endif
+}
+
+
+SHM_Channel::SHM_Channel(unsigned int _port)
+    : port(_port), connectType(0),
+    theSegment(0), sendRing(0), recvRing(0), sendBuf(0), recvBuf(0),
+    sendHead(0), recvTail(0)
+{
+#ifdef _WIN32
+    theMapping = 0;
+#endif
+}
+
+
+SHM_Channel::SHM_Channel(unsigned int other_Port,
+    const char *other_InetAddr)
+    : port(other_Port), connectType(1),
+    theSegment(0), sendRing(0), recvRing(0), sendBuf(0), recvBuf(0),
+    sendHead(0), recvTail(0)
+{
+#ifdef _WIN32
+    theMapping = 0;
+#endif
+
+    if (other_InetAddr != 0 && strcmp(other_InetAddr, "127.0.0.1") != 0 &&
+        strcmp(other_InetAddr, "localhost") != 0)  {
+        opserr << "SHM_Channel::SHM_Channel() - WARNING "
+            << other_InetAddr << " is ignored, shared memory "
+            << "channels only connect processes on the same machine\n";
+    }
+}
+
+
+SHM_Channel::~SHM_Channel()
+{
+    if (theSegment != 0)  {
+        // wake up the other process in case it waits for us
+        storeRelease(&theSegment->closed, 1);
+        increment(&sendRing->dataSeq);
+        increment(&recvRing->spaceSeq);
+        wakeAll(&sendRing->dataSeq);
+        wakeAll(&recvRing->spaceSeq);
+        this->unmap();
+    }
+}
+
+
+char *SHM_Channel::addToProgram()
+{
+    char *newStuff = (char *)malloc(100*sizeof(char));
+    sprintf(newStuff, " 4 127.0.0.1 %u ", port);
+
+    return newStuff;
+}
+
+
+int SHM_Channel::setUpConnection()
+{
+    char name[64];
+    getSegmentName(port, name);
+    void *mem = 0;
+
+    if (connectType == 0)  {
+        // create the segment and wait for the other process
+#ifdef _WIN32
+        theMapping = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL,
+            PAGE_READWRITE, 0, (DWORD)segmentSize, name);
+        if (theMapping == 0 || GetLastError() == ERROR_ALREADY_EXISTS)  {
+            opserr << "SHM_Channel::setUpConnection() - "
+                << "could not create shared memory " << name << endln;
+            return -1;
+        }
+        mem = MapViewOfFile(theMapping, FILE_MAP_ALL_ACCESS, 0, 0, segmentSize);
+        if (mem == 0)  {
+            opserr << "SHM_Channel::setUpConnection() - "
+                << "could not map shared memory " << name << endln;
+            return -1;
+        }
+#else
+        // remove a segment that a crashed process left behind
+        shm_unlink(name);
+        int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0)  {
+            opserr << "SHM_Channel::setUpConnection() - "
+                << "could not create shared memory " << name << endln;
+            return -1;
+        }
+        if (ftruncate(fd, segmentSize) < 0)  {
+            opserr << "SHM_Channel::setUpConnection() - "
+                << "could not size shared memory " << name << endln;
+            close(fd);
+            shm_unlink(name);
+            return -1;
+        }
+        mem = mmap(0, segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (mem == MAP_FAILED)  {
+            opserr << "SHM_Channel::setUpConnection() - "
+                << "could not map shared memory " << name << endln;
+            shm_unlink(name);
+            return -1;
+        }
+#endif
+        theSegment = (SHM_Segment *)mem;
+        memset(mem, 0, sizeof(SHM_Segment));
+        theSegment->magic = SHM_MAGIC;
+        theSegment->ringSize = SHM_RING_SIZE;
+        storeRelease(&theSegment->state, 1);
+
+        while (loadAcquire(&theSegment->state) != 2)
+            sleepMsec(1);
+
+#ifndef _WIN32
+        // both processes have the segment mapped now, so the
+        // name is not needed anymore and nothing is left behind
+        shm_unlink(name);
+#endif
+        sendRing = &theSegment->ring[0];
+        recvRing = &theSegment->ring[1];
+        sendBuf = (char *)(theSegment+1);
+        recvBuf = sendBuf + SHM_RING_SIZE;
+    }
+    else  {
+        // wait until the other process has created the segment
+        double tEnd = getTime() + SHM_CONNECT_TIMEOUT;
+        while (mem == 0)  {
+#ifdef _WIN32
+            theMapping = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, name);
+            if (theMapping != 0)  {
+                mem = MapViewOfFile(theMapping, FILE_MAP_ALL_ACCESS,
+                    0, 0, segmentSize);
+                if (mem == 0)  {
+                    CloseHandle(theMapping);
+                    theMapping = 0;
+                }
+            }
+#else
+            // the segment must not be mapped before it is sized
+            int fd = shm_open(name, O_RDWR, 0);
+            if (fd >= 0)  {
+                struct stat st;
+                if (fstat(fd, &st) == 0 && st.st_size >= (off_t)segmentSize)  {
+                    mem = mmap(0, segmentSize, PROT_READ | PROT_WRITE,
+                        MAP_SHARED, fd, 0);
+                    if (mem == MAP_FAILED)
+                        mem = 0;
+                }
+                close(fd);
+            }
+#endif
+            if (mem == 0)  {
+                if (getTime() > tEnd)  {
+                    opserr << "SHM_Channel::setUpConnection() - "
+                        << "could not connect to shared memory " << name << endln;
+                    return -1;
+                }
+                sleepMsec(1);
+            }
+        }
+        theSegment = (SHM_Segment *)mem;
+
+        while (loadAcquire(&theSegment->state) != 1)  {
+            if (getTime() > tEnd)  {
+                opserr << "SHM_Channel::setUpConnection() - "
+                    << "shared memory " << name << " was not initialized\n";
+                this->unmap();
+                return -1;
+            }
+            sleepMsec(1);
+        }
+        if (theSegment->magic != SHM_MAGIC ||
+            theSegment->ringSize != SHM_RING_SIZE)  {
+            opserr << "SHM_Channel::setUpConnection() - "
+                << "shared memory " << name << " has an unknown layout\n";
+            this->unmap();
+            return -1;
+        }
+        storeRelease(&theSegment->state, 2);
+
+        sendRing = &theSegment->ring[1];
+        recvRing = &theSegment->ring[0];
+        recvBuf = (char *)(theSegment+1);
+        sendBuf = recvBuf + SHM_RING_SIZE;
+    }
+    sendHead = 0;
+    recvTail = 0;
+
+    // bind the receiving thread to the requested cpu
+    options.bindThread();
+
+    return 0;
+}
+
+
+int SHM_Channel::setChannelOptions(const ChannelOptions &theOptions)
+{
+    // only the spin budget and the cpu are used
+    options = theOptions;
+
+    return 0;
+}
+
+
+int SHM_Channel::setNextAddress(const ChannelAddress &theAddress)
+{
+    opserr << "SHM_Channel::setNextAddress() - an SHM_Channel "
+        << "can only communicate with one other SHM_Channel\n";
+    return -1;
+}
+
+
+int SHM_Channel::sendObj(int commitTag,
+    MovableObject &theObject, ChannelAddress *theAddress)
+{
+    if (this->checkAddress(theAddress, "sendObj") < 0)
+        return -1;
+
+    return theObject.sendSelf(commitTag, *this);
+}
+
+
+int SHM_Channel::recvObj(int commitTag,
+    MovableObject &theObject, FEM_ObjectBroker &theBroker,
+    ChannelAddress *theAddress)
+{
+    if (this->checkAddress(theAddress, "recvObj") < 0)
+        return -1;
+
+    return theObject.recvSelf(commitTag, *this, theBroker);
+}
+
+
+int SHM_Channel::sendMsg(int dbTag, int commitTag,
+    const Message &msg, ChannelAddress *theAddress)
+{
+    if (this->checkAddress(theAddress, "sendMsg") < 0)
+        return -1;
+
+    if (this->write(msg.data, msg.length) < 0)
+        return -1;
+    this->publish();
+
+    return 0;
+}
+
+
+int SHM_Channel::recvMsg(int dbTag, int commitTag,
+    Message &msg, ChannelAddress *theAddress)
+{
+    if (this->checkAddress(theAddress, "recvMsg") < 0)
+        return -1;
+
+    return this->read(msg.data, msg.length);
+}
+
+
+int SHM_Channel::recvMsgUnknownSize(int dbTag, int commitTag,
+    Message &msg, ChannelAddress *theAddress)
+{
+    if (this->checkAddress(theAddress, "recvMsgUnknownSize") < 0)
+        return -1;
+
+    // read up to the end of the string or line
+    char *gMsg = msg.data;
+    int nleft = msg.length;
+    while (nleft > 0)  {
+        if (this->read(gMsg, 1) < 0)
+            return -1;
+        nleft--;
+        if (*gMsg == '\0')
+            break;
+        if (*gMsg == '\n')  {
+            if (nleft > 0)
+                *(gMsg+1) = '\0';
+            break;
+        }
+        gMsg++;
+    }
+
+    return 0;
+}
+
+
+int SHM_Channel::sendMatrix(int dbTag, int commitTag,
+    const Matrix &theMatrix, ChannelAddress *theAddress)
+{
+    if (this->checkAddress(theAddress, "sendMatrix") < 0)
+        return -1;
+
+    if (this->write((char *)theMatrix.data,
+        theMatrix.dataSize*sizeof(double)) < 0)
+        return -1;
+    this->publish();
+
+    return 0;
+}
+
+
+int SHM_Channel::recvMatrix(int dbTag, int commitTag,
+    Matrix &theMatrix, ChannelAddress *theAddress)
+{
+    if (this->checkAddress(theAddress, "recvMatrix") < 0)
+        return -1;
+
+    return this->read((char *)theMatrix.data,
+        theMatrix.dataSize*sizeof(double));
+}
+
+
+int SHM_Channel::sendVector(int dbTag, int commitTag,
+    const Vector &theVector, ChannelAddress *theAddress)
+{
+    if (this->checkAddress(theAddress, "sendVector") < 0)
+        return -1;
+
+    if (this->write((char *)theVector.theData,
+        theVector.sz*sizeof(double)) < 0)
+        return -1;
+    this->publish();
+
+    return 0;
+}
+
+
+int SHM_Channel::recvVector(int dbTag, int commitTag,
+    Vector &theVector, ChannelAddress *theAddress)
+{
+    if (this->checkAddress(theAddress, "recvVector") < 0)
+        return -1;
+
+    return this->read((char *)theVector.theData,
+        theVector.sz*sizeof(double));
+}
+
+
+int SHM_Channel::sendv(int dbTag, int commitTag,
+    const Vector *const *theVectors, int numVectors,
+    ChannelAddress *theAddress)
+{
+    if (this->checkAddress(theAddress, "sendv") < 0)
+        return -1;
+
+    // the vectors are copied into the ring one after the
+    // other and the receiver is woken up only once
+    for (int i=0; i<numVectors; i++)  {
+        const Vector *theVector = theVectors[i];
+        if (theVector == 0 || theVector->sz == 0)
+            continue;
+        if (this->write((char *)theVector->theData,
+            theVector->sz*sizeof(double)) < 0)
+            return -1;
+    }
+    this->publish();
+
+    return 0;
+}
+
+
+int SHM_Channel::recvv(int dbTag, int commitTag,
+    Vector *const *theVectors, int numVectors,
+    ChannelAddress *theAddress)
+{
+    if (this->checkAddress(theAddress, "recvv") < 0)
+        return -1;
+
+    for (int i=0; i<numVectors; i++)  {
+        Vector *theVector = theVectors[i];
+        if (theVector == 0 || theVector->sz == 0)
+            continue;
+        if (this->read((char *)theVector->theData,
+            theVector->sz*sizeof(double)) < 0)
+            return -1;
+    }
+
+    return 0;
+}
+
+
+int SHM_Channel::sendID(int dbTag, int commitTag,
+    const ID &theID, ChannelAddress *theAddress)
+{
+    if (this->checkAddress(theAddress, "sendID") < 0)
+        return -1;
+
+    if (this->write((char *)theID.data, theID.sz*sizeof(int)) < 0)
+        return -1;
+    this->publish();
+
+    return 0;
+}
+
+
+int SHM_Channel::recvID(int dbTag, int commitTag,
+    ID &theID, ChannelAddress *theAddress)
+{
+    if (this->checkAddress(theAddress, "recvID") < 0)
+        return -1;
+
+    return this->read((char *)theID.data, theID.sz*sizeof(int));
+}
+
+
+int SHM_Channel::checkAddress(ChannelAddress *theAddress,
+    const char *method)
+{
+    if (theSegment == 0)  {
+        opserr << "SHM_Channel::" << method << "() - "
+            << "connection is not set up\n";
+        return -1;
+    }
+    if (theAddress != 0)  {
+        opserr << "SHM_Channel::" << method << "() - an SHM_Channel "
+            << "can only communicate with one other SHM_Channel\n";
+        return -1;
+    }
+
+    return 0;
+}
+
+
+int SHM_Channel::write(const char *data, int nbytes)
+{
+    while (nbytes > 0)  {
+        unsigned int space = SHM_RING_SIZE -
+            (sendHead - loadAcquire(&sendRing->tail));
+        if (space == 0)  {
+            // pass on what is there so that the reader makes room
+            this->publish();
+            if (this->waitForSpace() < 0)
+                return -1;
+            continue;
+        }
+        unsigned int n = ((unsigned int)nbytes < space) ? nbytes : space;
+        unsigned int offset = sendHead & (SHM_RING_SIZE-1);
+        unsigned int first = (n < SHM_RING_SIZE-offset) ? n : SHM_RING_SIZE-offset;
+        memcpy(&sendBuf[offset], data, first);
+        memcpy(sendBuf, data+first, n-first);
+        sendHead += n;
+        data += n;
+        nbytes -= n;
+    }
+
+    return 0;
+}
+
+
+int SHM_Channel::read(char *data, int nbytes)
+{
+    while (nbytes > 0)  {
+        unsigned int avail = loadAcquire(&recvRing->head) - recvTail;
+        if (avail == 0)  {
+            if (this->waitForData() < 0)
+                return -1;
+            continue;
+        }
+        unsigned int n = ((unsigned int)nbytes < avail) ? nbytes : avail;
+        unsigned int offset = recvTail & (SHM_RING_SIZE-1);
+        unsigned int first = (n < SHM_RING_SIZE-offset) ? n : SHM_RING_SIZE-offset;
+        memcpy(data, &recvBuf[offset], first);
+        memcpy(data+first, recvBuf, n-first);
+        recvTail += n;
+        data += n;
+        nbytes -= n;
+
+        // hand the space back to the writer
+        storeRelease(&recvRing->tail, recvTail);
+        increment(&recvRing->spaceSeq);
+        fullFence();
+        if (loadAcquire(&recvRing->writerWaiting))
+            wakeAll(&recvRing->spaceSeq);
+    }
+
+    return 0;
+}
+
+
+void SHM_Channel::publish()
+{
+    if (loadAcquire(&sendRing->head) == sendHead)
+        return;
+
+    storeRelease(&sendRing->head, sendHead);
+    increment(&sendRing->dataSeq);
+    fullFence();
+    if (loadAcquire(&sendRing->readerWaiting))
+        wakeAll(&sendRing->dataSeq);
+}
+
+
+int SHM_Channel::waitForData()
+{
+    // spin first to avoid the wakeup latency of the scheduler
+    if (options.spin > 0)  {
+        double tEnd = getTime() + 1.0E-6*options.spin;
+        do  {
+            if (loadAcquire(&recvRing->head) != recvTail)
+                return 0;
+            cpuRelax();
+        } while (getTime() < tEnd);
+    }
+
+    // the sequence number is read before the flag is raised, so a
+    // message that is published in between ends the wait at once
+    for (;;)  {
+        unsigned int seq = loadAcquire(&recvRing->dataSeq);
+        storeRelease(&recvRing->readerWaiting, 1);
+        fullFence();
+        if (loadAcquire(&recvRing->head) != recvTail)
+            break;
+        if (loadAcquire(&theSegment->closed))  {
+            storeRelease(&recvRing->readerWaiting, 0);
+            opserr << "SHM_Channel::waitForData() - "
+                << "connection was closed\n";
+            return -1;
+        }
+        waitWhile(&recvRing->dataSeq, seq);
+    }
+    storeRelease(&recvRing->readerWaiting, 0);
+
+    return 0;
+}
+
+
+int SHM_Channel::waitForSpace()
+{
+    for (;;)  {
+        unsigned int seq = loadAcquire(&sendRing->spaceSeq);
+        storeRelease(&sendRing->writerWaiting, 1);
+        fullFence();
+        if (sendHead - loadAcquire(&sendRing->tail) < SHM_RING_SIZE)
+            break;
+        if (loadAcquire(&theSegment->closed))  {
+            storeRelease(&sendRing->writerWaiting, 0);
+            opserr << "SHM_Channel::waitForSpace() - "
+                << "connection was closed\n";
+            return -1;
+        }
+        waitWhile(&sendRing->spaceSeq, seq);
+    }
+    storeRelease(&sendRing->writerWaiting, 0);
+
+    return 0;
+}
+
+
+void SHM_Channel::unmap()
+{
+#ifdef _WIN32
+    if (theSegment != 0)
+        UnmapViewOfFile(theSegment);
+    if (theMapping != 0)
+        CloseHandle(theMapping);
+    theMapping = 0;
+#else
+    if (theSegment != 0)
+        munmap(theSegment, segmentSize);
+#endif
+    theSegment = 0;
+    sendRing = 0;
+    recvRing = 0;
+    sendBuf = 0;
+    recvBuf = 0;
+}
@@ -0,0 +1,140 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// $Revision$
+// $Date$
+// $URL$
+
+#ifndef SHM_Channel_h
+#define SHM_Channel_h
+
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the class definition for
+// SHM_Channel. SHM_Channel is a sub-class of channel for two processes
+// on the same machine. The data is passed through a shared memory
+// segment that is named after the port number and that holds one
+// single producer single consumer ring buffer for each direction, so
+// that no system calls and no kernel copies are needed while data
+// flows. A receiver that finds its ring empty spins for the spin
+// budget of the channel options and then sleeps on a futex until the
+// sender wakes it up (other platforms yield the cpu instead). Like the
+// TCP_Socket, the process that creates the channel with only a port
+// number waits for the other process to connect.
+
+#include <Channel.h>
+#include <ChannelOptions.h>
+
+struct SHM_Segment;
+struct SHM_Ring;
+
+class SHM_Channel : public Channel
+{
+public:
+    // constructors
+    SHM_Channel(unsigned int port);
+    SHM_Channel(unsigned int other_Port, const char *other_InetAddr);
+
+    // destructor
+    ~SHM_Channel();
+
+    char *addToProgram();
+
+    virtual int setUpConnection();
+    virtual int setChannelOptions(const ChannelOptions &theOptions);
+
+    int setNextAddress(const ChannelAddress &otherChannelAddress);
+    virtual ChannelAddress *getLastSendersAddress() {return 0;};
+
+    int sendObj(int commitTag,
+        MovableObject &theObject,
+        ChannelAddress *theAddress = 0);
+    int recvObj(int commitTag,
+        MovableObject &theObject,
+        FEM_ObjectBroker &theBroker,
+        ChannelAddress *theAddress = 0);
+
+    int sendMsg(int dbTag, int commitTag,
+        const Message &,
+        ChannelAddress *theAddress = 0);
+    int recvMsg(int dbTag, int commitTag,
+        Message &,
+        ChannelAddress *theAddress = 0);
+    int recvMsgUnknownSize(int dbTag, int commitTag,
+        Message &,
+        ChannelAddress *theAddress = 0);
+
+    int sendMatrix(int dbTag, int commitTag,
+        const Matrix &theMatrix,
+        ChannelAddress *theAddress = 0);
+    int recvMatrix(int dbTag, int commitTag,
+        Matrix &theMatrix,
+        ChannelAddress *theAddress = 0);
+
+    int sendVector(int dbTag, int commitTag,
+        const Vector &theVector,
+        ChannelAddress *theAddress = 0);
+    int recvVector(int dbTag, int commitTag,
+        Vector &theVector,
+        ChannelAddress *theAddress = 0);
+
+    int sendv(int dbTag, int commitTag,
+        const Vector *const *theVectors, int numVectors,
+        ChannelAddress *theAddress = 0);
+    int recvv(int dbTag, int commitTag,
+        Vector *const *theVectors, int numVectors,
+        ChannelAddress *theAddress = 0);
+
+    int sendID(int dbTag, int commitTag,
+        const ID &theID,
+        ChannelAddress *theAddress = 0);
+    int recvID(int dbTag, int commitTag,
+        ID &theID,
+        ChannelAddress *theAddress = 0);
+
+private:
+    int checkAddress(ChannelAddress *theAddress, const char *method);
+    int write(const char *data, int nbytes);
+    int read(char *data, int nbytes);
+    void publish();
+    int waitForData();
+    int waitForSpace();
+    void unmap();
+
+    unsigned int port;      // port number the segment is named after
+    int connectType;        // 0 = creates the segment, 1 = connects to it
+    ChannelOptions options;
+
+    SHM_Segment *theSegment;    // mapped shared memory segment
+    SHM_Ring *sendRing;     // ring buffer written by this process
+    SHM_Ring *recvRing;     // ring buffer read by this process
+    char *sendBuf;          // data of the send ring
+    char *recvBuf;          // data of the recv ring
+    unsigned int sendHead;  // bytes written, published at the end of a message
+    unsigned int recvTail;  // bytes read
+
+#ifdef _WIN32
+    void *theMapping;
+#endif
+};
+
+#endif
@@ -147,6 +147,18 @@ Shadow::recvVector(Vector &theVector)
     return theChannel->recvVector(0, commitTag, theVector, theRemoteActorsAddress);
 }
 
+int
+Shadow::sendv(const Vector *const *theVectors, int numVectors)
+{
+    return theChannel->sendv(0, commitTag, theVectors, numVectors, theRemoteActorsAddress);
+}
+
+int
+Shadow::recvv(Vector *const *theVectors, int numVectors)
+{
+    return theChannel->recvv(0, commitTag, theVectors, numVectors, theRemoteActorsAddress);
+}
+
 int
 Shadow::sendID(const ID &theID)
 {
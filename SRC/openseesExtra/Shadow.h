@@ -73,6 +73,8 @@ class Shadow
     virtual int recvMatrix(Matrix &theMatrix);      
     virtual int sendVector(const Vector &theVector);  
     virtual int recvVector(Vector &theVector);      
+    virtual int sendv(const Vector *const *theVectors, int numVectors);
+    virtual int recvv(Vector *const *theVectors, int numVectors);
     virtual int sendID(const ID &theID);  
     virtual int recvID(ID &theID);      
     void setCommitTag(int commitTag);
@@ -55,6 +55,7 @@ extern "C" {
 
   #include <sys/socket.h>
   #include <sys/types.h>
+  #include <sys/uio.h>
   #include <sys/ioctl.h>
 
   #include <arpa/inet.h>
@@ -70,15 +71,23 @@ extern "C" {
 #define MAX_UDP_DATAGRAM 9126
 #define MAX_INET_ADDR 28
 
+#define MAX_IOV_SEGMENTS 16
+
 #ifdef _WIN32
   typedef SOCKET socket_type;
   typedef int socklen_type;
+  typedef WSABUF iovec_type;
+  #define IOV_BASE(iov) (iov).buf
+  #define IOV_LEN(iov) (iov).len
   #define bzero(s,n) memset((s),0,(n))
   #define bcopy(s,d,len) memcpy((d),(s),(len))
   #define bcmp(s1,s2,n) memcmp((s1),(s2),(n))
 #else
   typedef int socket_type;
   typedef socklen_t socklen_type;
+  typedef struct iovec iovec_type;
+  #define IOV_BASE(iov) (iov).iov_base
+  #define IOV_LEN(iov) (iov).iov_len
 #endif
 
 extern int startup_sockets(void);
@@ -46,6 +46,9 @@ static void inttoa(unsigned int no, char *string, int *cnt);
 static void byte_swap(void *array, long long nArray,int size);
 #endif
 
+static int writeSegments(socket_type sockfd, iovec_type *iov, int numIov, int nleft);
+static int readSegments(socket_type sockfd, iovec_type *iov, int numIov, int nleft);
+
 
 // TCP_Socket(unsigned int other_Port, char *other_InetAddr): 
 // 	constructor to open a socket with my inet_addr and with a port number 
@@ -198,6 +201,10 @@ TCP_Socket::setUpConnection()
 {
     if (connectType == 1) {
         
+        // apply the channel options before connecting so that the
+        // buffer sizes are used in the window negotiation
+        options.applyTo(sockfd, true);
+        
         // now try to connect to socket with remote address.
         if (connect(sockfd, &other_Addr.addr, sizeof(other_Addr.addr))< 0) {
             opserr << "TCP_Socket::setUpConnection() - could not connect\n";
@@ -214,6 +221,9 @@ TCP_Socket::setUpConnection()
                     << "could not set TCP_NODELAY option\n";
         }
         
+        // bind the receiving thread to the requested cpu
+        options.bindThread();
+        
         // check for endianness problem if requested
         if (checkEndianness) {
             int i = 1;
@@ -241,6 +251,7 @@ TCP_Socket::setUpConnection()
 
         // wait for other process to contact me & set up connection
         socket_type newsockfd;
+        options.applyTo(sockfd, true);
         listen(sockfd, 1);    
         newsockfd = accept(sockfd, &other_Addr.addr, &addrLength);
         if (newsockfd < 0) {
@@ -267,6 +278,10 @@ TCP_Socket::setUpConnection()
                     << "could not set TCP_NODELAY option\n";
         }
         
+        // apply the channel options to the accepted socket
+        options.applyTo(sockfd, true);
+        options.bindThread();
+        
         // check for endianness problem if requested
         if (checkEndianness) {
             int i;
@@ -293,6 +308,16 @@ TCP_Socket::setUpConnection()
 }    
 
 
+int
+TCP_Socket::setChannelOptions(const ChannelOptions &theOptions)
+{
+    // the options are applied when the connection is set up
+    options = theOptions;
+    
+    return 0;
+}
+
+
 int
 TCP_Socket::setNextAddress(const ChannelAddress &theAddress)
 {	
@@ -412,10 +437,12 @@ TCP_Socket::recvMsg(int dbTag, int commitTag,
     nleft = msg.length;
 
     while (nleft > 0) {
+        options.spinUntilReadable(sockfd);
         nread = recv(sockfd,gMsg,nleft,0);
         nleft -= nread;
         gMsg +=  nread;
     }
+    options.rearmQuickAck(sockfd);
 
     return 0;
 }
@@ -549,10 +576,12 @@ TCP_Socket::recvMatrix(int dbTag, int commitTag,
     nleft = theMatrix.dataSize * sizeof(double);
 
     while (nleft > 0) {
+        options.spinUntilReadable(sockfd);
         nread = recv(sockfd,gMsg,nleft,0);
         nleft -= nread;
         gMsg +=  nread;
     }
+    options.rearmQuickAck(sockfd);
 
 #ifndef _WIN32
     if (endiannessProblem) {
@@ -655,10 +684,12 @@ TCP_Socket::recvVector(int dbTag, int commitTag,
     nleft = theVector.sz * sizeof(double);
 
     while (nleft > 0) {
+        options.spinUntilReadable(sockfd);
         nread = recv(sockfd,gMsg,nleft,0);
         nleft -= nread;
         gMsg +=  nread;
     }
+    options.rearmQuickAck(sockfd);
 
 #ifndef _WIN32
     if (endiannessProblem) {
@@ -760,10 +791,12 @@ TCP_Socket::recvID(int dbTag, int commitTag,
     nleft = theID.sz * sizeof(int);
 
     while (nleft > 0) {
+        options.spinUntilReadable(sockfd);
         nread = recv(sockfd,gMsg,nleft,0);
         nleft -= nread;
         gMsg +=  nread;
     }
+    options.rearmQuickAck(sockfd);
 
 #ifndef _WIN32
     if (endiannessProblem) {
@@ -776,6 +809,109 @@ TCP_Socket::recvID(int dbTag, int commitTag,
 }
 
 
+// void sendv(Vector **):
+// 	Method to send the data of several Vectors as one message, the data
+//	is written with one system call straight from the Vectors.
+int 
+TCP_Socket::sendv(int dbTag, int commitTag,
+    const Vector *const *theVectors, int numVectors,
+    ChannelAddress *theAddress)
+{
+    // let the base class stage the data if an address needs to be
+    // checked or if there are more segments than can be written at once
+    if (theAddress != 0 || numVectors > MAX_IOV_SEGMENTS)
+        return this->Channel::sendv(dbTag, commitTag,
+            theVectors, numVectors, theAddress);
+
+    // set up the segments pointing to the data in the Vectors
+    iovec_type iov[MAX_IOV_SEGMENTS];
+    int i, numIov = 0, nleft = 0;
+    for (i=0; i<numVectors; i++) {
+        const Vector *theVector = theVectors[i];
+        if (theVector == 0 || theVector->sz == 0)
+            continue;
+        IOV_BASE(iov[numIov]) = (char *)theVector->theData;
+        IOV_LEN(iov[numIov]) = theVector->sz * sizeof(double);
+        nleft += theVector->sz * sizeof(double);
+        numIov++;
+    }
+
+#ifndef _WIN32
+    if (endiannessProblem) {
+        for (i=0; i<numVectors; i++) {
+            if (theVectors[i] != 0)
+                byte_swap((void *)theVectors[i]->theData, theVectors[i]->sz, sizeof(double));
+        }
+    }
+#endif
+
+    int res = writeSegments(sockfd, iov, numIov, nleft);
+
+#ifndef _WIN32
+    if (endiannessProblem) {
+        for (i=0; i<numVectors; i++) {
+            if (theVectors[i] != 0)
+                byte_swap((void *)theVectors[i]->theData, theVectors[i]->sz, sizeof(double));
+        }
+    }
+#endif
+
+    if (res < 0) {
+        opserr << "TCP_Socket::sendv() - could not send data\n";
+        return -1;
+    }
+
+    return 0;
+}
+
+
+// void recvv(Vector **):
+// 	Method to receive one message into several Vectors, the data
+//	is read with one system call straight into the Vectors.
+int 
+TCP_Socket::recvv(int dbTag, int commitTag,
+    Vector *const *theVectors, int numVectors,
+    ChannelAddress *theAddress)
+{
+    // let the base class stage the data if an address needs to be
+    // checked or if there are more segments than can be read at once
+    if (theAddress != 0 || numVectors > MAX_IOV_SEGMENTS)
+        return this->Channel::recvv(dbTag, commitTag,
+            theVectors, numVectors, theAddress);
+
+    // set up the segments pointing to the data in the Vectors
+    iovec_type iov[MAX_IOV_SEGMENTS];
+    int i, numIov = 0, nleft = 0;
+    for (i=0; i<numVectors; i++) {
+        Vector *theVector = theVectors[i];
+        if (theVector == 0 || theVector->sz == 0)
+            continue;
+        IOV_BASE(iov[numIov]) = (char *)theVector->theData;
+        IOV_LEN(iov[numIov]) = theVector->sz * sizeof(double);
+        nleft += theVector->sz * sizeof(double);
+        numIov++;
+    }
+
+    options.spinUntilReadable(sockfd);
+    if (readSegments(sockfd, iov, numIov, nleft) < 0) {
+        opserr << "TCP_Socket::recvv() - could not receive data\n";
+        return -1;
+    }
+    options.rearmQuickAck(sockfd);
+
+#ifndef _WIN32
+    if (endiannessProblem) {
+        for (i=0; i<numVectors; i++) {
+            if (theVectors[i] != 0)
+                byte_swap((void *)theVectors[i]->theData, theVectors[i]->sz, sizeof(double));
+        }
+    }
+#endif
+
+    return 0;
+}
+
+
 // void Send(ID &):
 // 	Method to send a ID to an address given by other_Addr.addr_in.
 int 
@@ -953,3 +1089,62 @@ byte_swap(void *array, long long nArray,int size)
     }
 }
 #endif
+
+
+static void advanceSegments(iovec_type *&iov, int &numIov, int nbytes)
+{
+    // drop the segments that are complete and move into the partial one
+    while (numIov > 0 && nbytes >= (int)IOV_LEN(*iov)) {
+        nbytes -= (int)IOV_LEN(*iov);
+        iov++;
+        numIov--;
+    }
+    if (numIov > 0 && nbytes > 0) {
+        IOV_BASE(*iov) = (char *)IOV_BASE(*iov) + nbytes;
+        IOV_LEN(*iov) -= nbytes;
+    }
+}
+
+
+static int writeSegments(socket_type sockfd, iovec_type *iov, int numIov, int nleft)
+{
+    int nwrite;
+    while (nleft > 0) {
+#ifdef _WIN32
+        DWORD nsent;
+        if (WSASend(sockfd, iov, numIov, &nsent, 0, NULL, NULL) != 0)
+            return -1;
+        nwrite = (int)nsent;
+#else
+        nwrite = (int)writev(sockfd, iov, numIov);
+        if (nwrite < 0)
+            return -1;
+#endif
+        nleft -= nwrite;
+        advanceSegments(iov, numIov, nwrite);
+    }
+
+    return 0;
+}
+
+
+static int readSegments(socket_type sockfd, iovec_type *iov, int numIov, int nleft)
+{
+    int nread;
+    while (nleft > 0) {
+#ifdef _WIN32
+        DWORD nrecv, flags = 0;
+        if (WSARecv(sockfd, iov, numIov, &nrecv, &flags, NULL, NULL) != 0)
+            return -1;
+        nread = (int)nrecv;
+#else
+        nread = (int)readv(sockfd, iov, numIov);
+#endif
+        if (nread <= 0)
+            return -1;
+        nleft -= nread;
+        advanceSegments(iov, numIov, nread);
+    }
+
+    return 0;
+}
@@ -37,6 +37,7 @@
 #include <bool.h>
 #include <Socket.h>
 #include <Channel.h>
+#include <ChannelOptions.h>
 
 class TCP_Socket : public Channel
 {
@@ -51,6 +52,7 @@ class TCP_Socket : public Channel
     char *addToProgram();
     
     virtual int setUpConnection();
+    virtual int setChannelOptions(const ChannelOptions &theOptions);
 
     int setNextAddress(const ChannelAddress &otherChannelAddress);
     virtual ChannelAddress *getLastSendersAddress(){ return 0;};
@@ -86,6 +88,13 @@ class TCP_Socket : public Channel
     int recvVector(int dbTag, int commitTag, 
 		   Vector &theVector, 
 		   ChannelAddress *theAddress =0);
+
+    int sendv(int dbTag, int commitTag, 
+	      const Vector *const *theVectors, int numVectors,
+	      ChannelAddress *theAddress =0);
+    int recvv(int dbTag, int commitTag, 
+	      Vector *const *theVectors, int numVectors,
+	      ChannelAddress *theAddress =0);
     
     int sendID(int dbTag, int commitTag, 
 	       const ID &theID, 
@@ -117,6 +126,7 @@ class TCP_Socket : public Channel
     bool checkEndianness;
     bool endiannessProblem;
     int noDelay;
+    ChannelOptions options;
 };
 
 #endif 
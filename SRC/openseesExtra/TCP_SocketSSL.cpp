@@ -306,6 +306,10 @@ TCP_SocketSSL::setUpConnection()
 {
     if (connectType == 1) {
         
+        // apply the channel options before connecting so that the
+        // buffer sizes are used in the window negotiation
+        options.applyTo(sockfd, true);
+        
         // now try to connect to socket with remote address.
         if (connect(sockfd, &other_Addr.addr, sizeof(other_Addr.addr))< 0) {
                 opserr << "TCP_SocketSSL::setUpConnection() - could not connect\n";
@@ -322,6 +326,9 @@ TCP_SocketSSL::setUpConnection()
                     << "could not set TCP_NODELAY option\n";
         }
         
+        // bind the receiving thread to the requested cpu
+        options.bindThread();
+        
         // initiate SSL handshake with server
         ssl = SSL_new(ctx);
         SSL_set_fd(ssl, (int)sockfd);
@@ -375,6 +382,7 @@ TCP_SocketSSL::setUpConnection()
 
         // wait for other process to contact me & set up connection
         socket_type newsockfd;
+        options.applyTo(sockfd, true);
         listen(sockfd, 1);    
         newsockfd = accept(sockfd, &other_Addr.addr, &addrLength);
         if (newsockfd < 0) {
@@ -401,6 +409,10 @@ TCP_SocketSSL::setUpConnection()
                     << "could not set TCP_NODELAY option\n";
         }
         
+        // apply the channel options to the accepted socket
+        options.applyTo(sockfd, true);
+        options.bindThread();
+        
         // initiate SSL handshake with client
         ssl = SSL_new(ctx);
         SSL_set_fd(ssl, (int)sockfd);
@@ -457,6 +469,16 @@ TCP_SocketSSL::setUpConnection()
 }
 
 
+int
+TCP_SocketSSL::setChannelOptions(const ChannelOptions &theOptions)
+{
+    // the options are applied when the connection is set up
+    options = theOptions;
+    
+    return 0;
+}
+
+
 int
 TCP_SocketSSL::setNextAddress(const ChannelAddress &theAddress)
 {	
@@ -588,6 +610,7 @@ TCP_SocketSSL::recvMsg(int dbTag, int commitTag,
         nleft -= nread;
         gMsg  += nread;
     }
+    options.rearmQuickAck(sockfd);
 
     return 0;
 }
@@ -743,6 +766,7 @@ TCP_SocketSSL::recvMatrix(int dbTag, int commitTag,
         nleft -= nread;
         gMsg  += nread;
     }
+    options.rearmQuickAck(sockfd);
 
 #ifndef _WIN32
     if (endiannessProblem) {
@@ -860,6 +884,7 @@ TCP_SocketSSL::recvVector(int dbTag, int commitTag,
         nleft -= nread;
         gMsg  += nread;
     }
+    options.rearmQuickAck(sockfd);
 
 #ifndef _WIN32
     if (endiannessProblem) {
@@ -976,6 +1001,7 @@ TCP_SocketSSL::recvID(int dbTag, int commitTag,
         nleft -= nread;
         gMsg  += nread;
     }
+    options.rearmQuickAck(sockfd);
 
 #ifndef _WIN32
     if (endiannessProblem) {
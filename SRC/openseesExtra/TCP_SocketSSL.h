@@ -37,6 +37,7 @@
 #include <bool.h>
 #include <Socket.h>
 #include <Channel.h>
+#include <ChannelOptions.h>
 
 #include <openssl/ssl.h>
 
@@ -62,6 +63,7 @@ public:
     char *addToProgram();
 
     virtual int setUpConnection();
+    virtual int setChannelOptions(const ChannelOptions &theOptions);
 
     int setNextAddress(const ChannelAddress &otherChannelAddress);
     virtual ChannelAddress *getLastSendersAddress(){ return 0;};
@@ -133,6 +135,7 @@ private:
     bool checkEndianness;
     bool endiannessProblem;
     int noDelay;
+    ChannelOptions options;
 };
 
 #endif 
@@ -33,9 +33,11 @@
 #include <Message.h>
 
 #include <TCP_Socket.h>
+#include <DataCodec.h>
 
 TCP_Stream::TCP_Stream()
-  :OPS_Stream(OPS_STREAM_TAGS_TCP_Stream), sendSize(0), data(1), theChannel(0) 
+  :OPS_Stream(OPS_STREAM_TAGS_TCP_Stream), sendSize(0), data(1), theChannel(0),
+   theCodec(0), codecBuf(0), codecBufSize(0)
 {
   theChannel = new TCP_Socket();
 }
@@ -44,7 +46,8 @@ TCP_Stream::TCP_Stream()
 TCP_Stream::TCP_Stream(unsigned int other_Port, 
 		       const char *other_InetAddr,
 		       bool checkEndianness)
-  :OPS_Stream(OPS_STREAM_TAGS_TCP_Stream), sendSize(0), data(1), theChannel(0) 
+  :OPS_Stream(OPS_STREAM_TAGS_TCP_Stream), sendSize(0), data(1), theChannel(0),
+   theCodec(0), codecBuf(0), codecBufSize(0)
 {
   theChannel = new TCP_Socket(other_Port, other_InetAddr, checkEndianness);
   if (theChannel->setUpConnection() < 0) {
@@ -57,9 +60,20 @@ TCP_Stream::TCP_Stream(unsigned int other_Port,
 
 TCP_Stream::~TCP_Stream()
 {
-  data(0) = -1;
-  if (theChannel != 0 && theChannel->sendVector(0,0, data) < 0)
-    opserr << "TCP_Stream - failed to send close signal\n";
+  if (theCodec != 0) {
+    char close[DataCodec::lengthSize];
+    DataCodec::putFrameLength(close, 0);
+    Message msg(close, DataCodec::lengthSize);
+    if (theChannel != 0 && theChannel->sendMsg(0,0, msg) < 0)
+      opserr << "TCP_Stream - failed to send close signal\n";
+    delete theCodec;
+    if (codecBuf != 0)
+      delete [] codecBuf;
+  } else {
+    data(0) = -1;
+    if (theChannel != 0 && theChannel->sendVector(0,0, data) < 0)
+      opserr << "TCP_Stream - failed to send close signal\n";
+  }
 
   if (theChannel != 0) 
     delete theChannel;
@@ -127,6 +141,24 @@ TCP_Stream::write(Vector &dataToSend)
   if (sizeToSend == 0 || theChannel == 0)
     return 0;
 
+  if (theCodec != 0) {
+    int bufSize = DataCodec::lengthSize + DataCodec::getMaxFrameSize(sizeToSend);
+    if (bufSize > codecBufSize) {
+      if (codecBuf != 0)
+	delete [] codecBuf;
+      codecBuf = new char[bufSize];
+      codecBufSize = bufSize;
+    }
+    int numBytes = theCodec->encode(dataToSend, &codecBuf[DataCodec::lengthSize]);
+    DataCodec::putFrameLength(codecBuf, numBytes);
+    Message msg(codecBuf, DataCodec::lengthSize+numBytes);
+    if (theChannel->sendMsg(0,0, msg) < 0) {
+      opserr << "TCP_Stream - failed to send data\n";
+      return -1;
+    }
+    return 0;
+  }
+
   if (sizeToSend != sendSize) {
     data(0) = sizeToSend;
     if (theChannel->sendVector(0, 0, data) < 0) {
@@ -274,3 +306,13 @@ TCP_Stream::recvSelf(int commitTag, Channel &theChannel, FEM_ObjectBroker &theBr
   return -1;
 }
 
+int
+TCP_Stream::setCodec(const DataCodec &codec)
+{
+  if (theCodec != 0)
+    delete theCodec;
+  theCodec = new DataCodec(codec);
+
+  return 0;
+}
+
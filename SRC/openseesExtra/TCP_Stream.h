@@ -31,6 +31,7 @@
 #include <OPS_Stream.h>
 #include <Vector.h>
 class TCP_Socket;
+class DataCodec;
 
 class TCP_Stream : public OPS_Stream
 {
@@ -80,11 +81,19 @@ class TCP_Stream : public OPS_Stream
     int sendSelf(int commitTag, Channel &theChannel);  
     int recvSelf(int commitTag, Channel &theChannel, 
 		 FEM_ObjectBroker &theBroker);
+
+    // send each vector as a DataCodec frame prefixed with its
+    // length, a frame length of zero closes the stream
+    int setCodec(const DataCodec &theCodec);
     
  private:
     int sendSize;
     Vector data;
     TCP_Socket *theChannel;
+
+    DataCodec *theCodec;
+    char *codecBuf;
+    int codecBufSize;
 };
 
 #endif
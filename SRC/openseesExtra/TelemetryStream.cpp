@@ -0,0 +1,839 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// $Revision$
+// $Date$
+// $URL$
+
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the implementation of
+// TelemetryStream.
+
+#include "TelemetryStream.h"
+#include <Vector.h>
+
+#ifndef _WIN32
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/time.h>
+#include <time.h>
+#endif
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+// maximum time the publisher thread sleeps before it checks
+// for new subscribers and the time it waits for a full socket
+#define TELEMETRY_POLL_MSEC 20
+#define TELEMETRY_SELECT_MSEC 2
+
+
+static bool isValidSocket(socket_type sockfd)
+{
+#ifdef _WIN32
+    return (sockfd != INVALID_SOCKET);
+#else
+    return (sockfd >= 0);
+#endif
+}
+
+
+static void closeSocket(socket_type sockfd)
+{
+#ifdef _WIN32
+    closesocket(sockfd);
+#else
+    ::close(sockfd);
+#endif
+}
+
+
+static int setNonBlocking(socket_type sockfd)
+{
+#ifdef _WIN32
+    u_long mode = 1;
+    return (ioctlsocket(sockfd, FIONBIO, &mode) == 0) ? 0 : -1;
+#else
+    int flags = fcntl(sockfd, F_GETFL, 0);
+    if (flags < 0)
+        return -1;
+    return fcntl(sockfd, F_SETFL, flags | O_NONBLOCK);
+#endif
+}
+
+
+static bool wouldBlock()
+{
+#ifdef _WIN32
+    return (WSAGetLastError() == WSAEWOULDBLOCK);
+#else
+    return (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR);
+#endif
+}
+
+
+TelemetryStream::TelemetryStream(unsigned int _port,
+    const char *_mcastAddr, int _bufferSize, int _decimation,
+    int _maxSubscribers)
+    : OPS_Stream(OPS_STREAM_TAGS_TelemetryStream),
+    port(_port), mcastAddr(0), bufferSize(_bufferSize),
+    decimation(_decimation), maxSubscribers(_maxSubscribers),
+    subscribers(0), numSubscribers(0), frameSize(0), numWrites(0),
+    seqNum(0), numPublished(0), numDropped(0), numRejected(0),
+    stopFlag(false), running(false)
+{
+    if (bufferSize < 1)
+        bufferSize = 1;
+    if (decimation < 1)
+        decimation = 1;
+    if (maxSubscribers < 1)
+        maxSubscribers = 1;
+    
+    if (_mcastAddr != 0)  {
+        mcastAddr = new char [strlen(_mcastAddr)+1];
+        strcpy(mcastAddr, _mcastAddr);
+        maxSubscribers = 1;
+    }
+    
+#ifdef _WIN32
+    sockfd = INVALID_SOCKET;
+    InitializeCriticalSection(&theMutex);
+    InitializeConditionVariable(&theCond);
+#else
+    sockfd = -1;
+    pthread_mutex_init(&theMutex, NULL);
+    pthread_cond_init(&theCond, NULL);
+#endif
+    
+    if (this->setupSockets() < 0)  {
+        opserr << "TelemetryStream::TelemetryStream() - "
+            << "failed to set up socket on port " << (int)port << endln;
+        return;
+    }
+    
+    this->startThread();
+}
+
+
+TelemetryStream::~TelemetryStream()
+{
+    this->stopThread();
+    
+    // close the sockets and collect the counters
+    while (numSubscribers > 0)
+        this->removeSubscriber(numSubscribers-1);
+    if (isValidSocket(sockfd))  {
+        closeSocket(sockfd);
+        cleanup_sockets();
+    }
+    if (subscribers != 0)
+        delete [] subscribers;
+    
+    if (numDropped > 0)  {
+        opserr << "TelemetryStream - published " << numPublished
+            << " frames, subscribers dropped " << numDropped
+            << " frames in total\n";
+    }
+    
+    if (mcastAddr != 0)
+        delete [] mcastAddr;
+    
+#ifdef _WIN32
+    DeleteCriticalSection(&theMutex);
+#else
+    pthread_cond_destroy(&theCond);
+    pthread_mutex_destroy(&theMutex);
+#endif
+}
+
+
+int TelemetryStream::setFile(const char *fileName, openMode mode)
+{
+    return 0;
+}
+
+
+int TelemetryStream::open(void)
+{
+    return 0;
+}
+
+
+int TelemetryStream::close(void)
+{
+    return 0;
+}
+
+
+int TelemetryStream::tag(const char *tagName)
+{
+    return 0;
+}
+
+
+int TelemetryStream::tag(const char *tagName, const char *value)
+{
+    return 0;
+}
+
+
+int TelemetryStream::endTag()
+{
+    return 0;
+}
+
+
+int TelemetryStream::attr(const char *name, int value)
+{
+    return 0;
+}
+
+
+int TelemetryStream::attr(const char *name, double value)
+{
+    return 0;
+}
+
+
+int TelemetryStream::attr(const char *name, const char *value)
+{
+    return 0;
+}
+
+
+int TelemetryStream::write(Vector &data)
+{
+    int n = data.Size();
+    if (n == 0 || !running)
+        return 0;
+    
+    // publish only every decimation-th vector
+    if (numWrites++ % decimation != 0)
+        return 0;
+    
+    this->lock();
+    
+    if (n+2 != frameSize)
+        this->resizeFrames(n+2);
+    
+    // copy the frame into the ring buffer of each subscriber,
+    // the oldest frame is dropped if the ring buffer is full
+    seqNum++;
+    for (int i=0; i<numSubscribers; i++)  {
+        Subscriber &s = subscribers[i];
+        if (s.count == bufferSize)  {
+            s.head = (s.head+1) % bufferSize;
+            s.count--;
+            s.numDropped++;
+        }
+        double *frame = &s.ring[((s.head+s.count) % bufferSize)*frameSize];
+        frame[0] = n;
+        frame[1] = seqNum;
+        for (int j=0; j<n; j++)
+            frame[j+2] = data(j);
+        s.count++;
+    }
+    numPublished++;
+    
+    this->unlock();
+    this->notify();
+    
+    return 0;
+}
+
+
+OPS_Stream& TelemetryStream::write(const char *s, int n)
+{
+    return *this;
+}
+
+
+OPS_Stream& TelemetryStream::write(const unsigned char *s, int n)
+{
+    return *this;
+}
+
+
+OPS_Stream& TelemetryStream::write(const signed char *s, int n)
+{
+    return *this;
+}
+
+
+OPS_Stream& TelemetryStream::write(const void *s, int n)
+{
+    return *this;
+}
+
+
+OPS_Stream& TelemetryStream::operator<<(char c)
+{
+    return *this;
+}
+
+
+OPS_Stream& TelemetryStream::operator<<(unsigned char c)
+{
+    return *this;
+}
+
+
+OPS_Stream& TelemetryStream::operator<<(signed char c)
+{
+    return *this;
+}
+
+
+OPS_Stream& TelemetryStream::operator<<(const char *s)
+{
+    return *this;
+}
+
+
+OPS_Stream& TelemetryStream::operator<<(const unsigned char *s)
+{
+    return *this;
+}
+
+
+OPS_Stream& TelemetryStream::operator<<(const signed char *s)
+{
+    return *this;
+}
+
+
+OPS_Stream& TelemetryStream::operator<<(const void *p)
+{
+    return *this;
+}
+
+
+OPS_Stream& TelemetryStream::operator<<(int n)
+{
+    return *this;
+}
+
+
+OPS_Stream& TelemetryStream::operator<<(unsigned int n)
+{
+    return *this;
+}
+
+
+OPS_Stream& TelemetryStream::operator<<(long n)
+{
+    return *this;
+}
+
+
+OPS_Stream& TelemetryStream::operator<<(unsigned long n)
+{
+    return *this;
+}
+
+
+OPS_Stream& TelemetryStream::operator<<(short n)
+{
+    return *this;
+}
+
+
+OPS_Stream& TelemetryStream::operator<<(unsigned short n)
+{
+    return *this;
+}
+
+
+OPS_Stream& TelemetryStream::operator<<(bool b)
+{
+    return *this;
+}
+
+
+OPS_Stream& TelemetryStream::operator<<(double n)
+{
+    return *this;
+}
+
+
+OPS_Stream& TelemetryStream::operator<<(float n)
+{
+    return *this;
+}
+
+
+int TelemetryStream::sendSelf(int commitTag, Channel &theChannel)
+{
+    return -1;
+}
+
+
+int TelemetryStream::recvSelf(int commitTag, Channel &theChannel,
+    FEM_ObjectBroker &theBroker)
+{
+    return -1;
+}
+
+
+int TelemetryStream::getNumSubscribers()
+{
+    this->lock();
+    int num = (mcastAddr == 0) ? numSubscribers : 0;
+    this->unlock();
+    
+    return num;
+}
+
+
+int TelemetryStream::getNumPublished()
+{
+    this->lock();
+    int num = numPublished;
+    this->unlock();
+    
+    return num;
+}
+
+
+int TelemetryStream::getNumDropped()
+{
+    this->lock();
+    int num = numDropped;
+    for (int i=0; i<numSubscribers; i++)
+        num += subscribers[i].numDropped;
+    this->unlock();
+    
+    return num;
+}
+
+
+void TelemetryStream::Print(OPS_Stream &s)
+{
+    this->lock();
+    s << "TelemetryStream on port " << (int)port;
+    if (mcastAddr != 0)
+        s << ", multicast group " << mcastAddr;
+    s << endln;
+    s << "  bufferSize: " << bufferSize << ", decimation: " << decimation
+        << ", maxSubscribers: " << maxSubscribers << endln;
+    s << "  published: " << numPublished << ", dropped by removed subscribers: "
+        << numDropped << ", rejected subscribers: " << numRejected << endln;
+    for (int i=0; i<numSubscribers; i++)  {
+        s << "  subscriber " << i << " - sent: " << subscribers[i].numSent
+            << ", dropped: " << subscribers[i].numDropped
+            << ", queued: " << subscribers[i].count << endln;
+    }
+    this->unlock();
+}
+
+
+int TelemetryStream::setupSockets()
+{
+    startup_sockets();
+    
+    subscribers = new Subscriber [maxSubscribers];
+    
+    int on = 1;
+    struct sockaddr_in myAddr;
+    memset(&myAddr, 0, sizeof(myAddr));
+    myAddr.sin_family = AF_INET;
+    myAddr.sin_addr.s_addr = htonl(INADDR_ANY);
+    myAddr.sin_port = htons(port);
+    
+    if (mcastAddr == 0)  {
+        // listening socket for the TCP subscribers
+        sockfd = socket(AF_INET, SOCK_STREAM, 0);
+        if (!isValidSocket(sockfd))  {
+            cleanup_sockets();
+            return -1;
+        }
+        setsockopt(sockfd, SOL_SOCKET, SO_REUSEADDR, (char *) &on, sizeof(on));
+        if (bind(sockfd, (struct sockaddr *) &myAddr, sizeof(myAddr)) < 0 ||
+            listen(sockfd, maxSubscribers) < 0 || setNonBlocking(sockfd) < 0)  {
+            closeSocket(sockfd);
+            cleanup_sockets();
+#ifdef _WIN32
+            sockfd = INVALID_SOCKET;
+#else
+            sockfd = -1;
+#endif
+            return -1;
+        }
+    } else  {
+        // UDP socket sending to the multicast group, the group is
+        // the only subscriber and datagrams stay on the local subnet
+        memset(&groupAddr, 0, sizeof(groupAddr));
+        groupAddr.sin_family = AF_INET;
+        groupAddr.sin_addr.s_addr = inet_addr(mcastAddr);
+        groupAddr.sin_port = htons(port);
+        if (!IN_MULTICAST(ntohl(groupAddr.sin_addr.s_addr)))  {
+            opserr << "TelemetryStream::setupSockets() - "
+                << mcastAddr << " is not a multicast address\n";
+            cleanup_sockets();
+            return -1;
+        }
+        sockfd = socket(AF_INET, SOCK_DGRAM, 0);
+        if (!isValidSocket(sockfd))  {
+            cleanup_sockets();
+            return -1;
+        }
+#ifdef _WIN32
+        int ttl = 1;
+#else
+        unsigned char ttl = 1;
+#endif
+        setsockopt(sockfd, IPPROTO_IP, IP_MULTICAST_TTL, (char *) &ttl, sizeof(ttl));
+        setNonBlocking(sockfd);
+        this->addSubscriber(sockfd);
+    }
+    
+    return 0;
+}
+
+
+int TelemetryStream::addSubscriber(socket_type fd)
+{
+    if (numSubscribers >= maxSubscribers)
+        return -1;
+    
+    Subscriber &s = subscribers[numSubscribers];
+    s.sockfd = fd;
+    s.ring = (frameSize > 0) ? new double [bufferSize*frameSize] : 0;
+    s.head = 0;
+    s.count = 0;
+    s.sendBuf = 0;
+    s.sendCap = 0;
+    s.sendLen = 0;
+    s.sendPos = 0;
+    s.numSent = 0;
+    s.numDropped = 0;
+    numSubscribers++;
+    
+    return 0;
+}
+
+
+void TelemetryStream::removeSubscriber(int i)
+{
+    Subscriber &s = subscribers[i];
+    
+    // the frames that are still queued are lost as well
+    numDropped += s.numDropped + s.count;
+    if (s.sendLen > 0)
+        numDropped++;
+    if (mcastAddr == 0)
+        closeSocket(s.sockfd);
+    if (s.ring != 0)
+        delete [] s.ring;
+    if (s.sendBuf != 0)
+        delete [] s.sendBuf;
+    
+    numSubscribers--;
+    if (i < numSubscribers)
+        subscribers[i] = subscribers[numSubscribers];
+}
+
+
+int TelemetryStream::resizeFrames(int size)
+{
+    // called with the lock held, the queued frames of the old size
+    // are dropped, the send buffers belong to the publisher thread
+    for (int i=0; i<numSubscribers; i++)  {
+        Subscriber &s = subscribers[i];
+        if (s.ring != 0)
+            delete [] s.ring;
+        s.ring = new double [bufferSize*size];
+        s.numDropped += s.count;
+        s.head = 0;
+        s.count = 0;
+    }
+    frameSize = size;
+    
+    if (mcastAddr != 0 && frameSize*(int)sizeof(double) > MAX_UDP_DATAGRAM)  {
+        opserr << "WARNING TelemetryStream::write() - frames of "
+            << frameSize << " doubles exceed the maximum datagram size\n";
+    }
+    
+    return 0;
+}
+
+
+void TelemetryStream::acceptSubscribers()
+{
+    // accept all pending connections without blocking
+    while (true)  {
+        struct sockaddr_in otherAddr;
+        socklen_type addrLen = sizeof(otherAddr);
+        socket_type fd = accept(sockfd, (struct sockaddr *) &otherAddr, &addrLen);
+        if (!isValidSocket(fd))
+            return;
+        
+        int on = 1;
+        if (setNonBlocking(fd) < 0)  {
+            closeSocket(fd);
+            continue;
+        }
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, (char *) &on, sizeof(on));
+#ifdef SO_NOSIGPIPE
+        setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, (char *) &on, sizeof(on));
+#endif
+        
+        this->lock();
+        int rValue = this->addSubscriber(fd);
+        if (rValue < 0)
+            numRejected++;
+        this->unlock();
+        if (rValue < 0)
+            closeSocket(fd);
+    }
+}
+
+
+int TelemetryStream::sendFrames()
+{
+    // only the publisher thread adds and removes subscribers and uses
+    // the send buffers, the lock is only needed to take the frames
+    // from the ring buffers and to update the counters
+    fd_set writeSet;
+    FD_ZERO(&writeSet);
+    int numBlocked = 0;
+    socket_type maxfd = 0;
+    
+    int i = 0;
+    while (i < numSubscribers)  {
+        Subscriber &s = subscribers[i];
+        bool failed = false;
+        
+        while (true)  {
+            // take the next frame from the ring buffer
+            if (s.sendLen == 0)  {
+                this->lock();
+                if (s.count > 0)  {
+                    int len = frameSize*sizeof(double);
+                    if (s.sendCap < len)  {
+                        if (s.sendBuf != 0)
+                            delete [] s.sendBuf;
+                        s.sendBuf = new char [len];
+                        s.sendCap = len;
+                    }
+                    memcpy(s.sendBuf, &s.ring[s.head*frameSize], len);
+                    s.head = (s.head+1) % bufferSize;
+                    s.count--;
+                    s.sendLen = len;
+                    s.sendPos = 0;
+                }
+                this->unlock();
+                if (s.sendLen == 0)
+                    break;
+            }
+            
+            if (mcastAddr != 0)  {
+                // a datagram that cannot be sent right away is dropped
+                int n = sendto(s.sockfd, s.sendBuf, s.sendLen, 0,
+                    (struct sockaddr *) &groupAddr, sizeof(groupAddr));
+                this->lock();
+                if (n == s.sendLen)
+                    s.numSent++;
+                else
+                    s.numDropped++;
+                this->unlock();
+                s.sendLen = 0;
+            } else  {
+                int n = send(s.sockfd, s.sendBuf+s.sendPos, s.sendLen, MSG_NOSIGNAL);
+                if (n > 0)  {
+                    s.sendPos += n;
+                    s.sendLen -= n;
+                    if (s.sendLen == 0)  {
+                        this->lock();
+                        s.numSent++;
+                        this->unlock();
+                    }
+                } else if (n < 0 && wouldBlock())  {
+                    // the viewer is too slow, the ring buffer takes
+                    // the new frames until the socket is writable
+                    FD_SET(s.sockfd, &writeSet);
+                    if (s.sockfd > maxfd)
+                        maxfd = s.sockfd;
+                    numBlocked++;
+                    break;
+                } else  {
+                    failed = true;
+                    break;
+                }
+            }
+        }
+        
+        if (failed)  {
+            // the viewer disconnected
+            this->lock();
+            this->removeSubscriber(i);
+            this->unlock();
+        } else  {
+            i++;
+        }
+    }
+    
+    // wait a little for one of the full sockets to become writable
+    if (numBlocked > 0)  {
+        struct timeval timeout = {0, 1000*TELEMETRY_SELECT_MSEC};
+        select((int)maxfd+1, NULL, &writeSet, NULL, &timeout);
+    }
+    
+    return numBlocked;
+}
+
+
+int TelemetryStream::startThread()
+{
+    stopFlag = false;
+    running = true;
+    
+#ifdef _WIN32
+    theThread = CreateThread(NULL, 0, threadFunc, this, 0, NULL);
+    if (theThread == NULL)  {
+        opserr << "TelemetryStream::startThread() - "
+            << "could not create publisher thread\n";
+        running = false;
+        return -1;
+    }
+#else
+    if (pthread_create(&theThread, NULL, threadFunc, this) != 0)  {
+        opserr << "TelemetryStream::startThread() - "
+            << "could not create publisher thread\n";
+        running = false;
+        return -1;
+    }
+#endif
+    
+    return 0;
+}
+
+
+void TelemetryStream::stopThread()
+{
+    if (!running)
+        return;
+    
+    this->lock();
+    stopFlag = true;
+    this->unlock();
+    this->notify();
+    
+#ifdef _WIN32
+    WaitForSingleObject(theThread, INFINITE);
+    CloseHandle(theThread);
+    theThread = NULL;
+#else
+    pthread_join(theThread, NULL);
+#endif
+    
+    running = false;
+}
+
+
+#ifdef _WIN32
+DWORD WINAPI TelemetryStream::threadFunc(LPVOID arg)
+{
+    ((TelemetryStream *)arg)->runThread();
+    return 0;
+}
+#else
+void *TelemetryStream::threadFunc(void *arg)
+{
+    ((TelemetryStream *)arg)->runThread();
+    return 0;
+}
+#endif
+
+
+void TelemetryStream::runThread()
+{
+    int numBlocked = 0;
+    
+    this->lock();
+    while (!stopFlag)  {
+        // sleep until new frames arrive unless frames are queued
+        bool queued = (numBlocked > 0);
+        for (int i=0; i<numSubscribers && !queued; i++)
+            queued = (subscribers[i].count > 0);
+        if (!queued)
+            this->wait(TELEMETRY_POLL_MSEC);
+        if (stopFlag)
+            break;
+        this->unlock();
+        
+        if (mcastAddr == 0)
+            this->acceptSubscribers();
+        numBlocked = this->sendFrames();
+        
+        this->lock();
+    }
+    this->unlock();
+}
+
+
+void TelemetryStream::lock()
+{
+#ifdef _WIN32
+    EnterCriticalSection(&theMutex);
+#else
+    pthread_mutex_lock(&theMutex);
+#endif
+}
+
+
+void TelemetryStream::unlock()
+{
+#ifdef _WIN32
+    LeaveCriticalSection(&theMutex);
+#else
+    pthread_mutex_unlock(&theMutex);
+#endif
+}
+
+
+void TelemetryStream::notify()
+{
+#ifdef _WIN32
+    WakeAllConditionVariable(&theCond);
+#else
+    pthread_cond_broadcast(&theCond);
+#endif
+}
+
+
+void TelemetryStream::wait(int msec)
+{
+#ifdef _WIN32
+    SleepConditionVariableCS(&theCond, &theMutex, msec);
+#else
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    struct timespec until;
+    long nsec = 1000L*now.tv_usec + 1000000L*msec;
+    until.tv_sec = now.tv_sec + nsec/1000000000L;
+    until.tv_nsec = nsec % 1000000000L;
+    pthread_cond_timedwait(&theCond, &theMutex, &until);
+#endif
+}
@@ -0,0 +1,178 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// $Revision$
+// $Date$
+// $URL$
+
+#ifndef TelemetryStream_h
+#define TelemetryStream_h
+
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the class definition for
+// TelemetryStream. TelemetryStream is an output stream that publishes
+// the vectors written by a recorder to many live viewers without ever
+// blocking the thread that writes them. write() only copies the frame
+// into a ring buffer of each subscriber (dropping the oldest frame if
+// the buffer is full) and a publisher thread does all the network I/O
+// with non-blocking sockets. Viewers either connect with TCP to the
+// given port (up to maxSubscribers at a time) or, if a multicast group
+// address is given, join that group and receive one UDP datagram per
+// frame. Each frame consists of doubles in native byte order:
+// [n, sequenceNumber, data(0), ..., data(n-1)], so that a viewer can
+// detect dropped frames from gaps in the sequence numbers. With a
+// decimation of m only every m-th vector is published.
+
+#include <OPS_Stream.h>
+#include <Socket.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+class Vector;
+
+class TelemetryStream : public OPS_Stream
+{
+public:
+    // constructors
+    TelemetryStream(unsigned int port, const char *mcastAddr = 0,
+        int bufferSize = 64, int decimation = 1, int maxSubscribers = 8);
+
+    // destructor
+    ~TelemetryStream();
+
+    int setFile(const char *fileName, openMode mode = OVERWRITE);
+    int open(void);
+    int close(void);
+
+    // xml stuff
+    int tag(const char *);
+    int tag(const char *, const char *);
+    int endTag();
+    int attr(const char *name, int value);
+    int attr(const char *name, double value);
+    int attr(const char *name, const char *value);
+    int write(Vector &data);
+
+    // regular stuff
+    OPS_Stream& write(const char *s, int n);
+    OPS_Stream& write(const unsigned char *s, int n);
+    OPS_Stream& write(const signed char *s, int n);
+    OPS_Stream& write(const void *s, int n);
+    OPS_Stream& operator<<(char c);
+    OPS_Stream& operator<<(unsigned char c);
+    OPS_Stream& operator<<(signed char c);
+    OPS_Stream& operator<<(const char *s);
+    OPS_Stream& operator<<(const unsigned char *s);
+    OPS_Stream& operator<<(const signed char *s);
+    OPS_Stream& operator<<(const void *p);
+    OPS_Stream& operator<<(int n);
+    OPS_Stream& operator<<(unsigned int n);
+    OPS_Stream& operator<<(long n);
+    OPS_Stream& operator<<(unsigned long n);
+    OPS_Stream& operator<<(short n);
+    OPS_Stream& operator<<(unsigned short n);
+    OPS_Stream& operator<<(bool b);
+    OPS_Stream& operator<<(double n);
+    OPS_Stream& operator<<(float n);
+
+    int sendSelf(int commitTag, Channel &theChannel);
+    int recvSelf(int commitTag, Channel &theChannel,
+        FEM_ObjectBroker &theBroker);
+
+    // methods to get the counters
+    int getNumSubscribers();
+    int getNumPublished();
+    int getNumDropped();
+
+    // method to print the counters
+    void Print(OPS_Stream &s);
+
+private:
+    struct Subscriber {
+        socket_type sockfd;
+        double *ring;       // bufferSize frames of frameSize doubles
+        int head;           // index of the oldest frame
+        int count;          // number of frames in the ring
+        char *sendBuf;      // frame that is currently being sent
+        int sendCap;        // capacity of the send buffer in bytes
+        int sendLen;        // bytes of the frame that are left to send
+        int sendPos;        // bytes of the frame that have been sent
+        int numSent;        // number of frames sent
+        int numDropped;     // number of frames dropped
+    };
+
+    int setupSockets();
+    int addSubscriber(socket_type sockfd);
+    void removeSubscriber(int i);
+    int resizeFrames(int size);
+    void acceptSubscribers();
+    int sendFrames();
+    int startThread();
+    void stopThread();
+    void runThread();
+    void lock();
+    void unlock();
+    void notify();
+    void wait(int msec);
+
+#ifdef _WIN32
+    static DWORD WINAPI threadFunc(LPVOID arg);
+#else
+    static void *threadFunc(void *arg);
+#endif
+
+    unsigned int port;      // port to listen on or of multicast group
+    char *mcastAddr;        // multicast group address (0 = TCP)
+    int bufferSize;         // number of frames buffered per subscriber
+    int decimation;         // publish every decimation-th vector
+    int maxSubscribers;     // maximum number of TCP subscribers
+
+    socket_type sockfd;     // listening TCP or multicast UDP socket
+    struct sockaddr_in groupAddr;   // address of the multicast group
+    Subscriber *subscribers;        // array of subscribers
+    int numSubscribers;     // number of connected subscribers
+    int frameSize;          // number of doubles in a frame
+    int numWrites;          // number of vectors written
+    int seqNum;             // sequence number of the last frame
+    int numPublished;       // number of frames published
+    int numDropped;         // frames dropped by removed subscribers
+    int numRejected;        // subscribers rejected because of the limit
+    bool stopFlag;          // flag to stop the thread
+    bool running;           // flag if the thread is running
+
+#ifdef _WIN32
+    HANDLE theThread;
+    CRITICAL_SECTION theMutex;
+    CONDITION_VARIABLE theCond;
+#else
+    pthread_t theThread;
+    pthread_mutex_t theMutex;
+    pthread_cond_t theCond;
+#endif
+};
+
+#endif
@@ -192,6 +192,10 @@ UDP_Socket::~UDP_Socket()
 int 
 UDP_Socket::setUpConnection()
 {
+    // apply the channel options
+    options.applyTo(sockfd, false);
+    options.bindThread();
+    
     if (connectType == 1) {
         
         // send a message to address
@@ -260,6 +264,16 @@ UDP_Socket::setUpConnection()
 }    
 
 
+int
+UDP_Socket::setChannelOptions(const ChannelOptions &theOptions)
+{
+    // the options are applied when the connection is set up
+    options = theOptions;
+    
+    return 0;
+}
+
+
 int
 UDP_Socket::setNextAddress(const ChannelAddress &theAddress)
 {	
@@ -357,6 +371,7 @@ UDP_Socket::recvMsg(int dbTag, int commitTag,
     size = msg.length;
     
     while (size > 0) {
+        options.spinUntilReadable(sockfd);
         if (size <= MAX_UDP_DATAGRAM) {
             recvfrom(sockfd, gMsg, size, 0, &other_Addr.addr, &addrLength);
             size = 0;
@@ -461,6 +476,7 @@ UDP_Socket::recvMatrix(int dbTag, int commitTag,
     size = theMatrix.dataSize * sizeof(double);
     
     while (size > 0) {
+        options.spinUntilReadable(sockfd);
         if (size <= MAX_UDP_DATAGRAM) {
             recvfrom(sockfd, gMsg, size, 0, &other_Addr.addr, &addrLength);
             size = 0;
@@ -577,6 +593,7 @@ UDP_Socket::recvVector(int dbTag, int commitTag,
     size = theVector.sz * sizeof(double);
     
     while (size > 0) {
+        options.spinUntilReadable(sockfd);
         if (size <= MAX_UDP_DATAGRAM) {
             recvfrom(sockfd, gMsg, size, 0, &other_Addr.addr, &addrLength);
             size = 0;
@@ -693,6 +710,7 @@ UDP_Socket::recvID(int dbTag, int commitTag,
     size = theID.sz * sizeof(int);
     
     while (size > 0) {
+        options.spinUntilReadable(sockfd);
         if (size <= MAX_UDP_DATAGRAM) {
             recvfrom(sockfd, gMsg, size, 0, &other_Addr.addr, &addrLength);
             size = 0;
@@ -738,6 +756,145 @@ UDP_Socket::recvID(int dbTag, int commitTag,
 }
 
 
+int
+UDP_Socket::sendv(int dbTag, int commitTag,
+    const Vector *const *theVectors, int numVectors,
+    ChannelAddress *theAddress)
+{
+    // set up the segments pointing to the data in the Vectors
+    iovec_type iov[MAX_IOV_SEGMENTS];
+    int i, numIov = 0, size = 0;
+    if (numVectors <= MAX_IOV_SEGMENTS) {
+        for (i=0; i<numVectors; i++) {
+            const Vector *theVector = theVectors[i];
+            if (theVector == 0 || theVector->sz == 0)
+                continue;
+            IOV_BASE(iov[numIov]) = (char *)theVector->theData;
+            IOV_LEN(iov[numIov]) = theVector->sz * sizeof(double);
+            size += theVector->sz * sizeof(double);
+            numIov++;
+        }
+    }
+    
+    // let the base class stage the data if the message does not
+    // fit into one datagram or an address is given
+    if (theAddress != 0 || numVectors > MAX_IOV_SEGMENTS ||
+        size > MAX_UDP_DATAGRAM)
+        return this->Channel::sendv(dbTag, commitTag,
+            theVectors, numVectors, theAddress);
+    
+#ifndef _WIN32
+    if (endiannessProblem) {
+        for (i=0; i<numVectors; i++) {
+            if (theVectors[i] != 0)
+                byte_swap((void *)theVectors[i]->theData, theVectors[i]->sz, sizeof(double));
+        }
+    }
+#endif
+    
+    // send the segments as one datagram
+    int nsent;
+#ifdef _WIN32
+    DWORD nbytes;
+    if (WSASendTo(sockfd, iov, numIov, &nbytes, 0, &other_Addr.addr,
+        addrLength, NULL, NULL) != 0)
+        nsent = -1;
+    else
+        nsent = (int)nbytes;
+#else
+    struct msghdr msg;
+    bzero((char *) &msg, sizeof(msg));
+    msg.msg_name = &other_Addr.addr;
+    msg.msg_namelen = addrLength;
+    msg.msg_iov = iov;
+    msg.msg_iovlen = numIov;
+    nsent = (int)sendmsg(sockfd, &msg, 0);
+#endif
+    
+#ifndef _WIN32
+    if (endiannessProblem) {
+        for (i=0; i<numVectors; i++) {
+            if (theVectors[i] != 0)
+                byte_swap((void *)theVectors[i]->theData, theVectors[i]->sz, sizeof(double));
+        }
+    }
+#endif
+    
+    if (nsent != size) {
+        opserr << "UDP_Socket::sendv() - could not send data\n";
+        return -1;
+    }
+    
+    return 0;
+}
+
+
+int
+UDP_Socket::recvv(int dbTag, int commitTag,
+    Vector *const *theVectors, int numVectors,
+    ChannelAddress *theAddress)
+{
+    // set up the segments pointing to the data in the Vectors
+    iovec_type iov[MAX_IOV_SEGMENTS];
+    int i, numIov = 0, size = 0;
+    if (numVectors <= MAX_IOV_SEGMENTS) {
+        for (i=0; i<numVectors; i++) {
+            Vector *theVector = theVectors[i];
+            if (theVector == 0 || theVector->sz == 0)
+                continue;
+            IOV_BASE(iov[numIov]) = (char *)theVector->theData;
+            IOV_LEN(iov[numIov]) = theVector->sz * sizeof(double);
+            size += theVector->sz * sizeof(double);
+            numIov++;
+        }
+    }
+    
+    // let the base class stage the data if the message does not
+    // fit into one datagram or an address needs to be checked
+    if (theAddress != 0 || numVectors > MAX_IOV_SEGMENTS ||
+        size > MAX_UDP_DATAGRAM)
+        return this->Channel::recvv(dbTag, commitTag,
+            theVectors, numVectors, theAddress);
+    
+    // receive one datagram into the segments
+    int nrecv;
+    options.spinUntilReadable(sockfd);
+#ifdef _WIN32
+    DWORD nbytes, flags = 0;
+    if (WSARecvFrom(sockfd, iov, numIov, &nbytes, &flags, &other_Addr.addr,
+        &addrLength, NULL, NULL) != 0)
+        nrecv = -1;
+    else
+        nrecv = (int)nbytes;
+#else
+    struct msghdr msg;
+    bzero((char *) &msg, sizeof(msg));
+    msg.msg_name = &other_Addr.addr;
+    msg.msg_namelen = addrLength;
+    msg.msg_iov = iov;
+    msg.msg_iovlen = numIov;
+    nrecv = (int)recvmsg(sockfd, &msg, 0);
+    addrLength = msg.msg_namelen;
+#endif
+    
+    if (nrecv != size) {
+        opserr << "UDP_Socket::recvv() - could not receive data\n";
+        return -1;
+    }
+    
+#ifndef _WIN32
+    if (endiannessProblem) {
+        for (i=0; i<numVectors; i++) {
+            if (theVectors[i] != 0)
+                byte_swap((void *)theVectors[i]->theData, theVectors[i]->sz, sizeof(double));
+        }
+    }
+#endif
+    
+    return 0;
+}
+
+
 int
 UDP_Socket::sendID(int dbTag, int commitTag,
     const ID &theID, ChannelAddress *theAddress)
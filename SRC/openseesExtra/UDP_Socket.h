@@ -37,6 +37,7 @@
 #include <bool.h>
 #include <Socket.h>
 #include <Channel.h>
+#include <ChannelOptions.h>
 
 class UDP_Socket : public Channel
 {
@@ -50,6 +51,7 @@ class UDP_Socket : public Channel
     char *addToProgram();
     
     virtual int setUpConnection();
+    virtual int setChannelOptions(const ChannelOptions &theOptions);
 
     int setNextAddress(const ChannelAddress &otherChannelAddress);
     virtual ChannelAddress *getLastSendersAddress(){ return 0;};
@@ -84,6 +86,13 @@ class UDP_Socket : public Channel
     int recvVector(int dbTag, int commitTag, 
 		   Vector &theVector, 
 		   ChannelAddress *theAddress =0);
+
+    int sendv(int dbTag, int commitTag, 
+	      const Vector *const *theVectors, int numVectors,
+	      ChannelAddress *theAddress =0);
+    int recvv(int dbTag, int commitTag, 
+	      Vector *const *theVectors, int numVectors,
+	      ChannelAddress *theAddress =0);
     
     int sendID(int dbTag, int commitTag, 
 	       const ID &theID, 
@@ -114,6 +123,7 @@ class UDP_Socket : public Channel
     int connectType;
     bool checkEndianness;
     bool endiannessProblem;
+    ChannelOptions options;
 };
 
 #endif 
@@ -49,6 +49,11 @@
 #define recvdata_ RECVDATA
 #define recvnbdata_ RECVNBDATA
 #define getsocketid_ GETSOCKETID
+#define queuedata_ QUEUEDATA
+#define flushdata_ FLUSHDATA
+#define recvbatchdata_ RECVBATCHDATA
+#define queuematrix_ QUEUEMATRIX
+#define getmatrix_ GETMATRIX
 #elif defined(F77_NAME_LOWER_2USCORE)
 #define setupconnectionserver_ setupconnectionserver__
 #define setupconnectionclient_ setupconnectionclient__
@@ -58,6 +63,11 @@
 #define recvdata_ recvdata__
 #define recvnbdata_ recvnbdata__
 #define getsocketid_ getsocketid__
+#define queuedata_ queuedata__
+#define flushdata_ flushdata__
+#define recvbatchdata_ recvbatchdata__
+#define queuematrix_ queuematrix__
+#define getmatrix_ getmatrix__
 #elif !defined(F77_NAME_LOWER_USCORE)
 #define setupconnectionserver_ setupconnectionserver
 #define setupconnectionclient_ setupconnectionclient
@@ -67,6 +77,11 @@
 #define recvdata_ recvdata
 #define recvnbdata_ recvnbdata
 #define getsocketid_ getsocketid
+#define queuedata_ queuedata
+#define flushdata_ flushdata
+#define recvbatchdata_ recvbatchdata
+#define queuematrix_ queuematrix
+#define getmatrix_ getmatrix
 /* F77_NAME_LOWER_USCORE */
 /* Else leave name alone */
 #endif
@@ -89,6 +104,11 @@ void sendnbdata(int *socketID, int *dataTypeSize, char data[], int *lenData, int
 void recvdata(int *socketID, int *dataTypeSize, char data[], int *lenData, int *ierr);
 void recvnbdata(int *socketID, int *dataTypeSize, char data[], int *lenData, int *ierr);
 void getsocketid(unsigned int *port, const char machineInetAddr[], int *lengthInet, int *socketID);
+void queuedata(int *socketID, double data[], int *lenData, int *ierr);
+void flushdata(int *socketID, int *numReplies, int *ierr);
+void recvbatchdata(int *socketID, double data[], int *lenData, int *ierr);
+void queuematrix(int *socketID, int *matrixType, int *ndf, int *lenData, int *ierr);
+void getmatrix(int *socketID, int *matrixType, int *ndf, double data[], int *lenData, int *ierr);
 
 #ifdef  __cplusplus
 extern "C" {
@@ -127,6 +147,26 @@ void FORT_CALL getsocketid_ (unsigned int *port, CHNAME(machineInetAddr), int *l
 	  getsocketid(port, machineInetAddr, lengthInet, socketID);
 }
 
+void FORT_CALL queuedata_ (int *socketID, double data[], int *lenData, int *ierr) {
+    queuedata(socketID, data, lenData, ierr);
+}
+
+void FORT_CALL flushdata_ (int *socketID, int *numReplies, int *ierr) {
+    flushdata(socketID, numReplies, ierr);
+}
+
+void FORT_CALL recvbatchdata_ (int *socketID, double data[], int *lenData, int *ierr) {
+    recvbatchdata(socketID, data, lenData, ierr);
+}
+
+void FORT_CALL queuematrix_ (int *socketID, int *matrixType, int *ndf, int *lenData, int *ierr) {
+    queuematrix(socketID, matrixType, ndf, lenData, ierr);
+}
+
+void FORT_CALL getmatrix_ (int *socketID, int *matrixType, int *ndf, double data[], int *lenData, int *ierr) {
+    getmatrix(socketID, matrixType, ndf, data, lenData, ierr);
+}
+
 #ifdef  __cplusplus
 }
 #endif
@@ -0,0 +1,165 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// $Revision$
+// $Date$
+// $Source: $
+
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains a benchmark client for the
+// openFrescoClient library. It connects to one or more
+// SimAppSiteServers (on consecutive ports), runs a number of steps
+// with a harmonic displacement history and reports the throughput
+// and the per-step latency percentiles.
+//
+// usage: benchClient ipAddr ipPort numSites numDOF numSteps
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#include "openFrescoClient.h"
+
+
+static double getTime()
+{
+#ifdef _WIN32
+    LARGE_INTEGER freq, count;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&count);
+    return (double)count.QuadPart/(double)freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + 1.0E-9*ts.tv_nsec;
+#endif
+}
+
+
+static int compareDouble(const void *a, const void *b)
+{
+    double da = *(const double *)a;
+    double db = *(const double *)b;
+    return (da > db) - (da < db);
+}
+
+
+int main(int argc, char **argv)
+{
+    OF_Client **clients;
+    const double **ctrl;
+    double **daq, *ctrlData, *daqData, *lat;
+    int sizeCtrl[OF_CLIENT_ALL], sizeDaq[OF_CLIENT_ALL];
+    int numSites = 1, numDOF = 1, numSteps = 1000;
+    int i, j, k;
+    unsigned int port;
+    double t0, t1, tStart, tTotal;
+
+    if (argc < 3) {
+        fprintf(stderr,"usage: benchClient ipAddr ipPort <numSites> <numDOF> <numSteps>\n");
+        return -1;
+    }
+    port = (unsigned int)atoi(argv[2]);
+    if (argc > 3)
+        numSites = atoi(argv[3]);
+    if (argc > 4)
+        numDOF = atoi(argv[4]);
+    if (argc > 5)
+        numSteps = atoi(argv[5]);
+    if (numSites < 1 || numDOF < 1 || numSteps < 1) {
+        fprintf(stderr,"benchClient - invalid numSites, numDOF or numSteps\n");
+        return -1;
+    }
+
+    // control displacements and time, acquire displacements and forces
+    for (i=0; i<OF_CLIENT_ALL; i++) {
+        sizeCtrl[i] = 0;
+        sizeDaq[i] = 0;
+    }
+    sizeCtrl[OF_CLIENT_DISP] = numDOF;
+    sizeCtrl[OF_CLIENT_TIME] = 1;
+    sizeDaq[OF_CLIENT_DISP] = numDOF;
+    sizeDaq[OF_CLIENT_FORCE] = numDOF;
+
+    clients = (OF_Client **)calloc(numSites, sizeof(OF_Client *));
+    ctrl = (const double **)calloc(numSites, sizeof(double *));
+    daq = (double **)calloc(numSites, sizeof(double *));
+    ctrlData = (double *)calloc(numSites*numDOF, sizeof(double));
+    daqData = (double *)calloc(numSites*2*numDOF, sizeof(double));
+    lat = (double *)calloc(numSteps, sizeof(double));
+
+    // connect to the servers
+    for (i=0; i<numSites; i++) {
+        if (of_open(argv[1], port+i, &clients[i]) != 0)
+            return -2;
+        if (of_setup(clients[i], sizeCtrl, sizeDaq, 0) != 0)
+            return -3;
+        ctrl[i] = &ctrlData[i*numDOF];
+        daq[i] = &daqData[i*2*numDOF];
+    }
+
+    // run the steps
+    tStart = getTime();
+    for (k=0; k<numSteps; k++) {
+        for (i=0; i<numSites; i++) {
+            for (j=0; j<numDOF; j++)
+                ctrlData[i*numDOF+j] = sin(0.01*(k+1));
+        }
+        t0 = getTime();
+        if (of_stepMulti(clients, numSites, ctrl, 0.01*(k+1), daq) != 0)
+            return -4;
+        for (i=0; i<numSites; i++)
+            of_commit(clients[i]);
+        t1 = getTime();
+        lat[k] = t1 - t0;
+    }
+    tTotal = getTime() - tStart;
+
+    // report results
+    qsort(lat, numSteps, sizeof(double), compareDouble);
+    fprintf(stdout,"sites %d dof %d steps %d\n", numSites, numDOF, numSteps);
+    fprintf(stdout,"steps/sec %.1f\n", numSteps/tTotal);
+    fprintf(stdout,"latency [us] min %.1f p50 %.1f p90 %.1f p99 %.1f max %.1f\n",
+        1.0E6*lat[0], 1.0E6*lat[numSteps/2], 1.0E6*lat[(int)(0.9*(numSteps-1))],
+        1.0E6*lat[(int)(0.99*(numSteps-1))], 1.0E6*lat[numSteps-1]);
+
+    // shutdown
+    for (i=0; i<numSites; i++)
+        of_close(clients[i]);
+
+    free(clients);
+    free(ctrl);
+    free(daq);
+    free(ctrlData);
+    free(daqData);
+    free(lat);
+
+    return 0;
+}
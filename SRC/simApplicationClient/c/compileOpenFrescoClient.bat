@@ -0,0 +1,47 @@
+@echo off
+echo.
+
+:: provide path to Visual Studio VC directory
+:: (update this according to the specific installation on your local machine)
+::set "pathVC=C:\Program Files (x86)\Microsoft Visual Studio 10.0\VC"
+::set "pathVC=C:\Program Files (x86)\Microsoft Visual Studio\2017\Community\VC\Auxiliary\Build"
+set "pathIC=C:\Program Files (x86)\IntelSWTools\compilers_and_libraries\windows\bin"
+
+echo Initializing x64 (intel64) instruction set:
+echo ===========================================
+::call "%pathVC%\vcvarsall.bat" x64
+call "%pathIC%\iclvars.bat" intel64
+
+echo.
+echo Compiling openFrescoClient.dll:
+echo ===============================
+call del openFrescoClient.log
+call del openFrescoClient.dll
+::call cl openFrescoClient.c tcp_socket.c /LD /O2 /D_WIN32 /D_CRT_SECURE_NO_DEPRECATE /FeopenFrescoClient.dll WS2_32.lib >>openFrescoClient.log 2>&1
+call icl openFrescoClient.c tcp_socket.c /LD /O2 /D_WIN32 /D_CRT_SECURE_NO_DEPRECATE /FeopenFrescoClient.dll WS2_32.lib >>openFrescoClient.log 2>&1
+
+echo.
+echo Compiling benchClient.exe:
+echo ==========================
+call del benchClient.exe
+::call cl benchClient.c openFrescoClient.lib /O2 /D_WIN32 /D_CRT_SECURE_NO_DEPRECATE >>openFrescoClient.log 2>&1
+call icl benchClient.c openFrescoClient.lib /O2 /D_WIN32 /D_CRT_SECURE_NO_DEPRECATE >>openFrescoClient.log 2>&1
+
+echo.
+echo Compiling genericClient.exe:
+echo ============================
+call del genericClient.exe
+::call cl genericClient.c openFrescoClient.lib /O2 /D_WIN32 /D_CRT_SECURE_NO_DEPRECATE >>openFrescoClient.log 2>&1
+call icl genericClient.c openFrescoClient.lib /O2 /D_WIN32 /D_CRT_SECURE_NO_DEPRECATE >>openFrescoClient.log 2>&1
+
+echo.
+echo Compiling pingPong.exe:
+echo =======================
+call del pingPong.exe
+::call cl pingPong.c /O2 /D_WIN32 /D_CRT_SECURE_NO_DEPRECATE WS2_32.lib >>openFrescoClient.log 2>&1
+call icl pingPong.c /O2 /D_WIN32 /D_CRT_SECURE_NO_DEPRECATE WS2_32.lib >>openFrescoClient.log 2>&1
+
+goto :eof
+
+:: on Linux/Mac OS X the shared library and the clients are built with make
+:: (see the Makefile in this directory)
@@ -30,20 +30,17 @@
 // Description: This file contains the class definition for genericClient.
 // genericClient is a generic element defined by any number of nodes and 
 // the degrees of freedom at those nodes. The element communicates with 
-// an OpenFresco element through a udp connection.
+// an OpenFresco element through the openFrescoClient library.
 
 #include <stdlib.h>
 #include <stdio.h>
 #include <math.h>
 #include <string.h>
 
-int socketID;
-int dataSize = 256;
+#include "openFrescoClient.h"
 
-void udp_setupconnectionclient(unsigned int *port, const char inetAddr[], int *lengthInet, int *socketID);
-void udp_senddata(const int *socketID, int *dataTypeSize, char data[], int *lenData, int *ierr);
-void udp_recvdata(const int *socketID, int *dataTypeSize, char data[], int *lenData, int *ierr);
-void udp_closeconnection(int *socketID, int *ierr);
+OF_Client *client = NULL;
+int dataSize = 256;
 
 int genericClient(double *d,
                   double *ul,
@@ -63,12 +60,8 @@ int genericClient(double *d,
     static int i, j;
     unsigned int port;
     
-    static int    iData[11];
-    static double *sData;
-    static double *rData;
-    
-    int ierr, nleft, dataTypeSize;
-    char *gMsg;
+    int sizeCtrl[OF_CLIENT_ALL];
+    int sizeDaq[OF_CLIENT_ALL];
     
     // ==============================================================
     // output element type 
@@ -80,8 +73,6 @@ int genericClient(double *d,
     // check for valid input args
     else if (isw == 1) {
         
-        int sizeMachineInet;
-        
         if (ndf < 1 || ndf > 6)
             return -1;
         if (ndm < 1 || ndm > 3)
@@ -89,39 +80,27 @@ int genericClient(double *d,
         if (nst != d[0]*ndf)
             return -1;
         
-        // allocate memory for the send and receive vectors
-        dataSize = (1+3*nst>dataSize) ? 1+3*nst : dataSize;
+        // the matrices are received into the data of size dataSize
         dataSize = (nst*nst>dataSize) ? nst*nst : dataSize;
-        sData = calloc(dataSize, sizeof(double));
-        rData = calloc(dataSize, sizeof(double));
         
         // setup the connection
         port = (int)d[1];
-        sizeMachineInet = 9+1;
-        udp_setupconnectionclient(&port, "127.0.0.1", &sizeMachineInet, &socketID);
-        if (socketID < 0)
+        if (of_open("127.0.0.1", port, &client) != 0)
             return -1;
         
         // set the data size for the experimental element
-        // sizeCtrl
-        iData[0] = nst;  // disp
-        iData[1] = nst;  // vel
-        iData[2] = nst;  // accel
-        iData[3] = 0;    // force
-        iData[4] = 0;    // time
-        // sizeDaq
-        iData[5] = 0;    // disp
-        iData[6] = 0;    // vel
-        iData[7] = 0;    // accel
-        iData[8] = nst;  // force
-        iData[9] = 0;    // time
-        // dataSize
-        iData[10] = dataSize;
-        
-        gMsg = (char *)iData;
-        dataTypeSize = sizeof(int);
-        nleft = 11;
-        udp_senddata(&socketID, &dataTypeSize, gMsg, &nleft, &ierr);
+        sizeCtrl[OF_CLIENT_DISP]  = nst;
+        sizeCtrl[OF_CLIENT_VEL]   = nst;
+        sizeCtrl[OF_CLIENT_ACCEL] = nst;
+        sizeCtrl[OF_CLIENT_FORCE] = 0;
+        sizeCtrl[OF_CLIENT_TIME]  = 0;
+        sizeDaq[OF_CLIENT_DISP]   = 0;
+        sizeDaq[OF_CLIENT_VEL]    = 0;
+        sizeDaq[OF_CLIENT_ACCEL]  = 0;
+        sizeDaq[OF_CLIENT_FORCE]  = nst;
+        sizeDaq[OF_CLIENT_TIME]   = 0;
+        if (of_setup(client, sizeCtrl, sizeDaq, dataSize) != 0)
+            return -1;
     }
     // ==============================================================
     // check element for errors
@@ -133,50 +112,15 @@ int genericClient(double *d,
     // compute element residual and tangent matrix
     else if (isw == 3 || isw == 4 || isw == 6) {
         
-        // send trial response to experimental site
-        sData[0] = 3;
-        for (i=0; i<nst; i++) {
-            sData[1+i] = ul[i];
-            sData[1+nst+i] = uldot[i];
-            sData[1+2*nst+i] = uldotdot[i];
-        }
-        
-        gMsg = (char *)sData;
-        dataTypeSize = sizeof(double);
-        nleft = dataSize;
-        udp_senddata(&socketID, &dataTypeSize, gMsg, &nleft, &ierr);
+        // send trial response to experimental site and
+        // get measured resisting forces
+        if (of_step(client, ul, uldot, uldotdot, NULL, 0.0, r) != 0)
+            return -1;
         
         // add stiffness portion to matrix
         if (isw == 3) {
-            sData[0] = 13;
-            
-            gMsg = (char *)sData;
-            dataTypeSize = sizeof(double);
-            nleft = dataSize;
-            udp_senddata(&socketID, &dataTypeSize, gMsg, &nleft, &ierr);
-            
-            gMsg = (char *)rData;
-            nleft = dataSize;
-            udp_recvdata(&socketID, &dataTypeSize, gMsg, &nleft, &ierr);
-            
-            for (i=0; i<nst*nst; i++) {
-                s[i] = rData[i];
-            }
-        }
-        
-        // get measured resisting forces
-        sData[0] = 10;
-        
-        gMsg = (char *)sData;
-        nleft = dataSize;
-        udp_senddata(&socketID, &dataTypeSize, gMsg, &nleft, &ierr);
-        
-        gMsg = (char *)rData;
-        nleft = dataSize;
-        udp_recvdata(&socketID, &dataTypeSize, gMsg, &nleft, &ierr);
-        
-        for (i=0; i<nst; i++) {
-            r[i] = rData[i];
+            if (of_getMatrix(client, OF_CLIENT_TANGENT_STIFF, nst, s) != 0)
+                return -1;
         }
         
         if (isw == 6) {
@@ -190,20 +134,8 @@ int genericClient(double *d,
     // compute element mass matrix
     else if (isw == 5) {
         
-        sData[0] = 15;
-        
-        gMsg = (char *)sData;
-        dataTypeSize = sizeof(double);
-        nleft = dataSize;
-        udp_senddata(&socketID, &dataTypeSize, gMsg, &nleft, &ierr);
-        
-        gMsg = (char *)rData;
-        nleft = dataSize;
-        udp_recvdata(&socketID, &dataTypeSize, gMsg, &nleft, &ierr);
-        
-        for (i=0; i<nst*nst; i++) {
-            s[i] = rData[i];
-        }
+        if (of_getMatrix(client, OF_CLIENT_MASS, nst, s) != 0)
+            return -1;
     }
     // ==============================================================
     // output surface loading
@@ -221,18 +153,8 @@ int genericClient(double *d,
     // disconnect from experimental site
     else if (isw == 10) {
         
-        sData[0] = 99;
-        
-        gMsg = (char *)sData;
-        dataTypeSize = sizeof(double);
-        nleft = dataSize;
-        udp_senddata(&socketID, &dataTypeSize, gMsg, &nleft, &ierr);
-        
-        udp_closeconnection(&socketID, &ierr);
-        
-        // clean up allocated memory
-        free(sData);
-        free(rData);
+        of_close(client);
+        client = NULL;
     }
     // ==============================================================
     
@@ -0,0 +1,359 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// $Revision$
+// $Date$
+// $Source: $
+
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the implementation of the
+// openFrescoClient library.
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#define OF_CLIENT_EXPORTS
+#include "openFrescoClient.h"
+
+// remote test actions (see FrescoGlobals.h)
+#define OF_RemoteTest_setTrialResponse 3
+#define OF_RemoteTest_commitState      5
+#define OF_RemoteTest_getDaqResponse   6
+#define OF_RemoteTest_DIE              99
+
+// network transmission data size
+#define OF_Network_dataSize 256
+
+// functions defined in tcp_socket.c
+void tcp_setupconnectionclient(unsigned int *other_Port, const char other_InetAddr[], int *lengthInet, int *socketID);
+void tcp_closeconnection(int *socketID, int *ierr);
+void tcp_senddata(int *socketID, int *dataTypeSize, char data[], int *lenData, int *ierr);
+void tcp_queuedata(int *socketID, double data[], int *lenData, int *ierr);
+void tcp_flushdata(int *socketID, int *numReplies, int *ierr);
+void tcp_recvbatchdata(int *socketID, double data[], int *lenData, int *ierr);
+void tcp_getmatrix(int *socketID, int *matrixType, int *ndf, double data[], int *lenData, int *ierr);
+
+struct openFrescoClient {
+    int socketID;
+    int dataSize;
+    int sizeCtrl[OF_CLIENT_ALL];
+    int sizeDaq[OF_CLIENT_ALL];
+    int numCtrl;
+    int numDaq;
+    int pending;
+    double time;
+    double *sData;
+    double *rData;
+};
+
+
+int of_open(const char *inetAddr, unsigned int port, OF_Client **client)
+{
+    OF_Client *theClient;
+    int sizeInet;
+
+    *client = NULL;
+    if (inetAddr == NULL) {
+        fprintf(stderr,"openFrescoClient::of_open() - missing inetAddr\n");
+        return -1;
+    }
+
+    theClient = (OF_Client *)calloc(1, sizeof(OF_Client));
+    if (theClient == NULL) {
+        fprintf(stderr,"openFrescoClient::of_open() - could not allocate client\n");
+        return -2;
+    }
+
+    // setup the connection
+    sizeInet = (int)strlen(inetAddr) + 1;
+    tcp_setupconnectionclient(&port, inetAddr, &sizeInet, &theClient->socketID);
+    if (theClient->socketID < 0) {
+        fprintf(stderr,"openFrescoClient::of_open() - could not connect to server\n");
+        free(theClient);
+        return -3;
+    }
+
+    *client = theClient;
+    return 0;
+}
+
+
+int of_setup(OF_Client *client, const int sizeCtrl[OF_CLIENT_ALL],
+    const int sizeDaq[OF_CLIENT_ALL], int dataSize)
+{
+    int iData[2*OF_CLIENT_ALL+1];
+    int i, ierr, dataTypeSize, lenData;
+
+    if (client == NULL || client->sData != NULL) {
+        fprintf(stderr,"openFrescoClient::of_setup() - invalid or already setup client\n");
+        return -1;
+    }
+
+    client->numCtrl = 0;
+    client->numDaq = 0;
+    for (i=0; i<OF_CLIENT_ALL; i++) {
+        client->sizeCtrl[i] = sizeCtrl[i];
+        client->sizeDaq[i] = sizeDaq[i];
+        client->numCtrl += sizeCtrl[i];
+        client->numDaq += sizeDaq[i];
+    }
+    if (dataSize <= 0)
+        dataSize = OF_Network_dataSize;
+    if (dataSize < 1+client->numCtrl)
+        dataSize = 1+client->numCtrl;
+    if (dataSize < client->numDaq)
+        dataSize = client->numDaq;
+    client->dataSize = dataSize;
+
+    // allocate the send and receive buffers once
+    client->sData = (double *)calloc(dataSize, sizeof(double));
+    client->rData = (double *)calloc(dataSize, sizeof(double));
+    if (client->sData == NULL || client->rData == NULL) {
+        fprintf(stderr,"openFrescoClient::of_setup() - could not allocate buffers\n");
+        return -2;
+    }
+
+    // send the data sizes to the server
+    for (i=0; i<OF_CLIENT_ALL; i++) {
+        iData[i] = sizeCtrl[i];
+        iData[OF_CLIENT_ALL+i] = sizeDaq[i];
+    }
+    iData[2*OF_CLIENT_ALL] = dataSize;
+
+    dataTypeSize = sizeof(int);
+    lenData = 2*OF_CLIENT_ALL+1;
+    tcp_senddata(&client->socketID, &dataTypeSize, (char *)iData, &lenData, &ierr);
+
+    return ierr;
+}
+
+
+int of_commit(OF_Client *client)
+{
+    int ierr;
+
+    if (client == NULL || client->sData == NULL) {
+        fprintf(stderr,"openFrescoClient::of_commit() - client not setup\n");
+        return -1;
+    }
+
+    // the time of the committed step is the last trial time
+    memset(client->sData, 0, client->dataSize*sizeof(double));
+    client->sData[0] = OF_RemoteTest_commitState;
+    if (client->sizeCtrl[OF_CLIENT_TIME] != 0)
+        client->sData[1+client->numCtrl-client->sizeCtrl[OF_CLIENT_TIME]] = client->time;
+    tcp_queuedata(&client->socketID, client->sData, &client->dataSize, &ierr);
+
+    return ierr;
+}
+
+
+int of_submit(OF_Client *client, const double *disp,
+    const double *vel, const double *accel, const double *force,
+    double time)
+{
+    const double *ctrl[OF_CLIENT_TIME];
+    int i, j, id, ierr, numReplies;
+
+    if (client == NULL || client->sData == NULL) {
+        fprintf(stderr,"openFrescoClient::of_submit() - client not setup\n");
+        return -1;
+    }
+    if (client->pending) {
+        fprintf(stderr,"openFrescoClient::of_submit() - previous step not awaited\n");
+        return -2;
+    }
+
+    // assemble the trial response
+    ctrl[OF_CLIENT_DISP] = disp;
+    ctrl[OF_CLIENT_VEL] = vel;
+    ctrl[OF_CLIENT_ACCEL] = accel;
+    ctrl[OF_CLIENT_FORCE] = force;
+
+    memset(client->sData, 0, client->dataSize*sizeof(double));
+    client->sData[0] = OF_RemoteTest_setTrialResponse;
+    id = 1;
+    for (i=0; i<OF_CLIENT_TIME; i++) {
+        if (client->sizeCtrl[i] != 0 && ctrl[i] != NULL) {
+            for (j=0; j<client->sizeCtrl[i]; j++)
+                client->sData[id+j] = ctrl[i][j];
+        }
+        id += client->sizeCtrl[i];
+    }
+    if (client->sizeCtrl[OF_CLIENT_TIME] != 0)
+        client->sData[id] = time;
+    client->time = time;
+    tcp_queuedata(&client->socketID, client->sData, &client->dataSize, &ierr);
+    if (ierr != 0)
+        return ierr;
+
+    // request the daq response
+    client->sData[0] = OF_RemoteTest_getDaqResponse;
+    tcp_queuedata(&client->socketID, client->sData, &client->dataSize, &ierr);
+    if (ierr != 0)
+        return ierr;
+
+    // send everything in one message
+    tcp_flushdata(&client->socketID, &numReplies, &ierr);
+    if (ierr != 0)
+        return ierr;
+    client->pending = numReplies;
+
+    return 0;
+}
+
+
+int of_wait(OF_Client *client, double *daq)
+{
+    int ierr;
+
+    if (client == NULL || client->pending == 0) {
+        fprintf(stderr,"openFrescoClient::of_wait() - no step submitted\n");
+        return -1;
+    }
+
+    tcp_recvbatchdata(&client->socketID, client->rData, &client->dataSize, &ierr);
+    client->pending = 0;
+    if (ierr != 0)
+        return ierr;
+
+    if (daq != NULL)
+        memcpy(daq, client->rData, client->numDaq*sizeof(double));
+
+    return 0;
+}
+
+
+int of_step(OF_Client *client, const double *disp,
+    const double *vel, const double *accel, const double *force,
+    double time, double *daq)
+{
+    int ierr;
+
+    ierr = of_submit(client, disp, vel, accel, force, time);
+    if (ierr != 0)
+        return ierr;
+
+    return of_wait(client, daq);
+}
+
+
+int of_stepMulti(OF_Client **clients, int numClients,
+    const double **ctrl, double time, double **daq)
+{
+    const double *resp[OF_CLIENT_TIME];
+    int i, j, id, ierr, rValue = 0;
+
+    // first submit the steps of all clients
+    for (i=0; i<numClients; i++) {
+        id = 0;
+        for (j=0; j<OF_CLIENT_TIME; j++) {
+            resp[j] = (clients[i]->sizeCtrl[j] != 0) ? &ctrl[i][id] : NULL;
+            id += clients[i]->sizeCtrl[j];
+        }
+        ierr = of_submit(clients[i], resp[OF_CLIENT_DISP], resp[OF_CLIENT_VEL],
+            resp[OF_CLIENT_ACCEL], resp[OF_CLIENT_FORCE], time);
+        if (ierr != 0) {
+            fprintf(stderr,"openFrescoClient::of_stepMulti() - failed to submit step of client %d\n", i);
+            rValue = ierr;
+        }
+    }
+
+    // then collect their replies
+    for (i=0; i<numClients; i++) {
+        if (clients[i]->pending == 0)
+            continue;
+        ierr = of_wait(clients[i], daq != NULL ? daq[i] : NULL);
+        if (ierr != 0) {
+            fprintf(stderr,"openFrescoClient::of_stepMulti() - failed to receive daq of client %d\n", i);
+            rValue = ierr;
+        }
+    }
+
+    return rValue;
+}
+
+
+int of_getMatrix(OF_Client *client, int matrixType, int ndf,
+    double *matrix)
+{
+    int ierr;
+
+    if (client == NULL || client->sData == NULL || matrix == NULL) {
+        fprintf(stderr,"openFrescoClient::of_getMatrix() - client not set up\n");
+        return -1;
+    }
+    if (client->pending) {
+        fprintf(stderr,"openFrescoClient::of_getMatrix() - reply of submitted step not received\n");
+        return -2;
+    }
+    if (ndf*ndf > client->dataSize) {
+        fprintf(stderr,"openFrescoClient::of_getMatrix() - dataSize too small for matrix\n");
+        return -3;
+    }
+
+    tcp_getmatrix(&client->socketID, &matrixType, &ndf, matrix,
+        &client->dataSize, &ierr);
+
+    return ierr;
+}
+
+
+const double *of_getDaq(OF_Client *client)
+{
+    if (client == NULL)
+        return NULL;
+
+    return client->rData;
+}
+
+
+int of_close(OF_Client *client)
+{
+    int ierr = 0, dataTypeSize;
+
+    if (client == NULL)
+        return -1;
+
+    // receive outstanding replies first
+    if (client->pending)
+        of_wait(client, NULL);
+
+    if (client->sData != NULL) {
+        client->sData[0] = OF_RemoteTest_DIE;
+        dataTypeSize = sizeof(double);
+        tcp_senddata(&client->socketID, &dataTypeSize,
+            (char *)client->sData, &client->dataSize, &ierr);
+    }
+    tcp_closeconnection(&client->socketID, &ierr);
+
+    // clean up allocated memory
+    if (client->sData != NULL)
+        free(client->sData);
+    if (client->rData != NULL)
+        free(client->rData);
+    free(client);
+
+    return ierr;
+}
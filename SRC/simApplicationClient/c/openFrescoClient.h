@@ -0,0 +1,119 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// $Revision$
+// $Date$
+// $Source: $
+
+#ifndef openFrescoClient_h
+#define openFrescoClient_h
+
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the interface of the openFrescoClient
+// library. The library implements the OpenFresco remote test protocol
+// used by the SimAppSiteServer and SimAppElemServer on top of the
+// tcp_socket functions, so that external simulation applications do not
+// need to re-implement the message exchange. All requests of a step are
+// sent as one batch (OF_RemoteTest_batch), a step can be submitted
+// without waiting for its reply, and several clients can be stepped
+// together so that the round trips to different servers overlap.
+
+#ifdef _WIN32
+#ifdef OF_CLIENT_EXPORTS
+#define OF_CLIENT_API __declspec(dllexport)
+#else
+#define OF_CLIENT_API __declspec(dllimport)
+#endif
+#else
+#define OF_CLIENT_API
+#endif
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+// response types (same order as in FrescoGlobals.h)
+#define OF_CLIENT_DISP  0
+#define OF_CLIENT_VEL   1
+#define OF_CLIENT_ACCEL 2
+#define OF_CLIENT_FORCE 3
+#define OF_CLIENT_TIME  4
+#define OF_CLIENT_ALL   5
+
+// matrix types (same as the remote test actions in FrescoGlobals.h)
+#define OF_CLIENT_INITIAL_STIFF 12
+#define OF_CLIENT_TANGENT_STIFF 13
+#define OF_CLIENT_DAMP          14
+#define OF_CLIENT_MASS          15
+
+typedef struct openFrescoClient OF_Client;
+
+// open a connection to a SimAppSiteServer or SimAppElemServer
+OF_CLIENT_API int of_open(const char *inetAddr, unsigned int port,
+    OF_Client **client);
+
+// send the control and daq sizes to the server, dataSize is increased
+// if the provided one is too small for the control or daq data
+OF_CLIENT_API int of_setup(OF_Client *client, const int sizeCtrl[OF_CLIENT_ALL],
+    const int sizeDaq[OF_CLIENT_ALL], int dataSize);
+
+// queue a commit of the current state, sent with the next step
+OF_CLIENT_API int of_commit(OF_Client *client);
+
+// send the trial response and the daq request without waiting for the
+// reply (the pointers of the response types without size may be null)
+OF_CLIENT_API int of_submit(OF_Client *client, const double *disp,
+    const double *vel, const double *accel, const double *force,
+    double time);
+
+// wait for the daq response of the submitted step, the data is laid
+// out as disp, vel, accel, force, time according to sizeDaq
+OF_CLIENT_API int of_wait(OF_Client *client, double *daq);
+
+// submit a step and wait for its daq response
+OF_CLIENT_API int of_step(OF_Client *client, const double *disp,
+    const double *vel, const double *accel, const double *force,
+    double time, double *daq);
+
+// step several clients at once, all steps are submitted before the
+// first reply is awaited (ctrl[i] holds the control data of client i
+// laid out like the daq data, daq[i] receives its daq response)
+OF_CLIENT_API int of_stepMulti(OF_Client **clients, int numClients,
+    const double **ctrl, double time, double **daq);
+
+// get a ndf x ndf matrix of the element (the server only resends the
+// matrix if it changed, dataSize needs to be at least ndf*ndf)
+OF_CLIENT_API int of_getMatrix(OF_Client *client, int matrixType, int ndf,
+    double *matrix);
+
+// get the internal daq buffer of the last received response
+OF_CLIENT_API const double *of_getDaq(OF_Client *client);
+
+// shut down the server and close the connection
+OF_CLIENT_API int of_close(OF_Client *client);
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif
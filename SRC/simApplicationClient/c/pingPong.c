@@ -0,0 +1,444 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// $Revision$
+// $Date$
+// $Source: $
+
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains a loopback ping-pong benchmark for
+// the socket options that can be set on the OpenFresco channels
+// (-noDelay, -sndBuf, -rcvBuf, -quickAck, -busyPoll, -spin, -priority,
+// -cpu). An echo thread and the client exchange messages of dataSize
+// doubles over a TCP connection on the local host and the round trip
+// time percentiles and histogram are reported for each option set.
+// The options are applied the same way as in ChannelOptions. Note
+// that spinning only pays off if the client and the echo thread each
+// have a cpu of their own, otherwise they compete for the same core.
+//
+// usage: pingPong <ipPort> <dataSize> <numRoundTrips>
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <windows.h>
+typedef SOCKET socket_type;
+#define closesocket_type(s) closesocket(s)
+#else
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include <errno.h>
+typedef int socket_type;
+#define closesocket_type(s) close(s)
+#endif
+
+
+typedef struct {
+    const char *name;
+    int noDelay;
+    int sndBuf;
+    int rcvBuf;
+    int quickAck;
+    int busyPoll;
+    int spin;
+    int priority;
+    int cpu;
+} options;
+
+// the option sets to compare
+static const options optionSets[] = {
+    {"default",        0, 0,       0,       0, 0,  0,   -1, -1},
+    {"noDelay",        1, 0,       0,       0, 0,  0,   -1, -1},
+    {"+quickAck",      1, 0,       0,       1, 0,  0,   -1, -1},
+    {"+sndBuf/rcvBuf", 1, 1048576, 1048576, 1, 0,  0,   -1, -1},
+    {"+busyPoll 50",   1, 0,       0,       1, 50, 0,   -1, -1},
+    {"+spin 50",       1, 0,       0,       1, 0,  50,  -1, -1},
+    {"+spin 1000",     1, 0,       0,       1, 0,  1000, -1, -1},
+    {"+priority 6",    1, 0,       0,       1, 0,  0,    6, -1},
+    {"+cpu",           1, 0,       0,       1, 0,  0,   -1,  0},
+    {"+cpu +spin 1000",1, 0,       0,       1, 0,  1000, -1,  0}
+};
+
+// upper bounds of the round trip time histogram bins [us]
+static const double histBins[] = {5, 10, 20, 50, 100, 200, 500, 1000};
+#define NUM_HIST_BINS (sizeof(histBins)/sizeof(double) + 1)
+
+typedef struct {
+    const options *opt;
+    unsigned short port;
+    int msgSize;
+    int numTrips;
+    socket_type listenfd;
+} echoData;
+
+
+static double getTime()
+{
+#ifdef _WIN32
+    LARGE_INTEGER freq, count;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&count);
+    return (double)count.QuadPart/(double)freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + 1.0E-9*ts.tv_nsec;
+#endif
+}
+
+
+static int compareDouble(const void *a, const void *b)
+{
+    double da = *(const double *)a;
+    double db = *(const double *)b;
+    return (da > db) - (da < db);
+}
+
+
+static void applyOptions(socket_type sockfd, const options *opt)
+{
+    setsockopt(sockfd, IPPROTO_TCP, TCP_NODELAY,
+        (char *)&opt->noDelay, sizeof(int));
+    if (opt->sndBuf > 0)
+        setsockopt(sockfd, SOL_SOCKET, SO_SNDBUF,
+            (char *)&opt->sndBuf, sizeof(int));
+    if (opt->rcvBuf > 0)
+        setsockopt(sockfd, SOL_SOCKET, SO_RCVBUF,
+            (char *)&opt->rcvBuf, sizeof(int));
+#ifdef TCP_QUICKACK
+    if (opt->quickAck)
+        setsockopt(sockfd, IPPROTO_TCP, TCP_QUICKACK,
+            (char *)&opt->quickAck, sizeof(int));
+#endif
+#ifdef SO_BUSY_POLL
+    if (opt->busyPoll > 0)
+        setsockopt(sockfd, SOL_SOCKET, SO_BUSY_POLL,
+            (char *)&opt->busyPoll, sizeof(int));
+#endif
+#ifdef SO_PRIORITY
+    if (opt->priority >= 0)
+        setsockopt(sockfd, SOL_SOCKET, SO_PRIORITY,
+            (char *)&opt->priority, sizeof(int));
+#endif
+}
+
+
+static void bindThread(int cpu)
+{
+    if (cpu < 0)
+        return;
+#ifdef _WIN32
+    SetThreadAffinityMask(GetCurrentThread(), ((DWORD_PTR)1) << cpu);
+#elif defined(__linux__)
+    {
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        CPU_SET(cpu, &cpuSet);
+        pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet);
+    }
+#endif
+}
+
+
+static void spinUntilReadable(socket_type sockfd, int spin)
+{
+    double tEnd;
+    char data;
+    int rValue;
+
+    if (spin <= 0)
+        return;
+    tEnd = getTime() + 1.0E-6*spin;
+    do {
+#ifdef _WIN32
+        fd_set readSet;
+        struct timeval timeout = {0, 0};
+        FD_ZERO(&readSet);
+        FD_SET(sockfd, &readSet);
+        rValue = select(0, &readSet, NULL, NULL, &timeout);
+        if (rValue != 0)
+            return;
+#else
+        rValue = recv(sockfd, &data, 1, MSG_PEEK | MSG_DONTWAIT);
+        if (rValue >= 0 || (errno != EAGAIN && errno != EWOULDBLOCK))
+            return;
+#endif
+    } while (getTime() < tEnd);
+}
+
+
+static int recvAll(socket_type sockfd, char *data, int size,
+    int quickAck, int spin)
+{
+    int nread;
+    while (size > 0) {
+        spinUntilReadable(sockfd, spin);
+        nread = recv(sockfd, data, size, 0);
+        if (nread <= 0)
+            return -1;
+        size -= nread;
+        data += nread;
+    }
+#ifdef TCP_QUICKACK
+    if (quickAck)
+        setsockopt(sockfd, IPPROTO_TCP, TCP_QUICKACK,
+            (char *)&quickAck, sizeof(int));
+#endif
+    return 0;
+}
+
+
+static int sendAll(socket_type sockfd, const char *data, int size)
+{
+    int nwrite;
+    while (size > 0) {
+        nwrite = send(sockfd, data, size, 0);
+        if (nwrite <= 0)
+            return -1;
+        size -= nwrite;
+        data += nwrite;
+    }
+    return 0;
+}
+
+
+#ifdef _WIN32
+static DWORD WINAPI echoServer(LPVOID arg)
+#else
+static void *echoServer(void *arg)
+#endif
+{
+    echoData *data = (echoData *)arg;
+    socket_type sockfd;
+    char *msg;
+    int i;
+
+    sockfd = accept(data->listenfd, NULL, NULL);
+    if (sockfd < 0) {
+        fprintf(stderr,"pingPong::echoServer() - could not accept connection\n");
+        return 0;
+    }
+    applyOptions(sockfd, data->opt);
+
+    // keep the echo thread on a different cpu than the client
+    bindThread(data->opt->cpu < 0 ? -1 : data->opt->cpu+1);
+
+    msg = (char *)malloc(data->msgSize);
+    for (i=0; i<data->numTrips; i++) {
+        if (recvAll(sockfd, msg, data->msgSize, data->opt->quickAck,
+            data->opt->spin) != 0 ||
+            sendAll(sockfd, msg, data->msgSize) != 0)
+            break;
+    }
+    free(msg);
+    closesocket_type(sockfd);
+
+    return 0;
+}
+
+
+static int runOptionSet(const options *opt, unsigned short port,
+    int msgSize, int numTrips, double *rtt)
+{
+    struct sockaddr_in addr;
+    socket_type listenfd, sockfd;
+    echoData data;
+    char *msg;
+    int i, reuse = 1;
+    double t0;
+#ifdef _WIN32
+    HANDLE thread;
+#else
+    pthread_t thread;
+#endif
+
+    // setup the echo server
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+
+    listenfd = socket(AF_INET, SOCK_STREAM, 0);
+    setsockopt(listenfd, SOL_SOCKET, SO_REUSEADDR, (char *)&reuse, sizeof(int));
+    applyOptions(listenfd, opt);
+    if (bind(listenfd, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+        listen(listenfd, 1) < 0) {
+        fprintf(stderr,"pingPong::runOptionSet() - could not listen on port %d\n", port);
+        closesocket_type(listenfd);
+        return -1;
+    }
+
+    data.opt = opt;
+    data.port = port;
+    data.msgSize = msgSize;
+    data.numTrips = numTrips;
+    data.listenfd = listenfd;
+#ifdef _WIN32
+    thread = CreateThread(NULL, 0, echoServer, &data, 0, NULL);
+#else
+    pthread_create(&thread, NULL, echoServer, &data);
+#endif
+
+    // connect the client
+    sockfd = socket(AF_INET, SOCK_STREAM, 0);
+    applyOptions(sockfd, opt);
+    if (connect(sockfd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+        fprintf(stderr,"pingPong::runOptionSet() - could not connect\n");
+        closesocket_type(sockfd);
+        closesocket_type(listenfd);
+        return -2;
+    }
+    bindThread(opt->cpu);
+
+    // run the round trips
+    msg = (char *)calloc(msgSize, 1);
+    for (i=0; i<numTrips; i++) {
+        t0 = getTime();
+        if (sendAll(sockfd, msg, msgSize) != 0 ||
+            recvAll(sockfd, msg, msgSize, opt->quickAck, opt->spin) != 0) {
+            fprintf(stderr,"pingPong::runOptionSet() - round trip %d failed\n", i);
+            break;
+        }
+        rtt[i] = getTime() - t0;
+    }
+    free(msg);
+
+    closesocket_type(sockfd);
+#ifdef _WIN32
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+#else
+    pthread_join(thread, NULL);
+#endif
+    closesocket_type(listenfd);
+
+    // reset the affinity for the next option set
+#if defined(__linux__)
+    if (opt->cpu >= 0) {
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        for (int j=0; j<CPU_SETSIZE; j++)
+            CPU_SET(j, &cpuSet);
+        pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet);
+    }
+#endif
+
+    return (i == numTrips) ? 0 : -3;
+}
+
+
+int main(int argc, char **argv)
+{
+    int port = 8090, dataSize = 256, numTrips = 10000;
+    int numSets = sizeof(optionSets)/sizeof(options);
+    int i, j, k, n;
+    int *hist;
+    double *rtt;
+
+    if (argc > 1)
+        port = atoi(argv[1]);
+    if (argc > 2)
+        dataSize = atoi(argv[2]);
+    if (argc > 3)
+        numTrips = atoi(argv[3]);
+    if (port <= 0 || dataSize < 1 || numTrips < 1) {
+        fprintf(stderr,"usage: pingPong <ipPort> <dataSize> <numRoundTrips>\n");
+        return -1;
+    }
+
+#ifdef _WIN32
+    {
+        WSADATA wsaData;
+        if (WSAStartup(MAKEWORD(2,2), &wsaData) != 0) {
+            fprintf(stderr,"pingPong - could not initialize winsock\n");
+            return -1;
+        }
+    }
+#endif
+
+    rtt = (double *)calloc(numTrips, sizeof(double));
+    hist = (int *)calloc(numSets*NUM_HIST_BINS, sizeof(int));
+    fprintf(stdout,"message %d bytes, %d round trips\n",
+        dataSize*(int)sizeof(double), numTrips);
+    fprintf(stdout,"%-16s %10s %10s %10s %10s %10s   [us]\n",
+        "options", "min", "p50", "p90", "p99", "max");
+
+    for (i=0; i<numSets; i++) {
+        // use a new port for each set to avoid TIME_WAIT conflicts
+        if (runOptionSet(&optionSets[i], (unsigned short)(port+i),
+            dataSize*sizeof(double), numTrips, rtt) != 0)
+            continue;
+        qsort(rtt, numTrips, sizeof(double), compareDouble);
+        n = numTrips-1;
+        fprintf(stdout,"%-16s %10.1f %10.1f %10.1f %10.1f %10.1f\n",
+            optionSets[i].name, 1.0E6*rtt[0], 1.0E6*rtt[n/2],
+            1.0E6*rtt[(int)(0.9*n)], 1.0E6*rtt[(int)(0.99*n)], 1.0E6*rtt[n]);
+
+        // sort the round trips into the histogram bins
+        for (j=0, k=0; j<numTrips; j++) {
+            while (k < NUM_HIST_BINS-1 && 1.0E6*rtt[j] >= histBins[k])
+                k++;
+            hist[i*NUM_HIST_BINS+k]++;
+        }
+    }
+
+    // print the histograms
+    fprintf(stdout,"\nround trip time histogram [us]\n%-16s", "options");
+    for (k=0; k<NUM_HIST_BINS; k++) {
+        char label[16];
+        if (k < NUM_HIST_BINS-1)
+            sprintf(label, "<%g", histBins[k]);
+        else
+            sprintf(label, ">=%g", histBins[k-1]);
+        fprintf(stdout," %10s", label);
+    }
+    fprintf(stdout,"\n");
+    for (i=0; i<numSets; i++) {
+        fprintf(stdout,"%-16s", optionSets[i].name);
+        for (k=0; k<NUM_HIST_BINS; k++)
+            fprintf(stdout," %10d", hist[i*NUM_HIST_BINS+k]);
+        fprintf(stdout,"\n");
+    }
+
+    free(rtt);
+    free(hist);
+#ifdef _WIN32
+    WSACleanup();
+#endif
+
+    return 0;
+}
@@ -51,6 +51,19 @@
 #define MAX_UDP_DATAGRAM 9126
 #define MAX_INET_ADDR 28
 
+// remote test actions (see FrescoGlobals.h)
+#define OF_RemoteTest_getDaqResponse 6
+#define OF_RemoteTest_getInitialStiff 12
+#define OF_RemoteTest_getMass 15
+#define OF_RemoteTest_batch 16
+#define OF_RemoteTest_getMatrix 19
+
+// matrix reply formats (see FrescoGlobals.h)
+#define OF_Matrix_unchanged 0
+#define OF_Matrix_full 1
+#define OF_Matrix_upperTri 2
+#define MATRIX_HEADER 3
+
 #ifdef _WIN32
 typedef SOCKET socket_type;
 typedef int socklen_type;
@@ -69,6 +82,20 @@ typedef struct socketConnection {
     char *machineInetAddr;
     int socketID;
     socket_type sockfd;
+    double *batchData;
+    int sizeBatch;
+    int lenBatch;
+    int numBatch;
+    int numReplies;
+    int numPending;
+    int *replyKinds;        // 0 or matrix type of the replies of the queued requests
+    int *pendingKinds;      // 0 or matrix type of the replies of the flushed batch
+    int sizeKinds;
+    int ndfMatrix;          // size of the cached matrices
+    double *matrixData[4];  // cached initial, tangent, damping and mass matrices
+    int matrixVersion[4];   // server versions of the cached matrices
+    double *requestData;    // request of getmatrix
+    int lenRequest;
     struct socketConnection *next;
 } SocketConnection;
 
@@ -101,6 +128,107 @@ void CALL_CONV cleanupsockets()
 }
 
 
+// free the cached matrices of a connection
+static void freematrices(SocketConnection *theSocket)
+{
+    int i;
+    for (i=0; i<4; i++) {
+        if (theSocket->matrixData[i] != NULL)
+            free(theSocket->matrixData[i]);
+        theSocket->matrixData[i] = NULL;
+        theSocket->matrixVersion[i] = 0;
+    }
+    theSocket->ndfMatrix = 0;
+}
+
+
+// check a conditional matrix request and allocate the cache of the
+// matrix, which is restarted if the size of the matrices changes
+static int preparematrix(SocketConnection *theSocket, int type, int ndf,
+    int lenData, const char *func)
+{
+    int id = type - OF_RemoteTest_getInitialStiff;
+    
+    if (id < 0 || id > 3 || ndf < 1 || ndf*ndf > lenData || lenData < 4) {
+        fprintf(stderr,"tcp_socket::%s() - invalid matrix type or size\n", func);
+        return -1;
+    }
+    if (ndf != theSocket->ndfMatrix) {
+        freematrices(theSocket);
+        theSocket->ndfMatrix = ndf;
+    }
+    if (theSocket->matrixData[id] == NULL) {
+        theSocket->matrixData[id] = (double *)calloc(ndf*ndf, sizeof(double));
+        if (theSocket->matrixData[id] == NULL) {
+            fprintf(stderr,"tcp_socket::%s() - could not allocate matrix cache\n", func);
+            return -1;
+        }
+    }
+    
+    return 0;
+}
+
+
+// append a request to the batch and return the record to fill in
+static double *appendrequest(SocketConnection *theSocket, int lenData,
+    const char *func, int *ierr)
+{
+    double *newData;
+    int size;
+    
+    // all requests of a batch need to have the same length
+    if (theSocket->numBatch == 0)
+        theSocket->lenBatch = lenData;
+    else if (theSocket->lenBatch != lenData) {
+        fprintf(stderr,"tcp_socket::%s() - length of data does not match batch\n", func);
+        *ierr = -2;
+        return NULL;
+    }
+    
+    // grow the batch buffer if necessary
+    // (the first record is reserved for the batch header)
+    size = (theSocket->numBatch + 2) * lenData;
+    if (size > theSocket->sizeBatch) {
+        newData = (double *)realloc(theSocket->batchData, 2*size*sizeof(double));
+        if (newData == NULL) {
+            fprintf(stderr,"tcp_socket::%s() - could not allocate batch buffer\n", func);
+            *ierr = -3;
+            return NULL;
+        }
+        theSocket->batchData = newData;
+        theSocket->sizeBatch = 2*size;
+    }
+    
+    theSocket->numBatch++;
+    return &theSocket->batchData[theSocket->numBatch * lenData];
+}
+
+
+// count a reply that the server sends for a queued request,
+// kind is 0 or the matrix type of a conditional matrix request
+static int addreply(SocketConnection *theSocket, int kind)
+{
+    int *newKinds;
+    int size;
+    
+    if (theSocket->numReplies >= theSocket->sizeKinds) {
+        size = 2*theSocket->numReplies + 8;
+        newKinds = (int *)realloc(theSocket->replyKinds, size*sizeof(int));
+        if (newKinds == NULL)
+            return -1;
+        theSocket->replyKinds = newKinds;
+        newKinds = (int *)realloc(theSocket->pendingKinds, size*sizeof(int));
+        if (newKinds == NULL)
+            return -1;
+        theSocket->pendingKinds = newKinds;
+        theSocket->sizeKinds = size;
+    }
+    theSocket->replyKinds[theSocket->numReplies++] = kind;
+    
+    return 0;
+}
+
+
 /*
 * tcp_setupconnectionserver() - function to setup a connection from server
 *
@@ -125,7 +253,7 @@ void CALL_CONV tcp_setupconnectionserver(unsigned int *port, int *socketID)
     socklen_type addrLength;
     unsigned int other_Port;
     char *other_InetAddr;    
-    int ierr;
+    int i, ierr;
     
     // initialize sockets
     startupsockets(&ierr);
@@ -195,6 +323,22 @@ void CALL_CONV tcp_setupconnectionserver(unsigned int *port, int *socketID)
     strcpy(theSocket->machineInetAddr, other_InetAddr);
     theSocket->socketID = socketIDs;
     theSocket->sockfd = sockfd;
+    theSocket->batchData = NULL;
+    theSocket->sizeBatch = 0;
+    theSocket->lenBatch = 0;
+    theSocket->numBatch = 0;
+    theSocket->numReplies = 0;
+    theSocket->numPending = 0;
+    theSocket->replyKinds = NULL;
+    theSocket->pendingKinds = NULL;
+    theSocket->sizeKinds = 0;
+    theSocket->ndfMatrix = 0;
+    for (i=0; i<4; i++) {
+        theSocket->matrixData[i] = NULL;
+        theSocket->matrixVersion[i] = 0;
+    }
+    theSocket->requestData = NULL;
+    theSocket->lenRequest = 0;
     theSocket->next = theSockets;
     theSockets = theSocket;
     
@@ -226,7 +370,7 @@ void CALL_CONV tcp_setupconnectionclient(unsigned int *other_Port,
     
     SocketConnection *theSocket = theSockets;
     socket_type sockfd;    
-    int ierr;
+    int i, ierr;
     
     // check inputs
     if (other_InetAddr == 0) {
@@ -308,6 +452,22 @@ void CALL_CONV tcp_setupconnectionclient(unsigned int *other_Port,
     strcpy(theSocket->machineInetAddr, other_InetAddr);
     theSocket->socketID = socketIDs;
     theSocket->sockfd = sockfd;
+    theSocket->batchData = NULL;
+    theSocket->sizeBatch = 0;
+    theSocket->lenBatch = 0;
+    theSocket->numBatch = 0;
+    theSocket->numReplies = 0;
+    theSocket->numPending = 0;
+    theSocket->replyKinds = NULL;
+    theSocket->pendingKinds = NULL;
+    theSocket->sizeKinds = 0;
+    theSocket->ndfMatrix = 0;
+    for (i=0; i<4; i++) {
+        theSocket->matrixData[i] = NULL;
+        theSocket->matrixVersion[i] = 0;
+    }
+    theSocket->requestData = NULL;
+    theSocket->lenRequest = 0;
     theSocket->next = theSockets;
     theSockets = theSocket;
     
@@ -343,6 +503,28 @@ void CALL_CONV tcp_closeconnection(int *socketID, int *ierr)
     close(theSocket->sockfd);
 #endif
     
+    // free the batch buffer
+    if (theSocket->batchData != NULL) {
+        free(theSocket->batchData);
+        theSocket->batchData = NULL;
+        theSocket->sizeBatch = 0;
+    }
+    
+    // free the matrix caches
+    freematrices(theSocket);
+    if (theSocket->replyKinds != NULL) {
+        free(theSocket->replyKinds);
+        free(theSocket->pendingKinds);
+        theSocket->replyKinds = NULL;
+        theSocket->pendingKinds = NULL;
+        theSocket->sizeKinds = 0;
+    }
+    if (theSocket->requestData != NULL) {
+        free(theSocket->requestData);
+        theSocket->requestData = NULL;
+        theSocket->lenRequest = 0;
+    }
+    
     // cleanup sockets
     cleanupsockets();
 }
@@ -584,6 +766,319 @@ void CALL_CONV tcp_recvnbdata(int *socketID, int *dataTypeSize, char data[], int
 }
 
 
+// fill in a conditional matrix request with the version of the cache
+static void setmatrixrequest(SocketConnection *theSocket, double request[],
+    int type, int lenData)
+{
+    memset(request, 0, lenData * sizeof(double));
+    request[0] = OF_RemoteTest_getMatrix;
+    request[1] = type;
+    request[2] = theSocket->matrixVersion[type - OF_RemoteTest_getInitialStiff];
+    request[3] = 1;  // pack a symmetric matrix
+}
+
+
+// receive the reply to a conditional matrix request, update the
+// cache and copy the full matrix to data (at least ndf*ndf long)
+static void recvmatrixreply(SocketConnection *theSocket, int *socketID,
+    int type, double data[], int *ierr)
+{
+    int dataTypeSize = sizeof(double);
+    int lenHeader = MATRIX_HEADER;
+    int ndf = theSocket->ndfMatrix;
+    int id = type - OF_RemoteTest_getInitialStiff;
+    double *matrix = theSocket->matrixData[id];
+    double header[MATRIX_HEADER];
+    int format, len, i, j, k;
+    
+    // the header holds the version, the format and the length
+    tcp_recvdata(socketID, &dataTypeSize, (char *)header, &lenHeader, ierr);
+    if (*ierr != 0)
+        return;
+    format = (int)header[1];
+    len = (int)header[2];
+    
+    if (format == OF_Matrix_full && len == ndf*ndf) {
+        tcp_recvdata(socketID, &dataTypeSize, (char *)matrix, &len, ierr);
+    }
+    else if (format == OF_Matrix_upperTri && len == ndf*(ndf+1)/2) {
+        tcp_recvdata(socketID, &dataTypeSize, (char *)data, &len, ierr);
+        for (j=0, k=0; j<ndf; j++) {
+            for (i=0; i<=j; i++, k++)
+                matrix[i+j*ndf] = matrix[j+i*ndf] = data[k];
+        }
+    }
+    else if (format != OF_Matrix_unchanged || len != 0) {
+        fprintf(stderr,"tcp_socket::recvmatrixreply() - invalid matrix reply received\n");
+        *ierr = -5;
+    }
+    if (*ierr != 0)
+        return;
+    
+    theSocket->matrixVersion[id] = (int)header[0];
+    memcpy(data, matrix, ndf*ndf*sizeof(double));
+}
+
+
+/*
+* tcp_queuedata() - function to queue a request for a batched send
+*
+* input: int *socketID - socket identifier
+*        double *data - pointer to request to queue
+*        int *lenData - length of request (dataSize of the server)
+*        
+* return: int *ierr - 0 if successfull, negative number if not
+*/
+void CALL_CONV tcp_queuedata(int *socketID, double data[], int *lenData, int *ierr)
+{
+    SocketConnection *theSocket = theSockets;
+    double *request;
+    int action;
+    *ierr = 0;
+    
+    // find the socket
+    while (theSocket != 0 && theSocket->socketID != *socketID)
+        theSocket = theSocket->next;
+    if (theSocket == 0) {
+        fprintf(stderr,"tcp_socket::queuedata() - could not find socket to queue data\n");
+        *ierr = -1;
+        return;
+    }
+    
+    // append the request
+    request = appendrequest(theSocket, *lenData, "queuedata", ierr);
+    if (request == NULL)
+        return;
+    memcpy(request, data, *lenData * sizeof(double));
+    
+    // count the requests that the server answers
+    action = (int)data[0];
+    if (action >= OF_RemoteTest_getDaqResponse && action <= OF_RemoteTest_getMass) {
+        if (addreply(theSocket, 0) != 0) {
+            fprintf(stderr,"tcp_socket::queuedata() - could not allocate reply list\n");
+            *ierr = -3;
+        }
+    }
+}
+
+
+/*
+* tcp_flushdata() - function to send all queued requests as one message
+*
+* input: int *socketID - socket identifier
+*        
+* return: int *numReplies - number of replies to receive with recvbatchdata
+*         int *ierr - 0 if successfull, negative number if not
+*/
+void CALL_CONV tcp_flushdata(int *socketID, int *numReplies, int *ierr)
+{
+    SocketConnection *theSocket = theSockets;
+    int dataTypeSize = sizeof(double);
+    int lenData;
+    int *kinds;
+    *numReplies = 0;
+    *ierr = 0;
+    
+    // find the socket
+    while (theSocket != 0 && theSocket->socketID != *socketID)
+        theSocket = theSocket->next;
+    if (theSocket == 0) {
+        fprintf(stderr,"tcp_socket::flushdata() - could not find socket to flush data\n");
+        *ierr = -1;
+        return;
+    }
+    if (theSocket->numBatch == 0)
+        return;
+    
+    // replies of the previous batch need to be received first
+    if (theSocket->numPending != 0) {
+        fprintf(stderr,"tcp_socket::flushdata() - replies of previous batch not received\n");
+        *ierr = -2;
+        return;
+    }
+    
+    // fill in the batch header
+    memset(theSocket->batchData, 0, theSocket->lenBatch * sizeof(double));
+    theSocket->batchData[0] = OF_RemoteTest_batch;
+    theSocket->batchData[1] = theSocket->numBatch;
+    
+    // send header and requests in one message
+    lenData = (theSocket->numBatch + 1) * theSocket->lenBatch;
+    tcp_senddata(socketID, &dataTypeSize, (char *)theSocket->batchData, &lenData, ierr);
+    if (*ierr != 0)
+        return;
+    
+    // the kinds of the replies move on with the batch
+    kinds = theSocket->pendingKinds;
+    theSocket->pendingKinds = theSocket->replyKinds;
+    theSocket->replyKinds = kinds;
+    
+    *numReplies = theSocket->numReplies;
+    theSocket->numPending = theSocket->numReplies;
+    theSocket->numBatch = 0;
+    theSocket->numReplies = 0;
+}
+
+
+/*
+* tcp_recvbatchdata() - function to receive the replies of a flushed batch
+*
+* input: int *socketID - socket identifier
+*        double *data - pointer to data to receive (numReplies*lenData)
+*        int *lenData - length of one reply (dataSize of the server)
+*        
+* return: int *ierr - 0 if successfull, negative number if not
+*
+* The reply to a conditional matrix request (queuematrix) is expanded
+* from the matrix cache, so that its record holds the full matrix.
+*/
+void CALL_CONV tcp_recvbatchdata(int *socketID, double data[], int *lenData, int *ierr)
+{
+    SocketConnection *theSocket = theSockets;
+    int dataTypeSize = sizeof(double);
+    int lenTotal, i, first = 0;
+    *ierr = 0;
+    
+    // find the socket
+    while (theSocket != 0 && theSocket->socketID != *socketID)
+        theSocket = theSocket->next;
+    if (theSocket == 0) {
+        fprintf(stderr,"tcp_socket::recvbatchdata() - could not find socket to receive data\n");
+        *ierr = -1;
+        return;
+    }
+    if (theSocket->numPending == 0)
+        return;
+    
+    // all replies arrive back-to-back in the order of the requests
+    for (i=0; i<=theSocket->numPending; i++) {
+        if (i < theSocket->numPending && theSocket->pendingKinds[i] == 0)
+            continue;
+        
+        // receive the replies up to the next matrix reply in one piece
+        if (i > first) {
+            lenTotal = (i - first) * *lenData;
+            tcp_recvdata(socketID, &dataTypeSize, (char *)&data[first * *lenData], &lenTotal, ierr);
+            if (*ierr != 0)
+                break;
+        }
+        if (i < theSocket->numPending) {
+            recvmatrixreply(theSocket, socketID, theSocket->pendingKinds[i],
+                &data[i * *lenData], ierr);
+            if (*ierr != 0)
+                break;
+        }
+        first = i + 1;
+    }
+    theSocket->numPending = 0;
+}
+
+
+/*
+* tcp_queuematrix() - function to queue a conditional matrix request
+*
+* input: int *socketID - socket identifier
+*        int *matrixType - OF_RemoteTest_getInitialStiff, getTangentStiff,
+*                          getDamp or getMass (12 to 15)
+*        int *ndf - number of rows and columns of the matrix
+*        int *lenData - length of request (dataSize of the server)
+*        
+* return: int *ierr - 0 if successfull, negative number if not
+*
+* The server only sends the matrix if it changed since the version in
+* the cache of the connection and packs a symmetric matrix as its upper
+* triangle. The reply needs a stream connection, since it is shorter
+* than dataSize.
+*/
+void CALL_CONV tcp_queuematrix(int *socketID, int *matrixType, int *ndf, int *lenData, int *ierr)
+{
+    SocketConnection *theSocket = theSockets;
+    double *request;
+    *ierr = 0;
+    
+    // find the socket
+    while (theSocket != 0 && theSocket->socketID != *socketID)
+        theSocket = theSocket->next;
+    if (theSocket == 0) {
+        fprintf(stderr,"tcp_socket::queuematrix() - could not find socket to queue data\n");
+        *ierr = -1;
+        return;
+    }
+    if (preparematrix(theSocket, *matrixType, *ndf, *lenData, "queuematrix") != 0) {
+        *ierr = -4;
+        return;
+    }
+    
+    // append the request
+    request = appendrequest(theSocket, *lenData, "queuematrix", ierr);
+    if (request == NULL)
+        return;
+    setmatrixrequest(theSocket, request, *matrixType, *lenData);
+    
+    if (addreply(theSocket, *matrixType) != 0) {
+        fprintf(stderr,"tcp_socket::queuematrix() - could not allocate reply list\n");
+        *ierr = -3;
+    }
+}
+
+
+/*
+* tcp_getmatrix() - function to get a matrix with a conditional request
+*
+* input: int *socketID - socket identifier
+*        int *matrixType - OF_RemoteTest_getInitialStiff, getTangentStiff,
+*                          getDamp or getMass (12 to 15)
+*        int *ndf - number of rows and columns of the matrix
+*        double *data - pointer to data to receive (lenData)
+*        int *lenData - length of request (dataSize of the server)
+*        
+* return: int *ierr - 0 if successfull, negative number if not
+*/
+void CALL_CONV tcp_getmatrix(int *socketID, int *matrixType, int *ndf, double data[], int *lenData, int *ierr)
+{
+    SocketConnection *theSocket = theSockets;
+    int dataTypeSize = sizeof(double);
+    double *newData;
+    *ierr = 0;
+    
+    // find the socket
+    while (theSocket != 0 && theSocket->socketID != *socketID)
+        theSocket = theSocket->next;
+    if (theSocket == 0) {
+        fprintf(stderr,"tcp_socket::getmatrix() - could not find socket to get matrix\n");
+        *ierr = -1;
+        return;
+    }
+    if (theSocket->numPending != 0) {
+        fprintf(stderr,"tcp_socket::getmatrix() - replies of previous batch not received\n");
+        *ierr = -2;
+        return;
+    }
+    if (preparematrix(theSocket, *matrixType, *ndf, *lenData, "getmatrix") != 0) {
+        *ierr = -4;
+        return;
+    }
+    
+    // the request buffer is only allocated once
+    if (theSocket->lenRequest != *lenData) {
+        newData = (double *)realloc(theSocket->requestData, *lenData * sizeof(double));
+        if (newData == NULL) {
+            fprintf(stderr,"tcp_socket::getmatrix() - could not allocate request\n");
+            *ierr = -3;
+            return;
+        }
+        theSocket->requestData = newData;
+        theSocket->lenRequest = *lenData;
+    }
+    setmatrixrequest(theSocket, theSocket->requestData, *matrixType, *lenData);
+    
+    tcp_senddata(socketID, &dataTypeSize, (char *)theSocket->requestData, lenData, ierr);
+    if (*ierr != 0)
+        return;
+    recvmatrixreply(theSocket, socketID, *matrixType, data, ierr);
+}
+
+
 /*
 * tcp_getsocketid() - function to find an open connection
 *
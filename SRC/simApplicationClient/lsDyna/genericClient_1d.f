@@ -93,6 +93,7 @@ c
       integer*4 iData(11)
       real*8    sData(sizeSendData)
       real*8    rData(sizeSendData)
+      integer*4 numRply
 
       do i = lft, llt
          if (nint(hsv(i,1)) .eq. 0) then
@@ -152,19 +153,31 @@ c
             sData(1+j) = hsv(i,1+j)
          enddo
 c
-         call senddata(socketID, sizeDouble, sData, sizeSendData, stat)
+         call queuedata(socketID, sData, sizeSendData, stat)
 c
 c ...    get measured resisting forces
 c
          sData(1) = 10
-         call senddata(socketID, sizeDouble, sData, sizeSendData, stat)
+         call queuedata(socketID, sData, sizeSendData, stat)
 c
-         call recvdata(socketID, sizeDouble, rData, sizeSendData, stat)
+c ...    send both requests in one message without waiting for
+c ...    the reply so that all elements are served concurrently
 c
-         do j = 1, 2
-            force(i,j)   = rData(j)
-            force(i,j+6) = rData(j+2)
-         enddo
+         call flushdata(socketID, numRply, stat)
+      enddo
+c
+c ... collect the measured resisting forces of all elements
+c
+      do i = lft, llt
+         socketID = nint(hsv(i,1))
+         if (socketID .gt. 0) then
+            call recvbatchdata(socketID, rData, sizeSendData, stat)
+c
+            do j = 1, 2
+               force(i,j)   = rData(j)
+               force(i,j+6) = rData(j+2)
+            enddo
+         endif
       enddo
       
       return 
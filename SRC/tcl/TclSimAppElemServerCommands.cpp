@@ -36,21 +36,94 @@
 #include <TCP_Socket.h>
 #include <TCP_SocketSSL.h>
 #include <UDP_Socket.h>
+#include <ImpairedChannel.h>
+#include <ChannelOptions.h>
 
 #include <ExperimentalElement.h>
 
 
+// size of the header of a matrix reply (version, format, length)
+static const int sizeMatrixHeader = 3;
+
+
+// send the reply to a request or, if the request is part of a
+// batch (OF_RemoteTest_batch), collect it to be sent with the others
+static void sendReply(Channel *theChannel, Vector &sendData,
+    double *replyData, int &sizeReplies)
+{
+    if (replyData == 0)  {
+        theChannel->sendVector(0, 0, sendData, 0);
+    } else  {
+        int size = sendData.Size();
+        for (int i=0; i<size; i++)
+            replyData[sizeReplies+i] = sendData(i);
+        sizeReplies += size;
+    }
+}
+
+
+// fill the reply to a conditional matrix request (OF_RemoteTest_getMatrix)
+// and return its size: the matrix gets a new version whenever it differs
+// from the last one, a client that holds the current version only gets
+// the header and a symmetric matrix can be packed as its upper triangle
+static int setMatrixReply(const Matrix &theMatrix, Matrix &lastMatrix,
+    int &version, int cachedVersion, int packed, double *mData)
+{
+    int i, j, k = sizeMatrixHeader;
+    int n = theMatrix.noRows();
+    
+    bool changed = (version == 0);
+    for (j=0; j<n && !changed; j++)  {
+        for (i=0; i<n && !changed; i++)
+            changed = (theMatrix(i,j) != lastMatrix(i,j));
+    }
+    if (changed)  {
+        lastMatrix = theMatrix;
+        version++;
+    }
+    mData[0] = version;
+    
+    if (cachedVersion == version)  {
+        mData[1] = OF_Matrix_unchanged;
+    } else  {
+        bool symmetric = (packed != 0);
+        for (j=1; j<n && symmetric; j++)  {
+            for (i=0; i<j && symmetric; i++)
+                symmetric = (theMatrix(i,j) == theMatrix(j,i));
+        }
+        if (symmetric)  {
+            mData[1] = OF_Matrix_upperTri;
+            for (j=0; j<n; j++)  {
+                for (i=0; i<=j; i++)
+                    mData[k++] = theMatrix(i,j);
+            }
+        } else  {
+            mData[1] = OF_Matrix_full;
+            for (j=0; j<n; j++)  {
+                for (i=0; i<n; i++)
+                    mData[k++] = theMatrix(i,j);
+            }
+        }
+    }
+    mData[2] = k - sizeMatrixHeader;
+    
+    return k;
+}
+
+
 int TclStartSimAppElemServer(ClientData clientData, Tcl_Interp *interp,
     int argc, TCL_Char **argv, Domain *theDomain)
 { 
     if (argc < 3)  {
         opserr << "WARNING insufficient arguments\n"
-            << "Want: startSimAppElemServer eleTag ipPort <-udp> <-ssl>\n";
+            << "Want: startSimAppElemServer eleTag ipPort <-udp> <-ssl> <channelOptions>\n";
         return TCL_ERROR;
     }
     
     int eleTag, ipPort;
     int ssl = 0, udp = 0;
+    int numArgs;
+    ChannelOptions theOptions;
     Channel *theChannel = 0;
     
     if (Tcl_GetInt(interp, argv[1], &eleTag) != TCL_OK)  {
@@ -68,11 +141,18 @@ int TclStartSimAppElemServer(ClientData clientData, Tcl_Interp *interp,
         opserr << "WARNING invalid startSimAppElemServer ipPort\n";
         return TCL_ERROR;
     }
-    if (argc == 4)  {
-        if (strcmp(argv[3], "-ssl") == 0)
+    for (int i = 3; i < argc; i++)  {
+        if (strcmp(argv[i], "-ssl") == 0)
             ssl = 1;
-        else if (strcmp(argv[3], "-udp") == 0)
+        else if (strcmp(argv[i], "-udp") == 0)
             udp = 1;
+        else if ((numArgs = theOptions.parse(argc-i, &argv[i])) != 0)  {
+            if (numArgs < 0)  {
+                opserr << "WARNING invalid startSimAppElemServer channel option\n";
+                return TCL_ERROR;
+            }
+            i += numArgs-1;
+        }
     }
     
     // setup the connection
@@ -106,6 +186,8 @@ int TclStartSimAppElemServer(ClientData clientData, Tcl_Interp *interp,
             return TCL_ERROR;
         }
     }
+    theChannel->setChannelOptions(theOptions);
+    theChannel = ImpairedChannel::wrap(theChannel, theOptions);
     if (theChannel->setUpConnection() != 0)  {
         opserr << "WARNING could not setup connection\n";
         return TCL_ERROR;
@@ -209,13 +291,32 @@ int TclStartSimAppElemServer(ClientData clientData, Tcl_Interp *interp,
     Matrix *sMatrix = new Matrix(sData, ndf, ndf);
     sMatrix->Zero();
     
+    // last sent version of the initial and tangent stiffness,
+    // damping and mass matrices for the conditional requests
+    Matrix *lastMatrix[4];
+    int matrixVersion[4];
+    for (i=0; i<4; i++)  {
+        lastMatrix[i] = new Matrix(ndf, ndf);
+        matrixVersion[i] = 0;
+    }
+    double *mData = new double [sizeMatrixHeader + ndf*ndf];
+    
     // start server loop
     opserr << "\nSimAppElemServer with ExpElement " << eleTag
         << " now running...\n";
     Vector nodeData(1);
+    double *bRecvData = 0, *bSendData = 0, *replyData = 0;
+    int sizeBatch = 0, numBatch = 0, batchID = 0, sizeReplies = 0;
     bool exitYet = false;
     while (!exitYet) {
-        theChannel->recvVector(0, 0, *recvData, 0);
+        if (batchID < numBatch)  {
+            // get the next request of the batch
+            Vector batchData(bRecvData, numBatch*(*dataSize));
+            recvData->Extract(batchData, batchID*(*dataSize));
+            batchID++;
+        } else  {
+            theChannel->recvVector(0, 0, *recvData, 0);
+        }
         int action = (int)rData[0];
         
         //opserr << "\nLOOP action: " << *recvData << endln;
@@ -264,43 +365,103 @@ int TclStartSimAppElemServer(ClientData clientData, Tcl_Interp *interp,
                 (*sForce) = theExperimentalElement->getResistingForce();
             if (sTime != 0)
                 (*sTime) = theExperimentalElement->getTime();
-            theChannel->sendVector(0, 0, *sendData, 0);
+            sendReply(theChannel, *sendData, replyData, sizeReplies);
             break;
         case OF_RemoteTest_getDisp:
             (*sDisp) = theExperimentalElement->getDisp();
-            theChannel->sendVector(0, 0, *sendData, 0);
+            sendReply(theChannel, *sendData, replyData, sizeReplies);
             break;
         case OF_RemoteTest_getVel:
             (*sVel) = theExperimentalElement->getVel();
-            theChannel->sendVector(0, 0, *sendData, 0);
+            sendReply(theChannel, *sendData, replyData, sizeReplies);
             break;
         case OF_RemoteTest_getAccel:
             (*sAccel) = theExperimentalElement->getAccel();
-            theChannel->sendVector(0, 0, *sendData, 0);
+            sendReply(theChannel, *sendData, replyData, sizeReplies);
             break;
         case OF_RemoteTest_getForce:
             (*sForce) = theExperimentalElement->getResistingForce();
-            theChannel->sendVector(0, 0, *sendData, 0);
+            sendReply(theChannel, *sendData, replyData, sizeReplies);
             break;
         case OF_RemoteTest_getTime:
             (*sTime) = theExperimentalElement->getTime();
-            theChannel->sendVector(0, 0, *sendData, 0);
+            sendReply(theChannel, *sendData, replyData, sizeReplies);
             break;
         case OF_RemoteTest_getInitialStiff:
             (*sMatrix) = theExperimentalElement->getInitialStiff();
-            theChannel->sendVector(0, 0, *sendData, 0);
+            sendReply(theChannel, *sendData, replyData, sizeReplies);
             break;
         case OF_RemoteTest_getTangentStiff:
             (*sMatrix) = theExperimentalElement->getTangentStiff();
-            theChannel->sendVector(0, 0, *sendData, 0);
+            sendReply(theChannel, *sendData, replyData, sizeReplies);
             break;
         case OF_RemoteTest_getDamp:
             (*sMatrix) = theExperimentalElement->getDamp();
-            theChannel->sendVector(0, 0, *sendData, 0);
+            sendReply(theChannel, *sendData, replyData, sizeReplies);
             break;
         case OF_RemoteTest_getMass:
             (*sMatrix) = theExperimentalElement->getMass();
-            theChannel->sendVector(0, 0, *sendData, 0);
+            sendReply(theChannel, *sendData, replyData, sizeReplies);
+            break;
+        case OF_RemoteTest_getMatrix:
+            {
+                int type = (int)rData[1] - OF_RemoteTest_getInitialStiff;
+                const Matrix *theMatrix;
+                switch (type)  {
+                case 0:
+                    theMatrix = &theExperimentalElement->getInitialStiff();
+                    break;
+                case 1:
+                    theMatrix = &theExperimentalElement->getTangentStiff();
+                    break;
+                case 2:
+                    theMatrix = &theExperimentalElement->getDamp();
+                    break;
+                case 3:
+                    theMatrix = &theExperimentalElement->getMass();
+                    break;
+                default:
+                    opserr << "WARNING SimAppElemServer invalid matrix "
+                        << rData[1] << " requested\n";
+                    theMatrix = 0;
+                    break;
+                }
+                if (theMatrix == 0)
+                    break;
+                int size = setMatrixReply(*theMatrix, *lastMatrix[type],
+                    matrixVersion[type], (int)rData[2], (int)rData[3], mData);
+                Vector matrixReply(mData, size);
+                sendReply(theChannel, matrixReply, replyData, sizeReplies);
+            }
+            break;
+        case OF_RemoteTest_batch:
+            if (replyData != 0)  {
+                opserr << "WARNING SimAppElemServer nested batch "
+                    << "received which is ignored, continuing execution\n";
+                break;
+            }
+            numBatch = (int)rData[1];
+            if (numBatch <= 0)  {
+                numBatch = 0;
+                break;
+            }
+            if (numBatch*(*dataSize) > sizeBatch)  {
+                if (bRecvData != 0)
+                    delete [] bRecvData;
+                if (bSendData != 0)
+                    delete [] bSendData;
+                sizeBatch = numBatch*(*dataSize);
+                bRecvData = new double [sizeBatch];
+                bSendData = new double [numBatch*(*dataSize+sizeMatrixHeader)];
+            }
+            {
+                // receive all requests of the batch at once
+                Vector batchData(bRecvData, numBatch*(*dataSize));
+                theChannel->recvVector(0, 0, batchData, 0);
+            }
+            batchID = 0;
+            sizeReplies = 0;
+            replyData = bSendData;
             break;
         case OF_RemoteTest_DIE:
             exitYet = true;
@@ -310,6 +471,16 @@ int TclStartSimAppElemServer(ClientData clientData, Tcl_Interp *interp,
                 << action << " received\n";
             break;
         }
+        
+        // send the collected replies once the batch is complete
+        if (replyData != 0 && batchID == numBatch)  {
+            if (sizeReplies > 0)  {
+                Vector replies(bSendData, sizeReplies);
+                theChannel->sendVector(0, 0, replies, 0);
+            }
+            replyData = 0;
+            numBatch = batchID = sizeReplies = 0;
+        }
     }
     opserr << "\nSimAppElemServer with ExpElement " << eleTag
         << " shutdown\n\n";
@@ -344,6 +515,14 @@ int TclStartSimAppElemServer(ClientData clientData, Tcl_Interp *interp,
     delete sMatrix;
     delete sendData;
     delete [] sData;
+    for (i=0; i<4; i++)
+        delete lastMatrix[i];
+    delete [] mData;
+    
+    if (bRecvData != 0)
+        delete [] bRecvData;
+    if (bSendData != 0)
+        delete [] bSendData;
     
     return TCL_OK;
 }
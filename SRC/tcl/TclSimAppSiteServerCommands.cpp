@@ -34,6 +34,9 @@
 #include <TCP_Socket.h>
 #include <TCP_SocketSSL.h>
 #include <UDP_Socket.h>
+#include <SHM_Channel.h>
+#include <ImpairedChannel.h>
+#include <ChannelOptions.h>
 
 #include <ExperimentalSite.h>
 
@@ -41,17 +44,35 @@ extern ExperimentalSite *getExperimentalSite(int tag);
 extern int removeExperimentalSite(int tag);
 
 
+// send the reply to a request or, if the request is part of a
+// batch (OF_RemoteTest_batch), collect it to be sent with the others
+static void sendReply(Channel *theChannel, Vector &sendData,
+    double *replyData, int &numReplies)
+{
+    if (replyData == 0)  {
+        theChannel->sendVector(0, 0, sendData, 0);
+    } else  {
+        int size = sendData.Size();
+        for (int i=0; i<size; i++)
+            replyData[numReplies*size+i] = sendData(i);
+        numReplies++;
+    }
+}
+
+
 int TclStartSimAppSiteServer(ClientData clientData,
     Tcl_Interp *interp, int argc, TCL_Char **argv)
 { 
     if (argc < 3)  {
         opserr << "WARNING insufficient arguments\n"
-            << "Want: startSimAppSiteServer siteTag ipPort <-udp> <-ssl>\n";
+            << "Want: startSimAppSiteServer siteTag ipPort <-udp> <-ssl> <-shm> <channelOptions>\n";
         return TCL_ERROR;
     }
     
     int siteTag, ipPort;
-    int ssl = 0, udp = 0;
+    int ssl = 0, udp = 0, shm = 0;
+    int numArgs;
+    ChannelOptions theOptions;
     Channel *theChannel = 0;
     
     if (Tcl_GetInt(interp, argv[1], &siteTag) != TCL_OK)  {
@@ -68,15 +89,34 @@ int TclStartSimAppSiteServer(ClientData clientData,
         opserr << "WARNING invalid startSimAppSiteServer ipPort\n";
         return TCL_ERROR;
     }
-    if (argc == 4)  {
-        if (strcmp(argv[3], "-ssl") == 0)
+    for (int i = 3; i < argc; i++)  {
+        if (strcmp(argv[i], "-ssl") == 0)
             ssl = 1;
-        else if (strcmp(argv[3], "-udp") == 0)
+        else if (strcmp(argv[i], "-udp") == 0)
             udp = 1;
+        else if (strcmp(argv[i], "-shm") == 0)
+            shm = 1;
+        else if ((numArgs = theOptions.parse(argc-i, &argv[i])) != 0)  {
+            if (numArgs < 0)  {
+                opserr << "WARNING invalid startSimAppSiteServer channel option\n";
+                return TCL_ERROR;
+            }
+            i += numArgs-1;
+        }
     }
     
     // setup the connection
-    if (ssl)  {
+    if (shm)  {
+        theChannel = new SHM_Channel(ipPort);
+        if (theChannel != 0) {
+            opserr << "\nShared Memory Channel successfully created: "
+                << "Waiting for Simulation Application Client...\n";
+        } else {
+            opserr << "WARNING could not create shared memory channel\n";
+            return TCL_ERROR;
+        }
+    }
+    else if (ssl)  {
         theChannel = new TCP_SocketSSL(ipPort);
         if (theChannel != 0) {
             opserr << "\nSSL Channel successfully created: "
@@ -106,6 +146,8 @@ int TclStartSimAppSiteServer(ClientData clientData,
             return TCL_ERROR;
         }
     }
+    theChannel->setChannelOptions(theOptions);
+    theChannel = ImpairedChannel::wrap(theChannel, theOptions);
     if (theChannel->setUpConnection() != 0)  {
         opserr << "WARNING could not setup connection\n";
         return TCL_ERROR;
@@ -182,9 +224,18 @@ int TclStartSimAppSiteServer(ClientData clientData,
     // start server loop
     opserr << "\nSimAppSiteServer with ExpSite " << siteTag
         << " now running...\n";
+    double *bRecvData = 0, *bSendData = 0, *replyData = 0;
+    int sizeBatch = 0, numBatch = 0, batchID = 0, numReplies = 0;
     bool exitYet = false;
     while (!exitYet) {
-        theChannel->recvVector(0, 0, *recvData, 0);
+        if (batchID < numBatch)  {
+            // get the next request of the batch
+            Vector batchData(bRecvData, numBatch*(*dataSize));
+            recvData->Extract(batchData, batchID*(*dataSize));
+            batchID++;
+        } else  {
+            theChannel->recvVector(0, 0, *recvData, 0);
+        }
         int action = (int)rData[0];
         
         //opserr << "\nLOOP action: " << *recvData << endln;
@@ -204,27 +255,56 @@ int TclStartSimAppSiteServer(ClientData clientData,
             break;
         case OF_RemoteTest_getDaqResponse:
             theExperimentalSite->getDaqResponse(sDisp, sVel, sAccel, sForce, sTime);
-            theChannel->sendVector(0, 0, *sendData, 0);
+            sendReply(theChannel, *sendData, replyData, numReplies);
             break;
         case OF_RemoteTest_getDisp:
             (*sDisp) = theExperimentalSite->getDisp();
-            theChannel->sendVector(0, 0, *sendData, 0);
+            sendReply(theChannel, *sendData, replyData, numReplies);
             break;
         case OF_RemoteTest_getVel:
             (*sVel) = theExperimentalSite->getVel();
-            theChannel->sendVector(0, 0, *sendData, 0);
+            sendReply(theChannel, *sendData, replyData, numReplies);
             break;
         case OF_RemoteTest_getAccel:
             (*sAccel) = theExperimentalSite->getAccel();
-            theChannel->sendVector(0, 0, *sendData, 0);
+            sendReply(theChannel, *sendData, replyData, numReplies);
             break;
         case OF_RemoteTest_getForce:
             (*sForce) = theExperimentalSite->getForce();
-            theChannel->sendVector(0, 0, *sendData, 0);
+            sendReply(theChannel, *sendData, replyData, numReplies);
             break;
         case OF_RemoteTest_getTime:
             (*sTime) = theExperimentalSite->getTime();
-            theChannel->sendVector(0, 0, *sendData, 0);
+            sendReply(theChannel, *sendData, replyData, numReplies);
+            break;
+        case OF_RemoteTest_batch:
+            if (replyData != 0)  {
+                opserr << "WARNING SimAppSiteServer nested batch "
+                    << "received which is ignored, continuing execution\n";
+                break;
+            }
+            numBatch = (int)rData[1];
+            if (numBatch <= 0)  {
+                numBatch = 0;
+                break;
+            }
+            if (numBatch*(*dataSize) > sizeBatch)  {
+                if (bRecvData != 0)
+                    delete [] bRecvData;
+                if (bSendData != 0)
+                    delete [] bSendData;
+                sizeBatch = numBatch*(*dataSize);
+                bRecvData = new double [sizeBatch];
+                bSendData = new double [sizeBatch];
+            }
+            {
+                // receive all requests of the batch at once
+                Vector batchData(bRecvData, numBatch*(*dataSize));
+                theChannel->recvVector(0, 0, batchData, 0);
+            }
+            batchID = 0;
+            numReplies = 0;
+            replyData = bSendData;
             break;
         case OF_RemoteTest_DIE:
             //removeExperimentalSite(siteTag);
@@ -236,6 +316,16 @@ int TclStartSimAppSiteServer(ClientData clientData,
                 << action << " received\n";
             break;
         }
+        
+        // send the collected replies once the batch is complete
+        if (replyData != 0 && batchID == numBatch)  {
+            if (numReplies > 0)  {
+                Vector replies(bSendData, numReplies*(*dataSize));
+                theChannel->sendVector(0, 0, replies, 0);
+            }
+            replyData = 0;
+            numBatch = batchID = numReplies = 0;
+        }
     }
     opserr << "\nSimAppSiteServer with ExpSite " << siteTag
         << " shutdown\n\n";
@@ -270,5 +360,10 @@ int TclStartSimAppSiteServer(ClientData clientData,
     delete sendData;
     delete [] sData;
     
+    if (bRecvData != 0)
+        delete [] bRecvData;
+    if (bSendData != 0)
+        delete [] bSendData;
+    
     return TCL_OK;
 }
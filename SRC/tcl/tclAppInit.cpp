@@ -227,6 +227,26 @@ int openFresco_addExperimentalSite(ClientData clientData,
     return TclExpSiteCommand(clientData, interp, argc, argv, theDomain);
 }
 
+// experimental checkpoint command
+extern int TclExpCheckpointCommand(ClientData clientData, Tcl_Interp *interp,
+    int argc, TCL_Char **argv, Domain *theDomain);
+
+int openFresco_expCheckpoint(ClientData clientData,
+    Tcl_Interp *interp, int argc, TCL_Char **argv)
+{
+    return TclExpCheckpointCommand(clientData, interp, argc, argv, theDomain);
+}
+
+// experimental trajectory command
+extern int TclExpTrajectoryCommand(ClientData clientData, Tcl_Interp *interp,
+    int argc, TCL_Char **argv);
+
+int openFresco_expTrajectory(ClientData clientData,
+    Tcl_Interp *interp, int argc, TCL_Char **argv)
+{
+    return TclExpTrajectoryCommand(clientData, interp, argc, argv);
+}
+
 // experimental tangent stiffness commands
 extern int TclExpTangentStiffCommand(ClientData clientData, Tcl_Interp *interp,
     int argc, TCL_Char **argv, Domain *theDomain);
@@ -1030,6 +1050,12 @@ int Tcl_AppInit(Tcl_Interp *interp)
     Tcl_CreateCommand(interp, "expRecorder", openFresco_addExperimentalRecorder,
         (ClientData)NULL, (Tcl_CmdDeleteProc*)NULL);
     
+    Tcl_CreateCommand(interp, "expCheckpoint", openFresco_expCheckpoint,
+        (ClientData)NULL, (Tcl_CmdDeleteProc*)NULL);
+    
+    Tcl_CreateCommand(interp, "expTrajectory", openFresco_expTrajectory,
+        (ClientData)NULL, (Tcl_CmdDeleteProc*)NULL);
+    
     Tcl_CreateCommand(interp, "startLabServer", openFresco_startLabServer,
         (ClientData)NULL, (Tcl_CmdDeleteProc*)NULL);
     